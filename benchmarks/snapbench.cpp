@@ -0,0 +1,396 @@
+#include "stdafx.h"
+#include "n2v.h"
+
+#ifdef GLib_UNIX
+#include <sys/resource.h>
+#endif
+
+/////////////////////////////////////////////////
+// SNAP benchmark suite
+// Generates deterministic inputs, times a fixed set of hot paths, reports the
+// peak resident memory of each and writes the results as JSON. Given the JSON
+// of an earlier run as a baseline, the run fails when a benchmark is slower or
+// uses more memory than the tolerance allows, or when its result changed.
+
+// Peak resident set size in KB, -1 if unknown.
+int64 GetPeakRssKB() {
+#ifdef GLib_LINUX
+  FILE* F = fopen("/proc/self/status", "r");
+  if (F != NULL) {
+    char Ln[256];
+    int64 KB = -1;
+    while (fgets(Ln, sizeof(Ln), F) != NULL) {
+      if (strncmp(Ln, "VmHWM:", 6) == 0) { KB = atoll(Ln+6);  break; }
+    }
+    fclose(F);
+    if (KB >= 0) { return KB; }
+  }
+#endif
+#ifdef GLib_UNIX
+  struct rusage Usage;
+  getrusage(RUSAGE_SELF, &Usage);
+#ifdef GLib_MACOSX
+  return int64(Usage.ru_maxrss) / 1024;
+#else
+  return int64(Usage.ru_maxrss);
+#endif
+#else
+  return -1;
+#endif
+}
+
+// Resets the peak resident set size to the current one (Linux 4.0 and later).
+// Elsewhere the reported peak is the peak of the process so far.
+void ResetPeakRss() {
+#ifdef GLib_LINUX
+  FILE* F = fopen("/proc/self/clear_refs", "w");
+  if (F != NULL) { fputs("5", F);  fclose(F); }
+#endif
+}
+
+// Forest Fire graph like TSnap::GenForestFire, which always uses seed 1,
+// with the fire and the ambassadors drawn from Seed.
+PNGraph GenForestFire(const int& Nodes, const double& FwdProb, const double& BckProb, const int& Seed) {
+  PNGraph Graph = TNGraph::New(Nodes, -1);
+  TRnd Rnd(Seed);
+  TForestFire ForestFire(Graph, FwdProb, BckProb, 1.0, Seed);
+  Graph->AddNode(0);
+  for (int n = 1; n < Nodes; n++) {
+    Graph->AddNode(n);
+    ForestFire.Infect(Rnd.GetUniDevInt(n));
+    ForestFire.BurnGeoFire();
+    for (int e = 0; e < ForestFire.GetBurned(); e++) {
+      Graph->AddEdge(n, ForestFire.GetBurnedNId(e)); }
+  }
+  return Graph;
+}
+
+// Inputs of all benchmarks, generated from Seed and sized by Scale.
+class TBenchIn {
+public:
+  int Scale, Seed;
+  PNGraph RMat;          // R-MAT graph, 2^17*Scale nodes and 2^20*Scale edges
+  PUNGraph PrefAttach;   // Barabasi-Albert graph, 2^17*Scale nodes of out-degree 5
+  PNGraph ForestFire;    // Forest Fire graph, 2^12*Scale nodes
+  TStr EdgeFNm, BinFNm, TableFNm;
+  Schema EdgeS;
+  TTableContext Context;
+  PTable EdgeT;          // (Src, Dst, Label, Val) rows of the R-MAT edges
+  PTable NodeT;          // (NId, Name) rows of the R-MAT nodes
+public:
+  TBenchIn(const int& _Scale, const int& _Seed, const TStr& WorkDir);
+};
+
+TBenchIn::TBenchIn(const int& _Scale, const int& _Seed, const TStr& WorkDir) : Scale(_Scale), Seed(_Seed) {
+  TRnd Rnd(Seed);
+  RMat = TSnap::GenRMat((1<<17)*Scale, (1<<20)*Scale, 0.57, 0.19, 0.19, Rnd);
+  PrefAttach = TSnap::GenPrefAttach((1<<17)*Scale, 5, Rnd);
+  ForestFire = GenForestFire((1<<12)*Scale, 0.35, 0.32, Seed);
+  EdgeFNm = WorkDir + "/snapbench-edges.txt";
+  BinFNm = WorkDir + "/snapbench-graph.bin";
+  TableFNm = WorkDir + "/snapbench-table.tsv";
+  TSnap::SaveEdgeList(RMat, EdgeFNm);
+  { TFOut FOut(BinFNm);  RMat->Save(FOut); }
+  {
+    TFOut FOut(TableFNm);
+    for (TNGraph::TEdgeI EI = RMat->BegEI(); EI < RMat->EndEI(); EI++) {
+      FOut.PutStr(TStr::Fmt("%d\t%d\tl%d\t%d\n", EI.GetSrcNId(), EI.GetDstNId(),
+        Rnd.GetUniDevInt(1000), Rnd.GetUniDevInt(1000000)));
+    }
+  }
+  EdgeS.Add(TPair<TStr,TAttrType>("Src", atInt));
+  EdgeS.Add(TPair<TStr,TAttrType>("Dst", atInt));
+  EdgeS.Add(TPair<TStr,TAttrType>("Label", atStr));
+  EdgeS.Add(TPair<TStr,TAttrType>("Val", atInt));
+  EdgeT = TTable::LoadSS(EdgeS, TableFNm, &Context);
+  Schema NodeS;
+  NodeS.Add(TPair<TStr,TAttrType>("NId", atInt));
+  NodeS.Add(TPair<TStr,TAttrType>("Name", atStr));
+  NodeT = TTable::New(NodeS, &Context);
+  for (TNGraph::TNodeI NI = RMat->BegNI(); NI < RMat->EndNI(); NI++) {
+    TTableRow Row;
+    Row.AddInt(NI.GetId());
+    Row.AddStr(TStr::Fmt("n%d", NI.GetId() % 5000));
+    NodeT->AddRow(Row);
+  }
+}
+
+/////////////////////////////////////////////////
+// Benchmarks
+// Every benchmark times its hot path in Secs and returns a checksum of the
+// result. Inputs are deterministic, so the checksum only changes when the
+// result of the hot path changes.
+typedef double (*TBenchFn)(TBenchIn& In, double& Secs);
+
+double BenchLoadEdgeList(TBenchIn& In, double& Secs) {
+  TExeTm Tm;
+  PNGraph Graph = TSnap::LoadEdgeList<PNGraph>(In.EdgeFNm, 0, 1);
+  Secs = Tm.GetSecs();
+  return Graph->GetEdges();
+}
+
+double BenchLoadBinary(TBenchIn& In, double& Secs) {
+  TExeTm Tm;
+  TFIn FIn(In.BinFNm);
+  PNGraph Graph = TNGraph::Load(FIn);
+  Secs = Tm.GetSecs();
+  return Graph->GetEdges();
+}
+
+double BenchLoadTable(TBenchIn& In, double& Secs) {
+  TExeTm Tm;
+  PTable T = TTable::LoadSS(In.EdgeS, In.TableFNm, &In.Context);
+  Secs = Tm.GetSecs();
+  return T->GetNumValidRows();
+}
+
+double BenchBfs(TBenchIn& In, double& Secs) {
+  const int StartNId = TSnap::GetMxDegNId(In.RMat);
+  TExeTm Tm;
+  TBreathFS<PNGraph> Bfs(In.RMat);
+  Bfs.DoBfs(StartNId, true, false);
+  Secs = Tm.GetSecs();
+  return Bfs.GetNVisited();
+}
+
+double BenchPageRank(TBenchIn& In, double& Secs) {
+  TIntFltH PRankH;
+  TExeTm Tm;
+  TSnap::GetPageRank(In.RMat, PRankH);
+  Secs = Tm.GetSecs();
+  int MxNId = -1;
+  for (int i = 0; i < PRankH.Len(); i++) {
+    if (MxNId == -1 || PRankH[i] > PRankH.GetDat(MxNId)) { MxNId = PRankH.GetKey(i); }
+  }
+  return MxNId;
+}
+
+double BenchWcc(TBenchIn& In, double& Secs) {
+  TCnComV CnComV;
+  TExeTm Tm;
+  TSnap::GetWccs(In.RMat, CnComV);
+  Secs = Tm.GetSecs();
+  return CnComV.Len();
+}
+
+double BenchScc(TBenchIn& In, double& Secs) {
+  TCnComV CnComV;
+  TExeTm Tm;
+  TSnap::GetSccs(In.RMat, CnComV);
+  Secs = Tm.GetSecs();
+  return CnComV.Len();
+}
+
+double BenchTriangles(TBenchIn& In, double& Secs) {
+  TExeTm Tm;
+  const int64 Triads = TSnap::GetTriads(In.PrefAttach);
+  Secs = Tm.GetSecs();
+  return double(Triads);
+}
+
+double BenchKCore(TBenchIn& In, double& Secs) {
+  TIntPrV CoreIdSzV;
+  TExeTm Tm;
+  TSnap::GetKCoreNodes(In.PrefAttach, CoreIdSzV);
+  Secs = Tm.GetSecs();
+  return CoreIdSzV.Len();
+}
+
+double BenchTableJoin(TBenchIn& In, double& Secs) {
+  TExeTm Tm;
+  PTable T = In.EdgeT->Join("Src", *In.NodeT, "NId");
+  Secs = Tm.GetSecs();
+  return T->GetNumValidRows();
+}
+
+double BenchTableGroup(TBenchIn& In, double& Secs) {
+  PTable T = TTable::New(In.EdgeT);
+  TStrV GroupBy;
+  GroupBy.Add("Label");  GroupBy.Add("Dst");
+  TExeTm Tm;
+  T->Group(GroupBy, "GroupId");
+  Secs = Tm.GetSecs();
+  int Groups = 0;
+  for (TRowIterator RI = T->BegRI(); RI < T->EndRI(); RI++) {
+    Groups = TMath::Mx(Groups, RI.GetIntAttr("GroupId").Val+1); }
+  return Groups;
+}
+
+double BenchTableOrder(TBenchIn& In, double& Secs) {
+  PTable T = TTable::New(In.EdgeT);
+  TStrV OrderBy;
+  OrderBy.Add("Label");  OrderBy.Add("Val");
+  TExeTm Tm;
+  T->Order(OrderBy);
+  Secs = Tm.GetSecs();
+  return T->BegRI().GetIntAttr("Val");
+}
+
+double BenchNode2Vec(TBenchIn& In, double& Secs) {
+  TIntFltVH EmbeddingsHV;
+  TExeTm Tm;
+  node2vec(In.ForestFire, 1.0, 1.0, 32, 20, 5, 5, 1, false, EmbeddingsHV);
+  Secs = Tm.GetSecs();
+  return EmbeddingsHV.Len();
+}
+
+const int Benchs = 13;
+const char* BenchNmV[Benchs] = { "load.edgelist", "load.binary", "load.table", "bfs", "pagerank",
+  "wcc", "scc", "triangles", "kcore", "table.join", "table.group", "table.order", "node2vec" };
+const TBenchFn BenchFnV[Benchs] = { BenchLoadEdgeList, BenchLoadBinary, BenchLoadTable, BenchBfs,
+  BenchPageRank, BenchWcc, BenchScc, BenchTriangles, BenchKCore, BenchTableJoin, BenchTableGroup,
+  BenchTableOrder, BenchNode2Vec };
+
+/////////////////////////////////////////////////
+// Results
+
+// Runs benchmark BenchN Reps times and gets its fastest and median time.
+PJsonVal RunBench(TBenchIn& In, const int& BenchN, const int& Reps) {
+  TFltV SecsV;
+  double Result = 0;
+  ResetPeakRss();
+  for (int r = 0; r < Reps; r++) {
+    double Secs = 0;
+    Result = BenchFnV[BenchN](In, Secs);
+    SecsV.Add(Secs);
+  }
+  const double PeakRssKB = double(GetPeakRssKB());
+  SecsV.Sort();
+  PJsonVal Val = TJsonVal::NewObj();
+  Val->AddToObj("name", BenchNmV[BenchN]);
+  Val->AddToObj("secs", SecsV[0].Val);
+  Val->AddToObj("median_secs", SecsV[SecsV.Len()/2].Val);
+  Val->AddToObj("peak_rss_kb", PeakRssKB);
+  Val->AddToObj("result", Result);
+  return Val;
+}
+
+// Gets the benchmark Name of the baseline, NULL if it is not there.
+PJsonVal GetBaseBench(const PJsonVal& BaseVal, const TStr& Name) {
+  const PJsonVal BenchV = BaseVal->GetObjKey("benchmarks");
+  for (int b = 0; b < BenchV->GetArrVals(); b++) {
+    if (BenchV->GetArrVal(b)->GetObjStr("name") == Name) { return BenchV->GetArrVal(b); }
+  }
+  return NULL;
+}
+
+// Compares a benchmark with its baseline, prints the comparison and returns
+// false for a regression. Times are compared only with a baseline run on the
+// same number of threads, memory and results only on the same input. Entries of the baseline may override the tolerances
+// with "tolerance" and "mem_tolerance".
+bool CheckBench(const PJsonVal& Val, const PJsonVal& BaseVal, const bool& SameInput, const bool& SameThreads,
+ double Tol, double MemTol, const double& Slack) {
+  const TStr Name = Val->GetObjStr("name");
+  const double Secs = Val->GetObjNum("secs"), RssKB = Val->GetObjNum("peak_rss_kb");
+  if (BaseVal.Empty()) {
+    printf("  %-14s %9.3fs  (not in baseline)\n", Name.CStr(), Secs);
+    return true;
+  }
+  Tol = BaseVal->GetObjNum("tolerance", Tol);
+  MemTol = BaseVal->GetObjNum("mem_tolerance", MemTol);
+  const double BaseSecs = BaseVal->GetObjNum("secs"), BaseRssKB = BaseVal->GetObjNum("peak_rss_kb");
+  TStrV ErrV;
+  if (SameThreads && Secs > BaseSecs * (1.0 + Tol) + Slack) {
+    ErrV.Add(TStr::Fmt("slower than %.0f%%", 100.0 * Tol)); }
+  if (SameInput && RssKB > 0 && BaseRssKB > 0 && RssKB > BaseRssKB * (1.0 + MemTol)) {
+    ErrV.Add(TStr::Fmt("memory over %.0f%%", 100.0 * MemTol)); }
+  if (SameInput && Val->GetObjNum("result") != BaseVal->GetObjNum("result")) {
+    ErrV.Add("result changed"); }
+  TChA ErrChA;
+  for (int e = 0; e < ErrV.Len(); e++) { ErrChA += e == 0 ? "" : ", ";  ErrChA += ErrV[e]; }
+  printf("  %-14s %9.3fs  base %9.3fs %6.2fx  rss %8.1fMB  base %8.1fMB  %s\n", Name.CStr(),
+    Secs, BaseSecs, Secs / TMath::Mx(BaseSecs, 1e-6), RssKB / 1024.0, BaseRssKB / 1024.0,
+    ErrV.Empty() ? "ok" : ErrChA.CStr());
+  return ErrV.Empty();
+}
+
+// Saves the results with one benchmark per line, so that baselines diff well.
+void SaveJson(const TStr& FNm, const PJsonVal& ConfVal, const TJsonValV& BenchV) {
+  TFOut FOut(FNm);
+  FOut.PutStr("{\n\"config\": " + TJsonVal::GetStrFromVal(ConfVal) + ",\n\"benchmarks\": [\n");
+  for (int b = 0; b < BenchV.Len(); b++) {
+    FOut.PutStr(TJsonVal::GetStrFromVal(BenchV[b]));
+    FOut.PutStr(b+1 < BenchV.Len() ? ",\n" : "\n");
+  }
+  FOut.PutStr("]\n}\n");
+}
+
+int main(int argc, char* argv[]) {
+  Env = TEnv(argc, argv, TNotify::StdNotify);
+  Env.PrepArgs(TStr::Fmt("SNAP benchmarks. build: %s, %s. Time: %s", __TIME__, __DATE__, TExeTm::GetCurTm()));
+  TExeTm ExeTm;
+  int Failed = 0;
+  Try
+  const int Scale = Env.GetIfArgPrefixInt("-s:", 1, "Input size scale");
+  const int Seed = Env.GetIfArgPrefixInt("-seed:", 1, "Random seed of the inputs");
+  const int Reps = Env.GetIfArgPrefixInt("-t:", 3, "Repetitions of each benchmark (the fastest is reported)");
+  const TStr RunStr = Env.GetIfArgPrefixStr("-r:", "", "Comma separated benchmarks to run (empty: all)");
+  const TStr WorkDir = Env.GetIfArgPrefixStr("-w:", ".", "Directory of the generated input files");
+  const TStr OutFNm = Env.GetIfArgPrefixStr("-o:", "snapbench.json", "Output JSON file");
+  const TStr BaseFNm = Env.GetIfArgPrefixStr("-b:", "", "Baseline JSON file (empty: no comparison)");
+  const double Tol = Env.GetIfArgPrefixFlt("-tol:", 0.25, "Allowed relative slowdown");
+  const double MemTol = Env.GetIfArgPrefixFlt("-mtol:", 0.25, "Allowed relative growth of peak memory");
+  const double Slack = Env.GetIfArgPrefixFlt("-slack:", 0.02, "Allowed absolute slowdown in seconds");
+  TStrV RunV;
+  RunStr.SplitOnAllCh(',', RunV);
+  for (int r = 0; r < RunV.Len(); r++) {
+    bool IsBench = false;
+    for (int b = 0; b < Benchs; b++) { IsBench = IsBench || RunV[r] == BenchNmV[b]; }
+    if (! IsBench) { TExcept::Throw("Unknown benchmark " + RunV[r]); }
+  }
+  PJsonVal BaseVal;
+  if (! BaseFNm.Empty()) {
+    BaseVal = TJsonVal::GetValFromSIn(TFIn::New(BaseFNm));
+    if (! BaseVal->IsObj() || ! BaseVal->IsObjKey("benchmarks")) {
+      TExcept::Throw("Not a benchmark JSON file: " + BaseFNm); }
+  }
+  int Threads = 1;
+#ifdef USE_OPENMP
+  Threads = omp_get_max_threads();
+#endif
+
+  printf("generating inputs (scale %d, seed %d)...\n", Scale, Seed);
+  TExeTm GenTm;
+  TBenchIn In(Scale, Seed, WorkDir);
+  printf("  R-MAT %d nodes %d edges, PA %d nodes %d edges, FF %d nodes %d edges, table %d rows [%s]\n",
+    In.RMat->GetNodes(), In.RMat->GetEdges(), In.PrefAttach->GetNodes(), In.PrefAttach->GetEdges(),
+    In.ForestFire->GetNodes(), In.ForestFire->GetEdges(), In.EdgeT->GetNumValidRows().Val, GenTm.GetTmStr());
+
+  PJsonVal ConfVal = TJsonVal::NewObj();
+  ConfVal->AddToObj("suite", "snapbench");
+  ConfVal->AddToObj("version", 1);
+  ConfVal->AddToObj("scale", Scale);
+  ConfVal->AddToObj("seed", Seed);
+  ConfVal->AddToObj("reps", Reps);
+  ConfVal->AddToObj("threads", Threads);
+  ConfVal->AddToObj("time", TSecTm::GetCurTm().GetStr(tmu1Sec));
+  bool SameInput = false, SameThreads = false;
+  if (! BaseVal.Empty() && BaseVal->IsObjKey("config")) {
+    const PJsonVal BaseConfVal = BaseVal->GetObjKey("config");
+    SameInput = BaseConfVal->GetObjNum("scale", -1) == Scale && BaseConfVal->GetObjNum("seed", -1) == Seed;
+    SameThreads = BaseConfVal->GetObjNum("threads", -1) == Threads;
+  }
+  printf("running %d repetitions%s:\n", Reps, BaseVal.Empty() ? "" : TStr::Fmt(", baseline %s", BaseFNm.CStr()).CStr());
+  TJsonValV BenchV;
+  for (int b = 0; b < Benchs; b++) {
+    if (! RunV.Empty() && ! RunV.IsIn(BenchNmV[b])) { continue; }
+    BenchV.Add(RunBench(In, b, Reps));
+    if (BaseVal.Empty()) {
+      printf("  %-14s %9.3fs  median %9.3fs  rss %8.1fMB  result %.0f\n", BenchNmV[b],
+        BenchV.Last()->GetObjNum("secs"), BenchV.Last()->GetObjNum("median_secs"),
+        BenchV.Last()->GetObjNum("peak_rss_kb") / 1024.0, BenchV.Last()->GetObjNum("result"));
+    } else if (! CheckBench(BenchV.Last(), GetBaseBench(BaseVal, BenchNmV[b]), SameInput, SameThreads, Tol, MemTol, Slack)) {
+      Failed++;
+    }
+  }
+  SaveJson(OutFNm, ConfVal, BenchV);
+  printf("results saved to %s\n", OutFNm.CStr());
+  if (! BaseVal.Empty()) {
+    printf("%d of %d benchmarks regressed\n", Failed, BenchV.Len());
+    if (! SameInput) { printf("baseline has a different scale or seed, memory and results were not compared\n"); }
+    if (! SameThreads) { printf("baseline ran on a different number of threads, times were not compared\n"); }
+  }
+  Catch
+  printf("\nrun time: %s (%s)\n", ExeTm.GetTmStr(), TSecTm::GetCurTm().GetTmStr().CStr());
+  return Failed > 0 ? 1 : 0;
+}
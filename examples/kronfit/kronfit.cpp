@@ -21,6 +21,7 @@ int main(int argc, char* argv[]) {
   //const TInt GradType = Env.GetIfArgPrefixInt("-gt:", 1, "1:Grad1, 2:Grad2");
   const bool ScaleInitMtx = Env.GetIfArgPrefixBool("-sim:", true, "Scale the initiator to match the number of edges");
   const TFlt PermSwapNodeProb = Env.GetIfArgPrefixFlt("-nsp:", 1.0, "Probability of using NodeSwap (vs. EdgeSwap) MCMC proposal distribution");
+  const TInt Chains = Env.GetIfArgPrefixInt("-c:", 1, "Parallel MCMC permutation chains (samples are split among the chains)");
   if (OutFNm.Empty()) { OutFNm = TStr::Fmt("%s-fit%d", InFNm.GetFMid().CStr(), NZero()); }
   // load graph
   PNGraph G;
@@ -40,6 +41,7 @@ int main(int argc, char* argv[]) {
   KronLL.InitLL(G, InitKronMtx);
   InitKronMtx.Dump("SCALED PARAM", true);
   KronLL.SetPerm(Perm.GetCh(0));
+  KronLL.SetChains(Chains);
   double LogLike = 0;
   //if (GradType == 1) {
   LogLike = KronLL.GradDescent(GradIter, LrnRate, MnStep, MxStep, WarmUp, NSamples);
@@ -1,6 +1,9 @@
 #include "stdafx.h"
 #include "subgraphenum.h"
 #include "graphcounter.h"
+#ifdef USE_OPENMP
+#include <omp.h>
+#endif
 
 int main(int argc, char* argv[]) {
   Env = TEnv(argc, argv, TNotify::StdNotify);
@@ -12,8 +15,19 @@ int main(int argc, char* argv[]) {
   const int MotifSz = Env.GetIfArgPrefixInt("-m:", 3, "Motif size (has to be 3 or 4)");
   const bool DrawMotifs = Env.GetIfArgPrefixBool("-d:", true, "Draw motif shapes (requires GraphViz)");
   TStr OutFNm = Env.GetIfArgPrefixStr("-o:", "", "Output file prefix");
+  const TStr ProbStr = Env.GetIfArgPrefixStr("-p:", "", "Rand-ESU sampling, comma separated probabilities of visiting depth 1...MotifSz (empty: exact counts)");
+  const int NumThreads = Env.GetIfArgPrefixInt("-nt:", 4, "Number of threads for parallelization");
   if (OutFNm.Empty()) { OutFNm = InFNm.GetFMid(); }
   EAssert(MotifSz==3 || MotifSz==4);
+  TFltV ProbV;
+  if (! ProbStr.Empty()) {
+    TStrV ProbStrV;  ProbStr.SplitOnAllCh(',', ProbStrV);
+    EAssertR(ProbStrV.Len()==MotifSz, "Give one sampling probability per motif node");
+    for (int i = 0; i < ProbStrV.Len(); i++) { ProbV.Add(ProbStrV[i].GetFlt()); }
+  }
+#ifdef USE_OPENMP
+  omp_set_num_threads(NumThreads);
+#endif
 
   // load graph
   PNGraph G;
@@ -36,7 +50,9 @@ int main(int argc, char* argv[]) {
   // count frequency of connected subgraphs in G that have MotifSz nodes
   TD34GraphCounter GraphCounter(MotifSz);
   TSubGraphEnum<TD34GraphCounter> GraphEnum;
-  GraphEnum.GetSubGraphs(G, MotifSz, GraphCounter);
+  GraphEnum.GetSubGraphsMP(G, MotifSz, GraphCounter, ProbV);
+  // with sampling the counts are estimates
+  const double SampleProb = TSubGraphEnum<TD34GraphCounter>::GetSampleProb(ProbV);
   FILE *F = fopen(TStr::Fmt("%s-counts.tab", OutFNm.CStr()).CStr(), "wt");
   fprintf(F, "MotifId\tNodes\tEdges\tCount\n");
   for (int i = 0; i < GraphCounter.Len(); i++) {
@@ -44,9 +60,9 @@ int main(int argc, char* argv[]) {
     PNGraph SG = GraphCounter.GetGraph(gid);
     if (DrawMotifs) {
       TSnap::DrawGViz(SG, gvlNeato, TStr::Fmt("%s-motif%03d.gif", OutFNm.CStr(), i), 
-        TStr::Fmt("GId:%d  Count: %llu", gid, GraphCounter.GetCnt(gid)));
+        TStr::Fmt("GId:%d  Count: %.0f", gid, GraphCounter.GetCnt(gid)/SampleProb));
     }
-    fprintf(F, "%d\t%d\t%d\t%llu\n", gid, SG->GetNodes(), SG->GetEdges(), static_cast<long long unsigned int>(GraphCounter.GetCnt(gid)));
+    fprintf(F, "%d\t%d\t%d\t%.0f\n", gid, SG->GetNodes(), SG->GetEdges(), GraphCounter.GetCnt(gid)/SampleProb);
   }
   printf("done.");
   fclose(F); 
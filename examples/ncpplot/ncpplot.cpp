@@ -1,5 +1,8 @@
 #include "stdafx.h"
 #include "ncp.h"
+#ifdef USE_OPENMP
+#include <omp.h>
+#endif
 
 int main(int argc, char* argv[]) {
   Env = TEnv(argc, argv, TNotify::StdNotify);
@@ -18,6 +21,10 @@ int main(int argc, char* argv[]) {
   const int KMax = Env.GetIfArgPrefixInt("-kmax:", Mega(100), "maximum K (volume)");
   const int Coverage = Env.GetIfArgPrefixInt("-c:", 10, "coverage (so that every node is covered C times)");
   TLocClust::Verbose = Env.GetIfArgPrefixBool("-v:", true, "Verbose (plot intermediate output)");
+  const int NumThreads = Env.GetIfArgPrefixInt("-nt:", 4, "Number of threads for parallelization");
+#ifdef USE_OPENMP
+  omp_set_num_threads(NumThreads);
+#endif
   if (OutFNm.Empty()) { OutFNm = InFNm.GetFMid(); }
   if (Desc.Empty()) { Desc = OutFNm; }
   PUNGraph Graph = TSnap::GetMxWcc(TSnap::LoadEdgeList<PUNGraph>(InFNm,0,1));
@@ -21,6 +21,8 @@ int main(int argc, char* argv[]) {
 			  "Output file in which to write counts");
   const TFlt delta =
     Env.GetIfArgPrefixFlt("-delta:", 4096, "Time window delta");
+  const TFlt window =
+    Env.GetIfArgPrefixFlt("-w:", 0, "Sliding window width (0: whole graph)");
   const int num_threads =
     Env.GetIfArgPrefixInt("-nt:", 4, "Number of threads for parallelization");
 
@@ -29,9 +31,27 @@ int main(int argc, char* argv[]) {
 #endif
 
   // Count all 2-node and 3-node temporal motifs with 3 temporal edges
-  TempMotifCounter tmc(temporal_graph_filename);
   Counter2D counts;
-  tmc.Count3TEdge23Node(delta, counts);
+  if (window > 0) {
+    // Stream the edges in time order and report the counts of the last window
+    TVec<TTriple<TInt, TInt, TInt> > edges;
+    TSsParser Ss(temporal_graph_filename, ssfWhiteSep);
+    while (Ss.Next()) {
+      int src, dst, tim;
+      if (Ss.GetInt(0, src) && Ss.GetInt(1, dst) && Ss.GetInt(2, tim)) {
+        edges.Add(TTriple<TInt, TInt, TInt>(tim, src, dst));
+      }
+    }
+    edges.Sort();
+    TempMotifStreamCounter tmsc(window, delta);
+    for (int i = 0; i < edges.Len(); i++) {
+      tmsc.AddEdge(edges[i].Val2, edges[i].Val3, edges[i].Val1);
+    }
+    tmsc.GetCounts(counts);
+  } else {
+    TempMotifCounter tmc(temporal_graph_filename);
+    tmc.Count3TEdge23Node(delta, counts);
+  }
   FILE* output_file = fopen(output.CStr(), "wt");
   for (int i = 0; i < counts.m(); i++) {
     for (int j = 0; j < counts.n(); j++) {
@@ -81,6 +81,7 @@ int gettimeofday(struct timeval * tp, struct timezone * tzp)
 #include "dt.cpp"
 #include "ut.cpp"
 #include "hash.cpp"
+#include "hashmp.cpp"
 
 #include "unicode.cpp"
 #include "unicodestring.cpp"
@@ -72,6 +72,38 @@ public:
   void SaveTxt(TOLx& Lx) const;
 };
 
+/////////////////////////////////////////////////
+// Counter-Based Random
+/// Stateless random generator: value number (Ctr, SubCtr) of stream Seed is a hash of the three.
+/// Any position of the stream can be drawn independently, so parallel code
+/// produces the same numbers regardless of the number of threads.
+class TCtrRnd{
+private:
+  uint64 Seed;
+public:
+  TCtrRnd(const uint64& _Seed=1): Seed(Mix(_Seed)){}
+  TCtrRnd(const TCtrRnd& Rnd): Seed(Rnd.Seed){}
+  TCtrRnd& operator=(const TCtrRnd& Rnd){Seed=Rnd.Seed; return *this;}
+
+  /// Splitmix64 finalizer, a bijective 64-bit mixing function.
+  static uint64 Mix(uint64 X){
+    X+=0x9E3779B97F4A7C15ULL;
+    X=(X^(X>>30))*0xBF58476D1CE4E5B9ULL;
+    X=(X^(X>>27))*0x94D049BB133111EBULL;
+    return X^(X>>31);}
+  uint64 GetUInt64(const uint64& Ctr, const uint64& SubCtr=0) const {
+    return Mix(Mix(Seed^Mix(Ctr))+SubCtr);}
+  /// Returns a uniform deviate in [0, 1).
+  double GetUniDev(const uint64& Ctr, const uint64& SubCtr=0) const {
+    return (GetUInt64(Ctr, SubCtr)>>11)*(1.0/9007199254740992.0);}
+  /// Returns a uniform integer in [0, Range).
+  int GetUniDevInt(const int& Range, const uint64& Ctr, const uint64& SubCtr=0) const {
+    return int(((GetUInt64(Ctr, SubCtr)>>32)*uint64(Range))>>32);}
+  /// Returns a uniform integer in [0, Range).
+  int64 GetUniDevInt64(const int64& Range, const uint64& Ctr, const uint64& SubCtr=0) const {
+    return int64(GetUInt64(Ctr, SubCtr)%uint64(Range));}
+};
+
 /////////////////////////////////////////////////
 // Memory
 ClassTP(TMem, PMem)//{
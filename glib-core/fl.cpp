@@ -40,6 +40,13 @@ void TSIn::Load(char*& CStr){
   CStr[CStrLen]=TCh::NullCh;
 }
 
+int TSIn::GetNextBf(void* LBf, const int& MxLBfL){
+  int LBfL=0;
+  while ((LBfL<MxLBfL)&&(!Eof())){
+    ((char*)LBf)[LBfL++]=GetCh();}
+  return LBfL;
+}
+
 bool TSIn::GetNextLn(TStr& LnStr){
   TChA LnChA;
   const bool IsNext=GetNextLn(LnChA);
@@ -321,6 +328,17 @@ int TFIn::GetBf(const void* LBf, const TSize& LBfL){
   return LBfS;
 }
 
+int TFIn::GetNextBf(void* LBf, const int& MxLBfL){
+  int LBfL=0;
+  while (LBfL<MxLBfL){
+    if ((BfC==BfL)&&(Eof())){break;}
+    const int CpL=TInt::GetMn(BfL-BfC, MxLBfL-LBfL);
+    memcpy((char*)LBf+LBfL, Bf+BfC, CpL);
+    BfC+=CpL; LBfL+=CpL;
+  }
+  return LBfL;
+}
+
 // Gets the next line to LnChA.
 // Returns true, if LnChA contains a valid line.
 // Returns false, if LnChA is empty, such as end of file was encountered.
@@ -1398,7 +1416,10 @@ uint64 TFile::GetLastWriteTm(const TStr& FNm) {
 #elif defined(GLib_LINUX)
 
 uint64 TFile::GetSize(const TStr& FNm) {
-	Fail; return 0;
+	struct stat st;
+	if (stat(FNm.CStr(), &st) != 0) {
+		TExcept::Throw("Can not read size of file " + FNm + "!"); }
+	return uint64(st.st_size);
 }
 
 uint64 TFile::GetCreateTm(const TStr& FNm) {
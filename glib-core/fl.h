@@ -72,6 +72,7 @@ public:
   virtual char PeekCh()=0;    // get one char and do NOT advance
   virtual int GetBf(const void* Bf, const TSize& BfL)=0; // get BfL chars and advance
   virtual bool GetNextLnBf(TChA& LnChA)=0;  // get the next line and advance
+  virtual int GetNextBf(void* LBf, const int& MxLBfL); // get up to MxLBfL chars and advance, returns their number (0 at eof)
   virtual void Reset(){Fail;}
 
   bool IsFastMode() const {return FastMode;}
@@ -308,6 +309,7 @@ public:
   int GetBf(const void* LBf, const TSize& LBfL);
   void Reset(){rewind(FileId); Cs=TCs(); BfC=BfL=-1; FillBf();}
   bool GetNextLnBf(TChA& LnChA);
+  int GetNextBf(void* LBf, const int& MxLBfL);
 
   //J:not needed
   //TFileId GetFileId() const {return FileId;} //J:
@@ -251,6 +251,8 @@ public:
 
   const TKey& GetKey(const int& KeyId) const { return GetHashKeyDat(KeyId).Key;}
   int GetKeyId(const TKey& Key) const;
+  /// Returns the KeyId of the element iterator I points to.
+  int GetIterKeyId(const TIter& I) const { return int(I.operator->()-KeyDatV.BegI()); }
   /// Get an index of a random element. If the hash table has many deleted keys, this may take a long time.
   int GetRndKeyId(TRnd& Rnd) const;
   /// Get an index of a random element. If the hash table has many deleted keys, defrag the hash table first (that's why the function is non-const).
@@ -0,0 +1,173 @@
+#ifdef GCC_ATOMIC
+
+/////////////////////////////////////////////////
+// Concurrent-String-Hash-Table
+void TStrHashMP::Gen(const int& _ShardBits) {
+  IAssert(0 <= _ShardBits && _ShardBits <= 16);
+  ShardBits = _ShardBits;
+  const int Shards = GetShards();
+  BfVV.Clr();  BfVV.Gen(Shards);
+  OffsetVV.Clr();  OffsetVV.Gen(Shards);
+  HashCdVV.Clr();  HashCdVV.Gen(Shards);
+  TableVV.Clr();  TableVV.Gen(Shards);
+  LockV.Gen(Shards);  LockV.PutAll(0);
+}
+
+void TStrHashMP::Load(TSIn& SIn) {
+  ShardBits.Load(SIn);
+  BfVV.Load(SIn);  OffsetVV.Load(SIn);
+  HashCdVV.Load(SIn);  TableVV.Load(SIn);
+  SIn.LoadCs();
+  LockV.Gen(GetShards());  LockV.PutAll(0);
+}
+
+void TStrHashMP::LoadShM(TShMIn& ShMIn) {
+  TLoadVecInit Fn;
+  ShardBits.Load(ShMIn);
+  BfVV.LoadShM(ShMIn, Fn);  OffsetVV.LoadShM(ShMIn, Fn);
+  HashCdVV.LoadShM(ShMIn, Fn);  TableVV.LoadShM(ShMIn, Fn);
+  ShMIn.LoadCs();
+  LockV.Gen(GetShards());  LockV.PutAll(0);
+}
+
+void TStrHashMP::Save(TSOut& SOut) const {
+  ShardBits.Save(SOut);
+  BfVV.Save(SOut);  OffsetVV.Save(SOut);
+  HashCdVV.Save(SOut);  TableVV.Save(SOut);
+  SOut.SaveCs();
+}
+
+int64 TStrHashMP::Len() const {
+  int64 Keys = 0;
+  for (int ShardN = 0; ShardN < GetShards(); ShardN++) {
+    Keys += GetShardLen(ShardN); }
+  return Keys;
+}
+
+int64 TStrHashMP::GetMxKeyIds() const {
+  int MxLen = 0;
+  for (int ShardN = 0; ShardN < GetShards(); ShardN++) {
+    MxLen = TMath::Mx(MxLen, GetShardLen(ShardN)); }
+  return int64(MxLen) << ShardBits;
+}
+
+::TSize TStrHashMP::GetMemUsed() const {
+  ::TSize MemUsed = sizeof(TStrHashMP) + LockV.GetMemUsed();
+  for (int ShardN = 0; ShardN < GetShards(); ShardN++) {
+    MemUsed += ::TSize(BfVV[ShardN].Reserved()) + OffsetVV[ShardN].GetMemUsed() +
+      HashCdVV[ShardN].GetMemUsed() + TableVV[ShardN].GetMemUsed(); }
+  return MemUsed;
+}
+
+// Returns the local id of Key in shard ShardN or -1, SlotN is the table slot of the key or the free slot where it goes.
+int TStrHashMP::GetLocalId(const int& ShardN, const char* Key, const int& KeyLen, const int& HashCd, int& SlotN) const {
+  const TIntV& TableV = TableVV[ShardN];
+  SlotN = -1;
+  if (TableV.Empty()) { return -1; }
+  const TIntV& HashCdV = HashCdVV[ShardN];
+  const TUInt64V& OffsetV = OffsetVV[ShardN];
+  const char* Bf = (const char*) BfVV[ShardN].BegI();
+  const int Mask = TableV.Len() - 1;
+  SlotN = (HashCd >> ShardBits) & Mask;
+  while (TableV[SlotN] != -1) {
+    const int LocalId = TableV[SlotN];
+    if (HashCdV[LocalId] == HashCd) {
+      const char* CStr = Bf + OffsetV[LocalId].Val;
+      if (strncmp(CStr, Key, KeyLen) == 0 && CStr[KeyLen] == 0) { return LocalId; }
+    }
+    SlotN = (SlotN + 1) & Mask;
+  }
+  return -1;
+}
+
+// Doubles the table of shard ShardN, keys are reinserted from the stored hash codes.
+void TStrHashMP::ResizeTable(const int& ShardN) {
+  TIntV& TableV = TableVV[ShardN];
+  const TIntV& HashCdV = HashCdVV[ShardN];
+  const int TableLen = TableV.Empty() ? 16 : 2*TableV.Len();
+  const int Mask = TableLen - 1;
+  TableV.Gen(TableLen);  TableV.PutAll(-1);
+  for (int LocalId = 0; LocalId < HashCdV.Len(); LocalId++) {
+    int SlotN = (HashCdV[LocalId] >> ShardBits) & Mask;
+    while (TableV[SlotN] != -1) { SlotN = (SlotN + 1) & Mask; }
+    TableV[SlotN] = LocalId;
+  }
+}
+
+// Adds a key to shard ShardN, the caller must own the shard.
+int TStrHashMP::AddLocal(const int& ShardN, const char* Key, const int& KeyLen, const int& HashCd) {
+  int SlotN;
+  int LocalId = GetLocalId(ShardN, Key, KeyLen, HashCd, SlotN);
+  if (LocalId != -1) { return LocalId; }
+  TUInt64V& OffsetV = OffsetVV[ShardN];
+  if (2*(OffsetV.Len()+1) > TableVV[ShardN].Len()) {
+    ResizeTable(ShardN);
+    GetLocalId(ShardN, Key, KeyLen, HashCd, SlotN);
+  }
+  TVec<TCh, int64>& BfV = BfVV[ShardN];
+  const int64 Offset = BfV.Len();
+  const int64 BfLen = Offset + KeyLen + 1;
+  if (BfV.Reserved() < BfLen) { BfV.Reserve(TMath::Mx<int64>(2*BfV.Reserved(), BfLen)); }
+  BfV.Reserve(BfV.Reserved(), BfLen);
+  char* CStr = (char*) (BfV.BegI() + Offset);
+  memcpy(CStr, Key, KeyLen);  CStr[KeyLen] = 0;
+  LocalId = OffsetV.Add(TUInt64(Offset));
+  HashCdVV[ShardN].Add(HashCd);
+  TableVV[ShardN][SlotN] = LocalId;
+  return LocalId;
+}
+
+int64 TStrHashMP::AddKey(const char* Key, const int& KeyLen) {
+  const int HashCd = TStrHashF_DJB::GetPrimHashCd(Key, KeyLen);
+  const int ShardN = GetShardN(HashCd);
+  LockShard(ShardN);
+  const int LocalId = AddLocal(ShardN, Key, KeyLen, HashCd);
+  UnlockShard(ShardN);
+  return (int64(LocalId) << ShardBits) + ShardN;
+}
+
+int64 TStrHashMP::GetKeyId(const char* Key, const int& KeyLen) const {
+  const int HashCd = TStrHashF_DJB::GetPrimHashCd(Key, KeyLen);
+  const int ShardN = GetShardN(HashCd);
+  int SlotN;
+  LockShard(ShardN);
+  const int LocalId = GetLocalId(ShardN, Key, KeyLen, HashCd, SlotN);
+  UnlockShard(ShardN);
+  return LocalId == -1 ? -1 : (int64(LocalId) << ShardBits) + ShardN;
+}
+
+// Keys are hashed in parallel and bucketed by shard, each shard is then filled
+// by a single thread that takes the shard lock once. Ids follow the order of KeyV within each shard.
+void TStrHashMP::AddKeyV(const TStrV& KeyV, TVec<TInt64>& KeyIdV) {
+  const int Keys = KeyV.Len();
+  const int Shards = GetShards();
+  TIntV HashCdV(Keys);
+  KeyIdV.Gen(Keys);
+  #pragma omp parallel for schedule(static)
+  for (int KeyN = 0; KeyN < Keys; KeyN++) {
+    HashCdV[KeyN] = TStrHashF_DJB::GetPrimHashCd(KeyV[KeyN].CStr(), KeyV[KeyN].Len());
+  }
+  // counting sort of key positions by shard
+  TIntV ShardOffV(Shards+1);  ShardOffV.PutAll(0);
+  for (int KeyN = 0; KeyN < Keys; KeyN++) { ShardOffV[GetShardN(HashCdV[KeyN])+1] += 1; }
+  for (int ShardN = 0; ShardN < Shards; ShardN++) { ShardOffV[ShardN+1] += ShardOffV[ShardN]; }
+  TIntV KeyNV(Keys);
+  TIntV PosV(ShardOffV);
+  for (int KeyN = 0; KeyN < Keys; KeyN++) {
+    const int ShardN = GetShardN(HashCdV[KeyN]);
+    KeyNV[PosV[ShardN]] = KeyN;  PosV[ShardN] += 1;
+  }
+  #pragma omp parallel for schedule(dynamic, 1)
+  for (int ShardN = 0; ShardN < Shards; ShardN++) {
+    if (ShardOffV[ShardN] == ShardOffV[ShardN+1]) { continue; }
+    LockShard(ShardN);
+    for (int i = ShardOffV[ShardN]; i < ShardOffV[ShardN+1]; i++) {
+      const int KeyN = KeyNV[i];
+      const int LocalId = AddLocal(ShardN, KeyV[KeyN].CStr(), KeyV[KeyN].Len(), HashCdV[KeyN]);
+      KeyIdV[KeyN] = (int64(LocalId) << ShardBits) + ShardN;
+    }
+    UnlockShard(ShardN);
+  }
+}
+
+#endif // GCC_ATOMIC
@@ -566,6 +566,75 @@ int THashMP<TKey, TDat, THashFunc>::GetRndKeyId(TRnd& Rnd, const double& EmptyFr
   return 0;
 }
 
+/////////////////////////////////////////////////
+// Concurrent-String-Hash-Table
+/// Sharded string interner that can be filled from many threads. ##TStrHashMP
+class TStrHashMP {
+private:
+  class TLoadVecInit {
+  public:
+    TLoadVecInit() {}
+    template<typename TElem>
+    void operator() (TElem* Node, TShMIn& ShMIn) { Node->LoadShM(ShMIn); }
+  };
+private:
+  TInt ShardBits;
+  TVec<TVec<TCh, int64> > BfVV;  ///< Null-terminated strings of each shard.
+  TVec<TUInt64V> OffsetVV;       ///< Offset in the shard buffer of each local id.
+  TVec<TIntV> HashCdVV;          ///< Hash code of each local id.
+  TVec<TIntV> TableVV;           ///< Open addressing table of local ids, -1 is empty.
+  mutable TIntV LockV;           ///< One spin lock per shard.
+private:
+  int GetLocalId(const int& ShardN, const char* Key, const int& KeyLen, const int& HashCd, int& SlotN) const;
+  int AddLocal(const int& ShardN, const char* Key, const int& KeyLen, const int& HashCd);
+  void ResizeTable(const int& ShardN);
+  void LockShard(const int& ShardN) const {
+    while (__sync_lock_test_and_set(&LockV[ShardN].Val, 1)) { } }
+  void UnlockShard(const int& ShardN) const { __sync_lock_release(&LockV[ShardN].Val); }
+public:
+  /// Creates an interner with 2^ShardBits shards.
+  TStrHashMP(const int& _ShardBits=6) { Gen(_ShardBits); }
+  TStrHashMP(TSIn& SIn) { Load(SIn); }
+  /// Removes all keys and sets the number of shards to 2^ShardBits.
+  void Gen(const int& _ShardBits);
+  void Clr() { Gen(ShardBits); }
+  void Load(TSIn& SIn);
+  /// Loads the interner from shared memory without rehashing, the object is read only.
+  void LoadShM(TShMIn& ShMIn);
+  void Save(TSOut& SOut) const;
+
+  /// Returns the number of shards.
+  int GetShards() const { return 1 << ShardBits; }
+  /// Returns the shard of a key id or of a key hash code.
+  int GetShardN(const int64& KeyId) const { return int(KeyId & (GetShards()-1)); }
+  /// Returns the number of keys in shard ShardN.
+  int GetShardLen(const int& ShardN) const { return OffsetVV[ShardN].Len(); }
+  /// Returns the number of keys.
+  int64 Len() const;
+  bool Empty() const { return Len() == 0; }
+  /// Returns an upper bound on key ids, ids are in [0, GetMxKeyIds()).
+  int64 GetMxKeyIds() const;
+
+  /// Adds a key and returns its id, ids never change once assigned. Thread safe.
+  int64 AddKey(const char* Key, const int& KeyLen);
+  int64 AddKey(const char* Key) { return AddKey(Key, (int) strlen(Key)); }
+  int64 AddKey(const TStr& Key) { return AddKey(Key.CStr(), Key.Len()); }
+  /// Adds all keys in KeyV in parallel, KeyIdV[i] is the id of KeyV[i].
+  void AddKeyV(const TStrV& KeyV, TVec<TInt64>& KeyIdV);
+  /// Returns the id of a key or -1 if the key is not present. Thread safe.
+  int64 GetKeyId(const char* Key, const int& KeyLen) const;
+  int64 GetKeyId(const char* Key) const { return GetKeyId(Key, (int) strlen(Key)); }
+  int64 GetKeyId(const TStr& Key) const { return GetKeyId(Key.CStr(), Key.Len()); }
+  bool IsKey(const TStr& Key) const { return GetKeyId(Key) != -1; }
+  bool IsKeyId(const int64& KeyId) const {
+    return KeyId >= 0 && (KeyId >> ShardBits) < GetShardLen(GetShardN(KeyId)); }
+  /// Returns the key with id KeyId. Not synchronized with concurrent AddKey() calls.
+  const char* GetKey(const int64& KeyId) const {
+    const int ShardN = GetShardN(KeyId);
+    return (const char*) (BfVV[ShardN].BegI() + OffsetVV[ShardN][int(KeyId >> ShardBits)].Val); }
+  ::TSize GetMemUsed() const;
+};
+
 #endif // GCC_ATOMIC
 
 #endif // hashmp_h
@@ -1,3 +1,7 @@
+#ifdef USE_CBLAS
+#include <cblas.h>
+#endif
+
 ///////////////////////////////////////////////////////////////////////
 // Sparse-Column-Matrix
 void TSparseColMatrix::PMultiply(const TFltVV& B, int ColId, TFltV& Result) const {
@@ -425,68 +429,210 @@ void TLinAlg::MultiplyScalar(const double& k, const TIntFltKdV& x, TIntFltKdV& y
         y[i].Dat = k * x[i].Dat;
 }
 
+///////////////////////////////////////////////////////////////////////
+// Dense GEMM kernel
+// Packs rows Row0...Row0+Rows-1 and columns K0...K0+Kc-1 of op(A) into strips
+// of GemmMR rows, stored column by column and padded with zeros.
+void TLinAlg::GemmPackA(const bool& TransA, const double* A, const int& LdA,
+        const int& Row0, const int& Rows, const int& K0, const int& Kc, double* Ap) {
+    for (int r0 = 0; r0 < Rows; r0 += GemmMR) {
+        const int Rs = TInt::GetMn(GemmMR, Rows - r0);
+        for (int p = 0; p < Kc; p++) {
+            for (int r = 0; r < GemmMR; r++, Ap++) {
+                if (r >= Rs) { *Ap = 0.0; }
+                else if (TransA) { *Ap = A[int64(K0+p)*LdA + Row0+r0+r]; }
+                else { *Ap = A[int64(Row0+r0+r)*LdA + K0+p]; }
+            }
+        }
+    }
+}
+
+// Packs rows K0...K0+Kc-1 and columns Col0...Col0+Cols-1 of op(B), Cols <= GemmNR,
+// into a strip stored row by row and padded with zeros.
+void TLinAlg::GemmPackB(const bool& TransB, const double* B, const int& LdB,
+        const int& K0, const int& Kc, const int& Col0, const int& Cols, double* Bp) {
+    for (int p = 0; p < Kc; p++) {
+        for (int c = 0; c < GemmNR; c++, Bp++) {
+            if (c >= Cols) { *Bp = 0.0; }
+            else if (TransB) { *Bp = B[int64(Col0+c)*LdB + K0+p]; }
+            else { *Bp = B[int64(K0+p)*LdB + Col0+c]; }
+        }
+    }
+}
+
+// Acc := Ap * Bp for a GemmMR x Kc strip of A and a Kc x GemmNR strip of B.
+// The accumulator block stays in registers; the inner loop is vectorized by the compiler.
+void TLinAlg::GemmMicroKernel(const int& Kc, const double* Ap, const double* Bp, double* Acc) {
+    double C[GemmMR][GemmNR];
+    for (int r = 0; r < GemmMR; r++) {
+        for (int c = 0; c < GemmNR; c++) { C[r][c] = 0.0; }
+    }
+    for (int p = 0; p < Kc; p++, Ap += GemmMR, Bp += GemmNR) {
+        for (int r = 0; r < GemmMR; r++) {
+            const double a = Ap[r];
+            for (int c = 0; c < GemmNR; c++) { C[r][c] += a * Bp[c]; }
+        }
+    }
+    for (int r = 0; r < GemmMR; r++) {
+        for (int c = 0; c < GemmNR; c++) { Acc[r*GemmNR+c] = C[r][c]; }
+    }
+}
+
+void TLinAlg::GemmRowMajor(const bool& TransA, const bool& TransB,
+        const int& M, const int& N, const int& K, const double& Alpha,
+        const double* A, const int& LdA, const double* B, const int& LdB,
+        const double& Beta, double* C, const int& LdC) {
+    if (M <= 0 || N <= 0) { return; }
+#ifdef USE_CBLAS
+    if (K > 0) {
+        cblas_dgemm(CblasRowMajor, TransA ? CblasTrans : CblasNoTrans,
+            TransB ? CblasTrans : CblasNoTrans, M, N, K, Alpha, A, LdA, B, LdB, Beta, C, LdC);
+        return;
+    }
+#endif
+    const double Flops = double(M) * N * TInt::GetMx(K, 1);
+    // C := Beta * C
+    #pragma omp parallel for schedule(static) if(Flops > 1e6)
+    for (int i = 0; i < M; i++) {
+        double* CRow = C + int64(i)*LdC;
+        if (Beta == 0.0) { for (int j = 0; j < N; j++) { CRow[j] = 0.0; } }
+        else if (Beta != 1.0) { for (int j = 0; j < N; j++) { CRow[j] *= Beta; } }
+    }
+    if (K <= 0 || Alpha == 0.0) { return; }
+    if (Flops <= 32768.0) {
+        // small products are not worth packing
+        for (int i = 0; i < M; i++) {
+            double* CRow = C + int64(i)*LdC;
+            for (int p = 0; p < K; p++) {
+                const double a = Alpha * (TransA ? A[int64(p)*LdA + i] : A[int64(i)*LdA + p]);
+                if (a == 0.0) { continue; }
+                for (int j = 0; j < N; j++) {
+                    CRow[j] += a * (TransB ? B[int64(j)*LdB + p] : B[int64(p)*LdB + j]);
+                }
+            }
+        }
+        return;
+    }
+    // panels of op(B) are packed once and shared; threads work on tiles of
+    // GemmMC rows times TileStrips column strips, each packing its own block of op(A)
+    const int TileStrips = 8;
+    const int MBlocks = (M + GemmMC - 1) / GemmMC;
+    double* Bp = new double[int64(GemmKC) * (GemmNC + GemmNR)];
+    for (int jc = 0; jc < N; jc += GemmNC) {
+        const int Nc = TInt::GetMn(GemmNC, N - jc);
+        const int NStrips = (Nc + GemmNR - 1) / GemmNR;
+        const int NGroups = (NStrips + TileStrips - 1) / TileStrips;
+        for (int pc = 0; pc < K; pc += GemmKC) {
+            const int Kc = TInt::GetMn(GemmKC, K - pc);
+            #pragma omp parallel for schedule(static)
+            for (int s = 0; s < NStrips; s++) {
+                GemmPackB(TransB, B, LdB, pc, Kc, jc + s*GemmNR,
+                    TInt::GetMn(GemmNR, Nc - s*GemmNR), Bp + int64(s)*Kc*GemmNR);
+            }
+            #pragma omp parallel
+            {
+                double* Ap = new double[GemmMC * GemmKC];
+                double Acc[GemmMR * GemmNR];
+                #pragma omp for schedule(dynamic)
+                for (int t = 0; t < MBlocks * NGroups; t++) {
+                    const int ic = (t / NGroups) * GemmMC;
+                    const int Mc = TInt::GetMn(GemmMC, M - ic);
+                    const int s0 = (t % NGroups) * TileStrips;
+                    const int s1 = TInt::GetMn(s0 + TileStrips, NStrips);
+                    GemmPackA(TransA, A, LdA, ic, Mc, pc, Kc, Ap);
+                    for (int s = s0; s < s1; s++) {
+                        const int c0 = s * GemmNR;
+                        const int Cs = TInt::GetMn(GemmNR, Nc - c0);
+                        for (int r0 = 0; r0 < Mc; r0 += GemmMR) {
+                            const int Rs = TInt::GetMn(GemmMR, Mc - r0);
+                            GemmMicroKernel(Kc, Ap + int64(r0)*Kc, Bp + int64(s)*Kc*GemmNR, Acc);
+                            for (int r = 0; r < Rs; r++) {
+                                double* CRow = C + int64(ic+r0+r)*LdC + jc + c0;
+                                for (int c = 0; c < Cs; c++) { CRow[c] += Alpha * Acc[r*GemmNR+c]; }
+                            }
+                        }
+                    }
+                }
+                delete [] Ap;
+            }
+        }
+    }
+    delete [] Bp;
+}
+
+// matrix-vector products run over rows of A in parallel once A is large enough
 void TLinAlg::Multiply(const TFltVV& A, const TFltV& x, TFltV& y) {
     Assert(A.GetCols() == x.Len() && A.GetRows() == y.Len());
     int n = A.GetRows(), m = A.GetCols();
+    #pragma omp parallel for schedule(static) if(double(n)*m > 1e5)
     for (int i = 0; i < n; i++) {
-        y[i] = 0.0;
+        const TFlt* Row = &A(i,0);
+        double sum = 0.0;
         for (int j = 0; j < m; j++)
-            y[i] += A(i,j) * x[j];
+            sum += Row[j] * x[j];
+        y[i] = sum;
     }
 }
 
 void TLinAlg::Multiply(const TFltVV& A, const TFltV& x, TFltVV& C, int ColId) {
     Assert(A.GetCols() == x.Len() && A.GetRows() == C.GetRows());
     int n = A.GetRows(), m = A.GetCols();
+    #pragma omp parallel for schedule(static) if(double(n)*m > 1e5)
     for (int i = 0; i < n; i++) {
-        C(i,ColId) = 0.0;
+        const TFlt* Row = &A(i,0);
+        double sum = 0.0;
         for (int j = 0; j < m; j++)
-            C(i,ColId) += A(i,j) * x[j];
+            sum += Row[j] * x[j];
+        C(i,ColId) = sum;
     }
 }
 
 void TLinAlg::Multiply(const TFltVV& A, const TFltVV& B, int ColId, TFltV& y) {
     Assert(A.GetCols() == B.GetRows() && A.GetRows() == y.Len());
-    int n = A.GetRows(), m = A.GetCols();
-    for (int i = 0; i < n; i++) {
-        y[i] = 0.0;
-        for (int j = 0; j < m; j++)
-            y[i] += A(i,j) * B(j,ColId);
-    }
+    int m = A.GetCols();
+    TFltV x(m);
+    for (int j = 0; j < m; j++)
+        x[j] = B(j,ColId);
+    Multiply(A, x, y);
 }
 
 void TLinAlg::Multiply(const TFltVV& A, const TFltVV& B, int ColIdB, TFltVV& C, int ColIdC){
     Assert(A.GetCols() == B.GetRows() && A.GetRows() == C.GetRows());
-    int n = A.GetRows(), m = A.GetCols();
-    for (int i = 0; i < n; i++) {
-        C(i,ColIdC) = 0.0;
-        for (int j = 0; j < m; j++)
-            C(i,ColIdC) += A(i,j) * B(j,ColIdB);
-    }
+    int m = A.GetCols();
+    TFltV x(m);
+    for (int j = 0; j < m; j++)
+        x[j] = B(j,ColIdB);
+    Multiply(A, x, C, ColIdC);
 }
 
 void TLinAlg::MultiplyT(const TFltVV& A, const TFltV& x, TFltV& y) {
     Assert(A.GetRows() == x.Len() && A.GetCols() == y.Len());
     int n = A.GetCols(), m = A.GetRows();
-    for (int i = 0; i < n; i++) {
+    for (int i = 0; i < n; i++)
         y[i] = 0.0;
-        for (int j = 0; j < m; j++)
-            y[i] += A(j,i) * x[j];
+    // y += x[j] * A(j,:), with per-thread partial sums
+    #pragma omp parallel if(double(n)*m > 1e5)
+    {
+        TFltV PartV(n);
+        #pragma omp for schedule(static)
+        for (int j = 0; j < m; j++) {
+            const TFlt* Row = &A(j,0);
+            const double xj = x[j];
+            for (int i = 0; i < n; i++)
+                PartV[i] += Row[i] * xj;
+        }
+        #pragma omp critical
+        {
+            for (int i = 0; i < n; i++)
+                y[i] += PartV[i];
+        }
     }
 }
 
 void TLinAlg::Multiply(const TFltVV& A, const TFltVV& B, TFltVV& C) {
     Assert(A.GetRows() == C.GetRows() && B.GetCols() == C.GetCols() && A.GetCols() == B.GetRows());
-
     int n = C.GetRows(), m = C.GetCols(), l = A.GetCols();
-    for (int i = 0; i < n; i++) {
-        for (int j = 0; j < m; j++) {
-            double sum = 0.0;
-            for (int k = 0; k < l; k++)
-                sum += A(i,k)*B(k,j);
-            C(i,j) = sum;
-        }
-    }
+    GemmRowMajor(false, false, n, m, l, 1.0, GetDataPt(A), l, GetDataPt(B), m, 0.0, GetDataPt(C), m);
 }
 
 // general matrix multiplication (GEMM)
@@ -497,50 +643,43 @@ void TLinAlg::Gemm(const double& Alpha, const TFltVV& A, const TFltVV& B, const
 	bool tB = (TransposeFlags & GEMM_B_T) == GEMM_B_T;
 	bool tC = (TransposeFlags & GEMM_C_T) == GEMM_C_T;
 
-	// setting dimensions
-	int a_i = tA ? A.GetRows() : A.GetCols();
-	int a_j = tA ? A.GetCols() : A.GetRows();
-
-	int b_i = tB ? A.GetRows() : A.GetCols();
-	int b_j = tB ? A.GetCols() : A.GetRows();
-
-	int c_i = tC ? A.GetRows() : A.GetCols();
-	int c_j = tC ? A.GetCols() : A.GetRows();
-
-	int d_i = D.GetCols();
-	int d_j = D.GetRows();
-	
-	// assertions for dimensions
-  bool Cnd = a_i == c_j && b_i == c_i && a_i == b_j && c_i == d_i && c_j == d_j;
-  if (!Cnd) {
-	  Assert(Cnd);
-  }
-
-	double Aij, Bij, Cij;
-
-	// rows
-	for (int j = 0; j < a_j; j++) {
-		// cols
-		for (int i = 0; i < a_i; i++) {
-			// not optimized for speed (!)
-			double sum = 0;
-			for (int k = 0; k < a_i; k++) {
-				Aij = tA ? A.At(j, k) : A.At(k, j);
-				Bij = tB ? B.At(k, i) : B.At(i, k);
-				sum += Alpha * Aij * Bij;
-			}
-			Cij = tC ? C.At(i, j) : C.At(j, i);
-			sum += Beta * Cij;
-			D.At(i, j) = sum;
+	// setting dimensions: op(A) is Rows x Inner, op(B) is Inner x Cols
+	const int Rows = tA ? A.GetCols() : A.GetRows();
+	const int Inner = tA ? A.GetRows() : A.GetCols();
+	const int Cols = tB ? B.GetRows() : B.GetCols();
+	IAssert(Inner == (tB ? B.GetCols() : B.GetRows()));
+	IAssert(&A != &D && &B != &D);
+	if (D.GetRows() != Rows || D.GetCols() != Cols) { D.Gen(Rows, Cols); }
+
+	// D := op(C)
+	if (Beta != 0.0) {
+		IAssert(Rows == (tC ? C.GetCols() : C.GetRows()) && Cols == (tC ? C.GetRows() : C.GetCols()));
+		if (tC && &C == &D) {
+			TFltVV CT(Rows, Cols);
+			Transpose(C, CT);
+			D = CT;
+		} else if (tC) {
+			Transpose(C, D);
+		} else if (&C != &D) {
+			D = C;
 		}
 	}
+	GemmRowMajor(tA, tB, Rows, Cols, Inner, Alpha, GetDataPt(A), A.GetCols(),
+		GetDataPt(B), B.GetCols(), Beta, GetDataPt(D), Cols);
 }
 
 void TLinAlg::Transpose(const TFltVV& A, TFltVV& B) {
 	Assert(B.GetRows() == A.GetCols() && B.GetCols() == A.GetRows());
-	for (int i = 0; i < A.GetCols(); i++) {
-		for (int j = 0; j < A.GetRows(); j++) {
-			B.At(i, j) = A.At(j, i);
+	// 32 x 32 tiles keep both the reads and the writes in cache
+	const int Rows = A.GetRows(), Cols = A.GetCols();
+	#pragma omp parallel for schedule(static) if(double(Rows)*Cols > 1e6)
+	for (int i0 = 0; i0 < Cols; i0 += 32) {
+		for (int j0 = 0; j0 < Rows; j0 += 32) {
+			for (int i = i0; i < TInt::GetMn(i0+32, Cols); i++) {
+				for (int j = j0; j < TInt::GetMn(j0+32, Rows); j++) {
+					B.At(i, j) = A.At(j, i);
+				}
+			}
 		}
 	}
 }
@@ -595,12 +734,42 @@ void TLinAlg::GS(TVec<TFltV>& Q) {
     printf("\n");
 }
 
+// Classical Gram-Schmidt applied twice (as accurate as the modified variant),
+// which lets both steps sweep the rows of Q contiguously and in parallel.
 void TLinAlg::GS(TFltVV& Q) {
     int m = Q.GetCols(), n = Q.GetRows();
+    TFltV r(m);
     for (int i = 0; i < m; i++) {
-        for (int j = 0; j < i; j++) {
-            double r = TLinAlg::DotProduct(Q, i, Q, j);
-            TLinAlg::AddVec(-r,Q,j,Q,i);
+        const bool Par = double(n)*i > 1e5;
+        for (int Pass = 0; Pass < 2 && i > 0; Pass++) {
+            // r = Q(:,0:i-1)' * Q(:,i)
+            for (int j = 0; j < i; j++)
+                r[j] = 0.0;
+            #pragma omp parallel if(Par)
+            {
+                TFltV PartV(i);
+                #pragma omp for schedule(static)
+                for (int k = 0; k < n; k++) {
+                    const TFlt* Row = &Q(k,0);
+                    const double qk = Row[i];
+                    for (int j = 0; j < i; j++)
+                        PartV[j] += Row[j] * qk;
+                }
+                #pragma omp critical
+                {
+                    for (int j = 0; j < i; j++)
+                        r[j] += PartV[j];
+                }
+            }
+            // Q(:,i) -= Q(:,0:i-1) * r
+            #pragma omp parallel for schedule(static) if(Par)
+            for (int k = 0; k < n; k++) {
+                TFlt* Row = &Q(k,0);
+                double sum = 0.0;
+                for (int j = 0; j < i; j++)
+                    sum += Row[j] * r[j];
+                Row[i] -= sum;
+            }
         }
         double nr = TLinAlg::Norm(Q,i);
         for (int k = 0; k < n; k++)
@@ -1200,6 +1369,7 @@ void TSparseSVD::Lanczos(const TMatrix& Matrix, int NumEig,
             ConvgQV[i].Reserve(N,N); CountConvgV[i]++;
             TFltV& vec = ConvgQV[i];
             //vec = Q * V(:,i)
+            #pragma omp parallel for schedule(static) if(double(N)*K > 1e5)
             for (int k = 0; k < N; k++) {
               vec[k] = 0.0;
               for (int l = 0; l < K; l++) {
@@ -1356,6 +1526,7 @@ void TSparseSVD::Lanczos2(const TMatrix& Matrix, int MaxNumEig,
                     ConvgQV[i].Reserve(N,N); CountConvgV[i]++;
                     TFltV& vec = ConvgQV[i];
                     //vec = Q * V(:,i)
+                    #pragma omp parallel for schedule(static) if(double(N)*K > 1e5)
                     for (int k = 0; k < N; k++) {
                         vec[k] = 0.0;
                         for (int l = 0; l < K; l++)
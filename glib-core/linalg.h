@@ -154,7 +154,26 @@ public:
 //////////////////////////////////////////////////////////////////////
 // Basic Linear Algebra Operations
 class TLinAlg {
+private:
+    // register block of the GEMM micro-kernel and cache blocks of the packed panels
+    enum { GemmMR = 4, GemmNR = 8, GemmMC = 128, GemmKC = 256, GemmNC = 2048 };
+    static void GemmPackA(const bool& TransA, const double* A, const int& LdA,
+        const int& Row0, const int& Rows, const int& K0, const int& Kc, double* Ap);
+    static void GemmPackB(const bool& TransB, const double* B, const int& LdB,
+        const int& K0, const int& Kc, const int& Col0, const int& Cols, double* Bp);
+    static void GemmMicroKernel(const int& Kc, const double* Ap, const double* Bp, double* Acc);
+    static const double* GetDataPt(const TFltVV& X) { return X.Empty() ? NULL : &X(0,0).Val; }
+    static double* GetDataPt(TFltVV& X) { return X.Empty() ? NULL : &X(0,0).Val; }
 public:
+    // C := Alpha * op(A) * op(B) + Beta * C on row-major arrays with leading
+    // dimensions LdA, LdB and LdC, where op(A) is M x K and op(B) is K x N.
+    // Uses CBLAS when built with USE_CBLAS, otherwise a cache-blocked,
+    // multi-threaded kernel.
+    static void GemmRowMajor(const bool& TransA, const bool& TransB,
+        const int& M, const int& N, const int& K, const double& Alpha,
+        const double* A, const int& LdA, const double* B, const int& LdB,
+        const double& Beta, double* C, const int& LdC);
+
     // <x,y>
     static double DotProduct(const TFltV& x, const TFltV& y);
     // <X(:,ColIdX), Y(:,ColIdY)>
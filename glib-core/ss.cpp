@@ -348,11 +348,44 @@ TStr TSs::GetSsFmtNmVStr(){
 
 //#//////////////////////////////////////////////
 // Fast-Spread-Sheet-Parser
+
+// TSsParser indexes line ends and separators of each block with SIMD byte
+// compares, 32 bytes at a time with AVX2, 16 with SSE2 and one byte at a time
+// otherwise
+#if defined(__AVX2__)
+  #include <immintrin.h>
+  #define SS_SIMD_WIDTH 32
+  typedef __m256i TSsSimdV;
+  static inline TSsSimdV SsSimdSet(const char& Ch) { return _mm256_set1_epi8(Ch); }
+  static inline uint SsSimdEq(const char* Bf, const TSsSimdV& ChV) {
+    return (uint) _mm256_movemask_epi8(_mm256_cmpeq_epi8(_mm256_loadu_si256((const __m256i*) Bf), ChV)); }
+#elif defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+  #include <emmintrin.h>
+  #define SS_SIMD_WIDTH 16
+  typedef __m128i TSsSimdV;
+  static inline TSsSimdV SsSimdSet(const char& Ch) { return _mm_set1_epi8(Ch); }
+  static inline uint SsSimdEq(const char* Bf, const TSsSimdV& ChV) {
+    return (uint) _mm_movemask_epi8(_mm_cmpeq_epi8(_mm_loadu_si128((const __m128i*) Bf), ChV)); }
+#else
+  #define SS_SIMD_WIDTH 0
+#endif
+
+#if SS_SIMD_WIDTH > 0
+// index of the lowest set bit of a non-zero mask
+static inline int SsGetLowBit(const uint& Mask) {
+  #ifdef _MSC_VER
+  unsigned long Bit;  _BitScanForward(&Bit, Mask);  return int(Bit);
+  #else
+  return __builtin_ctz(Mask);
+  #endif
+}
+#endif
+
 TSsParser::TSsParser(const TStr& FNm, const TSsFmt _SsFmt, const bool& _SkipLeadBlanks, const bool& _SkipCmt, const bool& _SkipEmptyFld) : SsFmt(_SsFmt), 
- SkipLeadBlanks(_SkipLeadBlanks), SkipCmt(_SkipCmt), SkipEmptyFld(_SkipEmptyFld), LineCnt(0), /*Bf(NULL),*/ SplitCh('\t'), LineStr(), FldV(), FInPt(NULL) {
+ SkipLeadBlanks(_SkipLeadBlanks), SkipCmt(_SkipCmt), SkipEmptyFld(_SkipEmptyFld), LineCnt(0), SplitCh('\t'), LineStr(), FldV(), FldLenV(), FInPt(NULL),
+ Bf(NULL), BfC(0), BfL(0), MxBfL(0), PosV(NULL), PosN(0), PosL(0) {
   if (TZipIn::IsZipExt(FNm.GetFExt())) { FInPt = TZipIn::New(FNm); }
   else { FInPt = TFIn::New(FNm); }
-  //Bf = new char [BfLen];
   switch(SsFmt) {
     case ssfTabSep : SplitCh = '\t'; break;
     case ssfCommaSep : SplitCh = ','; break;
@@ -362,17 +395,100 @@ TSsParser::TSsParser(const TStr& FNm, const TSsFmt _SsFmt, const bool& _SkipLead
     case ssfWhiteSep: SplitCh = ' '; break;
     default: FailR("Unknown separator character.");
   }
+  Init();
 }
 
 TSsParser::TSsParser(const TStr& FNm, const char& Separator, const bool& _SkipLeadBlanks, const bool& _SkipCmt, const bool& _SkipEmptyFld) : SsFmt(ssfSpaceSep), 
- SkipLeadBlanks(_SkipLeadBlanks), SkipCmt(_SkipCmt), SkipEmptyFld(_SkipEmptyFld), LineCnt(0), /*Bf(NULL),*/ SplitCh('\t'), LineStr(), FldV(), FInPt(NULL) {
+ SkipLeadBlanks(_SkipLeadBlanks), SkipCmt(_SkipCmt), SkipEmptyFld(_SkipEmptyFld), LineCnt(0), SplitCh('\t'), LineStr(), FldV(), FldLenV(), FInPt(NULL),
+ Bf(NULL), BfC(0), BfL(0), MxBfL(0), PosV(NULL), PosN(0), PosL(0) {
   if (TZipIn::IsZipExt(FNm.GetFExt())) { FInPt = TZipIn::New(FNm); }
   else { FInPt = TFIn::New(FNm); }
   SplitCh = Separator;
+  Init();
 }
 
 TSsParser::~TSsParser() {
-  //if (Bf != NULL) { delete [] Bf; }
+  if (Bf != NULL) { delete [] Bf; }
+  if (PosV != NULL) { delete [] PosV; }
+}
+
+void TSsParser::Init() {
+  MxBfL = 1024*1024;
+  // one more byte for the terminator of a last line without a newline
+  Bf = new char [MxBfL+1];
+  PosV = new int [MxBfL];
+}
+
+// Appends to PosV the positions of line ends and separators in Bf[BfN...BfL).
+void TSsParser::IndexBf(int BfN) {
+  const bool WhiteSep = SsFmt == ssfWhiteSep;
+  #if SS_SIMD_WIDTH > 0
+  const TSsSimdV SepV = SsSimdSet(SplitCh), EolV = SsSimdSet('\n'), TabV = SsSimdSet('\t'), CrV = SsSimdSet('\r');
+  char TailBf[SS_SIMD_WIDTH];
+  for (; BfN < BfL; BfN += SS_SIMD_WIDTH) {
+    const char* Chunk = Bf+BfN;
+    if (BfN + SS_SIMD_WIDTH > BfL) { // the last partial chunk
+      memset(TailBf, 0, SS_SIMD_WIDTH);
+      memcpy(TailBf, Bf+BfN, BfL-BfN);
+      Chunk = TailBf;
+    }
+    uint Mask = SsSimdEq(Chunk, SepV) | SsSimdEq(Chunk, EolV);
+    if (WhiteSep) { Mask |= SsSimdEq(Chunk, TabV) | SsSimdEq(Chunk, CrV); }
+    for (; Mask != 0; Mask &= Mask-1) {
+      PosV[PosL++] = BfN + SsGetLowBit(Mask); }
+  }
+  #else
+  for (; BfN < BfL; BfN++) {
+    const char Ch = Bf[BfN];
+    if (Ch == '\n' || (WhiteSep ? TCh::IsWs(Ch) : Ch == SplitCh)) { PosV[PosL++] = BfN; }
+  }
+  #endif
+}
+
+// Moves the unparsed rest of the block to its start, appends the next part of
+// the file and indexes the block. Returns false at the end of the file.
+bool TSsParser::FillBf() {
+  const int RestL = BfL-BfC;
+  if (RestL == MxBfL) { // a line longer than the block
+    char* NewBf = new char [2*MxBfL+1];
+    memcpy(NewBf, Bf, RestL);
+    delete [] Bf;  Bf = NewBf;
+    delete [] PosV;  PosV = new int [2*MxBfL];
+    MxBfL *= 2;
+  } else if (BfC > 0) {
+    memmove(Bf, Bf+BfC, RestL);
+  }
+  BfC = 0;  BfL = RestL;
+  const int ReadL = FInPt->GetNextBf(Bf+BfL, MxBfL-BfL);
+  BfL += ReadL;
+  PosN = 0;  PosL = 0;
+  IndexBf(0);
+  return ReadL > 0;
+}
+
+// Finds the next line (without the line terminator) and terminates it with 0.
+// PosV[SepN...SepEndN) are the separators within the line. Returns false at the
+// end of the file.
+bool TSsParser::GetNextLn(char*& LnBeg, char*& LnEnd, int& SepN, int& SepEndN) {
+  int EolN = PosN, EolC;
+  while (true) {
+    while (EolN < PosL && Bf[PosV[EolN]] != '\n') { EolN++; }
+    if (EolN < PosL) { EolC = PosV[EolN];  break; }
+    const int ScanL = EolN-PosN;
+    if (! FillBf()) { // the last line has no newline
+      if (BfC >= BfL) { return false; }
+      EolN = PosL;  EolC = BfL;
+      break;
+    }
+    EolN = ScanL;
+  }
+  LnBeg = Bf+BfC;  LnEnd = Bf+EolC;
+  SepN = PosN;  SepEndN = EolN;
+  BfC = TInt::GetMn(EolC+1, BfL);
+  PosN = TInt::GetMn(EolN+1, PosL);
+  if (LnEnd > LnBeg && *(LnEnd-1) == '\r') { LnEnd--; }
+  *LnEnd = 0;
+  return true;
 }
 
 // Gets and parses the next line.
@@ -381,10 +497,13 @@ TSsParser::~TSsParser() {
 
 bool TSsParser::NextSlow() { // split on SplitCh
   FldV.Clr(false);
+  FldLenV.Clr(false);
   LineStr.Clr();
-  FldV.Clr();
   LineCnt++;
-  if (! FInPt->GetNextLn(LineStr)) { return false; }
+  char *LnBeg, *LnEnd;
+  int SepN, SepEndN;
+  if (! GetNextLn(LnBeg, LnEnd, SepN, SepEndN)) { return false; }
+  LineStr.AddBf(LnBeg, int(LnEnd-LnBeg));
   if (SkipCmt && !LineStr.Empty() && LineStr[0]=='#') { return NextSlow(); }
 
   char* cur = LineStr.CStr();
@@ -403,38 +522,39 @@ bool TSsParser::NextSlow() { // split on SplitCh
 
   if (*last != 0) { FldV.Add(last); }  // add last field
   if (SkipEmptyFld && FldV.Empty()) { return NextSlow(); } // skip empty lines
+  for (int f = 0; f < FldV.Len(); f++) { FldLenV.Add((int) strlen(FldV[f])); }
 
   return true; 
 }
 
-// Gets and parses the next line, quick version, works with buffers, not chars.
+// Gets and parses the next line, quick version, splits the line in place at
+// the separators indexed for its block.
 
 bool TSsParser::Next() { // split on SplitCh
-  FldV.Clr(false);
-  LineStr.Clr();
-  FldV.Clr();
-  LineCnt++;
-  if (! FInPt->GetNextLnBf(LineStr)) { return false; }
-  if (SkipCmt && !LineStr.Empty() && LineStr[0]=='#') { return Next(); }
-
-  char* cur = LineStr.CStr();
-  if (SkipLeadBlanks) { // skip leading blanks
-    while (*cur && TCh::IsWs(*cur)) { cur++; }
-  }
-  char *last = cur;
-  while (*cur) {
-    if (SsFmt == ssfWhiteSep) { while (*cur && ! TCh::IsWs(*cur)) { cur++; } } 
-    else { while (*cur && *cur!=SplitCh) { cur++; } }
-    if (*cur == 0) { break; }
-    *cur = 0;  cur++;
-    FldV.Add(last);  last = cur;
-    if (SkipEmptyFld && strlen(FldV.Last())==0) { FldV.DelLast(); } // skip empty fields
+  char *LnBeg, *LnEnd;
+  int SepN, SepEndN;
+  while (true) {
+    FldV.Clr(false);
+    FldLenV.Clr(false);
+    LineCnt++;
+    if (! GetNextLn(LnBeg, LnEnd, SepN, SepEndN)) { return false; }
+    if (SkipCmt && LnBeg < LnEnd && *LnBeg=='#') { continue; }
+    char* Last = LnBeg;
+    if (SkipLeadBlanks) { // skip leading blanks
+      while (Last < LnEnd && TCh::IsWs(*Last)) { Last++; }
+    }
+    for (; SepN < SepEndN; SepN++) {
+      char* Sep = Bf+PosV[SepN];
+      // leading blanks and a carriage return before the newline
+      if (Sep < Last || Sep >= LnEnd) { continue; }
+      *Sep = 0;
+      if (! SkipEmptyFld || Sep > Last) { FldV.Add(Last);  FldLenV.Add(int(Sep-Last)); }
+      Last = Sep+1;
+    }
+    if (Last < LnEnd) { FldV.Add(Last);  FldLenV.Add(int(LnEnd-Last)); } // add last field
+    if (SkipEmptyFld && FldV.Empty()) { continue; } // skip empty lines
+    return true;
   }
-
-  if (*last != 0) { FldV.Add(last); }  // add last field
-  if (SkipEmptyFld && FldV.Empty()) { return Next(); } // skip empty lines
-
-  return true; 
 }
 
 void TSsParser::ToLc() {
@@ -484,24 +604,46 @@ bool TSsParser::GetUInt64(const int& FldN, uint64& Val) const {
 
 bool TSsParser::GetFlt(const int& FldN, double& Val) const {
   // parsing format {ws} [+/-] +{d} ([.]{d}) ([E|e] [+/-] +{d})
+  // values with at most 15 significant digits and a decimal exponent within
+  // +/-22 are exact products (quotients) of two doubles, others go to atof()
+  static const double Pow10[] = { 1e0, 1e1, 1e2, 1e3, 1e4, 1e5, 1e6, 1e7, 1e8, 1e9, 1e10,
+    1e11, 1e12, 1e13, 1e14, 1e15, 1e16, 1e17, 1e18, 1e19, 1e20, 1e21, 1e22 };
   if (FldN >= Len()) { return false; }
   const char *c = GetFld(FldN);
   while (TCh::IsWs(*c)) { c++; }
-  if (*c=='+' || *c=='-') { c++; }
+  bool Minus = false;
+  if (*c=='+' || *c=='-') { Minus = *c=='-';  c++; }
   if (! TCh::IsNum(*c) && *c!='.') { return false; }
-  while (TCh::IsNum(*c)) { c++; }
+  uint64 Mant = 0;
+  int MantDigs = 0, Exp = 0;
+  for (; TCh::IsNum(*c); c++) {
+    if (Mant != 0 || *c != '0') { MantDigs++; }
+    if (MantDigs <= 19) { Mant = 10*Mant + TCh::GetNum(*c); } else { Exp++; }
+  }
   if (*c == '.') {
     c++;
-    while (TCh::IsNum(*c)) { c++; }
+    for (; TCh::IsNum(*c); c++) {
+      if (Mant != 0 || *c != '0') { MantDigs++; }
+      if (MantDigs <= 19) { Mant = 10*Mant + TCh::GetNum(*c);  Exp--; }
+    }
   }
   if (*c=='e' || *c == 'E') {
     c++;
-    if (*c == '+' || *c == '-' ) { c++; }
+    bool ExpMinus = false;
+    if (*c == '+' || *c == '-' ) { ExpMinus = *c=='-';  c++; }
     if (! TCh::IsNum(*c)) { return false; }
-    while (TCh::IsNum(*c)) { c++; }
+    int ExpVal = 0;
+    for (; TCh::IsNum(*c); c++) {
+      if (ExpVal < 100000) { ExpVal = 10*ExpVal + TCh::GetNum(*c); } }
+    Exp += ExpMinus ? -ExpVal : ExpVal;
   }
   if (*c != 0) { return false; }
-  Val = atof(GetFld(FldN));
+  if (MantDigs <= 15 && -22 <= Exp && Exp <= 22) {
+    const double Flt = Exp >= 0 ? double(Mant) * Pow10[Exp] : double(Mant) / Pow10[-Exp];
+    Val = Minus ? -Flt : Flt;
+  } else {
+    Val = atof(GetFld(FldN));
+  }
   return true;
 }
 
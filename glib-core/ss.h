@@ -73,10 +73,23 @@ private:
   bool SkipEmptyFld;    ///< Skip empty fields (i.e., multiple consecutive separators are considered as one).
   uint64 LineCnt;       ///< Number of processed lines so far.
   char SplitCh;         ///< Separator character (if one of the non-started separators is used)
-  TChA LineStr;         ///< Current line.
+  TChA LineStr;         ///< Current line (NextSlow() only).
   TVec<char*> FldV;     ///< Pointers to fields of the current line.
+  TVec<int> FldLenV;    ///< Lengths of fields of the current line.
   PSIn FInPt;           ///< Pointer to the input file stream.
+  char* Bf;             ///< Block of the input file, lines are split in place.
+  int BfC;              ///< Start of the next line in the block.
+  int BfL;              ///< Number of bytes in the block.
+  int MxBfL;            ///< Block size, doubles for lines longer than the block.
+  int* PosV;            ///< Positions of line ends and separators in the block.
+  int PosN;             ///< First position of the next line in PosV.
+  int PosL;             ///< Number of positions in PosV.
   UndefDefaultCopyAssign(TSsParser);
+private:
+  void Init();
+  void IndexBf(int BfN);
+  bool FillBf();
+  bool GetNextLn(char*& LnBeg, char*& LnEnd, int& SepN, int& SepEndN);
 public:
   /// Constructor. ##TSsParser::TSsParser1
   TSsParser(const TStr& FNm, const TSsFmt _SsFmt=ssfTabSep, const bool& _SkipLeadBlanks=false, const bool& _SkipCmt=true, const bool& _SkipEmptyFld=false);
@@ -98,7 +111,7 @@ public:
   /// Checks whether the current line is a comment (starts with '#').
   bool IsCmt() const { return Len()>0 && GetFld(0)[0] == '#'; }
   /// Checks for end of file.
-  bool Eof() const { return FInPt->Eof(); }
+  bool Eof() const { return BfC >= BfL && FInPt->Eof(); }
   /// Returns the current line
   TChA GetLnStr() const { TChA LnOut;  for (int i = 0; i < Len(); i++) { LnOut+=GetFld(i); LnOut+=' '; }  if (LnOut.Len() > 0) LnOut.DelLastCh();  return LnOut; }
   /// Transforms the current line to lower case.
@@ -106,6 +119,8 @@ public:
 
   /// Returns the contents of the field at index \c FldN.
   const char* GetFld(const int& FldN) const { return FldV[FldN]; }
+  /// Returns the length of the field at index \c FldN.
+  int GetFldLen(const int& FldN) const { return FldLenV[FldN]; }
   /// Returns the contents of the field at index \c FldN.
   char* GetFld(const int& FldN) { return FldV[FldN]; }
   /// Returns the contents of the field at index \c FldN.
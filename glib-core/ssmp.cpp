@@ -187,3 +187,12 @@ double TSsParserMP::GetFltFromFldV(TVec<char*>& FieldsV, const int& FldN) {
   if (*c != 0) { return -1; }
   return atof(FieldsV[FldN]);
 }
+
+int TSsParserMP::GetStrLenFromFldV(TVec<char*>& FieldsV, const int& FldN) {
+  const char *c = FieldsV[FldN];
+  if (SsFmt == ssfWhiteSep) { while (*c && ! TCh::IsWs(*c)) { c++; } }
+  else { while (*c && *c != SplitCh && *c != '\n') { c++; } }
+  // drop the carriage return of a CRLF line end
+  if (c > FieldsV[FldN] && *(c-1) == '\r' && (*c == '\n' || *c == 0)) { c--; }
+  return int(c - FieldsV[FldN]);
+}
@@ -93,5 +93,8 @@ public:
   /// Gets float at field \c FldN
   double GetFltFromFldV(TVec<char*>& FieldsV, const int& FldN);
 
+  /// Gets the length of the string at field \c FldN, fields are not null-terminated
+  int GetStrLenFromFldV(TVec<char*>& FieldsV, const int& FldN);
+
   const char* DumpStr() const;
 };
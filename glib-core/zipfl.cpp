@@ -1,3 +1,489 @@
+#ifdef USE_ZLIB
+#include <zlib.h>
+#endif
+#ifdef USE_ZSTD
+#include <zstd.h>
+#endif
+#ifdef USE_LZ4
+#include <lz4frame.h>
+#endif
+#ifdef GLib_UNIX
+#include <pthread.h>
+#endif
+
+/////////////////////////////////////////////////
+// ZIP Decoder
+// Streaming decompressor of a compressed file. Subclasses implement Decode()
+// for one format, GetNextBf() hands out blocks of the uncompressed data, which
+// a helper thread decodes into two alternating buffers ahead of the reader.
+// Decode() runs on the helper thread, so it reports errors through ErrMsg
+// instead of throwing and does not touch TStr.
+class TZipDecoder {
+public:
+  static const int MxBfL;
+  static const int MxInBfL;
+protected:
+  FILE* FIn;
+  char* InBf;
+  int InBfC, InBfL;
+  const char* ErrMsg;
+private:
+  char* BfV[2];
+  int BfLV[2];
+  bool FullV[2];
+  int BfN; // buffer handed to the reader, -1 before the first one
+  bool EndP, StopP;
+  #ifdef GLib_UNIX
+  pthread_t Thread;
+  pthread_mutex_t Mutex;
+  pthread_cond_t Cond;
+  bool ThreadP;
+  static void* DecodeThread(void* Decoder);
+  #endif
+private:
+  int FillBf(char* Bf);
+  void DecodeLoop();
+  int WaitBf(const int& BfId);
+protected:
+  bool ReadIn();
+  /// Decompresses up to MxBfL bytes to Bf, returns their number, 0 at the end of the stream and -1 on an error.
+  virtual int Decode(char* Bf, const int& MxBfL) = 0;
+public:
+  TZipDecoder(const TStr& FNm);
+  virtual ~TZipDecoder();
+  /// Starts decompressing on the helper thread (synchronous decoding without one).
+  void Start();
+  /// Returns the next block of uncompressed data in Bf and its length, 0 at the end of the stream.
+  int GetNextBf(char*& Bf);
+  /// Checks whether the next GetNextBf() returns the end of the stream.
+  bool Eof();
+  /// Length of the uncompressed data, decompresses the whole file.
+  uint64 GetFLen();
+
+  static bool IsExt(const TStr& FNmExt);
+  /// Returns a decoder for FNm (not started), NULL when no codec handles its extension.
+  static TZipDecoder* New(const TStr& FNm);
+};
+
+const int TZipDecoder::MxBfL=1024*1024;
+const int TZipDecoder::MxInBfL=256*1024;
+
+TZipDecoder::TZipDecoder(const TStr& FNm) : FIn(NULL), InBf(NULL), InBfC(0), InBfL(0), ErrMsg(NULL), BfN(-1), EndP(false), StopP(false) {
+  FIn = fopen(FNm.CStr(), "rb");
+  EAssertR(FIn != NULL, TStr::Fmt("Can not open file '%s'.", FNm.CStr()));
+  InBf = new char [MxInBfL];
+  for (int b = 0; b < 2; b++) {
+    BfV[b] = new char [MxBfL];  BfLV[b] = 0;  FullV[b] = false; }
+  #ifdef GLib_UNIX
+  ThreadP = false;
+  pthread_mutex_init(&Mutex, NULL);
+  pthread_cond_init(&Cond, NULL);
+  #endif
+}
+
+TZipDecoder::~TZipDecoder() {
+  #ifdef GLib_UNIX
+  if (ThreadP) {
+    pthread_mutex_lock(&Mutex);
+    StopP = true;
+    pthread_cond_broadcast(&Cond);
+    pthread_mutex_unlock(&Mutex);
+    pthread_join(Thread, NULL);
+  }
+  pthread_cond_destroy(&Cond);
+  pthread_mutex_destroy(&Mutex);
+  #endif
+  for (int b = 0; b < 2; b++) { delete [] BfV[b]; }
+  delete [] InBf;
+  if (FIn != NULL) { fclose(FIn); }
+}
+
+bool TZipDecoder::ReadIn() {
+  InBfC = 0;
+  InBfL = (int) fread(InBf, 1, MxInBfL, FIn);
+  return InBfL > 0;
+}
+
+// fills Bf to MxBfL bytes unless the stream ends, returns -1 on an error
+int TZipDecoder::FillBf(char* Bf) {
+  int BfL = 0;
+  while (BfL < MxBfL) {
+    const int DecL = Decode(Bf+BfL, MxBfL-BfL);
+    if (DecL < 0) { return -1; }
+    if (DecL == 0) { break; }
+    BfL += DecL;
+  }
+  return BfL;
+}
+
+#ifdef GLib_UNIX
+void* TZipDecoder::DecodeThread(void* Decoder) {
+  ((TZipDecoder*) Decoder)->DecodeLoop();
+  return NULL;
+}
+#endif
+
+void TZipDecoder::DecodeLoop() {
+  #ifdef GLib_UNIX
+  for (int b = 0; ; b = 1-b) {
+    pthread_mutex_lock(&Mutex);
+    while (FullV[b] && ! StopP) { pthread_cond_wait(&Cond, &Mutex); }
+    const bool Stop = StopP;
+    pthread_mutex_unlock(&Mutex);
+    if (Stop) { return; }
+    const int BfL = FillBf(BfV[b]);
+    pthread_mutex_lock(&Mutex);
+    BfLV[b] = BfL;  FullV[b] = true;
+    pthread_cond_broadcast(&Cond);
+    pthread_mutex_unlock(&Mutex);
+    if (BfL <= 0) { return; } // end of stream or an error
+  }
+  #endif
+}
+
+void TZipDecoder::Start() {
+  #ifdef GLib_UNIX
+  ThreadP = pthread_create(&Thread, NULL, DecodeThread, this) == 0;
+  #endif
+}
+
+// waits until the helper thread fills buffer BfId and returns its length
+int TZipDecoder::WaitBf(const int& BfId) {
+  int BfL;
+  #ifdef GLib_UNIX
+  if (ThreadP) {
+    pthread_mutex_lock(&Mutex);
+    while (! FullV[BfId]) { pthread_cond_wait(&Cond, &Mutex); }
+    BfL = BfLV[BfId];
+    pthread_mutex_unlock(&Mutex);
+  } else
+  #endif
+  {
+    if (! FullV[BfId]) {
+      BfLV[BfId] = FillBf(BfV[BfId]);  FullV[BfId] = true; }
+    BfL = BfLV[BfId];
+  }
+  EAssertR(BfL >= 0, TStr::Fmt("Error decompressing file: %s", ErrMsg != NULL ? ErrMsg : "corrupt data"));
+  return BfL;
+}
+
+int TZipDecoder::GetNextBf(char*& Bf) {
+  if (EndP) { return 0; }
+  if (BfN != -1) { // give the buffer being read back to the helper thread
+    #ifdef GLib_UNIX
+    pthread_mutex_lock(&Mutex);
+    FullV[BfN] = false;
+    pthread_cond_broadcast(&Cond);
+    pthread_mutex_unlock(&Mutex);
+    #else
+    FullV[BfN] = false;
+    #endif
+  }
+  BfN = (BfN+1) % 2;
+  const int BfL = WaitBf(BfN);
+  Bf = BfV[BfN];
+  EndP = BfL == 0;
+  return BfL;
+}
+
+bool TZipDecoder::Eof() {
+  return EndP || WaitBf((BfN+1) % 2) == 0;
+}
+
+uint64 TZipDecoder::GetFLen() {
+  IAssert(BfN == -1);
+  uint64 FLen = 0;
+  int BfL;
+  while ((BfL = FillBf(BfV[0])) > 0) { FLen += BfL; }
+  EAssertR(BfL == 0, TStr::Fmt("Error decompressing file: %s", ErrMsg != NULL ? ErrMsg : "corrupt data"));
+  return FLen;
+}
+
+#ifdef USE_ZLIB
+// gzip (also concatenated members) and zlib streams
+class TZlibDecoder : public TZipDecoder {
+private:
+  z_stream Zs;
+  bool FlushedP, StreamEndP;
+protected:
+  int Decode(char* Bf, const int& MxBfL);
+public:
+  TZlibDecoder(const TStr& FNm) : TZipDecoder(FNm), FlushedP(true), StreamEndP(false) {
+    memset(&Zs, 0, sizeof(Zs));
+    // 32 detects the gzip or the zlib header
+    EAssertR(inflateInit2(&Zs, 15+32) == Z_OK, "Can not initialize zlib.");
+  }
+  ~TZlibDecoder() { inflateEnd(&Zs); }
+};
+
+int TZlibDecoder::Decode(char* Bf, const int& MxBfL) {
+  Zs.next_out = (Bytef*) Bf;  Zs.avail_out = MxBfL;
+  while (Zs.avail_out > 0) {
+    if (InBfC == InBfL && FlushedP) {
+      if (! ReadIn()) { break; }
+      if (StreamEndP) { // next gzip member
+        inflateReset(&Zs);  StreamEndP = false; }
+    }
+    Zs.next_in = (Bytef*) (InBf+InBfC);  Zs.avail_in = InBfL-InBfC;
+    const int Ret = inflate(&Zs, Z_NO_FLUSH);
+    InBfC = InBfL-Zs.avail_in;
+    if (Ret == Z_STREAM_END) {
+      StreamEndP = true;
+      if (InBfC < InBfL) { inflateReset(&Zs);  StreamEndP = false; }
+    } else if (Ret != Z_OK && Ret != Z_BUF_ERROR) {
+      ErrMsg = Zs.msg != NULL ? Zs.msg : "zlib error";  return -1;
+    }
+    FlushedP = Zs.avail_out > 0;
+  }
+  if (Zs.avail_out > 0 && ! StreamEndP) { ErrMsg = "unexpected end of file";  return -1; }
+  return MxBfL-Zs.avail_out;
+}
+#endif
+
+#ifdef USE_ZSTD
+class TZstdDecoder : public TZipDecoder {
+private:
+  ZSTD_DStream* Ds;
+  bool FlushedP, FrameEndP;
+protected:
+  int Decode(char* Bf, const int& MxBfL);
+public:
+  TZstdDecoder(const TStr& FNm) : TZipDecoder(FNm), Ds(ZSTD_createDStream()), FlushedP(true), FrameEndP(true) {
+    EAssertR(Ds != NULL && ! ZSTD_isError(ZSTD_initDStream(Ds)), "Can not initialize zstd.");
+  }
+  ~TZstdDecoder() { ZSTD_freeDStream(Ds); }
+};
+
+int TZstdDecoder::Decode(char* Bf, const int& MxBfL) {
+  ZSTD_outBuffer Out = { Bf, (size_t) MxBfL, 0 };
+  while (Out.pos < Out.size) {
+    if (InBfC == InBfL && FlushedP) {
+      if (! ReadIn()) { break; }
+    }
+    ZSTD_inBuffer In = { InBf, (size_t) InBfL, (size_t) InBfC };
+    const size_t Ret = ZSTD_decompressStream(Ds, &Out, &In);
+    if (ZSTD_isError(Ret)) { ErrMsg = ZSTD_getErrorName(Ret);  return -1; }
+    InBfC = (int) In.pos;
+    FrameEndP = Ret == 0;
+    FlushedP = Out.pos < Out.size;
+  }
+  if (Out.pos < Out.size && ! FrameEndP) { ErrMsg = "unexpected end of file";  return -1; }
+  return (int) Out.pos;
+}
+#endif
+
+#ifdef USE_LZ4
+// LZ4 frame format (lz4 command line tool), not raw LZ4 blocks
+class TLz4Decoder : public TZipDecoder {
+private:
+  LZ4F_decompressionContext_t Dctx;
+  bool FlushedP, FrameEndP;
+protected:
+  int Decode(char* Bf, const int& MxBfL);
+public:
+  TLz4Decoder(const TStr& FNm) : TZipDecoder(FNm), Dctx(NULL), FlushedP(true), FrameEndP(true) {
+    EAssertR(! LZ4F_isError(LZ4F_createDecompressionContext(&Dctx, LZ4F_VERSION)), "Can not initialize lz4.");
+  }
+  ~TLz4Decoder() { LZ4F_freeDecompressionContext(Dctx); }
+};
+
+int TLz4Decoder::Decode(char* Bf, const int& MxBfL) {
+  int BfL = 0;
+  while (BfL < MxBfL) {
+    if (InBfC == InBfL && FlushedP) {
+      if (! ReadIn()) { break; }
+    }
+    size_t DstL = MxBfL-BfL, SrcL = InBfL-InBfC;
+    const size_t Ret = LZ4F_decompress(Dctx, Bf+BfL, &DstL, InBf+InBfC, &SrcL, NULL);
+    if (LZ4F_isError(Ret)) { ErrMsg = LZ4F_getErrorName(Ret);  return -1; }
+    InBfC += (int) SrcL;  BfL += (int) DstL;
+    FrameEndP = Ret == 0;
+    FlushedP = BfL < MxBfL;
+  }
+  if (BfL < MxBfL && ! FrameEndP) { ErrMsg = "unexpected end of file";  return -1; }
+  return BfL;
+}
+#endif
+
+bool TZipDecoder::IsExt(const TStr& FNmExt) {
+  const TStr Ext = FNmExt.GetLc();
+  #ifdef USE_ZLIB
+  if (Ext == ".gz" || Ext == ".zlib") { return true; }
+  #endif
+  #ifdef USE_ZSTD
+  if (Ext == ".zst") { return true; }
+  #endif
+  #ifdef USE_LZ4
+  if (Ext == ".lz4") { return true; }
+  #endif
+  return false;
+}
+
+TZipDecoder* TZipDecoder::New(const TStr& FNm) {
+  const TStr Ext = FNm.GetFExt().GetLc();
+  #ifdef USE_ZLIB
+  if (Ext == ".gz" || Ext == ".zlib") { return new TZlibDecoder(FNm); }
+  #endif
+  #ifdef USE_ZSTD
+  if (Ext == ".zst") { return new TZstdDecoder(FNm); }
+  #endif
+  #ifdef USE_LZ4
+  if (Ext == ".lz4") { return new TLz4Decoder(FNm); }
+  #endif
+  return NULL;
+}
+
+/////////////////////////////////////////////////
+// ZIP Encoder
+// Streaming compressor writing a compressed file, used by TZipOut.
+class TZipEncoder {
+public:
+  static const int MxOutBfL;
+protected:
+  FILE* FOut;
+  char* OutBf;
+  void WriteOut(const size_t& OutBfL) {
+    EAssertR(fwrite(OutBf, 1, OutBfL, FOut) == OutBfL, "Error writing compressed file."); }
+public:
+  TZipEncoder(const TStr& FNm, const int& _MxOutBfL=MxOutBfL);
+  virtual ~TZipEncoder();
+  /// Compresses BfL bytes from Bf.
+  virtual void Encode(const char* Bf, const int& BfL) = 0;
+  /// Ends the compressed stream, called once before the encoder is deleted.
+  virtual void Finish() = 0;
+  void Flush() { EAssertR(fflush(FOut) == 0, "Can not flush compressed file."); }
+
+  /// Returns an encoder for FNm, NULL when no codec handles its extension.
+  static TZipEncoder* New(const TStr& FNm);
+};
+
+const int TZipEncoder::MxOutBfL=256*1024;
+
+TZipEncoder::TZipEncoder(const TStr& FNm, const int& _MxOutBfL) : FOut(NULL), OutBf(NULL) {
+  FOut = fopen(FNm.CStr(), "wb");
+  EAssertR(FOut != NULL, TStr::Fmt("Can not open file '%s'.", FNm.CStr()));
+  OutBf = new char [_MxOutBfL];
+}
+
+TZipEncoder::~TZipEncoder() {
+  delete [] OutBf;
+  if (FOut != NULL) { fclose(FOut); }
+}
+
+#ifdef USE_ZLIB
+class TZlibEncoder : public TZipEncoder {
+private:
+  z_stream Zs;
+  void Deflate(const int& Flush);
+public:
+  TZlibEncoder(const TStr& FNm, const bool& GzipP) : TZipEncoder(FNm) {
+    memset(&Zs, 0, sizeof(Zs));
+    // 16 writes the gzip instead of the zlib wrapper
+    EAssertR(deflateInit2(&Zs, Z_DEFAULT_COMPRESSION, Z_DEFLATED, GzipP ? 15+16 : 15, 8, Z_DEFAULT_STRATEGY) == Z_OK, "Can not initialize zlib.");
+  }
+  ~TZlibEncoder() { deflateEnd(&Zs); }
+  void Encode(const char* Bf, const int& BfL) {
+    Zs.next_in = (Bytef*) Bf;  Zs.avail_in = BfL;  Deflate(Z_NO_FLUSH); }
+  void Finish() { Zs.next_in = NULL;  Zs.avail_in = 0;  Deflate(Z_FINISH); }
+};
+
+void TZlibEncoder::Deflate(const int& Flush) {
+  int Ret;
+  do {
+    Zs.next_out = (Bytef*) OutBf;  Zs.avail_out = MxOutBfL;
+    Ret = deflate(&Zs, Flush);
+    EAssertR(Ret != Z_STREAM_ERROR, "zlib error.");
+    WriteOut(MxOutBfL-Zs.avail_out);
+  } while (Zs.avail_out == 0 || (Flush == Z_FINISH && Ret != Z_STREAM_END));
+}
+#endif
+
+#ifdef USE_ZSTD
+class TZstdEncoder : public TZipEncoder {
+private:
+  ZSTD_CStream* Cs;
+public:
+  TZstdEncoder(const TStr& FNm) : TZipEncoder(FNm), Cs(ZSTD_createCStream()) {
+    EAssertR(Cs != NULL && ! ZSTD_isError(ZSTD_initCStream(Cs, 3)), "Can not initialize zstd.");
+  }
+  ~TZstdEncoder() { ZSTD_freeCStream(Cs); }
+  void Encode(const char* Bf, const int& BfL);
+  void Finish();
+};
+
+void TZstdEncoder::Encode(const char* Bf, const int& BfL) {
+  ZSTD_inBuffer In = { Bf, (size_t) BfL, 0 };
+  while (In.pos < In.size) {
+    ZSTD_outBuffer Out = { OutBf, (size_t) MxOutBfL, 0 };
+    const size_t Ret = ZSTD_compressStream(Cs, &Out, &In);
+    EAssertR(! ZSTD_isError(Ret), ZSTD_getErrorName(Ret));
+    WriteOut(Out.pos);
+  }
+}
+
+void TZstdEncoder::Finish() {
+  size_t Ret;
+  do {
+    ZSTD_outBuffer Out = { OutBf, (size_t) MxOutBfL, 0 };
+    Ret = ZSTD_endStream(Cs, &Out);
+    EAssertR(! ZSTD_isError(Ret), ZSTD_getErrorName(Ret));
+    WriteOut(Out.pos);
+  } while (Ret > 0);
+}
+#endif
+
+#ifdef USE_LZ4
+class TLz4Encoder : public TZipEncoder {
+private:
+  static const int MxInBfL;
+  LZ4F_compressionContext_t Cctx;
+  size_t MxLz4OutBfL;
+public:
+  TLz4Encoder(const TStr& FNm);
+  ~TLz4Encoder() { LZ4F_freeCompressionContext(Cctx); }
+  void Encode(const char* Bf, const int& BfL);
+  void Finish();
+};
+
+const int TLz4Encoder::MxInBfL=64*1024;
+
+TLz4Encoder::TLz4Encoder(const TStr& FNm) : TZipEncoder(FNm, int(LZ4F_compressBound(MxInBfL, NULL)+LZ4F_HEADER_SIZE_MAX)),
+ Cctx(NULL), MxLz4OutBfL(LZ4F_compressBound(MxInBfL, NULL)+LZ4F_HEADER_SIZE_MAX) {
+  EAssertR(! LZ4F_isError(LZ4F_createCompressionContext(&Cctx, LZ4F_VERSION)), "Can not initialize lz4.");
+  const size_t Ret = LZ4F_compressBegin(Cctx, OutBf, MxLz4OutBfL, NULL);
+  EAssertR(! LZ4F_isError(Ret), LZ4F_getErrorName(Ret));
+  WriteOut(Ret);
+}
+
+void TLz4Encoder::Encode(const char* Bf, const int& BfL) {
+  for (int BfC = 0; BfC < BfL; BfC += MxInBfL) {
+    const size_t Ret = LZ4F_compressUpdate(Cctx, OutBf, MxLz4OutBfL, Bf+BfC, TInt::GetMn(MxInBfL, BfL-BfC), NULL);
+    EAssertR(! LZ4F_isError(Ret), LZ4F_getErrorName(Ret));
+    WriteOut(Ret);
+  }
+}
+
+void TLz4Encoder::Finish() {
+  const size_t Ret = LZ4F_compressEnd(Cctx, OutBf, MxLz4OutBfL, NULL);
+  EAssertR(! LZ4F_isError(Ret), LZ4F_getErrorName(Ret));
+  WriteOut(Ret);
+}
+#endif
+
+TZipEncoder* TZipEncoder::New(const TStr& FNm) {
+  const TStr Ext = FNm.GetFExt().GetLc();
+  #ifdef USE_ZLIB
+  if (Ext == ".gz" || Ext == ".zlib") { return new TZlibEncoder(FNm, Ext == ".gz"); }
+  #endif
+  #ifdef USE_ZSTD
+  if (Ext == ".zst") { return new TZstdEncoder(FNm); }
+  #endif
+  #ifdef USE_LZ4
+  if (Ext == ".lz4") { return new TLz4Encoder(FNm); }
+  #endif
+  return NULL;
+}
+
 /////////////////////////////////////////////////
 // ZIP Input-File
 
@@ -45,7 +531,20 @@ void TZipIn::CreateZipProcess(const TStr& Cmd, const TStr& ZipFNm) {
   #endif
 }
 
+void TZipIn::OpenDecoder(const TStr& FNm) {
+  Decoder = TZipDecoder::New(FNm);
+  Decoder->Start();
+  FLen = TUInt64::Mx;
+}
+
 void TZipIn::FillBf(){
+  if (Decoder != NULL) {
+    EAssertR(BfC==BfL, "Error reading file '"+GetSNm()+"'.");
+    BfL = Decoder->GetNextBf(Bf);
+    EAssertR(BfL > 0, TStr::Fmt("End of file '%s' reached.", GetSNm().CStr()));
+    CurFPos += BfL;  BfC = 0;
+    return;
+  }
   EAssertR(CurFPos < FLen, TStr::Fmt("End of file '%s' reached (CurFPos=%s, FLen=%s).", GetSNm().CStr(), TUInt64(CurFPos).GetStr().CStr(), TUInt64(FLen).GetStr().CStr()));
   EAssertR((BfC==BfL)/*&&((BfL==-1)||(BfL==MxBfL))*/, "Error reading file '"+GetSNm()+"' (Set the TZipIn::SevenZipPath).");
   #ifdef GLib_WIN
@@ -63,7 +562,7 @@ void TZipIn::FillBf(){
 }
 
 TZipIn::TZipIn(const TStr& FNm) : TSBase(FNm.CStr()), TSIn(FNm), ZipStdoutRd(NULL), ZipStdoutWr(NULL),
-  FLen(0), CurFPos(0), Bf(NULL), BfC(0), BfL(0) {
+  Decoder(NULL), FLen(0), CurFPos(0), Bf(NULL), BfC(0), BfL(0) {
   EAssertR(! FNm.Empty(), "Empty file-name.");
   EAssertR(TFile::Exists(FNm), TStr::Fmt("File %s does not exist", FNm.CStr()).CStr());
   FLen = 0;
@@ -73,6 +572,7 @@ TZipIn::TZipIn(const TStr& FNm) : TSBase(FNm.CStr()), TSIn(FNm), ZipStdoutRd(NUL
     printf("*** Error: file %s, compression format %s not supported\n", FNm.CStr(), FNm.GetFExt().CStr());
     EFailR(TStr::Fmt("File %s: compression format %s not supported", FNm.CStr(), FNm.GetFExt().CStr()).CStr());
   }
+  if (IsCodecExt(FNm.GetFExt())) { OpenDecoder(FNm);  return; }
   FLen = TZipIn::GetFLen(FNm);
   // return for malformed files
   if (FLen == 0) { return; } // empty file
@@ -96,10 +596,11 @@ TZipIn::TZipIn(const TStr& FNm) : TSBase(FNm.CStr()), TSIn(FNm), ZipStdoutRd(NUL
 }
 
 TZipIn::TZipIn(const TStr& FNm, bool& OpenedP) : TSBase(FNm.CStr()), TSIn(FNm), ZipStdoutRd(NULL), ZipStdoutWr(NULL),
-  FLen(0), CurFPos(0), Bf(NULL), BfC(0), BfL(0) {
+  Decoder(NULL), FLen(0), CurFPos(0), Bf(NULL), BfC(0), BfL(0) {
   EAssertR(! FNm.Empty(), "Empty file-name.");
-  FLen = TZipIn::GetFLen(FNm);
   OpenedP = TFile::Exists(FNm);
+  if (OpenedP && IsCodecExt(FNm.GetFExt())) { OpenDecoder(FNm);  return; }
+  FLen = TZipIn::GetFLen(FNm);
   if (OpenedP) {
     #ifdef GLib_WIN
     SECURITY_ATTRIBUTES saAttr;
@@ -137,7 +638,23 @@ TZipIn::~TZipIn(){
   if (ZipStdoutRd != NULL) {
     EAssertR(pclose(ZipStdoutRd) != -1, "Closing of the process failed"); }
   #endif
-  if (Bf != NULL) { delete[] Bf; }
+  // the decoder owns the buffers it hands out
+  if (Decoder != NULL) { delete Decoder; }
+  else if (Bf != NULL) { delete[] Bf; }
+}
+
+bool TZipIn::Eof() {
+  if (BfC < BfL) { return false; }
+  if (Decoder == NULL) { return CurFPos==FLen; }
+  // load the next block, so that reading after a false Eof() does not wait
+  if (Decoder->Eof()) { return true; }
+  FillBf();
+  return false;
+}
+
+uint64 TZipIn::GetFLen() const {
+  if (FLen == TUInt64::Mx) { FLen = GetFLen(GetSNm()); }
+  return FLen;
 }
 
 int TZipIn::GetBf(const void* LBf, const TSize& LBfL){
@@ -153,6 +670,20 @@ int TZipIn::GetBf(const void* LBf, const TSize& LBfL){
   return LBfS;
 }
 
+int TZipIn::GetNextBf(void* LBf, const int& MxLBfL) {
+  int LBfL = 0;
+  while (LBfL < MxLBfL) {
+    if (BfC >= BfL) {
+      if (Eof()) { break; }
+      if (BfC >= BfL) { FillBf(); }
+    }
+    const int CpL = TInt::GetMn(BfL-BfC, MxLBfL-LBfL);
+    memcpy((char*) LBf+LBfL, Bf+BfC, CpL);
+    BfC += CpL;  LBfL += CpL;
+  }
+  return LBfL;
+}
+
 // Gets the next line to LnChA.
 // Returns true, if LnChA contains a valid line.
 // Returns false, if LnChA is empty, such as end of file was encountered.
@@ -184,7 +715,7 @@ int TZipIn::FindEol(int& BfN) {
   char Ch;
   if (BfC >= BfL) { // check for eof, read more data
     if (Eof()) { return -1; }
-    FillBf();
+    if (BfC >= BfL) { FillBf(); }
   }
   while (BfC < BfL) {
     Ch = Bf[BfC++];
@@ -198,7 +729,11 @@ int TZipIn::FindEol(int& BfN) {
 
 bool TZipIn::IsZipExt(const TStr& FNmExt) {
   if (FExtToCmdH.Empty()) FillFExtToCmdH();
-  return FExtToCmdH.IsKey(FNmExt);
+  return FExtToCmdH.IsKey(FNmExt) || IsCodecExt(FNmExt);
+}
+
+bool TZipIn::IsCodecExt(const TStr& FNmExt) {
+  return TZipDecoder::IsExt(FNmExt);
 }
 
 void TZipIn::FillFExtToCmdH() {
@@ -228,6 +763,12 @@ TStr TZipIn::GetCmd(const TStr& ZipFNm) {
 }
 
 uint64 TZipIn::GetFLen(const TStr& ZipFNm) {
+  if (IsCodecExt(ZipFNm.GetFExt())) {
+    TZipDecoder* Decoder = TZipDecoder::New(ZipFNm);
+    const uint64 FLen = Decoder->GetFLen();
+    delete Decoder;
+    return FLen;
+  }
   #ifdef GLib_WIN
   HANDLE ZipStdoutRd, ZipStdoutWr;
   // create pipes
@@ -294,6 +835,7 @@ TStrStrH TZipOut::FExtToCmdH;
 const TSize TZipOut::MxBfL=4*1024;
 
 void TZipOut::FlushBf() {
+  if (Encoder != NULL) { Encoder->Encode(Bf, int(BfL));  BfL = 0;  return; }
   #ifdef GLib_WIN
   DWORD BytesOut;
   EAssertR(WriteFile(ZipStdinWr, Bf, DWORD(BfL), &BytesOut, NULL)!=0, "Error writting to the file '"+GetSNm()+"'.");
@@ -329,13 +871,18 @@ void TZipOut::CreateZipProcess(const TStr& Cmd, const TStr& ZipFNm) {
   CloseHandle(piProcInfo.hProcess);
   CloseHandle(piProcInfo.hThread);
   #else
-  ZipStdinWr = popen((TZipIn::SevenZipPath+"/"+CmdLine).CStr(), "r");
+  ZipStdinWr = popen((TZipIn::SevenZipPath+"/"+CmdLine).CStr(), "w");
   EAssertR(ZipStdinWr,  TStr::Fmt("Can not execute '%s' (Set the TZipIn::SevenZipPath)", CmdLine.CStr()).CStr());
   #endif
 }
 
-TZipOut::TZipOut(const TStr& FNm) : TSBase(FNm.CStr()), TSOut(FNm), ZipStdinRd(NULL), ZipStdinWr(NULL), Bf(NULL), BfL(0){
+TZipOut::TZipOut(const TStr& FNm) : TSBase(FNm.CStr()), TSOut(FNm), ZipStdinRd(NULL), ZipStdinWr(NULL), Encoder(NULL), Bf(NULL), BfL(0){
   EAssertR(! FNm.Empty(), "Empty file-name.");
+  if (TZipIn::IsCodecExt(FNm.GetFExt())) {
+    Encoder = TZipEncoder::New(FNm);
+    Bf=new char[MxBfL];  BfL=0;
+    return;
+  }
   #ifdef GLib_WIN
   // create pipes
   SECURITY_ATTRIBUTES saAttr;
@@ -359,6 +906,7 @@ PSOut TZipOut::New(const TStr& FNm){
 
 TZipOut::~TZipOut() {
   if (BfL!=0) { FlushBf(); }
+  if (Encoder != NULL) { Encoder->Finish();  delete Encoder; }
   #ifdef GLib_WIN
   if (ZipStdinWr != NULL) { EAssertR(CloseHandle(ZipStdinWr), "Closing write-end of pipe failed"); }
   if (ZipStdinRd != NULL) { EAssertR(CloseHandle(ZipStdinRd), "Closing read-end of pipe failed"); }
@@ -387,6 +935,7 @@ int TZipOut::PutBf(const void* LBf, const TSize& LBfL){
 
 void TZipOut::Flush(){
   FlushBf();
+  if (Encoder != NULL) { Encoder->Flush();  return; }
   #ifdef GLib_WIN
   EAssertR(FlushFileBuffers(ZipStdinWr)!=0, "Can not flush file '"+GetSNm()+"'.");
   #else
@@ -396,7 +945,7 @@ void TZipOut::Flush(){
 
 bool TZipOut::IsZipExt(const TStr& FNmExt) {
   if (FExtToCmdH.Empty()) FillFExtToCmdH();
-  return FExtToCmdH.IsKey(FNmExt);
+  return FExtToCmdH.IsKey(FNmExt) || TZipIn::IsCodecExt(FNmExt);
 }
 
 void TZipOut::FillFExtToCmdH() {
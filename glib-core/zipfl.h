@@ -1,6 +1,9 @@
 #ifndef zipfl_h
 #define zipfl_h
 
+class TZipDecoder;
+class TZipEncoder;
+
 //#//////////////////////////////////////////////
 /// Compressed File Input Stream. The class reads from a compressed file without explicitly uncompressing it.
 /// This is eachieved by running external 7ZIP program which uncompresses to standard output, which is then piped to TZipFl.
@@ -11,6 +14,10 @@
 /// Use TZipIn::SevenZipPath to set the path to 7z executable.
 ///
 /// NOTE: Current implementation of TZipIn supports only .zip format, other compression formats are not supported.
+///
+/// Formats with an in-process codec are read without 7z: .gz and .zlib when built with USE_ZLIB, .zst with
+/// USE_ZSTD and .lz4 with USE_LZ4 (Makefile.config turns them on when the libraries are installed).
+/// A helper thread decompresses into one of two buffers while the other one is being read.
 // Obsolete note (RS 2014/01/29): You can only load .gz files of uncompressed size <2GB. If you load some other format (like .bz2 or rar) there is no such limitation.
 class TZipIn : public TSIn {
 public:
@@ -23,11 +30,14 @@ private:
   #else 
     FILE* ZipStdoutRd, *ZipStdoutWr;
   #endif
-  uint64 FLen, CurFPos;
+  TZipDecoder* Decoder; // in-process decoder, NULL when 7z is used
+  mutable uint64 FLen; // TUInt64::Mx until the uncompressed length is needed by the in-process decoder
+  uint64 CurFPos;
   char* Bf;
   int BfC, BfL;
 private:
   void FillBf();
+  void OpenDecoder(const TStr& FNm);
   int FindEol(int& BfN);
   void CreateZipProcess(const TStr& Cmd, const TStr& ZipFNm);
   static void FillFExtToCmdH();
@@ -42,23 +52,26 @@ public:
   static PSIn New(const TStr& FNm, bool& OpenedP);
   ~TZipIn();
 
-  bool Eof() { return CurFPos==FLen && BfC==BfL; }
-  int Len() const { return int(FLen-CurFPos+BfL-BfC); }
+  bool Eof();
+  int Len() const { return int(GetFLen()-CurFPos+BfL-BfC); }
   char GetCh() { if (BfC==BfL){FillBf();} return Bf[BfC++]; }
   char PeekCh() { if (BfC==BfL){FillBf();} return Bf[BfC]; }
   int GetBf(const void* LBf, const TSize& LBfL);
   bool GetNextLnBf(TChA& LnChA);
+  int GetNextBf(void* LBf, const int& MxLBfL);
 
-  uint64 GetFLen() const { return FLen; }
+  uint64 GetFLen() const;
   uint64 GetCurFPos() const { return CurFPos; }
 
-  /// Check whether the file extension of FNm is that of a compressed file (.gz, .7z, .rar, .zip, .cab, .arj. bzip2).
+  /// Check whether the file extension of FNm is that of a compressed file (.gz, .7z, .rar, .zip, .cab, .arj. bzip2, .zst, .lz4).
   static bool IsZipFNm(const TStr& FNm) { return IsZipExt(FNm.GetFExt()); }
-  /// Check whether the file extension FNmExt is that of a compressed file (.gz, .7z, .rar, .zip, .cab, .arj. bzip2).
+  /// Check whether the file extension FNmExt is that of a compressed file (.gz, .7z, .rar, .zip, .cab, .arj. bzip2, .zst, .lz4).
   static bool IsZipExt(const TStr& FNmExt);
+  /// Check whether files with extension FNmExt are (de)compressed in-process, without 7z.
+  static bool IsCodecExt(const TStr& FNmExt);
   /// Return a command-line string that is executed in order to decompress a file to standard output. 
   static TStr GetCmd(const TStr& ZipFNm);
-  /// Return the uncompressed size (in bytes) of the compressed file ZipFNm.
+  /// Return the uncompressed size (in bytes) of the compressed file ZipFNm. In-process codecs decompress the whole file.
   static uint64 GetFLen(const TStr& ZipFNm);
   static PSIn NewIfZip(const TStr& FNm) { return IsZipFNm(FNm) ? New(FNm) : TFIn::New(FNm); }
 };
@@ -71,6 +84,7 @@ public:
 /// The class TZIpOut expects that '7z' ('7z.exe') is in the working path.
 /// Note2: For 7z to work properly you need both the 7z executable and the directory 'Codecs'.
 /// Note3: Use TZipIn::SevenZipPath to set the path to 7z executable.
+/// Note4: Formats with an in-process codec (see TZipIn) are compressed without 7z.
 class TZipOut : public TSOut{
 private:
   static const TSize MxBfL;
@@ -80,6 +94,7 @@ private:
   #else 
     FILE *ZipStdinRd, *ZipStdinWr;
   #endif
+  TZipEncoder* Encoder; // in-process encoder, NULL when 7z is used
   char* Bf;
   TSize BfL;
 private:
@@ -7,8 +7,12 @@
 
 void TCoda::Save(TSOut& SOut) {
   G->Save(SOut);
-  F.Save(SOut);
-  H.Save(SOut);
+  // memberships are saved as hash tables
+  TVec<TIntFltH> FH(F.Len()), HH(H.Len());
+  for (int u = 0; u < F.Len(); u++) { F[u].GetH(FH[u]); }
+  for (int u = 0; u < H.Len(); u++) { H[u].GetH(HH[u]); }
+  FH.Save(SOut);
+  HH.Save(SOut);
   NIDV.Save(SOut);
   RegCoef.Save(SOut);
   SumFV.Save(SOut);
@@ -24,8 +28,13 @@ void TCoda::Save(TSOut& SOut) {
 
 void TCoda::Load(TSIn& SIn, const int& RndSeed) {
   G->Load(SIn);
-  F.Load(SIn);
-  H.Load(SIn);
+  TVec<TIntFltH> FH, HH;
+  FH.Load(SIn);
+  HH.Load(SIn);
+  F.Gen(FH.Len());
+  for (int u = 0; u < FH.Len(); u++) { F[u] = TAGMMembV(FH[u]); }
+  H.Gen(HH.Len());
+  for (int u = 0; u < HH.Len(); u++) { H[u] = TAGMMembV(HH[u]); }
   NIDV.Load(SIn);
   RegCoef.Load(SIn);
   SumFV.Load(SIn);
@@ -232,11 +241,9 @@ double TCoda::Likelihood(const bool _DoParallel) {
   TExeTm ExeTm;
   double L = 0.0;
   if (_DoParallel) {
-  #pragma omp parallel for 
+  #pragma omp parallel for schedule(dynamic, 1000) reduction(+:L)
     for (int u = 0; u < F.Len(); u++) {
-      double LU = LikelihoodForNode(true, u);
-      #pragma omp atomic
-        L += LU;
+      L += LikelihoodForNode(true, u);
     }
   }
   else {
@@ -256,16 +263,22 @@ double TCoda::LikelihoodForNode(const bool IsRow, const int UID) {
   }
 }
 
-double TCoda::LikelihoodForNode(const bool IsRow, const int UID, const TIntFltH& FU) {
+/// HOSumV[c] = sum of H_vc (F_vc if ! IsRow) over the nodes v held out for UID
+void TCoda::GetHoldOutSumV(const bool IsRow, const int UID, TFltV& HOSumV) {
+  HOSumV.Gen(NumComs);
+  for (int e = 0; e < HOVIDSV[UID].Len(); e++) {
+    const TAGMMembV& MV = IsRow ? H[HOVIDSV[UID][e]] : F[HOVIDSV[UID][e]];
+    for (int c = 0; c < MV.Len(); c++) {
+      HOSumV[MV.GetKey(c)] += MV[c];
+    }
+  }
+}
+
+double TCoda::LikelihoodForNode(const bool IsRow, const int UID, const TAGMMembV& FU) {
   double L = 0.0;
   TFltV HOSumHV; //adjust for Hv of v hold out
   if (HOVIDSV[UID].Len() > 0) {
-    HOSumHV.Gen(NumComs);
-    for (int e = 0; e < HOVIDSV[UID].Len(); e++) {
-      for (int c = 0; c < SumHV.Len(); c++) {
-        HOSumHV[c] += GetCom(! IsRow, HOVIDSV[UID][e], c);
-      }
-    }
+    GetHoldOutSumV(IsRow, UID, HOSumHV);
   }
   TNGraph::TNodeI NI = G->GetNI(UID);
   const int Deg = IsRow ? NI.GetOutDeg(): NI.GetInDeg();
@@ -279,9 +292,10 @@ double TCoda::LikelihoodForNode(const bool IsRow, const int UID, const TIntFltH&
       L += log (1.0 - Prediction(F[v], FU)) + NegWgt * DotProduct(F[v], FU);
     }
   }
-  for (TIntFltH::TIter HI = FU.BegI(); HI < FU.EndI(); HI++) {
-    double HOSum = HOVIDSV[UID].Len() > 0?  HOSumHV[HI.GetKey()].Val: 0.0;//subtract Hold out pairs only if hold out pairs exist
-    L -= NegWgt * (GetSumVal(! IsRow, HI.GetKey()) - HOSum - GetCom(! IsRow, UID, HI.GetKey())) * HI.GetDat();
+  for (int c = 0; c < FU.Len(); c++) {
+    const int CID = FU.GetKey(c);
+    double HOSum = HOVIDSV[UID].Len() > 0?  HOSumHV[CID].Val: 0.0;//subtract Hold out pairs only if hold out pairs exist
+    L -= NegWgt * (GetSumVal(! IsRow, CID) - HOSum - GetCom(! IsRow, UID, CID)) * FU[c];
   }
   //add regularization
   if (RegCoef > 0.0) { //L1
@@ -379,38 +393,31 @@ void TCoda::GradientForNode(const bool IsRow, const int UID, TIntFltH& GradU, co
 
   TFltV HOSumHV; //adjust for Hv of v hold out
   if (HOVIDSV[UID].Len() > 0) {
-    HOSumHV.Gen(NumComs);
-    for (int e = 0; e < HOVIDSV[UID].Len(); e++) {
-      for (int c = 0; c < SumHV.Len(); c++) {
-        HOSumHV[c] += GetCom(! IsRow, HOVIDSV[UID][e], c);
-      }
-    }
+    GetHoldOutSumV(IsRow, UID, HOSumHV);
   }
     
   TNGraph::TNodeI NI = G->GetNI(UID);
   int Deg = IsRow ? NI.GetOutDeg(): NI.GetInDeg();
-  TFltV PredV(Deg), GradV(CIDSet.Len());
+  TFltV GradV(CIDSet.Len());
   TIntV CIDV(CIDSet.Len());
+  // scatter the neighbors' memberships into the candidate communities (a single pass over the sorted vectors)
   for (int e = 0; e < Deg; e++) {
     int VID = IsRow? NI.GetOutNId(e): NI.GetInNId(e);
     if (VID == UID) { continue; }
     if (HOVIDSV[UID].IsKey(VID)) { continue; }
-    PredV[e] = IsRow? Prediction(UID, VID): Prediction(VID, UID);
+    const double Pred = IsRow? Prediction(UID, VID): Prediction(VID, UID);
+    const double Wgt = Pred / (1.0 - Pred) + NegWgt;
+    const TAGMMembV& MV = IsRow ? H[VID] : F[VID];
+    for (int c = 0; c < MV.Len(); c++) {
+      const int KeyId = CIDSet.GetKeyId(MV.GetKey(c));
+      if (KeyId != -1) { GradV[KeyId] += Wgt * MV[c]; }
+    }
   }
-  
   for (int c = 0; c < CIDSet.Len(); c++) {
     int CID = CIDSet.GetKey(c);
-    double Val = 0.0;
-    for (int e = 0; e < Deg; e++) {
-      int VID = IsRow? NI.GetOutNId(e): NI.GetInNId(e);
-      if (VID == UID) { continue; }
-      if (HOVIDSV[UID].IsKey(VID)) { continue; }
-      Val += PredV[e] * GetCom(! IsRow, VID, CID) / (1.0 - PredV[e]) + NegWgt * GetCom(! IsRow, VID, CID);
-    }
     double HOSum = HOVIDSV[UID].Len() > 0?  HOSumHV[CID].Val: 0.0;//subtract Hold out pairs only if hold out pairs exist
-    Val -= NegWgt * (GetSumVal(! IsRow, CID) - HOSum - GetCom(! IsRow, UID, CID));
+    GradV[c] -= NegWgt * (GetSumVal(! IsRow, CID) - HOSum - GetCom(! IsRow, UID, CID));
     CIDV[c] = CID;
-    GradV[c] = Val;
   }
   //add regularization
   if (RegCoef > 0.0) { //L1
@@ -859,15 +866,16 @@ double TCoda::LikelihoodHoldOut(const bool DoParallel) {
 double TCoda::GetStepSizeByLineSearch(const bool IsRow, const int UID, const TIntFltH& DeltaV, const TIntFltH& GradV, const double& Alpha, const double& Beta, const int MaxIter) {
   double StepSize = 1.0;
   double InitLikelihood = LikelihoodForNode(IsRow, UID);
-  TIntFltH NewVarV(DeltaV.Len());
+  TAGMMembV NewVarV;
+  NewVarV.Reserve(DeltaV.Len());
   for(int iter = 0; iter < MaxIter; iter++) {
     for (int i = 0; i < DeltaV.Len(); i++){
       int CID = DeltaV.GetKey(i);
       double NewVal;
-      NewVal = GetCom(IsRow, UID, CID) + StepSize * DeltaV.GetDat(CID);
+      NewVal = GetCom(IsRow, UID, CID) + StepSize * DeltaV[i];
       if (NewVal < MinVal) { NewVal = MinVal; }
       if (NewVal > MaxVal) { NewVal = MaxVal; }
-      NewVarV.AddDat(CID, NewVal);
+      NewVarV.AddDat(CID) = NewVal;
     }
     if (LikelihoodForNode(IsRow, UID, NewVarV) < InitLikelihood + Alpha * StepSize * DotProduct(GradV, DeltaV)) {
       StepSize *= Beta;
@@ -905,17 +913,16 @@ int TCoda::MLEGradAscent(const double& Thres, const int& MaxIter, const TStr Plo
       for (int e = 0; e < Deg; e++) {
         int VID = IsRow? UI.GetOutNId(e): UI.GetInNId(e);
         if (HOVIDSV[u].IsKey(VID)) { continue; }
-        TIntFltH NbhCIDH = IsRow? H[VID]: F[VID];
-        for (TIntFltH::TIter CI = NbhCIDH.BegI(); CI < NbhCIDH.EndI(); CI++) {
-          CIDSet.AddKey(CI.GetKey());
-          //printf("CI.GetKey:%d\n", CI.GetKey());
-          IAssert(CI.GetKey() <= NumComs);
+        const TAGMMembV& NbhCIDV = IsRow? H[VID]: F[VID];
+        for (int c = 0; c < NbhCIDV.Len(); c++) {
+          CIDSet.AddKey(NbhCIDV.GetKey(c));
+          IAssert(NbhCIDV.GetKey(c) <= NumComs);
         }
       }
-      TIntFltH& CurMem = IsRow? F[u]: H[u];
-      for (TIntFltH::TIter CI = CurMem.BegI(); CI < CurMem.EndI(); CI++) { //remove the community membership which U does not share with its neighbors
-        if (! CIDSet.IsKey(CI.GetKey())) {
-          DelCom(IsRow, u, CI.GetKey());
+      TAGMMembV& CurMem = IsRow? F[u]: H[u];
+      for (int c = CurMem.Len() - 1; c >= 0; c--) { //remove the community membership which U does not share with its neighbors
+        if (! CIDSet.IsKey(CurMem.GetKey(c))) {
+          DelCom(IsRow, u, CurMem.GetKey(c));
         }
       }
       if (CIDSet.Empty()) { continue; }
@@ -972,9 +979,16 @@ int TCoda::MLEGradAscentParallel(const double& Thres, const int& MaxIter, const
   for (int i = 0; i < F.Len(); i++) { NIdxV.Add(i); }
   TIntV NIDOPTV(F.Len()); //check if a node needs optimization or not 1: does not require optimization
   NIDOPTV.PutAll(0);
-  TVec<TIntFltH> NewF(ChunkNum * ChunkSize);
+  TVec<TAGMMembV> NewF(ChunkNum * ChunkSize);
   TIntV NewNIDV(ChunkNum * ChunkSize);
   TBoolV IsRowV(ChunkNum * ChunkSize);
+  // changes of SumFV and SumHV are accumulated per thread and merged after each round
+#ifdef USE_OPENMP
+  const int Threads = omp_get_max_threads();
+#else
+  const int Threads = 1;
+#endif
+  TVec<TFltV> SumFDeltaVV(Threads), SumHDeltaVV(Threads);
   for (iter = 0; iter < MaxIter; iter++) {
     NIdxV.Clr(false);
     for (int i = 0; i < F.Len(); i++) { 
@@ -983,35 +997,49 @@ int TCoda::MLEGradAscentParallel(const double& Thres, const int& MaxIter, const
     }
     IAssert (NIdxV.Len() <= F.Len());
     NIdxV.Shuffle(Rnd);
+    for (int t = 0; t < Threads; t++) {
+      if (SumFDeltaVV[t].Len() != SumFV.Len()) { SumFDeltaVV[t].Gen(SumFV.Len()); }
+      else { SumFDeltaVV[t].PutAll(0.0); }
+      if (SumHDeltaVV[t].Len() != SumHV.Len()) { SumHDeltaVV[t].Gen(SumHV.Len()); }
+      else { SumHDeltaVV[t].PutAll(0.0); }
+    }
     // compute gradient for chunk of nodes
-#pragma omp parallel for schedule(static, 1)
+#pragma omp parallel
+    {
+#ifdef USE_OPENMP
+    const int ThreadN = omp_get_thread_num();
+#else
+    const int ThreadN = 0;
+#endif
+#pragma omp for schedule(static, 1)
     for (int TIdx = 0; TIdx < ChunkNum; TIdx++) {
       TIntFltH GradV;
       for (int ui = TIdx * ChunkSize; ui < (TIdx + 1) * ChunkSize; ui++) {
         const bool IsRow = (ui % 2 == 0);
         NewNIDV[ui] = -1;
-        if (ui > NIdxV.Len()) { continue; }
+        if (ui >= NIdxV.Len()) { continue; }
         const int u = NIdxV[ui]; //
         //find set of candidate c (we only need to consider c to which a neighbor of u belongs to)
         TNGraph::TNodeI UI = G->GetNI(u);
         const int Deg = IsRow? UI.GetOutDeg(): UI.GetInDeg();
         TIntSet CIDSet(5 * Deg);
-        TIntFltH CurFU = IsRow? F[u]: H[u];
+        TAGMMembV& CurFU = NewF[ui];
+        CurFU = IsRow? F[u]: H[u];
         for (int e = 0; e < Deg; e++) {
           int VID = IsRow? UI.GetOutNId(e): UI.GetInNId(e);
           if (HOVIDSV[u].IsKey(VID)) { continue; }
-          TIntFltH& NbhCIDH = IsRow? H[VID]: F[VID];
-          for (TIntFltH::TIter CI = NbhCIDH.BegI(); CI < NbhCIDH.EndI(); CI++) {
-            CIDSet.AddKey(CI.GetKey());
+          const TAGMMembV& NbhCIDV = IsRow? H[VID]: F[VID];
+          for (int c = 0; c < NbhCIDV.Len(); c++) {
+            CIDSet.AddKey(NbhCIDV.GetKey(c));
           }
         }
         if (CIDSet.Empty()) { 
           CurFU.Clr();
         }
         else {
-          for (TIntFltH::TIter CI = CurFU.BegI(); CI < CurFU.EndI(); CI++) { //remove the community membership which U does not share with its neighbors
-            if (! CIDSet.IsKey(CI.GetKey())) {
-              CurFU.DelIfKey(CI.GetKey());
+          for (int c = CurFU.Len() - 1; c >= 0; c--) { //remove the community membership which U does not share with its neighbors
+            if (! CIDSet.IsKey(CurFU.GetKey(c))) {
+              CurFU.Del(c);
             }
           }
           GradientForNode(IsRow, u, GradV, CIDSet);
@@ -1020,37 +1048,32 @@ int TCoda::MLEGradAscentParallel(const double& Thres, const int& MaxIter, const
           if (LearnRate == 0.0) { NewNIDV[ui] = -2; continue; }
           for (int ci = 0; ci < GradV.Len(); ci++) {
             int CID = GradV.GetKey(ci);
-            double Change = LearnRate * GradV.GetDat(CID);
-            double NewFuc = CurFU.IsKey(CID)? CurFU.GetDat(CID) + Change : Change;
+            double Change = LearnRate * GradV[ci];
+            TFlt& FUC = CurFU.AddDat(CID);
+            double NewFuc = FUC + Change;
             if (NewFuc <= 0.0) {
-              CurFU.DelIfKey(CID);
+              CurFU.DelKey(CID);
             } else {
-              CurFU.AddDat(CID) = NewFuc;
+              FUC = NewFuc;
             }
           }
-          CurFU.Defrag();
         }
         //store changes
-        NewF[ui] = CurFU;
+        const TAGMMembV& OldFU = IsRow? F[u]: H[u];
+        TFltV& SumDeltaV = IsRow? SumFDeltaVV[ThreadN]: SumHDeltaVV[ThreadN];
+        for (int c = 0; c < OldFU.Len(); c++) { SumDeltaV[OldFU.GetKey(c)] -= OldFU[c]; }
+        for (int c = 0; c < CurFU.Len(); c++) { SumDeltaV[CurFU.GetKey(c)] += CurFU[c]; }
         NewNIDV[ui] = u;
         IsRowV[ui] = IsRow;
       }
     }
+    }
     int NumNoChangeGrad = 0;
     int NumNoChangeStepSize = 0;
     for (int ui = 0; ui < NewNIDV.Len(); ui++) {
       int NewNID = NewNIDV[ui];
       if (NewNID == -1) { NumNoChangeGrad++; continue; }
       if (NewNID == -2) { NumNoChangeStepSize++; continue; }
-      if (IsRowV[ui]) {
-        for (TIntFltH::TIter CI = F[NewNID].BegI(); CI < F[NewNID].EndI(); CI++) {
-          SumFV[CI.GetKey()] -= CI.GetDat();
-        }
-      } else {
-        for (TIntFltH::TIter CI = H[NewNID].BegI(); CI < H[NewNID].EndI(); CI++) {
-          SumHV[CI.GetKey()] -= CI.GetDat();
-        }
-      }
     }
 #pragma omp parallel for
     for (int ui = 0; ui < NewNIDV.Len(); ui++) {
@@ -1062,18 +1085,13 @@ int TCoda::MLEGradAscentParallel(const double& Thres, const int& MaxIter, const
         H[NewNID] = NewF[ui];
       }
     }
-    for (int ui = 0; ui < NewNIDV.Len(); ui++) {
-      int NewNID = NewNIDV[ui];
-      if (NewNID < 0) { continue; }
-      if (IsRowV[ui]) {
-        for (TIntFltH::TIter CI = F[NewNID].BegI(); CI < F[NewNID].EndI(); CI++) {
-          SumFV[CI.GetKey()] += CI.GetDat();
-        }
-      } else {
-        for (TIntFltH::TIter CI = H[NewNID].BegI(); CI < H[NewNID].EndI(); CI++) {
-          SumHV[CI.GetKey()] += CI.GetDat();
-        }
-      }
+#pragma omp parallel for schedule(static)
+    for (int c = 0; c < SumFV.Len(); c++) {
+      for (int t = 0; t < Threads; t++) { SumFV[c] += SumFDeltaVV[t][c]; }
+    }
+#pragma omp parallel for schedule(static)
+    for (int c = 0; c < SumHV.Len(); c++) {
+      for (int t = 0; t < Threads; t++) { SumHV[c] += SumHDeltaVV[t][c]; }
     }
     // update the nodes who are optimal
     for (int ui = 0; ui < NewNIDV.Len(); ui++) {
@@ -7,8 +7,8 @@
 class TCoda { //sparse AGM-fast with coordinate ascent for directed affiliation
 private:
   PNGraph G; //graph to fit
-  TVec<TIntFltH> F; // outdegree membership for each user (Size: Nodes * Coms)
-  TVec<TIntFltH> H; // in-degree membership for each user (Size: Nodes * Coms) A ~ F * H'
+  TVec<TAGMMembV> F; // outdegree membership for each user (Size: Nodes * Coms)
+  TVec<TAGMMembV> H; // in-degree membership for each user (Size: Nodes * Coms) A ~ F * H'
   TRnd Rnd; // random number generator
   TIntV NIDV; // original node ID vector
   TFlt RegCoef; //Regularization coefficient when we fit for P_c +: L1, -: L2
@@ -39,7 +39,8 @@ public:
   void SetCmtyVV(const TVec<TIntV>& CmtyVVOut, const TVec<TIntV>& CmtyVVIn);
   double Likelihood(const bool DoParallel = false);
   double LikelihoodForNode(const bool IsRow, const int UID);
-  double LikelihoodForNode(const bool IsRow, const int UID, const TIntFltH& FU);
+  double LikelihoodForNode(const bool IsRow, const int UID, const TAGMMembV& FU);
+  void GetHoldOutSumV(const bool IsRow, const int UID, TFltV& HOSumV);
   void GetNonEdgePairScores(TFltIntIntTrV& ScoreV);
   void GetNIDValH(TIntFltH& NIdValInOutH, TIntFltH& NIdValOutH, TIntFltH& NIdValInH, const int CID, const double Thres);
   void DumpMemberships(const TStr& OutFNm, const TStrHash<TInt>& NodeNameH) { DumpMemberships(OutFNm, NodeNameH, sqrt(PNoCom)); }
@@ -98,18 +99,10 @@ public:
     }
   }
   double inline GetComOut(const int& NID, const int& CID) {
-    if (F[NID].IsKey(CID)) {
-      return F[NID].GetDat(CID);
-    } else {
-      return 0.0;
-    }
+    return F[NID].GetDatOrZero(CID);
   }
   double inline GetComIn(const int& NID, const int& CID) {
-    if (H[NID].IsKey(CID)) {
-      return H[NID].GetDat(CID);
-    } else {
-      return 0.0;
-    }
+    return H[NID].GetDatOrZero(CID);
   }
   void inline AddCom(const bool IsOut, const int& NID, const int& CID, const double& Val) {
     if (IsOut) {
@@ -119,18 +112,14 @@ public:
     }
   }
   void inline AddComOut(const int& NID, const int& CID, const double& Val) {
-    if (F[NID].IsKey(CID)) {
-      SumFV[CID] -= F[NID].GetDat(CID);
-    }
-    F[NID].AddDat(CID) = Val;
-    SumFV[CID] += Val;
+    TFlt& FUC = F[NID].AddDat(CID);
+    SumFV[CID] += Val - FUC;
+    FUC = Val;
   }
   void inline AddComIn(const int& NID, const int& CID, const double& Val) {
-    if (H[NID].IsKey(CID)) {
-      SumHV[CID] -= H[NID].GetDat(CID);
-    }
-    H[NID].AddDat(CID) = Val;
-    SumHV[CID] += Val;
+    TFlt& HUC = H[NID].AddDat(CID);
+    SumHV[CID] += Val - HUC;
+    HUC = Val;
   }
   void inline DelCom(const bool IsOut, const int& NID, const int& CID) {
     if (IsOut) {
@@ -140,15 +129,17 @@ public:
     }
   }
   void inline DelComOut(const int& NID, const int& CID) {
-    if (F[NID].IsKey(CID)) {
-      SumFV[CID] -= F[NID].GetDat(CID);
-      F[NID].DelKey(CID);
+    const int N = F[NID].GetKeyId(CID);
+    if (N != -1) {
+      SumFV[CID] -= F[NID][N];
+      F[NID].Del(N);
     }
   }
   void inline DelComIn(const int& NID, const int& CID) {
-    if (H[NID].IsKey(CID)) {
-      SumHV[CID] -= H[NID].GetDat(CID);
-      H[NID].DelKey(CID);
+    const int N = H[NID].GetKeyId(CID);
+    if (N != -1) {
+      SumHV[CID] -= H[NID][N];
+      H[NID].Del(N);
     }
   }
   double inline DotProduct(const TIntFltH& UV, const TIntFltH& VV) {
@@ -168,10 +159,13 @@ public:
     }
     return DP;
   }
+  double inline DotProduct(const TAGMMembV& UV, const TAGMMembV& VV) {
+    return TAGMMembV::DotProduct(UV, VV);
+  }
   double inline DotProductUtoV(const int& UID, const int& VID) {
     return DotProduct(F[UID], H[VID]);
   }
-  double inline Prediction(const TIntFltH& FU, const TIntFltH& HV) {
+  double inline Prediction(const TAGMMembV& FU, const TAGMMembV& HV) {
     double DP = log (1.0 / (1.0 - PNoCom)) + DotProduct(FU, HV);
     IAssertR(DP > 0.0, TStr::Fmt("DP: %f", DP));
     return exp(- DP);
@@ -179,10 +173,10 @@ public:
   double inline Prediction(const int& UID, const int& VID) {
     return Prediction(F[UID], H[VID]);
   }
-  double inline Sum(const TIntFltH& UV) {
+  double inline Sum(const TAGMMembV& UV) {
     double N = 0.0;
-    for (TIntFltH::TIter HI = UV.BegI(); HI < UV.EndI(); HI++) {
-      N += HI.GetDat();
+    for (int c = 0; c < UV.Len(); c++) {
+      N += UV[c];
     }
     return N;
   }
@@ -193,6 +187,13 @@ public:
     }
     return N;
   }
+  double inline Norm2(const TAGMMembV& UV) {
+    double N = 0.0;
+    for (int c = 0; c < UV.Len(); c++) {
+      N += UV[c] * UV[c];
+    }
+    return N;
+  }
 };
 
 class TCodaAnalyzer {
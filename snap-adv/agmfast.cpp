@@ -4,9 +4,123 @@
 #include "Snap.h"
 #include "agm.h"
 
+/////////////////////////////////////////////////
+// Community membership vector
+TAGMMembV::TAGMMembV(const TAGMMembV& MembV) : Vals(0), MxVals(InlineVals), ValT(InlineV) {
+  Reserve(MembV.Vals);
+  for (int i = 0; i < MembV.Vals; i++) { ValT[i] = MembV.ValT[i]; }
+  Vals = MembV.Vals;
+}
+
+TAGMMembV::TAGMMembV(const TIntFltH& ComH) : Vals(0), MxVals(InlineVals), ValT(InlineV) {
+  Reserve(ComH.Len());
+  for (TIntFltH::TIter HI = ComH.BegI(); HI < ComH.EndI(); HI++) {
+    ValT[Vals++] = TIntFltKd(HI.GetKey(), HI.GetDat()); }
+  // insertion sort, vectors are short
+  for (int i = 1; i < Vals; i++) {
+    const TIntFltKd KeyDat = ValT[i];
+    int j = i;
+    for (; j > 0 && ValT[j-1].Key > KeyDat.Key; j--) { ValT[j] = ValT[j-1]; }
+    ValT[j] = KeyDat;
+  }
+}
+
+TAGMMembV& TAGMMembV::operator = (const TAGMMembV& MembV) {
+  if (this != &MembV) {
+    Vals = 0;
+    Reserve(MembV.Vals);
+    for (int i = 0; i < MembV.Vals; i++) { ValT[i] = MembV.ValT[i]; }
+    Vals = MembV.Vals;
+  }
+  return *this;
+}
+
+void TAGMMembV::Save(TSOut& SOut) const {
+  SOut.Save(Vals);
+  for (int i = 0; i < Vals; i++) { ValT[i].Save(SOut); }
+}
+
+void TAGMMembV::Load(TSIn& SIn) {
+  int _Vals;  SIn.Load(_Vals);
+  Clr();  Reserve(_Vals);
+  for (int i = 0; i < _Vals; i++) { ValT[i] = TIntFltKd(SIn); }
+  Vals = _Vals;
+}
+
+void TAGMMembV::Resize(const int& _MxVals) {
+  IAssert(_MxVals >= Vals);
+  TIntFltKd* NewValT = _MxVals > InlineVals ? new TIntFltKd [_MxVals] : InlineV;
+  if (NewValT != ValT) {
+    for (int i = 0; i < Vals; i++) { NewValT[i] = ValT[i]; }
+    if (! IsInline()) { delete [] ValT; }
+  }
+  ValT = NewValT;
+  MxVals = _MxVals > InlineVals ? _MxVals : int(InlineVals);
+}
+
+void TAGMMembV::Clr() {
+  if (! IsInline()) { delete [] ValT; }
+  ValT = InlineV;  MxVals = InlineVals;  Vals = 0;
+}
+
+int TAGMMembV::GetKeyId(const int& CID) const {
+  if (Vals <= 8) {
+    for (int i = 0; i < Vals && ValT[i].Key <= CID; i++) {
+      if (ValT[i].Key == CID) { return i; } }
+    return -1;
+  }
+  int LValN = 0, RValN = Vals - 1;
+  while (LValN <= RValN) {
+    const int ValN = (LValN + RValN) / 2;
+    if (CID == ValT[ValN].Key) { return ValN; }
+    if (CID < ValT[ValN].Key) { RValN = ValN - 1; } else { LValN = ValN + 1; }
+  }
+  return -1;
+}
+
+TFlt& TAGMMembV::AddDat(const int& CID) {
+  int N = 0;
+  while (N < Vals && ValT[N].Key < CID) { N++; }
+  if (N < Vals && ValT[N].Key == CID) { return ValT[N].Dat; }
+  if (Vals == MxVals) { Resize(2 * MxVals); }
+  for (int i = Vals; i > N; i--) { ValT[i] = ValT[i-1]; }
+  ValT[N] = TIntFltKd(CID, 0.0);
+  Vals++;
+  return ValT[N].Dat;
+}
+
+void TAGMMembV::Del(const int& N) {
+  IAssert(0 <= N && N < Vals);
+  for (int i = N + 1; i < Vals; i++) { ValT[i-1] = ValT[i]; }
+  Vals--;
+}
+
+void TAGMMembV::GetH(TIntFltH& ComH) const {
+  ComH.Gen(Vals);
+  for (int i = 0; i < Vals; i++) { ComH.AddDat(ValT[i].Key, ValT[i].Dat); }
+}
+
+double TAGMMembV::DotProduct(const TAGMMembV& UV, const TAGMMembV& VV) {
+  double DP = 0.0;
+  const TIntFltKd *UI = UV.ValT, *UEnd = UV.ValT + UV.Vals;
+  const TIntFltKd *VI = VV.ValT, *VEnd = VV.ValT + VV.Vals;
+  while (UI < UEnd && VI < VEnd) {
+    if (UI->Key < VI->Key) { UI++; }
+    else if (VI->Key < UI->Key) { VI++; }
+    else { DP += UI->Dat * VI->Dat;  UI++;  VI++; }
+  }
+  return DP;
+}
+
+/////////////////////////////////////////////////
+// AGM-fast
+
 void TAGMFast::Save(TSOut& SOut) {
   G->Save(SOut);
-  F.Save(SOut);
+  // memberships are saved as hash tables
+  TVec<TIntFltH> FH(F.Len());
+  for (int u = 0; u < F.Len(); u++) { F[u].GetH(FH[u]); }
+  FH.Save(SOut);
   NIDV.Save(SOut);
   RegCoef.Save(SOut);
   SumFV.Save(SOut);
@@ -21,7 +135,10 @@ void TAGMFast::Save(TSOut& SOut) {
 
 void TAGMFast::Load(TSIn& SIn, const int& RndSeed) {
   G->Load(SIn);
-  F.Load(SIn);
+  TVec<TIntFltH> FH;
+  FH.Load(SIn);
+  F.Gen(FH.Len());
+  for (int u = 0; u < FH.Len(); u++) { F[u] = TAGMMembV(FH[u]); }
   NIDV.Load(SIn);
   RegCoef.Load(SIn);
   SumFV.Load(SIn);
@@ -174,11 +291,9 @@ double TAGMFast::Likelihood(const bool _DoParallel) {
   TExeTm ExeTm;
   double L = 0.0;
   if (_DoParallel) {
-  #pragma omp parallel for 
+  #pragma omp parallel for schedule(dynamic, 1000) reduction(+:L)
     for (int u = 0; u < F.Len(); u++) {
-      double LU = LikelihoodForRow(u);
-      #pragma omp atomic
-        L += LU;
+      L += LikelihoodForRow(u);
     }
   }
   else {
@@ -195,34 +310,37 @@ double TAGMFast::LikelihoodForRow(const int UID) {
 }
 
 
-double TAGMFast::LikelihoodForRow(const int UID, const TIntFltH& FU) {
+/// HOSumFV[c] = sum of F_vc over the nodes v held out for UID
+void TAGMFast::GetHoldOutSumFV(const int UID, TFltV& HOSumFV) {
+  HOSumFV.Gen(SumFV.Len());
+  for (int e = 0; e < HOVIDSV[UID].Len(); e++) {
+    const TAGMMembV& FV = F[HOVIDSV[UID][e]];
+    for (int c = 0; c < FV.Len(); c++) {
+      HOSumFV[FV.GetKey(c)] += FV[c];
+    }
+  }
+}
+
+double TAGMFast::LikelihoodForRow(const int UID, const TAGMMembV& FU) {
   double L = 0.0;
   TFltV HOSumFV; //adjust for Fv of v hold out
   if (HOVIDSV[UID].Len() > 0) {
-    HOSumFV.Gen(SumFV.Len());
-    
-    for (int e = 0; e < HOVIDSV[UID].Len(); e++) {
-      for (int c = 0; c < SumFV.Len(); c++) {
-        HOSumFV[c] += GetCom(HOVIDSV[UID][e], c);
-      }
-    }
+    GetHoldOutSumFV(UID, HOSumFV);
   }
 
   TUNGraph::TNodeI NI = G->GetNI(UID);
   if (DoParallel && NI.GetDeg() > 10) {
-#pragma omp parallel for schedule(static, 1)
+#pragma omp parallel for schedule(static, 1) reduction(+:L)
     for (int e = 0; e < NI.GetDeg(); e++) {
       int v = NI.GetNbrNId(e);
       if (v == UID) { continue; }
       if (HOVIDSV[UID].IsKey(v)) { continue; }
-      double LU = log (1.0 - Prediction(FU, F[v])) + NegWgt * DotProduct(FU, F[v]);
-#pragma omp atomic
-      L += LU;
+      L += log (1.0 - Prediction(FU, F[v])) + NegWgt * DotProduct(FU, F[v]);
     }
-    for (TIntFltH::TIter HI = FU.BegI(); HI < FU.EndI(); HI++) {
-      double HOSum = HOVIDSV[UID].Len() > 0?  HOSumFV[HI.GetKey()].Val: 0.0;//subtract Hold out pairs only if hold out pairs exist
-      double LU = NegWgt * (SumFV[HI.GetKey()] - HOSum - GetCom(UID, HI.GetKey())) * HI.GetDat();
-      L -= LU;
+    for (int c = 0; c < FU.Len(); c++) {
+      const int CID = FU.GetKey(c);
+      double HOSum = HOVIDSV[UID].Len() > 0?  HOSumFV[CID].Val: 0.0;//subtract Hold out pairs only if hold out pairs exist
+      L -= NegWgt * (SumFV[CID] - HOSum - GetCom(UID, CID)) * FU[c];
     }
   } else {
     for (int e = 0; e < NI.GetDeg(); e++) {
@@ -231,9 +349,10 @@ double TAGMFast::LikelihoodForRow(const int UID, const TIntFltH& FU) {
       if (HOVIDSV[UID].IsKey(v)) { continue; }
       L += log (1.0 - Prediction(FU, F[v])) + NegWgt * DotProduct(FU, F[v]);
     }
-    for (TIntFltH::TIter HI = FU.BegI(); HI < FU.EndI(); HI++) {
-      double HOSum = HOVIDSV[UID].Len() > 0?  HOSumFV[HI.GetKey()].Val: 0.0;//subtract Hold out pairs only if hold out pairs exist
-      L -= NegWgt * (SumFV[HI.GetKey()] - HOSum - GetCom(UID, HI.GetKey())) * HI.GetDat();
+    for (int c = 0; c < FU.Len(); c++) {
+      const int CID = FU.GetKey(c);
+      double HOSum = HOVIDSV[UID].Len() > 0?  HOSumFV[CID].Val: 0.0;//subtract Hold out pairs only if hold out pairs exist
+      L -= NegWgt * (SumFV[CID] - HOSum - GetCom(UID, CID)) * FU[c];
     }
   }
   //add regularization
@@ -252,65 +371,47 @@ void TAGMFast::GradientForRow(const int UID, TIntFltH& GradU, const TIntSet& CID
 
   TFltV HOSumFV; //adjust for Fv of v hold out
   if (HOVIDSV[UID].Len() > 0) {
-    HOSumFV.Gen(SumFV.Len());
-    
-    for (int e = 0; e < HOVIDSV[UID].Len(); e++) {
-      for (int c = 0; c < SumFV.Len(); c++) {
-        HOSumFV[c] += GetCom(HOVIDSV[UID][e], c);
-      }
-    }
+    GetHoldOutSumFV(UID, HOSumFV);
   }
     
   TUNGraph::TNodeI NI = G->GetNI(UID);
   int Deg = NI.GetDeg();
   TFltV PredV(Deg), GradV(CIDSet.Len());
   TIntV CIDV(CIDSet.Len());
+  // PredV[e] = P(no edge) / P(edge) + NegWgt for neighbors that are not held out, -1 otherwise
   if (DoParallel && Deg + CIDSet.Len() > 10) {
 #pragma omp parallel for schedule(static, 1)
     for (int e = 0; e < Deg; e++) {
+      PredV[e] = -1.0;
       if (NI.GetNbrNId(e) == UID) { continue; }
       if (HOVIDSV[UID].IsKey(NI.GetNbrNId(e))) { continue; }
-      PredV[e] = Prediction(UID, NI.GetNbrNId(e));
+      const double Pred = Prediction(UID, NI.GetNbrNId(e));
+      PredV[e] = Pred / (1.0 - Pred) + NegWgt;
     }
-  
-#pragma omp parallel for schedule(static, 1)
-    for (int c = 0; c < CIDSet.Len(); c++) {
-      int CID = CIDSet.GetKey(c);
-      double Val = 0.0;
-      for (int e = 0; e < Deg; e++) {
-        int VID = NI.GetNbrNId(e);
-        if (VID == UID) { continue; }
-        if (HOVIDSV[UID].IsKey(VID)) { continue; }
-        Val += PredV[e] * GetCom(VID, CID) / (1.0 - PredV[e]) + NegWgt * GetCom(VID, CID);
-      }
-      double HOSum = HOVIDSV[UID].Len() > 0?  HOSumFV[CID].Val: 0.0;//subtract Hold out pairs only if hold out pairs exist
-      Val -= NegWgt * (SumFV[CID] - HOSum - GetCom(UID, CID));
-      CIDV[c] = CID;
-      GradV[c] = Val;
-    }
-  } 
-  else {
+  } else {
     for (int e = 0; e < Deg; e++) {
+      PredV[e] = -1.0;
       if (NI.GetNbrNId(e) == UID) { continue; }
       if (HOVIDSV[UID].IsKey(NI.GetNbrNId(e))) { continue; }
-      PredV[e] = Prediction(UID, NI.GetNbrNId(e));
+      const double Pred = Prediction(UID, NI.GetNbrNId(e));
+      PredV[e] = Pred / (1.0 - Pred) + NegWgt;
     }
-  
-    for (int c = 0; c < CIDSet.Len(); c++) {
-      int CID = CIDSet.GetKey(c);
-      double Val = 0.0;
-      for (int e = 0; e < Deg; e++) {
-        int VID = NI.GetNbrNId(e);
-        if (VID == UID) { continue; }
-        if (HOVIDSV[UID].IsKey(VID)) { continue; }
-        Val += PredV[e] * GetCom(VID, CID) / (1.0 - PredV[e]) + NegWgt * GetCom(VID, CID);
-      }
-      double HOSum = HOVIDSV[UID].Len() > 0?  HOSumFV[CID].Val: 0.0;//subtract Hold out pairs only if hold out pairs exist
-      Val -= NegWgt * (SumFV[CID] - HOSum - GetCom(UID, CID));
-      CIDV[c] = CID;
-      GradV[c] = Val;
+  }
+  // scatter the neighbors' memberships into the candidate communities (a single pass over the sorted vectors)
+  for (int e = 0; e < Deg; e++) {
+    if (PredV[e] < 0.0) { continue; }
+    const TAGMMembV& FV = F[NI.GetNbrNId(e)];
+    for (int c = 0; c < FV.Len(); c++) {
+      const int KeyId = CIDSet.GetKeyId(FV.GetKey(c));
+      if (KeyId != -1) { GradV[KeyId] += PredV[e] * FV[c]; }
     }
   }
+  for (int c = 0; c < CIDSet.Len(); c++) {
+    int CID = CIDSet.GetKey(c);
+    double HOSum = HOVIDSV[UID].Len() > 0?  HOSumFV[CID].Val: 0.0;//subtract Hold out pairs only if hold out pairs exist
+    GradV[c] -= NegWgt * (SumFV[CID] - HOSum - GetCom(UID, CID));
+    CIDV[c] = CID;
+  }
   //add regularization
   if (RegCoef > 0.0) { //L1
     for (int c = 0; c < GradV.Len(); c++) {
@@ -441,14 +542,14 @@ int TAGMFast::MLENewton(const double& Thres, const int& MaxIter, const TStr& Plo
       }
       for (int e = 0; e < UI.GetDeg(); e++) {
         if (HOVIDSV[UID].IsKey(UI.GetNbrNId(e))) { continue; }
-        TIntFltH& NbhCIDH = F[UI.GetNbrNId(e)];
-        for (TIntFltH::TIter CI = NbhCIDH.BegI(); CI < NbhCIDH.EndI(); CI++) {
-          CIDSet.AddKey(CI.GetKey());
+        const TAGMMembV& NbhCIDV = F[UI.GetNbrNId(e)];
+        for (int c = 0; c < NbhCIDV.Len(); c++) {
+          CIDSet.AddKey(NbhCIDV.GetKey(c));
         }
       }
-      for (TIntFltH::TIter CI = F[UID].BegI(); CI < F[UID].EndI(); CI++) { //remove the community membership which U does not share with its neighbors
-        if (! CIDSet.IsKey(CI.GetKey())) {
-          DelCom(UID, CI.GetKey());
+      for (int c = F[UID].Len() - 1; c >= 0; c--) { //remove the community membership which U does not share with its neighbors
+        if (! CIDSet.IsKey(F[UID].GetKey(c))) {
+          DelCom(UID, F[UID].GetKey(c));
         }
       }
       if (CIDSet.Empty()) { continue; }
@@ -665,14 +766,15 @@ double TAGMFast::LikelihoodHoldOut(const bool DoParallel) {
 double TAGMFast::GetStepSizeByLineSearch(const int UID, const TIntFltH& DeltaV, const TIntFltH& GradV, const double& Alpha, const double& Beta, const int MaxIter) {
   double StepSize = 1.0;
   double InitLikelihood = LikelihoodForRow(UID);
-  TIntFltH NewVarV(DeltaV.Len());
+  TAGMMembV NewVarV;
+  NewVarV.Reserve(DeltaV.Len());
   for(int iter = 0; iter < MaxIter; iter++) {
     for (int i = 0; i < DeltaV.Len(); i++){
       int CID = DeltaV.GetKey(i);
-      double NewVal = GetCom(UID, CID) + StepSize * DeltaV.GetDat(CID);
+      double NewVal = GetCom(UID, CID) + StepSize * DeltaV[i];
       if (NewVal < MinVal) { NewVal = MinVal; }
       if (NewVal > MaxVal) { NewVal = MaxVal; }
-      NewVarV.AddDat(CID, NewVal);
+      NewVarV.AddDat(CID) = NewVal;
     }
     if (LikelihoodForRow(UID, NewVarV) < InitLikelihood + Alpha * StepSize * DotProduct(GradV, DeltaV)) {
       StepSize *= Beta;
@@ -707,14 +809,14 @@ int TAGMFast::MLEGradAscent(const double& Thres, const int& MaxIter, const TStr&
       TIntSet CIDSet(5 * UI.GetDeg());
       for (int e = 0; e < UI.GetDeg(); e++) {
         if (HOVIDSV[u].IsKey(UI.GetNbrNId(e))) { continue; }
-        TIntFltH& NbhCIDH = F[UI.GetNbrNId(e)];
-        for (TIntFltH::TIter CI = NbhCIDH.BegI(); CI < NbhCIDH.EndI(); CI++) {
-          CIDSet.AddKey(CI.GetKey());
+        const TAGMMembV& NbhCIDV = F[UI.GetNbrNId(e)];
+        for (int c = 0; c < NbhCIDV.Len(); c++) {
+          CIDSet.AddKey(NbhCIDV.GetKey(c));
         }
       }
-      for (TIntFltH::TIter CI = F[u].BegI(); CI < F[u].EndI(); CI++) { //remove the community membership which U does not share with its neighbors
-        if (! CIDSet.IsKey(CI.GetKey())) {
-          DelCom(u, CI.GetKey());
+      for (int c = F[u].Len() - 1; c >= 0; c--) { //remove the community membership which U does not share with its neighbors
+        if (! CIDSet.IsKey(F[u].GetKey(c))) {
+          DelCom(u, F[u].GetKey(c));
         }
       }
       if (CIDSet.Empty()) { continue; }
@@ -771,8 +873,15 @@ int TAGMFast::MLEGradAscentParallel(const double& Thres, const int& MaxIter, con
   for (int i = 0; i < F.Len(); i++) { NIdxV.Add(i); }
   TIntV NIDOPTV(F.Len()); //check if a node needs optimization or not 1: does not require optimization
   NIDOPTV.PutAll(0);
-  TVec<TIntFltH> NewF(ChunkNum * ChunkSize);
+  TVec<TAGMMembV> NewF(ChunkNum * ChunkSize);
   TIntV NewNIDV(ChunkNum * ChunkSize);
+  // changes of SumFV are accumulated per thread and merged after each round
+#ifdef USE_OPENMP
+  const int Threads = omp_get_max_threads();
+#else
+  const int Threads = 1;
+#endif
+  TVec<TFltV> SumDeltaVV(Threads);
   for (iter = 0; iter < MaxIter; iter++) {
     NIdxV.Clr(false);
     for (int i = 0; i < F.Len(); i++) { 
@@ -780,32 +889,44 @@ int TAGMFast::MLEGradAscentParallel(const double& Thres, const int& MaxIter, con
     }
     IAssert (NIdxV.Len() <= F.Len());
     NIdxV.Shuffle(Rnd);
+    for (int t = 0; t < Threads; t++) {
+      if (SumDeltaVV[t].Len() != SumFV.Len()) { SumDeltaVV[t].Gen(SumFV.Len()); }
+      else { SumDeltaVV[t].PutAll(0.0); }
+    }
     // compute gradient for chunk of nodes
-#pragma omp parallel for schedule(static, 1)
+#pragma omp parallel
+    {
+#ifdef USE_OPENMP
+    TFltV& SumDeltaV = SumDeltaVV[omp_get_thread_num()];
+#else
+    TFltV& SumDeltaV = SumDeltaVV[0];
+#endif
+#pragma omp for schedule(static, 1)
     for (int TIdx = 0; TIdx < ChunkNum; TIdx++) {
       TIntFltH GradV;
       for (int ui = TIdx * ChunkSize; ui < (TIdx + 1) * ChunkSize; ui++) {
         NewNIDV[ui] = -1;
-        if (ui > NIdxV.Len()) { continue; }
+        if (ui >= NIdxV.Len()) { continue; }
         int u = NIdxV[ui]; //
         //find set of candidate c (we only need to consider c to which a neighbor of u belongs to)
         TUNGraph::TNodeI UI = G->GetNI(u);
         TIntSet CIDSet(5 * UI.GetDeg());
-        TIntFltH CurFU = F[u];
+        TAGMMembV& CurFU = NewF[ui];
+        CurFU = F[u];
         for (int e = 0; e < UI.GetDeg(); e++) {
           if (HOVIDSV[u].IsKey(UI.GetNbrNId(e))) { continue; }
-          TIntFltH& NbhCIDH = F[UI.GetNbrNId(e)];
-          for (TIntFltH::TIter CI = NbhCIDH.BegI(); CI < NbhCIDH.EndI(); CI++) {
-            CIDSet.AddKey(CI.GetKey());
+          const TAGMMembV& NbhCIDV = F[UI.GetNbrNId(e)];
+          for (int c = 0; c < NbhCIDV.Len(); c++) {
+            CIDSet.AddKey(NbhCIDV.GetKey(c));
           }
         }
         if (CIDSet.Empty()) { 
           CurFU.Clr();
         }
         else {
-          for (TIntFltH::TIter CI = CurFU.BegI(); CI < CurFU.EndI(); CI++) { //remove the community membership which U does not share with its neighbors
-            if (! CIDSet.IsKey(CI.GetKey())) {
-              CurFU.DelIfKey(CI.GetKey());
+          for (int c = CurFU.Len() - 1; c >= 0; c--) { //remove the community membership which U does not share with its neighbors
+            if (! CIDSet.IsKey(CurFU.GetKey(c))) {
+              CurFU.Del(c);
             }
           }
           GradientForRow(u, GradV, CIDSet);
@@ -814,30 +935,30 @@ int TAGMFast::MLEGradAscentParallel(const double& Thres, const int& MaxIter, con
           if (LearnRate == 0.0) { NewNIDV[ui] = -2; continue; }
           for (int ci = 0; ci < GradV.Len(); ci++) {
             int CID = GradV.GetKey(ci);
-            double Change = LearnRate * GradV.GetDat(CID);
-            double NewFuc = CurFU.IsKey(CID)? CurFU.GetDat(CID) + Change : Change;
+            double Change = LearnRate * GradV[ci];
+            TFlt& FUC = CurFU.AddDat(CID);
+            double NewFuc = FUC + Change;
             if (NewFuc <= 0.0) {
-              CurFU.DelIfKey(CID);
+              CurFU.DelKey(CID);
             } else {
-              CurFU.AddDat(CID) = NewFuc;
+              FUC = NewFuc;
             }
           }
-          CurFU.Defrag();
         }
         //store changes
-        NewF[ui] = CurFU;
+        const TAGMMembV& OldFU = F[u];
+        for (int c = 0; c < OldFU.Len(); c++) { SumDeltaV[OldFU.GetKey(c)] -= OldFU[c]; }
+        for (int c = 0; c < CurFU.Len(); c++) { SumDeltaV[CurFU.GetKey(c)] += CurFU[c]; }
         NewNIDV[ui] = u;
       }
     }
+    }
     int NumNoChangeGrad = 0;
     int NumNoChangeStepSize = 0;
     for (int ui = 0; ui < NewNIDV.Len(); ui++) {
       int NewNID = NewNIDV[ui];
       if (NewNID == -1) { NumNoChangeGrad++; continue; }
       if (NewNID == -2) { NumNoChangeStepSize++; continue; }
-      for (TIntFltH::TIter CI = F[NewNID].BegI(); CI < F[NewNID].EndI(); CI++) {
-        SumFV[CI.GetKey()] -= CI.GetDat();
-      }
     }
 #pragma omp parallel for
     for (int ui = 0; ui < NewNIDV.Len(); ui++) {
@@ -845,12 +966,9 @@ int TAGMFast::MLEGradAscentParallel(const double& Thres, const int& MaxIter, con
       if (NewNID < 0) { continue; }
       F[NewNID] = NewF[ui];
     }
-    for (int ui = 0; ui < NewNIDV.Len(); ui++) {
-      int NewNID = NewNIDV[ui];
-      if (NewNID < 0) { continue; }
-      for (TIntFltH::TIter CI = F[NewNID].BegI(); CI < F[NewNID].EndI(); CI++) {
-        SumFV[CI.GetKey()] += CI.GetDat();
-      }
+#pragma omp parallel for schedule(static)
+    for (int c = 0; c < SumFV.Len(); c++) {
+      for (int t = 0; t < Threads; t++) { SumFV[c] += SumDeltaVV[t][c]; }
     }
     // update the nodes who are optimal
     for (int ui = 0; ui < NewNIDV.Len(); ui++) {
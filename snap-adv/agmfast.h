@@ -2,12 +2,60 @@
 #define snap_agmfast_h
 #include "Snap.h"
 
+/////////////////////////////////////////////////
+/// Sparse community membership vector of a node: (community, weight) pairs sorted by community.
+/// Up to InlineVals memberships are stored inside the object, larger vectors on the heap.
+class TAGMMembV {
+public:
+  enum { InlineVals = 3 };
+private:
+  int Vals, MxVals;
+  TIntFltKd* ValT;
+  TIntFltKd InlineV[InlineVals];
+private:
+  bool IsInline() const { return ValT == InlineV; }
+  void Resize(const int& _MxVals);
+public:
+  TAGMMembV() : Vals(0), MxVals(InlineVals), ValT(InlineV) { }
+  TAGMMembV(const TAGMMembV& MembV);
+  explicit TAGMMembV(const TIntFltH& ComH);
+  ~TAGMMembV() { if (! IsInline()) { delete [] ValT; } }
+  TAGMMembV& operator = (const TAGMMembV& MembV);
+  void Save(TSOut& SOut) const;
+  void Load(TSIn& SIn);
+
+  int Len() const { return Vals; }
+  bool Empty() const { return Vals == 0; }
+  void Clr();
+  void Reserve(const int& _MxVals) { if (_MxVals > MxVals) { Resize(_MxVals); } }
+  /// Returns the community at position N (communities are in increasing order).
+  int GetKey(const int& N) const { return ValT[N].Key; }
+  /// Returns the weight at position N.
+  const TFlt& operator [] (const int& N) const { return ValT[N].Dat; }
+  TFlt& operator [] (const int& N) { return ValT[N].Dat; }
+  /// Returns the position of community CID or -1 if the node is not its member.
+  int GetKeyId(const int& CID) const;
+  bool IsKey(const int& CID) const { return GetKeyId(CID) != -1; }
+  const TFlt& GetDat(const int& CID) const { const int N = GetKeyId(CID);  IAssert(N != -1);  return ValT[N].Dat; }
+  /// Returns the weight of community CID or 0 if the node is not its member.
+  double GetDatOrZero(const int& CID) const { const int N = GetKeyId(CID);  return N == -1 ? 0.0 : ValT[N].Dat.Val; }
+  /// Returns the weight of community CID, inserting it with weight 0 if needed.
+  TFlt& AddDat(const int& CID);
+  void DelKey(const int& CID) { const int N = GetKeyId(CID);  IAssert(N != -1);  Del(N); }
+  void DelIfKey(const int& CID) { const int N = GetKeyId(CID);  if (N != -1) { Del(N); } }
+  /// Deletes the membership at position N.
+  void Del(const int& N);
+  void GetH(TIntFltH& ComH) const;
+  /// Dot product of two membership vectors (merge of the sorted communities).
+  static double DotProduct(const TAGMMembV& UV, const TAGMMembV& VV);
+};
+
 /////////////////////////////////////////////////
 /// Community detection with AGM. Sparse AGM-fast with coordinate ascent.
 class TAGMFast { 
 private:
   PUNGraph G; //graph to fit
-  TVec<TIntFltH> F; // membership for each user (Size: Nodes * Coms)
+  TVec<TAGMMembV> F; // membership for each user (Size: Nodes * Coms)
   TRnd Rnd; // random number generator
   TIntV NIDV; // original node ID vector
   TFlt RegCoef; //Regularization coefficient when we fit for P_c +: L1, -: L2
@@ -32,9 +80,10 @@ public:
   void SetCmtyVV(const TVec<TIntV>& CmtyVV);
   double Likelihood(const bool DoParallel = false);
   double LikelihoodForRow(const int UID);
-  double LikelihoodForRow(const int UID, const TIntFltH& FU);
+  double LikelihoodForRow(const int UID, const TAGMMembV& FU);
   int MLENewton(const double& Thres, const int& MaxIter, const TStr& PlotNm = TStr());
   void GradientForRow(const int UID, TIntFltH& GradU, const TIntSet& CIDSet);
+  void GetHoldOutSumFV(const int UID, TFltV& HOSumFV);
   double GradientForOneVar(const TFltV& AlphaKV, const int UID, const int CID, const double& Val);
   double HessianForOneVar(const TFltV& AlphaKV, const int UID, const int CID, const double& Val);
   double LikelihoodForOneVar(const TFltV& AlphaKV, const int UID, const int CID, const double& Val);
@@ -55,24 +104,19 @@ public:
   void Save(TSOut& SOut);
   void Load(TSIn& SIn, const int& RndSeed = 0);
   double inline GetCom(const int& NID, const int& CID) {
-    if (F[NID].IsKey(CID)) {
-      return F[NID].GetDat(CID);
-    } else {
-      return 0.0;
-    }
+    return F[NID].GetDatOrZero(CID);
   }
   void inline AddCom(const int& NID, const int& CID, const double& Val) {
-    if (F[NID].IsKey(CID)) {
-      SumFV[CID] -= F[NID].GetDat(CID);
-    }
-    F[NID].AddDat(CID) = Val;
-    SumFV[CID] += Val;
+    TFlt& FUC = F[NID].AddDat(CID);
+    SumFV[CID] += Val - FUC;
+    FUC = Val;
   }
 
   void inline DelCom(const int& NID, const int& CID) {
-    if (F[NID].IsKey(CID)) {
-      SumFV[CID] -= F[NID].GetDat(CID);
-      F[NID].DelKey(CID);
+    const int N = F[NID].GetKeyId(CID);
+    if (N != -1) {
+      SumFV[CID] -= F[NID][N];
+      F[NID].Del(N);
     }
   }
   double inline DotProduct(const TIntFltH& UV, const TIntFltH& VV) {
@@ -92,10 +136,13 @@ public:
     }
     return DP;
   }
+  double inline DotProduct(const TAGMMembV& UV, const TAGMMembV& VV) {
+    return TAGMMembV::DotProduct(UV, VV);
+  }
   double inline DotProduct(const int& UID, const int& VID) {
-    return DotProduct(F[UID], F[VID]);
+    return TAGMMembV::DotProduct(F[UID], F[VID]);
   }
-  double inline Prediction(const TIntFltH& FU, const TIntFltH& FV) {
+  double inline Prediction(const TAGMMembV& FU, const TAGMMembV& FV) {
     double DP = log (1.0 / (1.0 - PNoCom)) + DotProduct(FU, FV);
     IAssertR(DP > 0.0, TStr::Fmt("DP: %f", DP));
     return exp(- DP);
@@ -103,10 +150,10 @@ public:
   double inline Prediction(const int& UID, const int& VID) {
     return Prediction(F[UID], F[VID]);
   }
-  double inline Sum(const TIntFltH& UV) {
+  double inline Sum(const TAGMMembV& UV) {
     double N = 0.0;
-    for (TIntFltH::TIter HI = UV.BegI(); HI < UV.EndI(); HI++) {
-      N += HI.GetDat();
+    for (int c = 0; c < UV.Len(); c++) {
+      N += UV[c];
     }
     return N;
   }
@@ -117,6 +164,13 @@ public:
     }
     return N;
   }
+  double inline Norm2(const TAGMMembV& UV) {
+    double N = 0.0;
+    for (int c = 0; c < UV.Len(); c++) {
+      N += UV[c] * UV[c];
+    }
+    return N;
+  }
 };
 
 
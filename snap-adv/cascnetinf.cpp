@@ -59,6 +59,15 @@ double TCascade::UpdateProb(const int& N1, const int& N2, const bool& UpdateProb
     return CurProb;
 }
 
+// gain in the cascade log-likelihood if the edge (N1, N2) was added, only depends on the parent of N2
+double TCascade::GetGain(const int& N1, const int& N2) const {
+    if (!IsNode(N1) || !IsNode(N2)) { return 0; }
+    if (GetTm(N1) >= GetTm(N2)) { return 0; }
+    const double P1 = log(TransProb(GetParent(N2), N2));
+    const double P2 = log(TransProb(N1, N2));
+    return P1 < P2 ? P2 - P1 : 0;
+}
+
 void TNetInfBs::LoadCascadesTxt(TSIn& SIn, const int& Model, const double& alpha) {
   TStr Line;
   while (!SIn.Eof()) {
@@ -353,6 +362,82 @@ TIntPr TNetInfBs::GetBestEdge(double& CurProb, double& LastGain, bool& msort, in
   return TIntPr(-1, -1);
 }
 
+// marginal gain of the candidate edge CascPerEdge.GetKey(CandN), unlike GetAllCascProb() it does not
+// depend on the rounding of the cascade probabilities, so a candidate evaluates the same until its destination changes
+double TNetInfBs::GetCandGain(const int& CandN) const {
+  const TIntPr& Edge = CascPerEdge.GetKey(CandN);
+  const TIntV& CascsEdge = CascPerEdge[CandN];
+  double P = 0.0;
+  for (int c = 0; c < CascsEdge.Len(); c++) {
+    P += CascV[CascsEdge[c]].GetGain(Edge.Val1, Edge.Val2); }
+  return P;
+}
+
+// evaluates the marginal gains of all candidate edges and builds the priority queue of the lazy greedy
+void TNetInfBs::InitLazyGreedy() {
+  const int Cands = CascPerEdge.Len();
+  CandGainV.Gen(Cands);
+  CandInDegV.Gen(Cands);
+  for (int i = 0; i < Cands; i++) {
+    CandInDegV[i] = Graph->GetNI(CascPerEdge.GetKey(i).Val2).GetInDeg(); }
+#ifdef USE_OPENMP
+  #pragma omp parallel for schedule(dynamic, 64)
+#endif
+  for (int i = 0; i < Cands; i++) {
+    CandGainV[i] = GetCandGain(i); }
+  CandHeap = THeap<TFltIntPr>(Cands);
+  for (int i = 0; i < Cands; i++) {
+    const TIntPr& Edge = CascPerEdge.GetKey(i);
+    if (CandGainV[i] > 0 && ! Graph->IsEdge(Edge.Val1, Edge.Val2)) {
+      CandHeap.Add(TFltIntPr(CandGainV[i], -i)); }
+  }
+  CandHeap.MakeHeap();
+}
+
+// The gain of an edge only depends on the parents of its destination node, so a candidate is stale only if
+// an edge into its destination was added since its last evaluation. Stale heads are re-evaluated in batches
+// in parallel until the head is up to date. Gains never grow, so the head is the edge with the largest gain
+// (ties go to the candidate that comes first in CascPerEdge) and the edge order is that of the plain greedy.
+TIntPr TNetInfBs::GetBestEdgeMP(double& CurProb, double& LastGain) {
+#ifdef USE_OPENMP
+  const int MxBatch = omp_get_max_threads() > 1 ? 4*omp_get_max_threads() : 1;
+#else
+  const int MxBatch = 1;
+#endif
+  TIntV BatchV(MxBatch, 0);
+  while (! CandHeap.Empty()) {
+    BatchV.Clr(false);
+    while (! CandHeap.Empty() && BatchV.Len() < MxBatch) {
+      const int CandN = -CandHeap.TopHeap().Val2;
+      const TIntPr& Edge = CascPerEdge.GetKey(CandN);
+      if (Graph->IsEdge(Edge.Val1, Edge.Val2)) { CandHeap.PopHeap();  continue; }
+      if (CandInDegV[CandN] == Graph->GetNI(Edge.Val2).GetInDeg()) { break; }
+      CandInDegV[CandN] = Graph->GetNI(Edge.Val2).GetInDeg();
+      BatchV.Add(CandHeap.PopHeap().Val2);
+    }
+    if (BatchV.Empty()) {
+      if (CandHeap.Empty()) { break; }
+      const int CandN = -CandHeap.PopHeap().Val2;
+      const double BestGain = CandGainV[CandN];
+      CurProb += BestGain;
+      if (BestGain == 0) { return TIntPr(-1, -1); }
+      LastGain = BestGain;
+      return CascPerEdge.GetKey(CandN);
+    }
+#ifdef USE_OPENMP
+    #pragma omp parallel for schedule(dynamic, 1)
+#endif
+    for (int b = 0; b < BatchV.Len(); b++) {
+      CandGainV[-BatchV[b]] = GetCandGain(-BatchV[b]); }
+    for (int b = 0; b < BatchV.Len(); b++) {
+      const int CandN = -BatchV[b];
+      if (CandGainV[CandN] > 0) { CandHeap.PushHeap(TFltIntPr(CandGainV[CandN], -CandN)); }
+    }
+  }
+  printf("Edges exhausted!\n");
+  return TIntPr(-1, -1);
+}
+
 double TNetInfBs::GetBound(const TIntPr& Edge, double& CurProb) {
   double Bound = 0;
   TFltV Bounds;
@@ -374,11 +459,10 @@ double TNetInfBs::GetBound(const TIntPr& Edge, double& CurProb) {
 void TNetInfBs::GreedyOpt(const int& MxEdges) {
     double CurProb = GetAllCascProb(-1, -1);
     double LastGain = TFlt::Mx;
-    int attempts = 0;
-    bool msort = false;
+    InitLazyGreedy();
 
-    for (int k = 0; k < MxEdges && EdgeGainV.Len() > 0; k++) {
-      const TIntPr BestE = GetBestEdge(CurProb, LastGain, msort, attempts);
+    for (int k = 0; k < MxEdges && ! CandHeap.Empty(); k++) {
+      const TIntPr BestE = GetBestEdgeMP(CurProb, LastGain);
       if (BestE == TIntPr(-1, -1)) // if we cannot add more edges, we stop
         break;
 
@@ -402,14 +486,18 @@ void TNetInfBs::GreedyOpt(const int& MxEdges) {
       
       // localized update!
       TIntV &CascsEdge = CascPerEdge.GetDat(BestE); // only check cascades that contain the edge
+#ifdef USE_OPENMP
+      #pragma omp parallel for schedule(dynamic, 64)
+#endif
       for (int c = 0; c < CascsEdge.Len(); c++) {
         CascV[CascsEdge[c]].UpdateProb(BestE.Val1, BestE.Val2, true); // update probabilities
       }
 
-      // some extra info for the added edge
+      // some extra info for the added edge (only cascades that contain the edge can have it as a parent)
       TInt Vol; TFlt AverageTimeDiff; TFltV TimeDiffs;
       Vol = 0; AverageTimeDiff = 0;
-      for (int i=0; i< CascV.Len(); i++) {
+      for (int c = 0; c < CascsEdge.Len(); c++) {
+        const int i = CascsEdge[c];
         if (CascV[i].IsNode(BestE.Val2) && CascV[i].GetParent(BestE.Val2) == BestE.Val1) {
           Vol += 1; TimeDiffs.Add(CascV[i].GetTm(BestE.Val2)-CascV[i].GetTm(BestE.Val1));
           AverageTimeDiff += TimeDiffs[TimeDiffs.Len()-1]; }
@@ -44,6 +44,7 @@ public:
   double GetProb(const PNGraph& G);
   void InitProb();
   double UpdateProb(const int& N1, const int& N2, const bool& UpdateProb=false);
+  double GetGain(const int& N1, const int& N2) const;
 };
 
 // Node info (name and number of cascades)
@@ -87,6 +88,10 @@ public:
   TVec<TPair<TFlt, TIntPr> > EdgeGainV;
 
   THash<TIntPr, TIntV> CascPerEdge; // To implement localized update
+  // lazy greedy, candidate i is the edge CascPerEdge.GetKey(i)
+  TFltV CandGainV;            // marginal gain of the candidate at its last evaluation (upper bound if stale)
+  TIntV CandInDegV;           // in-degree of the candidate's destination at its last evaluation
+  THeap<TFltIntPr> CandHeap;  // (gain, -candidate) of the candidates with a positive gain
   PNGraph Graph, GroundTruth;
   bool BoundOn, CompareGroundTruth;
   TFltPrV PrecisionRecall;
@@ -120,6 +125,9 @@ public:
   void Init();
   double GetAllCascProb(const int& EdgeN1, const int& EdgeN2);
   TIntPr GetBestEdge(double& CurProb, double& LastGain, bool& msort, int &attempts);
+  double GetCandGain(const int& CandN) const;
+  void InitLazyGreedy();
+  TIntPr GetBestEdgeMP(double& CurProb, double& LastGain);
   double GetBound(const TIntPr& Edge, double& CurProb);
   void GreedyOpt(const int& MxEdges);
 
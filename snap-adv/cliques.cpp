@@ -1,6 +1,184 @@
 #include "stdafx.h"
 #include "cliques.h"
 
+/////////////////////////////////////////////////
+// Bitset Bron-Kerbosch search with Tomita pivoting, one root vertex at a time.
+// The local vertices of root v are its later neighbours P0 in the degeneracy order (at most
+// degeneracy many) followed by its earlier neighbours X0 that are adjacent to some vertex of P0.
+// Sets are bitsets over P0 and over X0, so the rows only need the neighbours of each local
+// vertex within P0 and, for vertices of P0, within X0, which bounds memory by degeneracy*degree.
+class TMaxCliqueBits {
+private:
+  const TIntV& NIdV;
+  const TIntV& OffV;
+  const TIntV& NbrV;
+  int MinSize;
+  TMaxCliqueVisitor& Visitor;
+  TIntV PV, XV;           // local index -> label
+  TIntV PLocV, XLocV;     // label -> local index, -1 if not local
+  int PWords, XWords, FrameWords;
+  TVec<TUInt64> PRowV;    // rows over P0 of the vertices of P0 and X0
+  TVec<TUInt64> XRowV;    // rows over X0 of the vertices of P0
+  TVec<TUInt64> FrameV;   // P, X within P0 and X within X0 at each depth
+  TIntV CliqueV;
+  TIntV CliqueNIdV;
+private:
+  static int GetBits(const uint64& Word) {
+#ifdef __GNUC__
+    return __builtin_popcountll(Word);
+#else
+    int Bits = 0;
+    for (uint64 W = Word; W != 0; W &= W - 1) { Bits++; }
+    return Bits;
+#endif
+  }
+  static int GetLowBit(const uint64& Word) {
+#ifdef __GNUC__
+    return __builtin_ctzll(Word);
+#else
+    int Bit = 0;
+    while (((Word >> Bit) & 1) == 0) { Bit++; }
+    return Bit;
+#endif
+  }
+  static bool IsEmpty(const TUInt64* Bits, const int& Words) {
+    for (int w = 0; w < Words; w++) { if (Bits[w].Val != 0) { return false; } }
+    return true;
+  }
+  void GetRow(const int& Label, const TIntV& UnivV, const TIntV& LocV, TUInt64* Row) const;
+  void Expand(const int& Depth);
+  void AddClique();
+public:
+  TMaxCliqueBits(const TIntV& _NIdV, const TIntV& _OffV, const TIntV& _NbrV, const int& _MinSize, TMaxCliqueVisitor& _Visitor) :
+    NIdV(_NIdV), OffV(_OffV), NbrV(_NbrV), MinSize(_MinSize), Visitor(_Visitor), PLocV(_NIdV.Len()), XLocV(_NIdV.Len()),
+    PWords(0), XWords(0), FrameWords(0) { PLocV.PutAll(-1);  XLocV.PutAll(-1); }
+  void Run(const int& Label);
+};
+
+// Sets the bits of the neighbours of Label among UnivV, long adjacency lists are binary searched instead of scanned.
+void TMaxCliqueBits::GetRow(const int& Label, const TIntV& UnivV, const TIntV& LocV, TUInt64* Row) const {
+  const int Beg = OffV[Label], End = OffV[Label+1];
+  if (End - Beg > 8*UnivV.Len()) {
+    for (int u = 0; u < UnivV.Len(); u++) {
+      int Lo = Beg, Hi = End;
+      while (Lo < Hi) {
+        const int Mid = (Lo + Hi) / 2;
+        if (NbrV[Mid] < UnivV[u]) { Lo = Mid + 1; } else { Hi = Mid; }
+      }
+      if (Lo < End && NbrV[Lo] == UnivV[u]) { Row[u / 64].Val |= uint64(1) << (u % 64); }
+    }
+  } else {
+    for (int n = Beg; n < End; n++) {
+      const int Loc = LocV[NbrV[n]];
+      if (Loc != -1) { Row[Loc / 64].Val |= uint64(1) << (Loc % 64); }
+    }
+  }
+}
+
+void TMaxCliqueBits::AddClique() {
+  CliqueNIdV.Gen(CliqueV.Len(), 0);
+  for (int i = 0; i < CliqueV.Len(); i++) { CliqueNIdV.Add(NIdV[CliqueV[i]]); }
+#ifdef USE_OPENMP
+  #pragma omp critical (TMaxCliqueBits)
+#endif
+  {
+    CliqueNIdV.Sort();
+    Visitor.OnClique(CliqueNIdV);
+  }
+}
+
+void TMaxCliqueBits::Run(const int& Label) {
+  PV.Clr(false);  XV.Clr(false);
+  for (int n = OffV[Label]; n < OffV[Label+1]; n++) {
+    if (NbrV[n] > Label) { PV.Add(NbrV[n]); } else { XV.Add(NbrV[n]); }
+  }
+  CliqueV.Clr(false);
+  CliqueV.Add(Label);
+  if (PV.Empty()) {
+    if (XV.Empty() && MinSize <= 1) { AddClique(); }
+    return;
+  }
+  const int PLen = PV.Len();
+  PWords = (PLen + 63) / 64;
+  for (int p = 0; p < PLen; p++) { PLocV[PV[p]] = p; }
+  PRowV.Gen((PLen + XV.Len()) * PWords);
+  PRowV.PutAll(0);
+  for (int p = 0; p < PLen; p++) { GetRow(PV[p], PV, PLocV, &PRowV[p*PWords]); }
+  // earlier neighbours with no neighbour in P0 can not extend any clique through the root
+  int XLen = 0;
+  for (int x = 0; x < XV.Len(); x++) {
+    TUInt64* Row = &PRowV[(PLen+XLen)*PWords];
+    GetRow(XV[x], PV, PLocV, Row);
+    if (! IsEmpty(Row, PWords)) { XV[XLen] = XV[x];  XLen++; }
+  }
+  XV.Trunc(XLen);
+  XWords = (XLen + 63) / 64;
+  for (int x = 0; x < XLen; x++) { XLocV[XV[x]] = x; }
+  XRowV.Gen(PLen * TMath::Mx(XWords, 1));
+  XRowV.PutAll(0);
+  for (int p = 0; p < PLen && XLen > 0; p++) { GetRow(PV[p], XV, XLocV, &XRowV[p*XWords]); }
+  FrameWords = 2*PWords + XWords;
+  FrameV.Gen((PLen + 1) * FrameWords);
+  FrameV.PutAll(0);
+  for (int p = 0; p < PLen; p++) { FrameV[p / 64].Val |= uint64(1) << (p % 64); }
+  for (int x = 0; x < XLen; x++) { FrameV[2*PWords + x / 64].Val |= uint64(1) << (x % 64); }
+  Expand(0);
+  for (int p = 0; p < PLen; p++) { PLocV[PV[p]] = -1; }
+  for (int x = 0; x < XLen; x++) { XLocV[XV[x]] = -1; }
+}
+
+void TMaxCliqueBits::Expand(const int& Depth) {
+  TUInt64* P = &FrameV[Depth*FrameWords];
+  TUInt64* XP = P + PWords;
+  TUInt64* XX = XP + PWords;
+  if (IsEmpty(P, PWords)) {
+    if (IsEmpty(XP, PWords) && IsEmpty(XX, XWords) && CliqueV.Len() >= MinSize) { AddClique(); }
+    return;
+  }
+  // pivot: the vertex of P and X with the most neighbours in P
+  int Pivot = -1, MxNbrs = -1;
+  for (int w = 0; w < PWords; w++) {
+    for (uint64 Bits = P[w].Val | XP[w].Val; Bits != 0; Bits &= Bits - 1) {
+      const int u = w*64 + GetLowBit(Bits);
+      const TUInt64* Row = &PRowV[u*PWords];
+      int Nbrs = 0;
+      for (int i = 0; i < PWords; i++) { Nbrs += GetBits(P[i].Val & Row[i].Val); }
+      if (Nbrs > MxNbrs) { MxNbrs = Nbrs;  Pivot = u; }
+    }
+  }
+  for (int w = 0; w < XWords; w++) {
+    for (uint64 Bits = XX[w].Val; Bits != 0; Bits &= Bits - 1) {
+      const int u = PV.Len() + w*64 + GetLowBit(Bits);
+      const TUInt64* Row = &PRowV[u*PWords];
+      int Nbrs = 0;
+      for (int i = 0; i < PWords; i++) { Nbrs += GetBits(P[i].Val & Row[i].Val); }
+      if (Nbrs > MxNbrs) { MxNbrs = Nbrs;  Pivot = u; }
+    }
+  }
+  const TUInt64* PivotRow = &PRowV[Pivot*PWords];
+  TUInt64* NextP = P + FrameWords;
+  TUInt64* NextXP = NextP + PWords;
+  TUInt64* NextXX = NextXP + PWords;
+  for (int w = 0; w < PWords; w++) {
+    for (uint64 Bits = P[w].Val & ~PivotRow[w].Val; Bits != 0; Bits &= Bits - 1) {
+      const int q = w*64 + GetLowBit(Bits);
+      const TUInt64* PRow = &PRowV[q*PWords];
+      const TUInt64* XRow = &XRowV[q*XWords];
+      for (int i = 0; i < PWords; i++) {
+        NextP[i].Val = P[i].Val & PRow[i].Val;
+        NextXP[i].Val = XP[i].Val & PRow[i].Val;
+      }
+      for (int i = 0; i < XWords; i++) { NextXX[i].Val = XX[i].Val & XRow[i].Val; }
+      CliqueV.Add(PV[q]);
+      Expand(Depth + 1);
+      CliqueV.DelLast();
+      P[w].Val &= ~(uint64(1) << (q % 64));
+      XP[w].Val |= uint64(1) << (q % 64);
+    }
+  }
+}
+
+
 /////////////////////////////////////////////////
 // TCommunity implementation
 void TCliqueOverlap::GetRelativeComplement(const THashSet<TInt>& A, const THashSet<TInt>& B, THashSet<TInt>& Complement) {
@@ -124,53 +302,100 @@ void TCliqueOverlap::GetMaximalCliques(const PUNGraph& G, int MinMaxCliqueSize,
 	Expand(SUBG, CAND);
 }
 
+// Builds the inverted index of the cliques on at least MinNodeOverlap nodes: CliqueNodeVV[i] holds the
+// compact node indices of clique i and NodeCliqueVV[k] the increasing ids of the cliques containing node k.
+void TCliqueOverlap::GetNodeCliques(const TVec<TIntV>& MaxCliques, int MinNodeOverlap, TVec<TIntV>& NodeCliqueVV, TVec<TIntV>& CliqueNodeVV) {
+  const int n = MaxCliques.Len();
+  TIntSet NIdSet;
+  CliqueNodeVV.Gen(n);
+  for (int i=0; i<n; i++) {
+    const int len = MaxCliques[i].Len();
+    if (len < MinNodeOverlap) { continue; }
+    CliqueNodeVV[i].Gen(len, 0);
+    for (int j=0; j<len; j++) { CliqueNodeVV[i].Add(NIdSet.AddKey(MaxCliques[i][j])); }
+  }
+  NodeCliqueVV.Gen(NIdSet.Len());
+  for (int i=0; i<n; i++) {
+    for (int j=0; j<CliqueNodeVV[i].Len(); j++) { NodeCliqueVV[CliqueNodeVV[i][j]].Add(i); }
+  }
+}
+
+// Overlaps are counted through the node to clique index, so only pairs of cliques sharing a node are visited.
 void TCliqueOverlap::CalculateOverlapMtx(const TVec<TIntV>& MaxCliques, int MinNodeOverlap, TVec<TIntV>& OverlapMtx) {
 	OverlapMtx.Clr();
-	//
-	int n = MaxCliques.Len();
-	//Convert max cliques to HashSets
-		TVec<THashSet<TInt> > cliques;
-	for (int i=0; i<n; i++) {
-		const int len = MaxCliques[i].Len();
-    cliques.Add();
-    if (len < MinNodeOverlap) { continue; }
-		THashSet<TInt>& set = cliques.Last();  set.Gen(len);
-    for (int j=0; j<len; j++) { set.AddKey(MaxCliques[i][j]); }
-	}
+	const int n = MaxCliques.Len();
+  TVec<TIntV> NodeCliqueVV, CliqueNodeVV;
+  GetNodeCliques(MaxCliques, MinNodeOverlap, NodeCliqueVV, CliqueNodeVV);
 	//Init clique clique overlap matrix
-	n = cliques.Len();
 	OverlapMtx.Gen(n);
 	for (int i=0; i<n; i++) OverlapMtx[i].Gen(n);
 	//Calculate clique clique overlap matrix
+#ifdef USE_OPENMP
+  #pragma omp parallel for schedule(dynamic, 64)
+#endif
   for (int i=0; i<n; i++) {
-    OverlapMtx[i][i] = cliques[i].Len();
-    for (int j=i+1; j<n; j++) {
-      OverlapMtx[i][j] = Intersection(cliques[i], cliques[j]); }
+    TIntV& Row = OverlapMtx[i];
+    Row[i] = CliqueNodeVV[i].Len();
+    for (int k=0; k<CliqueNodeVV[i].Len(); k++) {
+      const TIntV& CliqueV = NodeCliqueVV[CliqueNodeVV[i][k]];
+      for (int c=CliqueV.SearchBin(i)+1; c<CliqueV.Len(); c++) { Row[CliqueV[c]] += 1; }
+    }
   }
 }
 
 PUNGraph TCliqueOverlap::CalculateOverlapMtx(const TVec<TIntV>& MaxCliques, int MinNodeOverlap) {
 	const int n = MaxCliques.Len();
-  //Convert max cliques to HashSets
-	TVec<THashSet<TInt> > cliques;
-	for (int i=0; i<n; i++) {
-		const int len = MaxCliques[i].Len();
-    cliques.Add();
-    if (len < MinNodeOverlap) { continue; }
-		THashSet<TInt>& set = cliques.Last();  set.Gen(len);
-    for (int j=0; j<len; j++) { set.AddKey(MaxCliques[i][j]); }
-	}
 	//Init clique clique overlap matrix
 	PUNGraph OverlapMtx = TUNGraph::New();
   for (int i=0; i < n; i++) {
     OverlapMtx->AddNode(i); }
+  if (MinNodeOverlap <= 0) {
+    // every pair of cliques overlaps in at least zero nodes
+    for (int i=0; i<n; i++) {
+      for (int j=i+1; j<n; j++) { OverlapMtx->AddEdge(i,j); } }
+    return OverlapMtx;
+  }
+  TVec<TIntV> NodeCliqueVV, CliqueNodeVV;
+  GetNodeCliques(MaxCliques, MinNodeOverlap, NodeCliqueVV, CliqueNodeVV);
 	//Calculate clique clique overlap matrix
-  for (int i=0; i<n; i++) {
-    for (int j=i+1; j<n; j++) {
-      if (Intersection(cliques[i], cliques[j]) >= MinNodeOverlap) {
-        OverlapMtx->AddEdge(i,j); }
+  TVec<TIntV> NbrCliqueVV(n);
+#ifdef USE_OPENMP
+  #pragma omp parallel
+#endif
+  {
+    TIntV CntV(n), TouchedV;
+    CntV.PutAll(0);
+#ifdef USE_OPENMP
+    #pragma omp for schedule(dynamic, 64)
+#endif
+    for (int i=0; i<n; i++) {
+      TouchedV.Clr(false);
+      for (int k=0; k<CliqueNodeVV[i].Len(); k++) {
+        const TIntV& CliqueV = NodeCliqueVV[CliqueNodeVV[i][k]];
+        for (int c=CliqueV.SearchBin(i)+1; c<CliqueV.Len(); c++) {
+          const int j = CliqueV[c];
+          if (CntV[j] == 0) { TouchedV.Add(j); }
+          CntV[j] += 1;
+        }
+      }
+      for (int t=0; t<TouchedV.Len(); t++) {
+        if (CntV[TouchedV[t]] >= MinNodeOverlap) { NbrCliqueVV[i].Add(TouchedV[t]); }
+        CntV[TouchedV[t]] = 0;
+      }
     }
   }
+  // edges are appended and the adjacency vectors sorted once at the end
+  TIntV DegV(n);
+  for (int i=0; i<n; i++) {
+    DegV[i] += NbrCliqueVV[i].Len();
+    for (int j=0; j<NbrCliqueVV[i].Len(); j++) { DegV[NbrCliqueVV[i][j]] += 1; }
+  }
+  for (int i=0; i<n; i++) { OverlapMtx->ReserveNIdDeg(i, DegV[i]); }
+  for (int i=0; i<n; i++) {
+    for (int j=0; j<NbrCliqueVV[i].Len(); j++) {
+      OverlapMtx->AddEdgeUnchecked(i, NbrCliqueVV[i][j]); }
+  }
+  OverlapMtx->SortNodeAdjV();
   return OverlapMtx;
 }
 
@@ -220,12 +445,115 @@ void TCliqueOverlap::GetMaxCliques(const PUNGraph& G, int MinMaxCliqueSize, TVec
   CO.GetMaximalCliques(G, MinMaxCliqueSize, MaxCliques);
 }
 
+// Relabels the nodes by a k-core peel (Batagelj-Zaversnik bucket order), label i is node NIdV[i].
+// The neighbours of label i are NbrV[OffV[i]..OffV[i+1]), sorted and without self-loops.
+void TCliqueOverlap::GetDegenAdj(const PUNGraph& G, TIntV& NIdV, TIntV& OffV, TIntV& NbrV) {
+  const int Nodes = G->GetNodes();
+  TIntV IdxNIdV;
+  G->GetNIdV(IdxNIdV);
+  TIntH NIdIdxH(Nodes);
+  for (int i = 0; i < Nodes; i++) { NIdIdxH.AddDat(IdxNIdV[i], i); }
+  TIntV DegV(Nodes);
+  for (int i = 0; i < Nodes; i++) {
+    const TUNGraph::TNodeI NI = G->GetNI(IdxNIdV[i]);
+    DegV[i] = NI.GetDeg() - (NI.IsNbrNId(IdxNIdV[i]) ? 1 : 0);
+  }
+  TIntV IdxOffV(Nodes+1);
+  IdxOffV[0] = 0;
+  for (int i = 0; i < Nodes; i++) { IdxOffV[i+1] = IdxOffV[i] + DegV[i]; }
+  TIntV IdxNbrV(IdxOffV[Nodes]);
+#ifdef USE_OPENMP
+  #pragma omp parallel for schedule(dynamic, 1000)
+#endif
+  for (int i = 0; i < Nodes; i++) {
+    const TUNGraph::TNodeI NI = G->GetNI(IdxNIdV[i]);
+    int Pos = IdxOffV[i];
+    for (int n = 0; n < NI.GetDeg(); n++) {
+      if (NI.GetNbrNId(n) != IdxNIdV[i]) { IdxNbrV[Pos] = NIdIdxH.GetDat(NI.GetNbrNId(n));  Pos++; }
+    }
+  }
+  // bucket peel, repeatedly removes a node of minimum remaining degree
+  int MxDeg = 0;
+  for (int i = 0; i < Nodes; i++) { MxDeg = TMath::Mx(MxDeg, DegV[i].Val); }
+  TIntV BinV(MxDeg+1), PosV(Nodes), OrderV(Nodes);
+  BinV.PutAll(0);
+  for (int i = 0; i < Nodes; i++) { BinV[DegV[i]] += 1; }
+  for (int d = 0, Start = 0; d <= MxDeg; d++) { const int Cnt = BinV[d];  BinV[d] = Start;  Start += Cnt; }
+  for (int i = 0; i < Nodes; i++) {
+    PosV[i] = BinV[DegV[i]];  OrderV[PosV[i]] = i;  BinV[DegV[i]] += 1;
+  }
+  for (int d = MxDeg; d > 0; d--) { BinV[d] = BinV[d-1]; }
+  BinV[0] = 0;
+  for (int p = 0; p < Nodes; p++) {
+    const int v = OrderV[p];
+    for (int n = IdxOffV[v]; n < IdxOffV[v+1]; n++) {
+      const int u = IdxNbrV[n];
+      if (DegV[u] > DegV[v]) {
+        const int Du = DegV[u], Pu = PosV[u], Pw = BinV[Du], w = OrderV[Pw];
+        if (u != w) { PosV[u] = Pw;  OrderV[Pu] = w;  PosV[w] = Pu;  OrderV[Pw] = u; }
+        BinV[Du] += 1;
+        DegV[u] -= 1;
+      }
+    }
+  }
+  NIdV.Gen(Nodes);
+  OffV.Gen(Nodes+1);
+  OffV[0] = 0;
+  for (int p = 0; p < Nodes; p++) {
+    NIdV[p] = IdxNIdV[OrderV[p]];
+    OffV[p+1] = OffV[p] + IdxOffV[OrderV[p]+1] - IdxOffV[OrderV[p]];
+  }
+  // visiting the labels in increasing order fills every adjacency list already sorted
+  NbrV.Gen(OffV[Nodes]);
+  TIntV FillV(OffV);
+  for (int p = 0; p < Nodes; p++) {
+    const int v = OrderV[p];
+    for (int n = IdxOffV[v]; n < IdxOffV[v+1]; n++) {
+      const int q = PosV[IdxNbrV[n]];
+      NbrV[FillV[q]] = p;  FillV[q] += 1;
+    }
+  }
+}
+
+// Root vertices are taken in degeneracy order, each one runs a search bounded by the degeneracy,
+// a dynamic schedule hands them out to the threads.
+void TCliqueOverlap::GetMaxCliquesMP(const PUNGraph& G, int MinMaxCliqueSize, TMaxCliqueVisitor& Visitor) {
+  TIntV NIdV, OffV, NbrV;
+  GetDegenAdj(G, NIdV, OffV, NbrV);
+  const int Nodes = NIdV.Len();
+#ifdef USE_OPENMP
+  #pragma omp parallel
+#endif
+  {
+    TMaxCliqueBits CliqueBits(NIdV, OffV, NbrV, MinMaxCliqueSize, Visitor);
+#ifdef USE_OPENMP
+    #pragma omp for schedule(dynamic, 16)
+#endif
+    for (int v = 0; v < Nodes; v++) { CliqueBits.Run(v); }
+  }
+}
+
+class TMaxCliqueVec : public TMaxCliqueVisitor {
+private:
+  TVec<TIntV>& MaxCliques;
+public:
+  TMaxCliqueVec(TVec<TIntV>& _MaxCliques) : MaxCliques(_MaxCliques) { }
+  void OnClique(const TIntV& NIdV) { MaxCliques.Add(NIdV); }
+};
+
+void TCliqueOverlap::GetMaxCliquesMP(const PUNGraph& G, int MinMaxCliqueSize, TVec<TIntV>& MaxCliques) {
+  MaxCliques.Clr(false);
+  TMaxCliqueVec CliqueVec(MaxCliques);
+  GetMaxCliquesMP(G, MinMaxCliqueSize, CliqueVec);
+  MaxCliques.Sort();
+}
+
 /// Clique Percolation method communities
 void TCliqueOverlap::GetCPMCommunities(const PUNGraph& G, int MinMaxCliqueSize, TVec<TIntV>& NIdCmtyVV) {
   printf("Clique Percolation Method\n");
   TExeTm ExeTm;
   TVec<TIntV> MaxCliques;
-  TCliqueOverlap::GetMaxCliques(G, MinMaxCliqueSize, MaxCliques);
+  TCliqueOverlap::GetMaxCliquesMP(G, MinMaxCliqueSize, MaxCliques);
   // op RS 2012/05/15, commented out next line, a parameter is missing,
   //   creating a warning on OS X
   // printf("...%d cliques found\n");
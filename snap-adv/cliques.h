@@ -3,6 +3,15 @@
 
 #include "Snap.h"
 
+/////////////////////////////////////////////////
+// Maximal clique visitor
+class TMaxCliqueVisitor {
+public:
+  virtual ~TMaxCliqueVisitor() { }
+  /// Called once for each maximal clique with its node ids sorted, calls are serialized.
+  virtual void OnClique(const TIntV& NIdV) = 0;
+};
+
 /////////////////////////////////////////////////
 // Clique Percolation Method for Overlapping community detection
 class TCliqueOverlap {
@@ -25,11 +34,18 @@ public:
   static PUNGraph CalculateOverlapMtx(const TVec<TIntV>& MaxCliques, int MinNodeOverlap);
 	static void GetOverlapCliques(const TVec<TIntV>& OverlapMtx, int MinNodeOverlap, TVec<TIntV>& CliqueIdVV);
 	static void GetOverlapCliques(const TVec<TIntV>& OverlapMtx, const TVec<TIntV>& MaxCliques, double MinOverlapFrac, TVec<TIntV>& CliqueIdVV);
+private:
+  static void GetDegenAdj(const PUNGraph& G, TIntV& NIdV, TIntV& OffV, TIntV& NbrV);
+  static void GetNodeCliques(const TVec<TIntV>& MaxCliques, int MinNodeOverlap, TVec<TIntV>& NodeCliqueVV, TVec<TIntV>& CliqueNodeVV);
 public:
   TCliqueOverlap() : m_G(), m_Q(), m_maxCliques(NULL), m_minMaxCliqueSize(3) { }
 	void GetMaximalCliques(const PUNGraph& G, int MinMaxCliqueSize, TVec<TIntV>& MaxCliques);
   /// Enumerate maximal cliques of the network on more than MinMaxCliqueSize nodes
   static void GetMaxCliques(const PUNGraph& G, int MinMaxCliqueSize, TVec<TIntV>& MaxCliques);
+  /// Enumerates maximal cliques on at least MinMaxCliqueSize nodes in parallel and passes each one to Visitor
+  static void GetMaxCliquesMP(const PUNGraph& G, int MinMaxCliqueSize, TMaxCliqueVisitor& Visitor);
+  /// Enumerates maximal cliques on at least MinMaxCliqueSize nodes in parallel, cliques are sorted
+  static void GetMaxCliquesMP(const PUNGraph& G, int MinMaxCliqueSize, TVec<TIntV>& MaxCliques);
   /// Clique Percolation method communities
   static void GetCPMCommunities(const PUNGraph& G, int MinMaxCliqueSize, TVec<TIntV>& Communities);
 };
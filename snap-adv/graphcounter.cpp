@@ -77,6 +77,9 @@ TD34GraphCounter::TD34GraphCounter(int GraphSz) {
 	if(GraphSz==3) numOfGraphs = TD3Graph::m_numOfGraphs;
 	else if(GraphSz==4) numOfGraphs = TD4Graph::m_numOfGraphs;
 	//
+	m_graphMaps.Gen(GraphSz==3 ? 256 : 32768);
+	m_graphMaps.PutAll(-1);
+	//
 	for(int i=0; i<numOfGraphs; i++) {
 		int graphId = 0;
 		if(GraphSz==3) graphId = TD3Graph::m_graphIds[i];
@@ -85,12 +88,12 @@ TD34GraphCounter::TD34GraphCounter(int GraphSz) {
 		TVec<PNGraph> isoG;
 		TGraphEnumUtils::GetIsoGraphs(graphId, GraphSz, isoG);
 		//
-		TVec<uint64> graphIds(isoG.Len());
+		TVec<uint64> graphIds(isoG.Len(), 0);
 		uint64 minGraphId = TGraphEnumUtils::GetMinAndGraphIds(isoG, graphIds);
+		const int keyId = m_graphCounters.AddKey((int)minGraphId);
+		m_graphCounters[keyId] = 0;
 		for(int j=0; j<graphIds.Len(); j++)
-			m_graphMaps.AddDat((int)graphIds[j], (int)minGraphId);
-		//
-		m_graphCounters.AddDat((int)minGraphId, 0);
+			m_graphMaps[(int)graphIds[j]] = keyId;
 	}
 }
 void TD34GraphCounter::operator()(const PNGraph &G, const TIntV &sg) {
@@ -98,10 +101,19 @@ void TD34GraphCounter::operator()(const PNGraph &G, const TIntV &sg) {
 	if(m_subGraphSize==3) graphId = TD3Graph::getId(G, sg);
 	else if(m_subGraphSize==4) graphId = TD4Graph::getId(G, sg);
 	//
-	if(!m_graphMaps.IsKey(graphId)) { printf("This graph does not exist: %d\n", graphId); getchar(); return; }
-	int minGraphId = m_graphMaps.GetDat(graphId);
+	const int keyId = m_graphMaps[graphId];
+	if(keyId == -1) { printf("This graph does not exist: %d\n", graphId); getchar(); return; }
 	//
-	m_graphCounters.GetDat(minGraphId)++;
+	m_graphCounters[keyId]++;
+}
+
+void TD34GraphCounter::Clr() {
+	for(int i=0; i<m_graphCounters.Len(); i++) m_graphCounters[i] = 0;
+}
+
+void TD34GraphCounter::Add(const TD34GraphCounter& Counter) {
+	IAssert(m_subGraphSize == Counter.m_subGraphSize);
+	for(int i=0; i<m_graphCounters.Len(); i++) m_graphCounters[i] += Counter.m_graphCounters[i];
 }
 
 PNGraph TD34GraphCounter::GetGraph(const int& GraphId) const {
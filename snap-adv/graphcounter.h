@@ -15,8 +15,10 @@ public:
   int GetId(const int& i) const { return m_graphCounters.GetKey(i); }
   uint64 GetCnt(const  int& GraphId) const { return m_graphCounters.GetDat(GraphId); }
   PNGraph GetGraph(const int& GraphId) const;
+  void Clr();
+  void Add(const TD34GraphCounter& Counter);
 private:
-  THash<TInt,TInt> m_graphMaps;
+  TIntV m_graphMaps; // graph id (adjacency bitmask) to the key id of its isomorphism class in m_graphCounters
   THash<TInt,TUInt64> m_graphCounters;
   int m_subGraphSize;
 };
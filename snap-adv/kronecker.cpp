@@ -455,6 +455,55 @@ PNGraph TKronMtx::GenFastKronecker(const TKronMtx& SeedMtx, const int& NIter, co
   return Graph;
 }
 
+// Kronecker edge by recursive descent, drawn from a counter-based random stream
+class TKronEdgeGen {
+private:
+  TCtrRnd Rnd;
+  int NNodes, NIter, MtxDim;
+  TVec<TFltIntIntTr> ProbToRCPosV; // row, col position
+public:
+  TKronEdgeGen(const TKronMtx& SeedGraph, const int& _NIter, const int& Seed) :
+   Rnd(Seed), NNodes(SeedGraph.GetNodes(_NIter)), NIter(_NIter), MtxDim(SeedGraph.GetDim()) {
+    const double MtxSum = SeedGraph.GetMtxSum();
+    double CumProb = 0.0;
+    for (int r = 0; r < MtxDim; r++) {
+      for (int c = 0; c < MtxDim; c++) {
+        const double Prob = SeedGraph.At(r, c);
+        if (Prob > 0.0) {
+          CumProb += Prob;
+          ProbToRCPosV.Add(TFltIntIntTr(CumProb/MtxSum, r, c));
+        }
+      }
+    }
+  }
+  void operator()(const int64& Ctr, int& Row, int& Col) const {
+    int Rng=NNodes;  Row=0;  Col=0;
+    for (int iter = 0; iter < NIter; iter++) {
+      const double Prob = Rnd.GetUniDev(Ctr, iter);
+      int n = 0; while(n < ProbToRCPosV.Len()-1 && Prob > ProbToRCPosV[n].Val1) { n++; }
+      Rng /= MtxDim;
+      Row += ProbToRCPosV[n].Val2 * Rng;
+      Col += ProbToRCPosV[n].Val3 * Rng;
+    }
+  }
+};
+
+PNGraph TKronMtx::GenFastKroneckerMP(const TKronMtx& SeedMtx, const int& NIter, const bool& IsDir, const int& Seed) {
+  return GenFastKroneckerMP(SeedMtx, NIter, SeedMtx.GetEdges(NIter), IsDir, Seed);
+}
+
+// generates edges in parallel and deduplicates them in CSR form (allows self-loops)
+PNGraph TKronMtx::GenFastKroneckerMP(const TKronMtx& SeedMtx, const int& NIter, const int& Edges, const bool& IsDir, const int& Seed) {
+  const int NNodes = SeedMtx.GetNodes(NIter);
+  printf("  FastKroneckerMP: %d nodes, %d edges, %s...\n", NNodes, Edges, IsDir ? "Directed":"UnDirected");
+  TVec<TInt64> OffV;
+  TVec<TInt, int64> NbrV;
+  TSnap::TSnapDetail::GenCsrMP(NNodes, Edges, IsDir, true, TKronEdgeGen(SeedMtx, NIter, Seed), OffV, NbrV);
+  PNGraph Graph;
+  TSnap::TSnapDetail::GetGraphFromCsr(OffV, NbrV, Graph);
+  return Graph;
+}
+
 PNGraph TKronMtx::GenDetKronecker(const TKronMtx& SeedMtx, const int& NIter, const bool& IsDir) {
   const TKronMtx& SeedGraph = SeedMtx;
   const int NNodes = SeedGraph.GetNodes(NIter);
@@ -908,6 +957,7 @@ void TKroneckerLL::SetGraph(const PNGraph& GraphPt) {
   RealEdges = Graph->GetEdges();
   LEdgeV = TIntTrV();
   LSelfEdge = 0;
+  InitKronDigits();
 }
 
 
@@ -1035,16 +1085,19 @@ double TKroneckerLL::CalcGraphLL() {
 
 // approximate graph log-likelihood, takes O(E + N_0)
 double TKroneckerLL::CalcApxGraphLL() {
-  LogLike = GetApxEmptyGraphLL(); // O(N_0)
+  InitKronDigits();
+  double LL = GetApxEmptyGraphLL(); // O(N_0)
+  #ifdef USE_OPENMP
+  #pragma omp parallel for schedule(dynamic,1024) reduction(+:LL)
+  #endif
   for (int nid = 0; nid < Nodes; nid++) {
     const TNGraph::TNodeI Node = Graph->GetNI(nid);
     const int SrcNId = NodePerm[nid];
     for (int e = 0; e < Node.GetOutDeg(); e++) {
-      const int DstNId = NodePerm[Node.GetOutNId(e)];
-      LogLike = LogLike - LLMtx.GetApxNoEdgeLL(SrcNId, DstNId, KronIters)
-        + LLMtx.GetEdgeLL(SrcNId, DstNId, KronIters);
+      LL += GetKronEdgeLLDelta(SrcNId, NodePerm[Node.GetOutNId(e)]);
     }
   }
+  LogLike = LL;
   return LogLike;
 }
 
@@ -1059,21 +1112,16 @@ double TKroneckerLL::NodeLLDelta(const int& NId) const {
   // out-edges
   const int SrcRow = NodePerm[NId];
   for (int e = 0; e < Node.GetOutDeg(); e++) {
-    const int DstCol = NodePerm[Node.GetOutNId(e)];
-    Delta += - LLMtx.GetApxNoEdgeLL(SrcRow, DstCol, KronIters)
-      + LLMtx.GetEdgeLL(SrcRow, DstCol, KronIters);
+    Delta += GetKronEdgeLLDelta(SrcRow, NodePerm[Node.GetOutNId(e)]);
   }
   //in-edges
   const int SrcCol = NodePerm[NId];
   for (int e = 0; e < Node.GetInDeg(); e++) {
-    const int DstRow = NodePerm[Node.GetInNId(e)];
-    Delta += - LLMtx.GetApxNoEdgeLL(DstRow, SrcCol, KronIters)
-      + LLMtx.GetEdgeLL(DstRow, SrcCol, KronIters);
+    Delta += GetKronEdgeLLDelta(NodePerm[Node.GetInNId(e)], SrcCol);
   }
   // double counted self-edge
   if (Graph->IsEdge(NId, NId)) {
-    Delta += + LLMtx.GetApxNoEdgeLL(SrcRow, SrcCol, KronIters)
-      - LLMtx.GetEdgeLL(SrcRow, SrcCol, KronIters);
+    Delta -= GetKronEdgeLLDelta(SrcRow, SrcCol);
     IAssert(SrcRow == SrcCol);
   }
   return Delta;
@@ -1086,11 +1134,9 @@ double TKroneckerLL::SwapNodesLL(const int& NId1, const int& NId2) {
   const int PrevId1 = NodePerm[NId1], PrevId2 = NodePerm[NId2];
   // double-counted edges
   if (Graph->IsEdge(NId1, NId2)) {
-    LogLike += - LLMtx.GetApxNoEdgeLL(PrevId1, PrevId2, KronIters)
-      + LLMtx.GetEdgeLL(PrevId1, PrevId2, KronIters); }
+    LogLike += GetKronEdgeLLDelta(PrevId1, PrevId2); }
   if (Graph->IsEdge(NId2, NId1)) {
-    LogLike += - LLMtx.GetApxNoEdgeLL(PrevId2, PrevId1, KronIters)
-      + LLMtx.GetEdgeLL(PrevId2, PrevId1, KronIters); }
+    LogLike += GetKronEdgeLLDelta(PrevId2, PrevId1); }
   // swap
   NodePerm.Swap(NId1, NId2);
   InvertPerm.Swap(NodePerm[NId1], NodePerm[NId2]);
@@ -1099,27 +1145,29 @@ double TKroneckerLL::SwapNodesLL(const int& NId1, const int& NId2) {
   const int NewId1 = NodePerm[NId1], NewId2 = NodePerm[NId2];
   // correct for double-counted edges
   if (Graph->IsEdge(NId1, NId2)) {
-    LogLike += + LLMtx.GetApxNoEdgeLL(NewId1, NewId2, KronIters)
-      - LLMtx.GetEdgeLL(NewId1, NewId2, KronIters); }
+    LogLike -= GetKronEdgeLLDelta(NewId1, NewId2); }
   if (Graph->IsEdge(NId2, NId1)) {
-    LogLike += + LLMtx.GetApxNoEdgeLL(NewId2, NewId1, KronIters)
-      - LLMtx.GetEdgeLL(NewId2, NewId1, KronIters); }
+    LogLike -= GetKronEdgeLLDelta(NewId2, NewId1); }
   return LogLike;
 }
 
 // metropolis sampling from P(permutation|graph)
 bool TKroneckerLL::SampleNextPerm(int& NId1, int& NId2) {
+  return SampleNextPerm(NId1, NId2, TKronMtx::Rnd);
+}
+
+bool TKroneckerLL::SampleNextPerm(int& NId1, int& NId2, TRnd& Rnd) {
   // pick 2 uniform nodes and swap
-  if (TKronMtx::Rnd.GetUniDev() < PermSwapNodeProb) {
-    NId1 = TKronMtx::Rnd.GetUniDevInt(Nodes);
-    NId2 = TKronMtx::Rnd.GetUniDevInt(Nodes);
-    while (NId2 == NId1) { NId2 = TKronMtx::Rnd.GetUniDevInt(Nodes); }
+  if (Rnd.GetUniDev() < PermSwapNodeProb) {
+    NId1 = Rnd.GetUniDevInt(Nodes);
+    NId2 = Rnd.GetUniDevInt(Nodes);
+    while (NId2 == NId1) { NId2 = Rnd.GetUniDevInt(Nodes); }
   } else {
     // pick uniform edge and swap endpoints (slow as it moves around high degree nodes)
-    const int e = TKronMtx::Rnd.GetUniDevInt(GEdgeV.Len());
+    const int e = Rnd.GetUniDevInt(GEdgeV.Len());
     NId1 = GEdgeV[e].Val1;  NId2 = GEdgeV[e].Val2;
   }
-  const double U = TKronMtx::Rnd.GetUniDev();
+  const double U = Rnd.GetUniDev();
   const double OldLL = LogLike;
   const double NewLL = SwapNodesLL(NId1, NId2);
   const double LogU = log(U);
@@ -1132,6 +1180,63 @@ bool TKroneckerLL::SampleNextPerm(int& NId1, int& NId2) {
   return true; // accept new sample
 }
 
+// KronIters base-Dim digits (lowest first) of every id in {0,..,Dim^KronIters-1}.
+// LLMtx.GetEdgeLL() recomputes these with a div/mod per level on every call.
+// Digits of initiators larger than 256 do not fit in a uchar and tables over
+// TInt::Mx digits do not fit in a TVec, then the table is empty and the
+// digits are computed on every call.
+void TKroneckerLL::InitKronDigits() {
+  const int Dim = LLMtx.GetDim();
+  if (Dim < 2 || Dim > 256 || KronIters < 1) { KronDigitV.Clr();  return; }
+  int64 Ids = 1;
+  for (int i = 0; i < KronIters && Ids*KronIters < TInt::Mx; i++) { Ids *= Dim; }
+  if (Ids*KronIters >= TInt::Mx) { KronDigitV.Clr();  return; }
+  if (KronDigitV.Len() == Ids*KronIters) { return; } // up to date
+  KronDigitV.Gen(int(Ids*KronIters));
+  for (int Id = 0; Id < Ids; Id++) {
+    uchar* DigitV = KronDigitV.BegI() + int64(Id)*KronIters;
+    int Rest = Id;
+    for (int level = 0; level < KronIters; level++) {
+      DigitV[level] = uchar(Rest % Dim);  Rest /= Dim; }
+  }
+}
+
+double TKroneckerLL::GetKronEdgeLL(const int& Row, const int& Col) const {
+  if (KronDigitV.Empty()) { return LLMtx.GetEdgeLL(Row, Col, KronIters); }
+  const uchar* RowDigit = KronDigitV.BegI() + int64(Row)*KronIters;
+  const uchar* ColDigit = KronDigitV.BegI() + int64(Col)*KronIters;
+  double LL = 0.0;
+  for (int level = 0; level < KronIters; level++) {
+    const double& LLVal = LLMtx.At(RowDigit[level], ColDigit[level]);
+    if (LLVal == TKronMtx::NInf) { return TKronMtx::NInf; }
+    LL += LLVal;
+  }
+  return LL;
+}
+
+// LLMtx.GetEdgeLL() - LLMtx.GetApxNoEdgeLL(), the change of LL when an edge is added
+double TKroneckerLL::GetKronEdgeLLDelta(const int& Row, const int& Col) const {
+  const double EdgeLL = GetKronEdgeLL(Row, Col);
+  return EdgeLL + exp(EdgeLL) + 0.5*exp(2*EdgeLL);
+}
+
+// adds Sign*(LLMtx.GetEdgeDLL() - LLMtx.GetApxNoEdgeDLL()) for all parameters in one pass over the levels
+void TKroneckerLL::AddKronEdgeDLLDelta(const int& Row, const int& Col, const double& Sign, TFltV& DLLV) const {
+  const bool IsDigitV = ! KronDigitV.Empty();
+  const uchar* RowDigit = IsDigitV ? KronDigitV.BegI() + int64(Row)*KronIters : NULL;
+  const uchar* ColDigit = IsDigitV ? KronDigitV.BegI() + int64(Col)*KronIters : NULL;
+  const int Dim = LLMtx.GetDim();
+  const double EdgeLL = GetKronEdgeLL(Row, Col);
+  int RowRest = Row, ColRest = Col;
+  for (int level = 0; level < KronIters; level++) {
+    const int X = IsDigitV ? RowDigit[level] : RowRest % Dim;
+    const int Y = IsDigitV ? ColDigit[level] : ColRest % Dim;
+    RowRest /= Dim;  ColRest /= Dim;
+    const double CellLL = LLMtx.At(X, Y);
+    DLLV[Y*Dim+X] += Sign * (1.0/exp(LLMtx.At(Y, X)) + exp(EdgeLL-CellLL) + exp(2*EdgeLL-CellLL));
+  }
+}
+
 // exact gradient of an empty graph, O(N^2)
 double TKroneckerLL::GetEmptyGraphDLL(const int& ParamId) const {
   double DLL = 0.0;
@@ -1192,18 +1297,31 @@ const TFltV& TKroneckerLL::CalcFullApxGraphDLL() {
 
 // fast approximate gradient, runs O(E)
 const TFltV& TKroneckerLL::CalcApxGraphDLL() {
-  for (int ParamId = 0; ParamId < LLMtx.Len(); ParamId++) {
-    double DLL = GetApxEmptyGraphDLL(ParamId);
+  InitKronDigits();
+  const int Params = LLMtx.Len();
+  for (int ParamId = 0; ParamId < Params; ParamId++) {
+    GradV[ParamId] = GetApxEmptyGraphDLL(ParamId); }
+  #ifdef USE_OPENMP
+  #pragma omp parallel
+  #endif
+  {
+    // all parameters are updated in a single pass over the edges
+    TFltV ThDLLV(Params);
+    #ifdef USE_OPENMP
+    #pragma omp for schedule(dynamic,1024)
+    #endif
     for (int nid = 0; nid < Nodes; nid++) {
       const TNGraph::TNodeI Node = Graph->GetNI(nid);
       const int SrcNId = NodePerm[nid];
       for (int e = 0; e < Node.GetOutDeg(); e++) {
-        const int DstNId = NodePerm[Node.GetOutNId(e)];
-        DLL = DLL - LLMtx.GetApxNoEdgeDLL(ParamId, SrcNId, DstNId, KronIters)
-          + LLMtx.GetEdgeDLL(ParamId, SrcNId, DstNId, KronIters);
+        AddKronEdgeDLLDelta(SrcNId, NodePerm[Node.GetOutNId(e)], 1.0, ThDLLV);
       }
     }
-    GradV[ParamId] = DLL;
+    #ifdef USE_OPENMP
+    #pragma omp critical
+    #endif
+    for (int ParamId = 0; ParamId < Params; ParamId++) {
+      GradV[ParamId] += ThDLLV[ParamId]; }
   }
   return GradV;
 }
@@ -1236,39 +1354,55 @@ double TKroneckerLL::NodeDLLDelta(const int ParamId, const int& NId) const {
   return Delta;
 }
 
+// NodeDLLDelta() for all parameters at once, added to DLLV with the given sign
+void TKroneckerLL::AddNodeDLLDelta(const int& NId, const double& Sign, TFltV& DLLV) const {
+  if (! Graph->IsNode(NId)) { return; } // zero degree node
+  const TNGraph::TNodeI Node = Graph->GetNI(NId);
+  const int SrcRow = NodePerm[NId];
+  for (int e = 0; e < Node.GetOutDeg(); e++) {
+    AddKronEdgeDLLDelta(SrcRow, NodePerm[Node.GetOutNId(e)], Sign, DLLV);
+  }
+  const int SrcCol = NodePerm[NId];
+  for (int e = 0; e < Node.GetInDeg(); e++) {
+    AddKronEdgeDLLDelta(NodePerm[Node.GetInNId(e)], SrcCol, Sign, DLLV);
+  }
+  // double counter self-edge
+  if (Graph->IsEdge(NId, NId)) {
+    AddKronEdgeDLLDelta(SrcRow, SrcCol, -Sign, DLLV);
+    IAssert(SrcRow == SrcCol);
+  }
+}
+
 // given old DLL and new permutation, efficiently updates the DLL
 // permutation is new, but DLL is old
 void TKroneckerLL::UpdateGraphDLL(const int& SwapNId1, const int& SwapNId2) {
-  for (int ParamId = 0; ParamId < LLMtx.Len(); ParamId++) {
-    // permutation before the swap (swap back to previous position)
-    NodePerm.Swap(SwapNId1, SwapNId2);
-    // subtract old DLL
-    TFlt& DLL = GradV[ParamId];
-    DLL = DLL - NodeDLLDelta(ParamId, SwapNId1) - NodeDLLDelta(ParamId, SwapNId2);
-    // double-counted edges
-    const int PrevId1 = NodePerm[SwapNId1], PrevId2 = NodePerm[SwapNId2];
-    if (Graph->IsEdge(SwapNId1, SwapNId2)) {
-      DLL += - LLMtx.GetApxNoEdgeDLL(ParamId, PrevId1, PrevId2, KronIters)
-        + LLMtx.GetEdgeDLL(ParamId, PrevId1, PrevId2, KronIters); }
-    if (Graph->IsEdge(SwapNId2, SwapNId1)) {
-      DLL += - LLMtx.GetApxNoEdgeDLL(ParamId, PrevId2, PrevId1, KronIters)
-        + LLMtx.GetEdgeDLL(ParamId, PrevId2, PrevId1, KronIters); }
-    // permutation after the swap (restore the swap)
-    NodePerm.Swap(SwapNId1, SwapNId2);
-    // add new DLL
-    DLL = DLL + NodeDLLDelta(ParamId, SwapNId1) + NodeDLLDelta(ParamId, SwapNId2);
-    const int NewId1 = NodePerm[SwapNId1], NewId2 = NodePerm[SwapNId2];
-    // double-counted edges
-    if (Graph->IsEdge(SwapNId1, SwapNId2)) {
-      DLL += + LLMtx.GetApxNoEdgeDLL(ParamId, NewId1, NewId2, KronIters)
-        - LLMtx.GetEdgeDLL(ParamId, NewId1, NewId2, KronIters); }
-    if (Graph->IsEdge(SwapNId2, SwapNId1)) {
-      DLL += + LLMtx.GetApxNoEdgeDLL(ParamId, NewId2, NewId1, KronIters)
-        - LLMtx.GetEdgeDLL(ParamId, NewId2, NewId1, KronIters); }
-  }
+  // permutation before the swap (swap back to previous position)
+  NodePerm.Swap(SwapNId1, SwapNId2);
+  // subtract old DLL
+  AddNodeDLLDelta(SwapNId1, -1.0, GradV);
+  AddNodeDLLDelta(SwapNId2, -1.0, GradV);
+  // double-counted edges
+  const int PrevId1 = NodePerm[SwapNId1], PrevId2 = NodePerm[SwapNId2];
+  if (Graph->IsEdge(SwapNId1, SwapNId2)) {
+    AddKronEdgeDLLDelta(PrevId1, PrevId2, 1.0, GradV); }
+  if (Graph->IsEdge(SwapNId2, SwapNId1)) {
+    AddKronEdgeDLLDelta(PrevId2, PrevId1, 1.0, GradV); }
+  // permutation after the swap (restore the swap)
+  NodePerm.Swap(SwapNId1, SwapNId2);
+  // add new DLL
+  AddNodeDLLDelta(SwapNId1, 1.0, GradV);
+  AddNodeDLLDelta(SwapNId2, 1.0, GradV);
+  const int NewId1 = NodePerm[SwapNId1], NewId2 = NodePerm[SwapNId2];
+  // double-counted edges
+  if (Graph->IsEdge(SwapNId1, SwapNId2)) {
+    AddKronEdgeDLLDelta(NewId1, NewId2, -1.0, GradV); }
+  if (Graph->IsEdge(SwapNId2, SwapNId1)) {
+    AddKronEdgeDLLDelta(NewId2, NewId1, -1.0, GradV); }
 }
 
 void TKroneckerLL::SampleGradient(const int& WarmUp, const int& NSamples, double& AvgLL, TFltV& AvgGradV) {
+  if (GetChains() > 1) {
+    SampleGradientMP(WarmUp, NSamples, AvgLL, AvgGradV);  return; }
   printf("SampleGradient: %s (%s warm-up):", TInt::GetMegaStr(NSamples).CStr(), TInt::GetMegaStr(WarmUp).CStr());
   int NId1=0, NId2=0, NAccept=0;
   TExeTm ExeTm1;
@@ -1296,6 +1430,87 @@ void TKroneckerLL::SampleGradient(const int& WarmUp, const int& NSamples, double
     double(100*NAccept)/double(NSamples));
 }
 
+// chains share the graph, the edge vector and the digit table of this object
+void TKroneckerLL::InitChains() {
+  const int Chains = GetChains();
+  if (ChainV.Len() != Chains) {
+    ChainV.Gen(Chains);
+    for (int c = 0; c < Chains; c++) { ChainV[c] = TKroneckerLL::New(); }
+  }
+  for (int c = 0; c < Chains; c++) {
+    TKroneckerLL& Chain = *ChainV[c];
+    Chain.Graph = Graph;
+    Chain.Nodes = Nodes;  Chain.KronIters = KronIters;
+    Chain.PermSwapNodeProb = PermSwapNodeProb;
+    Chain.GEdgeV.GenExt(GEdgeV.BegI(), GEdgeV.Len());
+    Chain.KronDigitV.GenExt(KronDigitV.BegI(), KronDigitV.Len());
+    Chain.NodePerm = NodePerm;  Chain.InvertPerm = InvertPerm;
+    Chain.ProbMtx = ProbMtx;  Chain.LLMtx = LLMtx;
+    Chain.GradV.Gen(LLMtx.Len());
+    Chain.LogLike = LogLike;
+  }
+}
+
+// runs GetChains() independent Metropolis chains started from the current permutation,
+// each takes NSamples/GetChains() samples. The permutation of the best chain is kept.
+void TKroneckerLL::SampleGradientMP(const int& WarmUp, const int& NSamples, double& AvgLL, TFltV& AvgGradV) {
+  const int Chains = GetChains();
+  const int ChainSamples = TMath::Mx(1, (NSamples + Chains - 1) / Chains);
+  printf("SampleGradientMP: %d x %s (%s warm-up):", Chains, TInt::GetMegaStr(ChainSamples).CStr(), TInt::GetMegaStr(WarmUp).CStr());
+  TExeTm ExeTm1;
+  InitKronDigits();
+  InitChains();
+  TIntV SeedV(Chains);
+  for (int c = 0; c < Chains; c++) { SeedV[c] = 1 + TKronMtx::Rnd.GetUniDevInt(TInt::Mx-1); }
+  const int Params = LLMtx.Len();
+  TFltV ChainLLV(Chains);
+  TIntV ChainAcceptV(Chains);
+  TVec<TFltV> ChainGradV(Chains);
+  #ifdef USE_OPENMP
+  #pragma omp parallel for schedule(dynamic,1)
+  #endif
+  for (int c = 0; c < Chains; c++) {
+    TKroneckerLL& Chain = *ChainV[c];
+    TRnd Rnd(SeedV[c]);
+    int NId1=0, NId2=0, NAccept=0;
+    if (WarmUp > 0) {
+      Chain.CalcApxGraphLL();
+      for (int s = 0; s < WarmUp; s++) { Chain.SampleNextPerm(NId1, NId2, Rnd); }
+    }
+    Chain.CalcApxGraphLL(); // re-calculate LL (due to numerical errors)
+    Chain.CalcApxGraphDLL();
+    double SumLL = 0;
+    TFltV& SumGradV = ChainGradV[c];
+    SumGradV.Gen(Params);
+    for (int s = 0; s < ChainSamples; s++) {
+      if (Chain.SampleNextPerm(NId1, NId2, Rnd)) { // new permutation
+        Chain.UpdateGraphDLL(NId1, NId2);  NAccept++; }
+      for (int m = 0; m < Params; m++) { SumGradV[m] += Chain.GradV[m]; }
+      SumLL += Chain.GetLL();
+    }
+    ChainLLV[c] = SumLL;
+    ChainAcceptV[c] = NAccept;
+  }
+  AvgLL = 0;
+  AvgGradV.Gen(Params);  AvgGradV.PutAll(0.0);
+  int NAccept = 0, BestChain = 0;
+  for (int c = 0; c < Chains; c++) {
+    AvgLL += ChainLLV[c];  NAccept += ChainAcceptV[c];
+    for (int m = 0; m < Params; m++) { AvgGradV[m] += ChainGradV[c][m]; }
+    if (ChainV[c]->GetLL() > ChainV[BestChain]->GetLL()) { BestChain = c; }
+  }
+  const double TotSamples = double(Chains) * double(ChainSamples);
+  AvgLL = AvgLL / TotSamples;
+  for (int m = 0; m < Params; m++) {
+    AvgGradV[m] = AvgGradV[m] / TotSamples; }
+  // continue from the most likely permutation
+  const TKroneckerLL& Best = *ChainV[BestChain];
+  NodePerm = Best.NodePerm;  InvertPerm = Best.InvertPerm;
+  LogLike = Best.LogLike;  GradV = Best.GradV;
+  printf(" sampling:%s (%.0f/s), accept %.1f%%\n", ExeTm1.GetTmStr(), TotSamples/ExeTm1.GetSecs(),
+    double(100*NAccept)/TotSamples);
+}
+
 double TKroneckerLL::GradDescent(const int& NIter, const double& LrnRate, double MnStep, double MxStep, const int& WarmUp, const int& NSamples) {
   printf("\n----------------------------------------------------------------------\n");
   printf("Fitting graph on %d nodes, %d edges\n", Graph->GetNodes(), Graph->GetEdges());
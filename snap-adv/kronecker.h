@@ -87,6 +87,9 @@ public:
   static PNGraph GenKronecker(const TKronMtx& SeedMtx, const int& NIter, const bool& IsDir, const int& Seed=0);
   static PNGraph GenFastKronecker(const TKronMtx& SeedMtx, const int& NIter, const bool& IsDir, const int& Seed=0);
   static PNGraph GenFastKronecker(const TKronMtx& SeedMtx, const int& NIter, const int& Edges, const bool& IsDir, const int& Seed=0);
+  // parallel GenFastKronecker, the output depends only on Seed and not on the number of threads
+  static PNGraph GenFastKroneckerMP(const TKronMtx& SeedMtx, const int& NIter, const bool& IsDir, const int& Seed=0);
+  static PNGraph GenFastKroneckerMP(const TKronMtx& SeedMtx, const int& NIter, const int& Edges, const bool& IsDir, const int& Seed=0);
   static PNGraph GenDetKronecker(const TKronMtx& SeedMtx, const int& NIter, const bool& IsDir);
   static void PlotCmpGraphs(const TKronMtx& SeedMtx, const PNGraph& Graph, const TStr& OutFNm, const TStr& Desc);
   static void PlotCmpGraphs(const TKronMtx& SeedMtx1, const TKronMtx& SeedMtx2, const PNGraph& Graph, const TStr& OutFNm, const TStr& Desc);
@@ -142,6 +145,10 @@ private:
   TFltV LLV;			// Log-likelihood (per EM iteration)
   TVec<TKronMtx> MtxV;	// Kronecker initiator matrix (per EM iteration)
 
+  TVec<uchar> KronDigitV; // Kronecker digits of every row/column id (KronIters per id)
+  TInt NChains;         // number of parallel permutation chains in SampleGradient()
+  TVec<PKroneckerLL> ChainV; // chain samplers, share Graph, GEdgeV and KronDigitV with this object
+
 public:
   // RS 07/03/12, changed the order in the constructor initializer list
   //    so that it matches the declaration order. This changes also
@@ -206,6 +213,13 @@ public:
   double NodeLLDelta(const int& NId) const;
   double SwapNodesLL(const int& NId1, const int& NId2);
   bool SampleNextPerm(int& NId1, int& NId2); // sampling from P(perm|graph)
+  bool SampleNextPerm(int& NId1, int& NId2, TRnd& Rnd);
+
+  // edge likelihoods through the cached Kronecker digits of row/column ids
+  void InitKronDigits();
+  double GetKronEdgeLL(const int& Row, const int& Col) const; // LLMtx.GetEdgeLL(Row, Col, KronIters)
+  double GetKronEdgeLLDelta(const int& Row, const int& Col) const; // edge LL minus approx. no-edge LL
+  void AddKronEdgeDLLDelta(const int& Row, const int& Col, const double& Sign, TFltV& DLLV) const; // same for all derivatives
 
   // derivative of the log-likelihood
   double GetEmptyGraphDLL(const int& ParamId) const;
@@ -214,12 +228,18 @@ public:
   const TFltV& CalcFullApxGraphDLL();
   const TFltV& CalcApxGraphDLL();
   double NodeDLLDelta(const int ParamId, const int& NId) const;
+  void AddNodeDLLDelta(const int& NId, const double& Sign, TFltV& DLLV) const;
   void UpdateGraphDLL(const int& SwapNId1, const int& SwapNId2);
   const TFltV& GetDLL() const { return GradV; }
   double GetDLL(const int& ParamId) const { return GradV[ParamId]; }
 
   // gradient
   void SampleGradient(const int& WarmUp, const int& NSamples, double& AvgLL, TFltV& GradV);
+  // parallel permutation chains: each chain takes NSamples/Chains samples, gradients are averaged
+  void SetChains(const int& Chains) { NChains = Chains;  ChainV.Clr(); }
+  int GetChains() const { return TMath::Mx(1, NChains()); }
+  void InitChains();
+  void SampleGradientMP(const int& WarmUp, const int& NSamples, double& AvgLL, TFltV& GradV);
   double GradDescent(const int& NIter, const double& LrnRate, double MnStep, double MxStep, const int& WarmUp, const int& NSamples);
   double GradDescent2(const int& NIter, const double& LrnRate, double MnStep, double MxStep, const int& WarmUp, const int& NSamples);
 
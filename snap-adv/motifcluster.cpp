@@ -755,7 +755,8 @@ double MotifCluster::NFiedlerVector(const TSparseColMatrix& W, TFltV& fvec,
     L_col.Add(TIntFltKd(j, 2.0));    
   }
 
-  TSparseColMatrix L(L_weights, N, N);
+  // ARPACK multiplies through the parallel CSR copy of I + Ln
+  TCsrMtx L(TSparseColMatrix(L_weights, N, N));
   TFltV evals;
   TFullColMatrix evecs;
   SymeigsSmallest(L, 2, evals, evecs, tol, maxiter);
@@ -952,7 +953,7 @@ void MotifCluster::SpectralCut(const WeightVH& weights, TSweepCut& sweepcut,
   sweepcut.cluster = cluster;
 }
 
-void SymeigsSmallest(const TSparseColMatrix& A, int nev, TFltV& evals,
+void SymeigsSmallest(const TMatrix& A, int nev, TFltV& evals,
                      TFullColMatrix& evecs, double tol, int maxiter) {
   // type of problem
   int mode = 1;
@@ -992,13 +993,12 @@ void SymeigsSmallest(const TSparseColMatrix& A, int nev, TFltV& evals,
   int info = 0;
 
   TFltV Ax(n);
+  TFltV result(n);
   // Communication loop.  We keep applying A * x until ARPACK tells us to stop.
   while (true) {
     F77_NAME(dsaupd)(&ido, &bmat, &n, &which[0], &nev, &tol, &resid[0], &ncv,
                      &V[0], &ldv, &iparam[0], &ipntr[0], &workd[0], &workl[0],
                      &lworkl, &info);
-    TFltV result(n);
-    result.PutAll(0.0);
     double *load = &workd[ipntr[0] - 1];
     for (int i = 0; i < n; i++) {
       result[i] = load[i];
@@ -49,7 +49,7 @@ class TSweepCut {
 // is the stopping tolerance, and maxiter is the maximum number of iterations.
 // This routine stores the eigenvalues in evals and the eigenvectors in evecs,
 // sorted from smallest to largest eigenvalue.
-void SymeigsSmallest(const TSparseColMatrix& A, int nev, TFltV& evals,
+void SymeigsSmallest(const TMatrix& A, int nev, TFltV& evals,
 		     TFullColMatrix& evecs, double tol=kDefaultTol,
 		     int maxiter=kMaxIter);
 
@@ -6,65 +6,97 @@
 
 bool TLocClust::Verbose = true;
 
+TLocClust::TDenseGraph::TDenseGraph(const PUNGraph& Graph) {
+  const int Nodes = Graph->GetNodes();
+  NIdIdxH.Gen(Nodes);  IdxNIdV.Gen(Nodes, 0);  DegV.Gen(Nodes, 0);
+  for (TUNGraph::TNodeI NI = Graph->BegNI(); NI < Graph->EndNI(); NI++) {
+    NIdIdxH.AddDat(NI.GetId(), IdxNIdV.Len());
+    IdxNIdV.Add(NI.GetId());  DegV.Add(NI.GetOutDeg());
+  }
+  AdjOffV.Gen(Nodes+1, 0);  AdjV.Gen(2*Graph->GetEdges(), 0);
+  AdjOffV.Add(0);
+  for (TUNGraph::TNodeI NI = Graph->BegNI(); NI < Graph->EndNI(); NI++) {
+    for (int e = 0; e < NI.GetOutDeg(); e++) {
+      AdjV.Add(NIdIdxH.GetDat(NI.GetOutNId(e))); }
+    AdjOffV.Add(AdjV.Len());
+  }
+}
+
+TLocClust::TLocClust(const PUNGraph& GraphPt, const double& AlphaVal) :
+  Graph(GraphPt), Nodes(GraphPt->GetNodes()), Edges2(2*GraphPt->GetEdges()), Alpha(AlphaVal), SeedNId(-1), BestCutIdx(-1) {
+  // the push and the sweep only touch arrays, copies of the object share the dense graph
+  DenseG = new TDenseGraph(Graph);
+  ProbV.Gen(Nodes);  ProbV.PutAll(0.0);
+  ResV.Gen(Nodes);  ResV.PutAll(0.0);
+  RankV.Gen(Nodes);  RankV.PutAll(-1);
+}
+
 int TLocClust::ApproxPageRank(const int& SeedNode, const double& Eps) {
-  for (int i = 0; i < ProbH.Len(); i++) { ProbH[i]=0.0; }
-  for (int i = 0; i < ResH.Len(); i++) { ResH[i]=0.0; }
-  ProbH.Clr(false, -1, false);
-  ResH.Clr(false, -1, false);
-  ResH.AddDat(SeedNode, 1.0);
+  const TIntV& DegV = DenseG->DegV;
+  const TIntV& AdjOffV = DenseG->AdjOffV;
+  const TIntV& AdjV = DenseG->AdjV;
+  // sparse reset of the previous run
+  for (int i = 0; i < SupV.Len(); i++) { ProbV[SupV[i]]=0.0;  RankV[SupV[i]]=-1; }
+  for (int i = 0; i < ResIdxV.Len(); i++) { ResV[ResIdxV[i]]=0.0; }
+  SupV.Clr(false);
+  ResIdxV.Clr(false);
+  const int SeedIdx = DenseG->NIdIdxH.GetDat(SeedNode);
+  ResV[SeedIdx] = 1.0;  ResIdxV.Add(SeedIdx);
   int iter = 0;
   double OldRes = 0.0;
   NodeQ.Clr(false);
-  NodeQ.Push(SeedNode);
+  NodeQ.Push(SeedIdx);
   TExeTm ExeTm;
   while (! NodeQ.Empty()) {
-    const int NId = NodeQ.Top(); NodeQ.Pop();
-    const TUNGraph::TNodeI& Node = Graph->GetNI(NId);
-    const int NIdDeg = Node.GetOutDeg();
-    const double PushVal = ResH.GetDat(NId) - 0.5*Eps*NIdDeg;
-    const double PutVal = (1.0-Alpha) * PushVal / double(NIdDeg);
-    ProbH.AddDat(NId) += Alpha*PushVal;
-    ResH.AddDat(NId) = 0.5 * Eps * NIdDeg;
-    for (int e = 0; e < NIdDeg; e++) {
-      const int DstNId = Node.GetOutNId(e);
-      const int DstDeg = Graph->GetNI(DstNId).GetOutDeg();
-      double& ResVal = ResH.AddDat(DstNId).Val;
+    const int Idx = NodeQ.Top(); NodeQ.Pop();
+    const int IdxDeg = DegV[Idx];
+    const double PushVal = ResV[Idx] - 0.5*Eps*IdxDeg;
+    const double PutVal = (1.0-Alpha) * PushVal / double(IdxDeg);
+    if (RankV[Idx] == -1) { RankV[Idx] = SupV.Len();  SupV.Add(Idx); }
+    ProbV[Idx] += Alpha*PushVal;
+    ResV[Idx] = 0.5 * Eps * IdxDeg;
+    for (int e = AdjOffV[Idx]; e < AdjOffV[Idx+1]; e++) {
+      const int DstIdx = AdjV[e];
+      const int DstDeg = DegV[DstIdx];
+      double& ResVal = ResV[DstIdx].Val;
       OldRes = ResVal;
+      if (OldRes == 0.0) { ResIdxV.Add(DstIdx); }
       ResVal += PutVal;
       if (ResVal >= Eps*DstDeg && OldRes < Eps*DstDeg) {
-        NodeQ.Push(DstNId); }
+        NodeQ.Push(DstIdx); }
     }
     iter++;
     if (iter % Mega(1) == 0) { 
       printf(" %d[%s]", NodeQ.Len(), ExeTm.GetStr());
-      if (iter/1000 > Graph->GetNodes() || ExeTm.GetSecs() > 4*3600) { // more than 2 hours
+      if (iter/1000 > Nodes || ExeTm.GetSecs() > 4*3600) { // more than 2 hours
         printf("Too many iterations! Stop to save time.\n");
         return iter; }
     }
   }
   // check that the residuals are sufficiently small
-  /*for (int i =0; i < ProbH.Len(); i++) {
-    const int Deg = Graph->GetNI(ResH.GetKey(i)).GetOutDeg();
-    IAssert(ResH[i] < Eps*Deg); } //*/
+  /*for (int i =0; i < ResIdxV.Len(); i++) {
+    IAssert(ResV[ResIdxV[i]] < Eps*DegV[ResIdxV[i]]); } //*/
   return iter;
 }
 
 void TLocClust::SupportSweep() {
+  const TIntV& DegV = DenseG->DegV;
+  const TIntV& AdjOffV = DenseG->AdjOffV;
+  const TIntV& AdjV = DenseG->AdjV;
   TExeTm ExeTm;
   VolV.Clr(false);  CutV.Clr(false);  PhiV.Clr(false);
-  if (ProbH.Empty()) { return; }
-  const int TopNId = ProbH.GetKey(0);
-  const int TopNIdDeg = Graph->GetNI(TopNId).GetOutDeg();
-  int Vol = TopNIdDeg, Cut = TopNIdDeg;
+  if (SupV.Empty()) { return; }
+  for (int i = 0; i < SupV.Len(); i++) { RankV[SupV[i]] = i; }
+  const int TopIdxDeg = DegV[SupV[0]];
+  int Vol = TopIdxDeg, Cut = TopIdxDeg;
   double Phi = Cut/double(Vol);
   VolV.Add(Vol);  CutV.Add(Cut);  PhiV.Add(1.0);
-  for (int i = 1; i < ProbH.Len(); i++) {
-    const int NId = ProbH.GetKey(i);
-    const TUNGraph::TNodeI& Node = Graph->GetNI(NId);
-    const int OutDeg = Node.GetOutDeg();
+  for (int i = 1; i < SupV.Len(); i++) {
+    const int Idx = SupV[i];
+    const int OutDeg = DegV[Idx];
     int CutSz = OutDeg; // edges outside
-    for (int e = 0; e < OutDeg; e++) {
-      const int Rank = ProbH.GetKeyId(Node.GetOutNId(e));
+    for (int e = AdjOffV[Idx]; e < AdjOffV[Idx+1]; e++) {
+      const int Rank = RankV[AdjV[e]];
       if ( Rank > -1 && Rank < i) { CutSz -= 2;  }
     }
     Vol += OutDeg;  Cut += CutSz;
@@ -84,19 +116,34 @@ void TLocClust::FindBestCut(const int& SeedNode, const int& ClustSz, const doubl
   SeedNId = SeedNode;
   // calculate pagerank and cut sets
   ApproxPageRank(SeedNId, 1.0/double(ClustSz));
-  for (int i = 0; i < ProbH.Len(); i++) {
-    ProbH[i] /= Graph->GetNI(ProbH.GetKey(i)).GetOutDeg(); }
-  ProbH.SortByDat(false);
+  for (int i = 0; i < SupV.Len(); i++) {
+    ProbV[SupV[i]] /= DenseG->DegV[SupV[i]]; }
+  // order the support by decreasing score, ties keep the order of the push. The heap does
+  // not draw from the global random generator, so the seeds of the caller stay the same.
+  THeap<TFltIntPr> SweepHeap(SupV.Len());
+  for (int i = 0; i < SupV.Len(); i++) {
+    SweepHeap.Add(TFltIntPr(ProbV[SupV[i]], -i)); }
+  SweepHeap.MakeHeap();
+  NIdV.Clr(false);
+  for (int i = 0; i < SupV.Len(); i++) {
+    NIdV.Add(SupV[-SweepHeap.PopHeap().Val2]); }
+  for (int i = 0; i < SupV.Len(); i++) {
+    SupV[i] = NIdV[i];  NIdV[i] = DenseG->IdxNIdV[SupV[i]]; }
   SupportSweep();
   // find best cut
-  NIdV.Clr(false);
   for (int i = 0; i < PhiV.Len(); i++) {
     const double Phi = PhiV[i];
-    NIdV.Add(ProbH.GetKey(i));
     if (Phi < MaxPhi) { MaxPhi = Phi;  BestCutIdx = i; }
   }
 }
 
+void TLocClust::SwapSweep(TLocClust& Clust) {
+  NIdV.Swap(Clust.NIdV);  VolV.Swap(Clust.VolV);
+  CutV.Swap(Clust.CutV);  PhiV.Swap(Clust.PhiV);
+  const int Seed = SeedNId;  SeedNId = Clust.SeedNId;  Clust.SeedNId = Seed;
+  const int CutIdx = BestCutIdx;  BestCutIdx = Clust.BestCutIdx;  Clust.BestCutIdx = CutIdx;
+}
+
 void TLocClust::PlotVolDistr(const TStr& OutFNm, TStr Desc) const {
   TFltPrV RankValV(VolV.Len(), 0);
   for (int i = 0; i < VolV.Len(); i++) {
@@ -308,7 +355,19 @@ void TLocClustStat::Run(const PUNGraph& _Graph, const bool& SaveAllSweeps, const
   printf("  SizeFrac: %g\n\n", SizeFrac());
   TExeTm TotTm;
   Clr();
-  TLocClust Clust(Graph, Alpha);
+  // the threads share the dense graph and each pushes in its own score and residual vectors, sweeps
+  // of a block of runs are kept and merged in the order of the runs, so the result does not depend
+  // on the number of threads
+#ifdef USE_OPENMP
+  const int Threads = omp_get_max_threads();
+#else
+  const int Threads = 1;
+#endif
+  TVec<TLocClust> ClustV(Threads);
+  ClustV[0] = TLocClust(Graph, Alpha);
+  for (int t = 1; t < Threads; t++) { ClustV[t] = ClustV[0]; }
+  const int BlockLen = 16*Threads;
+  TVec<TLocClust> SweepV(BlockLen);
   BestCut.CutNIdV.Clr(false); 
   BestCut.CutSz=-1;  BestCut.Edges=-1;
   double BestPhi = TFlt::Mx;
@@ -333,57 +392,75 @@ void TLocClustStat::Run(const PUNGraph& _Graph, const bool& SaveAllSweeps, const
     //if (K+1 > Graph->GetEdges()) { K = Graph->GetEdges(); NextDone=true; }
     TExeTm ExeTm, IterTm;
     double MeanSz=0.0, MeanVol=0.0, Count=0.0;
-    for (int run = 0; run < Runs; run++) {
-      const int SeedNId = Graph->GetRndNId();  IterTm.Tick();
-      Clust.FindBestCut(SeedNId, K, SizeFrac);
-      const int Sz = Clust.BestCutNodes();
-      const int Vol = Clust.GetCutVol();
-      const double Phi = TMath::Round(Clust.GetCutPhi(), 4);
-      if (Sz == 0 || Vol == 0 || Phi == 0) { continue; }
-      MeanSz+=Sz;  MeanVol+=Vol;  Count+= 1;
-      if (SaveAllSweeps) { // save the full cut set and conductances for all trials
-        SweepsV.Add(TNodeSweep(SeedNId, Clust.GetNIdV(), Clust.GetPhiV())); }
-      int SAtBestPhi=-1;
-      for (int s = 0; s < Clust.Len(); s++) {
-        const int size = s+1;
-        const int cut = Clust.GetCut(s);
-        const int edges = (Clust.GetVol(s)-cut)/2;
-        const double phi = Clust.GetPhi(s);
-        if (( Clust.GetPhi(s) != double(cut)/double(2*edges+cut))) { continue; } // more than half of the edges
-        IAssert((Clust.GetVol(s) - cut) % 2 == 0);
-        IAssert(phi == double(cut)/double(2*edges+cut));
-        IAssert(phi >= 1.0/double((1+s)*s+1));
-        //// If we want to take pieces that minimize some other community goodness measure
-        // TCutInfo CutInfo(size, edges, cut); Clust.GetNIdV().GetSubValV(0, size-1, CutInfo.CutNIdV);
-        //double MxFrac=0, AvgFrac=0, MedianFrac=0, Pct9Frac=0, Flake=0;
-        //CutInfo.GetFracDegOut(Graph, MxFrac, AvgFrac, MedianFrac, Pct9Frac, Flake);
-        //const double phi = MxFrac;
-        if (BestPhi >= phi) {
-          BestPhi = phi;
-          BestCut = TCutInfo(size, edges, cut);
-          SAtBestPhi = s;
+    TIntV SeedNIdV(Runs, 0);
+    for (int run = 0; run < Runs; run++) { SeedNIdV.Add(Graph->GetRndNId()); }
+    for (int Run0 = 0; Run0 < Runs; Run0 += BlockLen) {
+      const int Block = TMath::Mn(BlockLen, Runs-Run0);
+#ifdef USE_OPENMP
+      #pragma omp parallel for schedule(dynamic, 1)
+#endif
+      for (int b = 0; b < Block; b++) {
+#ifdef USE_OPENMP
+        TLocClust& ThClust = ClustV[omp_get_thread_num()];
+#else
+        TLocClust& ThClust = ClustV[0];
+#endif
+        ThClust.FindBestCut(SeedNIdV[Run0+b], K, SizeFrac);
+        ThClust.SwapSweep(SweepV[b]);
+      }
+      for (int b = 0; b < Block; b++) {
+        const int run = Run0+b;
+        const TLocClust& Clust = SweepV[b];
+        const int SeedNId = SeedNIdV[run];  IterTm.Tick();
+        const int Sz = Clust.BestCutNodes();
+        const int Vol = Clust.GetCutVol();
+        const double Phi = TMath::Round(Clust.GetCutPhi(), 4);
+        if (Sz == 0 || Vol == 0 || Phi == 0) { continue; }
+        MeanSz+=Sz;  MeanVol+=Vol;  Count+= 1;
+        if (SaveAllSweeps) { // save the full cut set and conductances for all trials
+          SweepsV.Add(TNodeSweep(SeedNId, Clust.GetNIdV(), Clust.GetPhiV())); }
+        int SAtBestPhi=-1;
+        for (int s = 0; s < Clust.Len(); s++) {
+          const int size = s+1;
+          const int cut = Clust.GetCut(s);
+          const int edges = (Clust.GetVol(s)-cut)/2;
+          const double phi = Clust.GetPhi(s);
+          if (( Clust.GetPhi(s) != double(cut)/double(2*edges+cut))) { continue; } // more than half of the edges
+          IAssert((Clust.GetVol(s) - cut) % 2 == 0);
+          IAssert(phi == double(cut)/double(2*edges+cut));
+          IAssert(phi >= 1.0/double((1+s)*s+1));
+          //// If we want to take pieces that minimize some other community goodness measure
+          // TCutInfo CutInfo(size, edges, cut); Clust.GetNIdV().GetSubValV(0, size-1, CutInfo.CutNIdV);
+          //double MxFrac=0, AvgFrac=0, MedianFrac=0, Pct9Frac=0, Flake=0;
+          //CutInfo.GetFracDegOut(Graph, MxFrac, AvgFrac, MedianFrac, Pct9Frac, Flake);
+          //const double phi = MxFrac;
+          if (BestPhi >= phi) {
+            BestPhi = phi;
+            BestCut = TCutInfo(size, edges, cut);
+            SAtBestPhi = s;
+          }
+          //// If we want to take pieces that minimize some other community goodness measure
+          //bool TAKE=false;  if (! BestCutH.IsKey(size)) { TAKE=true; }
+          //else { BestCutH.GetDat(size).GetFracDegOut(Graph, MxFrac, AvgFrac, MedianFrac, Pct9Frac, Flake);  if (MxFrac >= phi) { TAKE = true; } }
+          // if (TAKE) {
+          if (! BestCutH.IsKey(size) || BestCutH.GetDat(size).GetPhi() >= phi) { //new best cut (size, edges inside and nodes)
+            BestCutH.AddDat(size, TCutInfo(size, edges, cut));  // for every size store best cut (NIds inside the cut)
+            if (SaveBestNodesAtK) { // store node ids in best community for each size k
+              if (! SizeBucketSet.Empty() && ! SizeBucketSet.IsKey(size)) { continue; } // only save best clusters at SizeBucketSet
+              Clust.GetNIdV().GetSubValV(0, size-1, BestCutH.GetDat(size).CutNIdV); }
+          }
+          if (SaveAllCond) { // for every size store all conductances
+            SizePhiH.AddDat(size).Add(phi); }
         }
-        //// If we want to take pieces that minimize some other community goodness measure
-        //bool TAKE=false;  if (! BestCutH.IsKey(size)) { TAKE=true; }
-        //else { BestCutH.GetDat(size).GetFracDegOut(Graph, MxFrac, AvgFrac, MedianFrac, Pct9Frac, Flake);  if (MxFrac >= phi) { TAKE = true; } }
-        // if (TAKE) {
-        if (! BestCutH.IsKey(size) || BestCutH.GetDat(size).GetPhi() >= phi) { //new best cut (size, edges inside and nodes)
-          BestCutH.AddDat(size, TCutInfo(size, edges, cut));  // for every size store best cut (NIds inside the cut)
-          if (SaveBestNodesAtK) { // store node ids in best community for each size k
-            if (! SizeBucketSet.Empty() && ! SizeBucketSet.IsKey(size)) { continue; } // only save best clusters at SizeBucketSet
-            Clust.GetNIdV().GetSubValV(0, size-1, BestCutH.GetDat(size).CutNIdV); }
+        if (SAtBestPhi != -1) { // take nodes in best cluster
+          const int size = SAtBestPhi+1;
+          Clust.GetNIdV().GetSubValV(0, size-1, BestCut.CutNIdV); 
+        }
+        if (TLocClust::Verbose) {
+          printf(".");
+          if (run % 50 == 0) {
+            printf("\r                                                   %d / %d \r", run, Runs); }
         }
-        if (SaveAllCond) { // for every size store all conductances
-          SizePhiH.AddDat(size).Add(phi); }
-      }
-      if (SAtBestPhi != -1) { // take nodes in best cluster
-        const int size = SAtBestPhi+1;
-        Clust.GetNIdV().GetSubValV(0, size-1, BestCut.CutNIdV); 
-      }
-      if (TLocClust::Verbose) {
-        printf(".");
-        if (run % 50 == 0) {
-          printf("\r                                                   %d / %d \r", run, Runs); }
       }
     }
     if (TLocClust::Verbose) {
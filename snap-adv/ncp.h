@@ -12,10 +12,26 @@ class TNcpGraphsBase;
 class TLocClust {
 public:
   static bool Verbose;
+private:
+  // dense copy of the graph, read only and shared by the copies of the object
+  class TDenseGraph {
+  private:
+    TCRef CRef;
+  public:
+    TIntH NIdIdxH;         // node id to dense node index
+    TIntV IdxNIdV, DegV;   // node id and degree of each dense node index
+    TIntV AdjOffV, AdjV;   // neighbors of node index i are AdjV[AdjOffV[i]...AdjOffV[i+1]-1]
+  public:
+    TDenseGraph(const PUNGraph& Graph);
+    friend class TPt<TDenseGraph>;
+  };
 private:
   PUNGraph Graph;
   int Nodes, Edges2;       // Nodes, 2*edges in Graph
-  TIntFltH ProbH, ResH;
+  TPt<TDenseGraph> DenseG;
+  TFltV ProbV, ResV;       // PageRank score and residual of each node index (zero outside of the last run)
+  TIntV SupV, ResIdxV;     // support of the PageRank vector (in sweep order), indices with a residual (for a sparse reset)
+  TIntV RankV;             // position of the node index in SupV, -1 outside the support
   TIntQ NodeQ;
   double Alpha;            // PageRank jump probability (smaller Alpha diffuses the mass farther away)
   int SeedNId;             // Seed node
@@ -24,8 +40,9 @@ private:
   TFltV PhiV;              // Conductance
   int BestCutIdx;          // Index K to vectors where the conductance of the bounding cut (PhiV[K]) achieves its minimum
 public:
-  TLocClust(const PUNGraph& GraphPt, const double& AlphaVal) :
-    Graph(GraphPt), Nodes(GraphPt->GetNodes()), Edges2(2*GraphPt->GetEdges()), Alpha(AlphaVal) { }
+  /// Creates an empty object that only holds the sweep of another object, see SwapSweep().
+  TLocClust() : Nodes(0), Edges2(0), Alpha(0), SeedNId(-1), BestCutIdx(-1) { }
+  TLocClust(const PUNGraph& GraphPt, const double& AlphaVal);
   /// Returns the support of the approximate random walk, the number of nodes with non-zero PageRank score.   
   int Len() const { return GetRndWalkSup(); }
   /// Returns the support of the approximate random walk, the number of nodes with non-zero PageRank score.
@@ -66,6 +83,8 @@ public:
   void SupportSweep();
   /// Finds minimum conductance cut in the graph around the seed node. ##TLocClust::FindBestCut
   void FindBestCut(const int& SeedNode, const int& ClustSz, const double& MinSizeFrac=0.2);
+  /// Exchanges the seed, the sweep vectors and the best cut with Clust. ##TLocClust::SwapSweep
+  void SwapSweep(TLocClust& Clust);
 
   /// Plots the cluster volume vs. cluster size K (cluster is composed of nodes NIdV[1...K]).
   void PlotVolDistr(const TStr& OutFNm, TStr Desc=TStr()) const;
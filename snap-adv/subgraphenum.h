@@ -62,18 +62,29 @@ private:
 	int m_nodes;
 	int m_subGraphSz;
 	TGraphCounter *m_functor;
+	TIntV m_nbrOffV, m_nbrV; // undirected neighbours of node i are m_nbrV[m_nbrOffV[i]...m_nbrOffV[i+1]-1]
 private:
 	void GetSubGraphs_recursive(TSVec &sg, const TSSet &sgNbrs, TSSet &ext, int vId);
 	void GetSubGraphs_recursive(TSVec &sg, const TSSet &sgNbrs, TSSet &ext);
+	void GetSubGraphsMP_root(TGraphCounter &Counter, int vId, TIntV &sg, TVec<TIntV> &extV, TIntV &nbrCntV, const TFltV &probV, TRnd &rnd);
+	void GetSubGraphsMP_recursive(TGraphCounter &Counter, int level, int vId, TIntV &sg, TVec<TIntV> &extV, TIntV &nbrCntV, const TFltV &probV, TRnd &rnd);
 public: 
   TSubGraphEnum() { }
 	//Graph must be normalized (vertex ids are 0,1,2,...)
 	void GetSubGraphs(PNGraph &Graph, int SubGraphSz, TGraphCounter& Counter);
 	void GetSubGraphs(PNGraph &Graph, int NId, int SubGraphSz, TGraphCounter& Counter);
+	//Same as GetSubGraphs() but the roots are enumerated in parallel, each thread counts into
+	//its own copy of Counter (cleared with Clr()) and the copies are merged into Counter with Add()
+	void GetSubGraphsMP(PNGraph &Graph, int SubGraphSz, TGraphCounter& Counter);
+	//Rand-ESU sampling: a node at depth d of the enumeration tree is visited with probability ProbV[d-1],
+	//so each subgraph is counted with probability GetSampleProb(ProbV) and counts divided by it are unbiased
+	void GetSubGraphsMP(PNGraph &Graph, int SubGraphSz, TGraphCounter& Counter, const TFltV &ProbV, const int &Seed=1);
+	static double GetSampleProb(const TFltV &ProbV);
 };
 // TGraphCounter must implement 
 // void operator()(const PNGraph &G, const TIntV &SubGraphNIdV);
 // which gets called whenever a new subgraph on nodes in SubGraphNIdV is identified
+// GetSubGraphsMP() also needs a copy constructor, void Clr() and void Add(const TGraphCounter &Counter)
 
 /////////////////////////////////////////////////
 // TSubGraphEnum implementation
@@ -194,5 +205,120 @@ void TSubGraphEnum<TGraphCounter>::GetSubGraphs(PNGraph &Graph, int NId, int Sub
 	printf("secs: %llf\n", extime.GetSecs());
 }
 
+/////////////////////////////////////////////////
+// TSubGraphEnum parallel implementation
+//
+// ESU recursion on the undirected neighbours of the nodes. NbrCntV[u] counts the nodes
+// of the current subgraph whose closed neighbourhood contains u, so u is an exclusive
+// neighbour of a new node w exactly when NbrCntV[u] is zero.
+template <class TGraphCounter>
+void TSubGraphEnum<TGraphCounter>::GetSubGraphsMP_recursive(TGraphCounter &Counter, int level, int vId, TIntV &sg, TVec<TIntV> &extV, TIntV &nbrCntV, const TFltV &probV, TRnd &rnd) {
+	if(level+1 == m_subGraphSz) { Counter(m_graph, sg); return; }
+	//
+	TIntV &ext = extV[level];
+	TIntV &newExt = extV[level+1];
+	while(! ext.Empty()) {
+		const int wId = ext.Last();
+		ext.DelLast();
+		if(! probV.Empty() && rnd.GetUniDev() >= probV[level+1]) continue;
+		//
+		newExt = ext;
+		nbrCntV[wId]++;
+		for(int j=m_nbrOffV[wId]; j<m_nbrOffV[wId+1]; j++) {
+			const int nbrId = m_nbrV[j];
+			if(nbrCntV[nbrId] == 0 && nbrId > vId) newExt.Add(nbrId);
+			nbrCntV[nbrId]++;
+		}
+		sg[level+1] = wId;
+		GetSubGraphsMP_recursive(Counter, level+1, vId, sg, extV, nbrCntV, probV, rnd);
+		sg[level+1] = -1;
+		nbrCntV[wId]--;
+		for(int j=m_nbrOffV[wId]; j<m_nbrOffV[wId+1]; j++) nbrCntV[m_nbrV[j]]--;
+	}
+}
+
+template <class TGraphCounter>
+void TSubGraphEnum<TGraphCounter>::GetSubGraphsMP_root(TGraphCounter &Counter, int vId, TIntV &sg, TVec<TIntV> &extV, TIntV &nbrCntV, const TFltV &probV, TRnd &rnd) {
+	if(! probV.Empty() && rnd.GetUniDev() >= probV[0]) return;
+	//
+	TIntV &ext = extV[0];
+	ext.Clr(false);
+	nbrCntV[vId]++;
+	for(int j=m_nbrOffV[vId]; j<m_nbrOffV[vId+1]; j++) {
+		const int nbrId = m_nbrV[j];
+		if(nbrId > vId) ext.Add(nbrId);
+		nbrCntV[nbrId]++;
+	}
+	sg[0] = vId;
+	GetSubGraphsMP_recursive(Counter, 0, vId, sg, extV, nbrCntV, probV, rnd);
+	sg[0] = -1;
+	nbrCntV[vId]--;
+	for(int j=m_nbrOffV[vId]; j<m_nbrOffV[vId+1]; j++) nbrCntV[m_nbrV[j]]--;
+}
+
+template <class TGraphCounter>
+void TSubGraphEnum<TGraphCounter>::GetSubGraphsMP(PNGraph &Graph, int SubGraphSz, TGraphCounter &Counter) {
+	GetSubGraphsMP(Graph, SubGraphSz, Counter, TFltV());
+}
+
+template <class TGraphCounter>
+void TSubGraphEnum<TGraphCounter>::GetSubGraphsMP(PNGraph &Graph, int SubGraphSz, TGraphCounter &Counter, const TFltV &ProbV, const int &Seed) {
+	IAssert(SubGraphSz >= 1);
+	IAssert(ProbV.Empty() || ProbV.Len() == SubGraphSz);
+	IAssert(Seed > 0);
+	m_graph = Graph;
+	m_nodes = m_graph->GetMxNId();
+	m_subGraphSz = SubGraphSz;
+	m_functor = &Counter;
+	//undirected neighbours without self loops, in and out neighbours are sorted
+	m_nbrOffV.Gen(m_nodes+1);  m_nbrOffV.PutAll(0);
+	m_nbrV.Gen(m_graph->GetEdges()*2, 0);
+	for(int vId=0; vId<m_nodes; vId++) {
+		m_nbrOffV[vId] = m_nbrV.Len();
+		if(! m_graph->IsNode(vId)) continue;
+		const TNGraph::TNodeI it = m_graph->GetNI(vId);
+		int i=0, o=0;
+		while(i < it.GetInDeg() || o < it.GetOutDeg()) {
+			int nbrId;
+			if(o == it.GetOutDeg() || (i < it.GetInDeg() && it.GetInNId(i) < it.GetOutNId(o))) { nbrId = it.GetInNId(i++); }
+			else if(i == it.GetInDeg() || it.GetOutNId(o) < it.GetInNId(i)) { nbrId = it.GetOutNId(o++); }
+			else { nbrId = it.GetInNId(i++); o++; }
+			if(nbrId != vId) m_nbrV.Add(nbrId);
+		}
+	}
+	m_nbrOffV[m_nodes] = m_nbrV.Len();
+	//
+	Counter.Clr();
+	const int nodes = m_nodes;
+#ifdef USE_OPENMP
+	#pragma omp parallel
+#endif
+	{
+		TGraphCounter thCounter(Counter);
+		TIntV sg(SubGraphSz), nbrCntV(nodes);
+		TVec<TIntV> extV(SubGraphSz);
+		TRnd rnd;
+		sg.PutAll(-1);  nbrCntV.PutAll(0);
+#ifdef USE_OPENMP
+		#pragma omp for schedule(dynamic, 16)
+#endif
+		for(int vId=0; vId<nodes; vId++) {
+			if(m_nbrOffV[vId] == m_nbrOffV[vId+1] && SubGraphSz > 1) continue;
+			if(! ProbV.Empty()) rnd.PutSeed(TPairHashImpl2::GetHashCd(Seed, vId)+1);
+			GetSubGraphsMP_root(thCounter, vId, sg, extV, nbrCntV, ProbV, rnd);
+		}
+#ifdef USE_OPENMP
+		#pragma omp critical (TSubGraphEnum)
+#endif
+		Counter.Add(thCounter);
+	}
+}
+
+template <class TGraphCounter>
+double TSubGraphEnum<TGraphCounter>::GetSampleProb(const TFltV &ProbV) {
+	double prob = 1.0;
+	for(int i=0; i<ProbV.Len(); i++) prob *= ProbV[i];
+	return prob;
+}
 
 #endif
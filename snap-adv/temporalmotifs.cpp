@@ -562,6 +562,231 @@ void TempMotifCounter::Count3TEdgeTriads(double delta, Counter3D& counts) {
   }
 }
 
+///////////////////////////////////////////////////////////////////////////////
+// Streaming sliding-window motif counter
+namespace {
+int GetNbrCount(const THash<TIntPr, TInt>& nbr_counts, int nbr, int dir) {
+  const int key_id = nbr_counts.GetKeyId(TIntPr(nbr, dir));
+  return key_id == -1 ? 0 : nbr_counts[key_id].Val;
+}
+}
+
+TempMotifStreamCounter::TempMotifStreamCounter(double window, double delta) :
+    window_(window), delta_(delta < 0 ? window : delta) {
+  Clr();
+}
+
+void TempMotifStreamCounter::Clr() {
+  last_tim_ = TInt::Mn;
+  counts_ = Counter2D(6, 6);
+  srcs_.Clr();
+  dsts_.Clr();
+  tims_.Clr();
+  first_seq_ = 0;
+  head_ = 0;
+  node_events_.Clr();
+  node_heads_.Clr();
+}
+
+void TempMotifStreamCounter::AddEdge(int src, int dst, int tim) {
+  AdvanceTime(tim);
+  // Do not include self loops as they do not appear in the definition of
+  // temporal motifs.
+  if (src == dst) { return; }
+  const int64 seq = first_seq_ + srcs_.Len();
+  srcs_.Add(src);
+  dsts_.Add(dst);
+  tims_.Add(tim);
+  node_events_.AddDat(src).Add(seq);
+  node_events_.AddDat(dst).Add(seq);
+  node_heads_.AddDat(src);
+  node_heads_.AddDat(dst);
+  UpdateCounts(seq, true, 1);
+}
+
+void TempMotifStreamCounter::AdvanceTime(int tim) {
+  if (tim < last_tim_) {
+    TExcept::Throw("Temporal edges must arrive in non-decreasing time order.");
+  }
+  last_tim_ = tim;
+  while (head_ < tims_.Len() && double(tims_[head_]) + window_ < double(tim)) {
+    UpdateCounts(first_seq_ + head_, false, -1);
+    PopEdge();
+  }
+}
+
+void TempMotifStreamCounter::PopEdge() {
+  const int64 seq = first_seq_ + head_;
+  const int nodes[2] = {srcs_[head_], dsts_[head_]};
+  for (int i = 0; i < 2; i++) {
+    const int key_id = node_events_.GetKeyId(nodes[i]);
+    TVec<TInt64>& events = node_events_[key_id];
+    TInt& node_head = node_heads_.GetDat(nodes[i]);
+    IAssert(events[node_head] == seq);
+    node_head++;
+    if (node_head == events.Len()) {
+      node_events_.DelKeyId(key_id);
+      node_heads_.DelKey(nodes[i]);
+    } else if (node_head > 16 && 2 * node_head > events.Len()) {
+      events.Del(0, node_head - 1);
+      node_head = 0;
+    }
+  }
+  head_++;
+  // Drop the expired prefix once it makes up most of the buffer
+  if (head_ == srcs_.Len() || (head_ > 1024 && 2 * head_ > srcs_.Len())) {
+    srcs_.Del(0, head_ - 1);
+    dsts_.Del(0, head_ - 1);
+    tims_.Del(0, head_ - 1);
+    first_seq_ += head_;
+    head_ = 0;
+  }
+}
+
+void TempMotifStreamCounter::GetAdjacentEvents(int node, int64 seq,
+                                               bool is_last,
+                                               TVec<TInt64>& seqs,
+                                               TVec<StarEdgeData>& events) {
+  seqs.Clr(false);
+  events.Clr(false);
+  const TVec<TInt64>& node_seqs = node_events_.GetDat(node);
+  const double tim = tims_[int(seq - first_seq_)];
+  int begin = node_heads_.GetDat(node);
+  int end = node_seqs.Len();
+  if (is_last) {
+    // The edge is the newest one, take the edges at most delta before it
+    IAssert(node_seqs[end - 1] == seq);
+    end--;
+    begin = end;
+    while (begin > node_heads_.GetDat(node) &&
+           double(tims_[int(node_seqs[begin - 1] - first_seq_)]) + delta_ >= tim) {
+      begin--;
+    }
+  } else {
+    // The edge is the oldest one, take the edges at most delta after it
+    IAssert(node_seqs[begin] == seq);
+    begin++;
+    int last = begin;
+    while (last < end &&
+           double(tims_[int(node_seqs[last] - first_seq_)]) <= tim + delta_) {
+      last++;
+    }
+    end = last;
+  }
+  for (int i = begin; i < end; i++) {
+    const int index = int(node_seqs[i] - first_seq_);
+    seqs.Add(node_seqs[i]);
+    if (srcs_[index] == node) {
+      events.Add(StarEdgeData(dsts_[index], 0));
+    } else {
+      events.Add(StarEdgeData(srcs_[index], 1));
+    }
+  }
+}
+
+void TempMotifStreamCounter::UpdateCounts(int64 seq, bool is_last, int sign) {
+  const int index = int(seq - first_seq_);
+  const int x = srcs_[index];
+  const int y = dsts_[index];
+  // Counts of the ordered pairs formed by the other two edges of an instance.
+  // The first two indices give the static edge of each: 0 for {x, y}, 1 for
+  // {x, w} and 2 for {y, w}, where w is the third node.  The last two give the
+  // directions (0 outgoing, 1 incoming) relative to x, x and y, respectively.
+  uint64 pairs[3][3][2][2];
+  memset(pairs, 0, sizeof(pairs));
+  TVec<TInt64> seqs[2];
+  TVec<StarEdgeData> events[2];
+  for (int side = 0; side < 2; side++) {
+    const int node = side == 0 ? x : y;
+    const int other = side == 0 ? y : x;
+    const int key = side + 1;
+    GetAdjacentEvents(node, seq, is_last, seqs[side], events[side]);
+    // Edges seen so far on {x, y} and on {node, w} for all w
+    uint64 edge_seen[2] = {0, 0};
+    uint64 nbr_seen[2] = {0, 0};
+    THash<TIntPr, TInt> nbr_counts;
+    for (int i = 0; i < events[side].Len(); i++) {
+      const int nbr = events[side][i].nbr;
+      const int dir = events[side][i].dir;
+      if (nbr == other) {
+        const int xy_dir = side == 0 ? dir : 1 - dir;
+        for (int d = 0; d < 2; d++) {
+          // Both end points see the edges on {x, y}; count those pairs once.
+          if (side == 0) { pairs[0][0][d][xy_dir] += edge_seen[d]; }
+          pairs[key][0][d][xy_dir] += nbr_seen[d];
+        }
+        edge_seen[xy_dir]++;
+      } else {
+        for (int d = 0; d < 2; d++) {
+          pairs[0][key][d][dir] += edge_seen[d];
+          pairs[key][key][d][dir] += GetNbrCount(nbr_counts, nbr, d);
+        }
+        nbr_counts.AddDat(TIntPr(nbr, dir))++;
+        nbr_seen[dir]++;
+      }
+    }
+  }
+
+  // Triangles pair an edge on {x, w} with an edge on {y, w}, so merge the
+  // events of both end points in time order.
+  THash<TIntPr, TInt> nbr_counts[2];
+  int pos[2] = {0, 0};
+  while (pos[0] < events[0].Len() || pos[1] < events[1].Len()) {
+    const int side = (pos[1] == events[1].Len() ||
+                      (pos[0] < events[0].Len() &&
+                       seqs[0][pos[0]] < seqs[1][pos[1]])) ? 0 : 1;
+    const StarEdgeData& event = events[side][pos[side]++];
+    if (event.nbr == (side == 0 ? y : x)) { continue; }
+    for (int d = 0; d < 2; d++) {
+      pairs[2 - side][side + 1][d][event.dir] +=
+        GetNbrCount(nbr_counts[1 - side], event.nbr, d);
+    }
+    nbr_counts[side].AddDat(TIntPr(event.nbr, event.dir))++;
+  }
+
+  // Any id other than x and y stands in for the third node
+  int w = -1;
+  while (w == x || w == y) { w--; }
+  const int ends[3][2] = {{x, y}, {x, w}, {y, w}};
+  for (int a = 0; a < 3; a++) {
+    for (int b = 0; b < 3; b++) {
+      for (int da = 0; da < 2; da++) {
+        for (int db = 0; db < 2; db++) {
+          const uint64 count = pairs[a][b][da][db];
+          if (count == 0) { continue; }
+          const int s1 = ends[a][da], d1 = ends[a][1 - da];
+          const int s2 = ends[b][db], d2 = ends[b][1 - db];
+          if (is_last) {
+            AddMotif(s1, d1, s2, d2, x, y, count, sign);
+          } else {
+            AddMotif(x, y, s1, d1, s2, d2, count, sign);
+          }
+        }
+      }
+    }
+  }
+}
+
+void TempMotifStreamCounter::AddMotif(int s1, int d1, int s2, int d2,
+                                      int s3, int d3, uint64 count, int sign) {
+  // With the nodes labeled 0 (s1), 1 (d1) and 2 (third node), motif M_{i,j}
+  // has second edge 2 --> 1, 1 --> 2, 2 --> 0, 0 --> 2, 1 --> 0, 0 --> 1 for
+  // i = 0, ..., 5 and third edge 0 --> 1, 1 --> 0, 0 --> 2, 2 --> 0, 1 --> 2,
+  // 2 --> 1 for j = 0, ..., 5.
+  static const int edge_codes[3][3] = {{-1, 0, 2}, {1, -1, 4}, {3, 5, -1}};
+  const int s2_label = s2 == s1 ? 0 : (s2 == d1 ? 1 : 2);
+  const int d2_label = d2 == s1 ? 0 : (d2 == d1 ? 1 : 2);
+  const int s3_label = s3 == s1 ? 0 : (s3 == d1 ? 1 : 2);
+  const int d3_label = d3 == s1 ? 0 : (d3 == d1 ? 1 : 2);
+  const int i = 5 - edge_codes[s2_label][d2_label];
+  const int j = edge_codes[s3_label][d3_label];
+  if (sign > 0) {
+    counts_(i, j) += count;
+  } else {
+    counts_(i, j) -= count;
+  }
+}
+
 ///////////////////////////////////////////////////////////////////////////////
 // Generic three temporal edge motif counter
 void ThreeTEdgeMotifCounter::Count(const TIntV& event_string, const TIntV& timestamps,
@@ -190,6 +190,70 @@ class TempMotifCounter {
   TVec< THash<TInt, TIntV> > temporal_data_;
 };
 
+// Streaming counterpart of TempMotifCounter::Count3TEdge23Node().  Temporal
+// edges arrive one at a time in non-decreasing timestamp order and the class
+// maintains the counts of all 3-edge, {2,3}-node delta-temporal motifs among
+// the edges of a sliding time window: an edge with timestamp t stays in the
+// window until the stream reaches a time greater than t + window.  Adding or
+// expiring an edge only visits the edges adjacent to its end points that lie
+// within delta of it, so the counts can be read at any point of the stream.
+// Edges with equal timestamps are ordered by arrival, while the batch counter
+// orders them by their role in the motif, so with ties only the totals of the
+// two-node, star and triangle motifs agree with Count3TEdge23Node().
+class TempMotifStreamCounter {
+ public:
+  // Constructs an empty counter with the given window width.  Motif instances
+  // must span at most delta time units; a negative delta uses the window.
+  TempMotifStreamCounter(double window, double delta=-1);
+
+  // Adds the temporal edge src --> dst at time tim, expiring all edges that
+  // fall out of the window first.  Self loops are ignored.
+  void AddEdge(int src, int dst, int tim);
+  // Moves the window to end at time tim without adding an edge.
+  void AdvanceTime(int tim);
+  // Removes all edges and resets the counts.
+  void Clr();
+
+  // Fills counts with the motif counts of the current window in the format of
+  // TempMotifCounter::Count3TEdge23Node().
+  void GetCounts(Counter2D& counts) const { counts = counts_; }
+  // Returns the number of temporal edges in the current window.
+  int GetEdges() const { return srcs_.Len() - head_; }
+  double GetWindow() const { return window_; }
+  double GetDelta() const { return delta_; }
+
+ private:
+  // Adds (sign = 1) or removes (sign = -1) all motif instances that contain the
+  // edge with sequence number seq as their last (is_last) or first edge.
+  void UpdateCounts(int64 seq, bool is_last, int sign);
+  // Gathers the edges adjacent to node that can form a motif instance with the
+  // edge seq, in time order.  Directions are relative to node.
+  void GetAdjacentEvents(int node, int64 seq, bool is_last,
+                         TVec<TInt64>& seqs, TVec<StarEdgeData>& events);
+  // Adds count instances of the ordered temporal edges (s1, d1), (s2, d2),
+  // (s3, d3) to the motif counts.
+  void AddMotif(int s1, int d1, int s2, int d2, int s3, int d3,
+                uint64 count, int sign);
+  // Removes the oldest edge in the window.
+  void PopEdge();
+
+  double window_;
+  double delta_;
+  int last_tim_;
+  Counter2D counts_;
+  // Edges in the window by arrival; entry i has sequence number first_seq_ + i
+  // and entries before head_ have already expired.
+  TIntV srcs_;
+  TIntV dsts_;
+  TIntV tims_;
+  int64 first_seq_;
+  int head_;
+  // Sequence numbers of the edges adjacent to each node, in arrival order,
+  // with the expired prefix length kept in node_heads_.
+  THash<TInt, TVec<TInt64> > node_events_;
+  THash<TInt, TInt> node_heads_;
+};
+
 // This class exhaustively counts all size^3 three-edge temporal motifs in an
 // alphabet of a given size.
 class ThreeTEdgeMotifCounter {
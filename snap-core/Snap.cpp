@@ -27,6 +27,7 @@
 
 // algorithms
 #include "subgraph.cpp"      // subgraph manipulations
+#include "reorder.cpp"       // node reordering for cache locality
 #include "anf.cpp"           // approximate diameter calculation
 #include "cncom.cpp"         // connected components
 #include "alg.cpp"           // misc graph algorithms
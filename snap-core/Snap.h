@@ -30,6 +30,7 @@
 
 // algorithms
 #include "subgraph.h"        // subgraph manipulations
+#include "reorder.h"         // node reordering for cache locality
 #include "anf.h"             // approximate diameter calculation
 #include "bfsdfs.h"          // breadth and depth first search
 #include "cncom.h"           // connected components
@@ -394,13 +394,12 @@ TIntH MaxCPGreedyBetter3(const PUNGraph& Graph, const int k) {
 
 //Weighted PageRank
 int GetWeightedPageRank(const PNEANet Graph, TIntFltH& PRankH, const TStr& Attr, const double& C, const double& Eps, const int& MaxIter) {
-  if (!Graph->IsFltAttrE(Attr)) return -1;
-
-  TFltV Weights = Graph->GetFltAttrVecE(Attr);
+  const TNEANet::TFltAttrHnd WeightH = Graph->GetFltAttrHndE(Attr);
+  if (WeightH.Empty()) return -1;
 
   int mxid = Graph->GetMxNId();
   TFltV OutWeights(mxid);
-  Graph->GetWeightOutEdgesV(OutWeights, Weights);
+  Graph->GetWeightOutEdgesV(OutWeights, WeightH);
 
   const int NNodes = Graph->GetNodes();
   //const double OneOver = 1.0/double(NNodes);
@@ -415,10 +414,10 @@ int GetWeightedPageRank(const PNEANet Graph, TIntFltH& PRankH, const TStr& Attr,
     for (TNEANet::TNodeI NI = Graph->BegNI(); NI < Graph->EndNI(); NI++, j++) {
       TmpV[j] = 0;
       for (int e = 0; e < NI.GetInDeg(); e++) {
-        const int InNId = NI.GetInNId(e);
+        const TNEANet::TEdgeI EI = Graph->GetEI(NI.GetInEId(e));
+        const int InNId = EI.GetSrcNId();
         const TFlt OutWeight = OutWeights[InNId];
-        int EId = Graph->GetEId(InNId, NI.GetId());
-        const TFlt Weight = Weights[Graph->GetFltKeyIdE(EId)];
+        const TFlt Weight = WeightH.GetDat(EI);
         if (OutWeight > 0) {
           TmpV[j] += PRankH.GetDat(InNId) * Weight / OutWeight; }
       }
@@ -441,7 +440,8 @@ int GetWeightedPageRank(const PNEANet Graph, TIntFltH& PRankH, const TStr& Attr,
 
 #ifdef USE_OPENMP
 int GetWeightedPageRankMP(const PNEANet Graph, TIntFltH& PRankH, const TStr& Attr, const double& C, const double& Eps, const int& MaxIter) {
-  if (!Graph->IsFltAttrE(Attr)) return -1;
+  const TNEANet::TFltAttrHnd WeightH = Graph->GetFltAttrHndE(Attr);
+  if (WeightH.Empty()) return -1;
   const int NNodes = Graph->GetNodes();
   TVec<TNEANet::TNodeI> NV;
 
@@ -461,13 +461,15 @@ int GetWeightedPageRankMP(const PNEANet Graph, TIntFltH& PRankH, const TStr& Att
   TFltV PRankV(MxId+1);
   TFltV OutWeights(MxId+1);
 
-  TFltV Weights = Graph->GetFltAttrVecE(Attr);
-
   #pragma omp parallel for schedule(dynamic,10000)
   for (int j = 0; j < NNodes; j++) {
     TNEANet::TNodeI NI = NV[j];
     int Id = NI.GetId();
-    OutWeights[Id] = Graph->GetWeightOutEdges(NI, Attr);
+    TFlt OutWeight = 0;
+    for (int e = 0; e < NI.GetOutDeg(); e++) {
+      OutWeight += WeightH.GetDat(NI.GetOutEId(e));
+    }
+    OutWeights[Id] = OutWeight;
     PRankV[Id] = 1/NNodes;
   }
 
@@ -479,12 +481,12 @@ int GetWeightedPageRankMP(const PNEANet Graph, TIntFltH& PRankH, const TStr& Att
       TNEANet::TNodeI NI = NV[j];
       TFlt Tmp = 0;
       for (int e = 0; e < NI.GetInDeg(); e++) {
-        const int InNId = NI.GetInNId(e);
+        const TNEANet::TEdgeI EI = Graph->GetEI(NI.GetInEId(e));
+        const int InNId = EI.GetSrcNId();
 
         const TFlt OutWeight = OutWeights[InNId];
 
-        int EId = Graph->GetEId(InNId, NI.GetId());
-        const TFlt Weight = Weights[Graph->GetFltKeyIdE(EId)];
+        const TFlt Weight = WeightH.GetDat(EI);
 
         if (OutWeight > 0) {
           Tmp += PRankH.GetDat(InNId) * Weight / OutWeight;
@@ -551,4 +551,309 @@ PNGraph GenRMatEpinions() {
   return GenRMat(75888, 508837, 0.550, 0.228, 0.212);
 }
 
+namespace TSnapDetail {
+void GetCsrMP(const int& Nodes, const TVec<TInt, int64>& SrcV, const TVec<TInt, int64>& DstV, const bool& SelfLoops, TVec<TInt64>& OffV, TVec<TInt, int64>& NbrV) {
+  const int64 Edges = SrcV.Len();
+  IAssert(DstV.Len() == Edges);
+  // bucket the edges by source node
+  TVec<TInt64> PosV(Nodes+1);
+#ifdef USE_OPENMP
+  #pragma omp parallel for schedule(static)
+#endif
+  for (int64 e = 0; e < Edges; e++) {
+#ifdef USE_OPENMP
+    __sync_fetch_and_add(&PosV[SrcV[e]+1].Val, 1);
+#else
+    PosV[SrcV[e]+1].Val++;
+#endif
+  }
+  for (int n = 0; n < Nodes; n++) { PosV[n+1] += PosV[n]; }
+  TVec<TInt64> FillV(PosV);
+  TVec<TInt, int64> BufV(Edges);
+#ifdef USE_OPENMP
+  #pragma omp parallel for schedule(static)
+#endif
+  for (int64 e = 0; e < Edges; e++) {
+#ifdef USE_OPENMP
+    const int64 Pos = __sync_fetch_and_add(&FillV[SrcV[e]].Val, 1);
+#else
+    const int64 Pos = FillV[SrcV[e]].Val++;
+#endif
+    BufV[Pos] = DstV[e];
+  }
+  // sort each adjacency list, drop duplicates (and self-loops)
+  TVec<TInt64> DegV(Nodes+1);
+#ifdef USE_OPENMP
+  #pragma omp parallel for schedule(dynamic, 10000)
+#endif
+  for (int n = 0; n < Nodes; n++) {
+    const int64 Beg = PosV[n], End = PosV[n+1];
+    if (End - Beg > 1) { BufV.QSort(Beg, End-1, true); }
+    int64 Deg = 0;
+    for (int64 i = Beg; i < End; i++) {
+      if (! SelfLoops && BufV[i] == n) { continue; }
+      if (Deg > 0 && BufV[Beg+Deg-1] == BufV[i]) { continue; }
+      BufV[Beg+Deg] = BufV[i];  Deg++;
+    }
+    DegV[n+1] = Deg;
+  }
+  OffV.Gen(Nodes+1);
+  for (int n = 0; n < Nodes; n++) { OffV[n+1] = OffV[n] + DegV[n+1]; }
+  NbrV.Gen(OffV[Nodes]);
+#ifdef USE_OPENMP
+  #pragma omp parallel for schedule(dynamic, 10000)
+#endif
+  for (int n = 0; n < Nodes; n++) {
+    const int64 Beg = PosV[n], Off = OffV[n];
+    for (int64 i = 0; i < DegV[n+1]; i++) { NbrV[Off+i] = BufV[Beg+i]; }
+  }
+}
+
+void KeepNewCsrEdges(const TVec<TInt64>& OffV, const TVec<TInt, int64>& NbrV, const int64& Beg, const int64& Missing, const bool& IsDir, const bool& SelfLoops, TVec<TInt, int64>& SrcV, TVec<TInt, int64>& DstV) {
+  const int64 Step = IsDir ? 1 : 2;
+  THashSet<TIntPr> NewEdgeH;
+  int64 New = 0, Len = Beg;
+  for (int64 i = Beg; i < SrcV.Len() && New < Missing; i += Step) {
+    const int SrcNId = SrcV[i], DstNId = DstV[i];
+    if (! SelfLoops && SrcNId == DstNId) { continue; }
+    // an undirected edge adds an entry in both directions, a self-loop only one
+    const int64 Add = IsDir || SrcNId == DstNId ? 1 : 2;
+    if (New + Add > Missing) { continue; }
+    const TIntPr Edge = IsDir || SrcNId < DstNId ? TIntPr(SrcNId, DstNId) : TIntPr(DstNId, SrcNId);
+    if (NewEdgeH.IsKey(Edge)) { continue; }
+    int64 Lo = OffV[SrcNId], Hi = OffV[SrcNId+1];
+    while (Lo < Hi) {
+      const int64 Mid = Lo + (Hi-Lo)/2;
+      if (NbrV[Mid] < DstNId) { Lo = Mid+1; } else { Hi = Mid; }
+    }
+    if (Lo < OffV[SrcNId+1] && NbrV[Lo] == DstNId) { continue; }
+    NewEdgeH.AddKey(Edge);  New += Add;
+    for (int64 j = i; j < i+Step; j++) { SrcV[Len] = SrcV[j];  DstV[Len] = DstV[j];  Len++; }
+  }
+  SrcV.Trunc(Len);  DstV.Trunc(Len);
+}
+
+void GetGraphFromCsr(const TVec<TInt64>& OffV, const TVec<TInt, int64>& NbrV, PNGraph& Graph) {
+  const int Nodes = OffV.Len()-1;
+  Graph = TNGraph::New(Nodes, int(NbrV.Len()));
+  TIntV InDegV(Nodes);
+  for (int64 i = 0; i < NbrV.Len(); i++) { InDegV[NbrV[i]]++; }
+  for (int n = 0; n < Nodes; n++) {
+    Graph->AddNode(n);
+    Graph->ReserveNIdOutDeg(n, int(OffV[n+1]-OffV[n]));
+    Graph->ReserveNIdInDeg(n, InDegV[n]);
+  }
+  // adding edges in (source, destination) order keeps all adjacency vectors sorted
+  for (int n = 0; n < Nodes; n++) {
+    for (int64 i = OffV[n]; i < OffV[n+1]; i++) {
+      Graph->AddEdgeUnchecked(n, NbrV[i]); }
+  }
+}
+
+void GetGraphFromCsr(const TVec<TInt64>& OffV, const TVec<TInt, int64>& NbrV, PUNGraph& Graph) {
+  const int Nodes = OffV.Len()-1;
+  Graph = TUNGraph::New(Nodes, int(NbrV.Len()/2));
+  for (int n = 0; n < Nodes; n++) {
+    Graph->AddNode(n);
+    Graph->ReserveNIdDeg(n, int(OffV[n+1]-OffV[n]));
+  }
+  // each undirected edge is added once from its smaller endpoint, which keeps adjacency vectors sorted
+  for (int n = 0; n < Nodes; n++) {
+    for (int64 i = OffV[n]; i < OffV[n+1]; i++) {
+      if (NbrV[i] >= n) { Graph->AddEdgeUnchecked(n, NbrV[i]); }
+    }
+  }
+}
+
+/// Returns the target of edge slot EdgeN in the Barabasi-Albert edge array.
+/// Slot EdgeN copies a uniformly chosen earlier endpoint, so the chain of copies
+/// can be resolved independently for every slot (Sanders and Schulz, 2016).
+int GetPrefAttachDst(const TCtrRnd& Rnd, const int& NodeOutDeg, int64 EdgeN) {
+  forever {
+    const int64 Pos = Rnd.GetUniDevInt64(2*EdgeN+1, EdgeN);
+    if (Pos % 2 == 0) { return int(Pos / 2 / NodeOutDeg); } // source of edge Pos/2
+    EdgeN = Pos / 2; // target of an earlier edge
+  }
+}
+
+/// R-MAT edge by recursive descent, see GenRMat().
+class TRMatEdgeGen {
+private:
+  TCtrRnd Rnd;
+  int Nodes;
+  TFltV SumA, SumAB, SumAC, SumABC;
+public:
+  TRMatEdgeGen(const int& Seed, const int& _Nodes, const double& A, const double& B, const double& C) :
+   Rnd(Seed), Nodes(_Nodes), SumA(128, 0), SumAB(128, 0), SumAC(128, 0), SumABC(128, 0) {
+    const TCtrRnd NoiseRnd(~uint64(Seed));
+    for (int i = 0; i < 128; i++) {
+      const double a = A * (NoiseRnd.GetUniDev(i, 0) + 0.5);
+      const double b = B * (NoiseRnd.GetUniDev(i, 1) + 0.5);
+      const double c = C * (NoiseRnd.GetUniDev(i, 2) + 0.5);
+      const double d = (1.0 - (A+B+C)) * (NoiseRnd.GetUniDev(i, 3) + 0.5);
+      const double abcd = a+b+c+d;
+      SumA.Add(a / abcd);
+      SumAB.Add((a+b) / abcd);
+      SumAC.Add((a+c) / abcd);
+      SumABC.Add((a+b+c) / abcd);
+    }
+  }
+  void operator()(const int64& Ctr, int& SrcNId, int& DstNId) const {
+    int rngX = Nodes, rngY = Nodes, offX = 0, offY = 0;
+    for (int Depth = 0; rngX > 1 || rngY > 1; Depth++) {
+      const double RndProb = Rnd.GetUniDev(Ctr, Depth);
+      if (rngX>1 && rngY>1) {
+        if (RndProb < SumA[Depth]) { rngX/=2; rngY/=2; }
+        else if (RndProb < SumAB[Depth]) { offX+=rngX/2;  rngX-=rngX/2;  rngY/=2; }
+        else if (RndProb < SumABC[Depth]) { offY+=rngY/2;  rngX/=2;  rngY-=rngY/2; }
+        else { offX+=rngX/2;  offY+=rngY/2;  rngX-=rngX/2;  rngY-=rngY/2; }
+      } else
+      if (rngX>1) { // row vector
+        if (RndProb < SumAC[Depth]) { rngX/=2; rngY/=2; }
+        else { offX+=rngX/2;  rngX-=rngX/2;  rngY/=2; }
+      } else { // column vector
+        if (RndProb < SumAB[Depth]) { rngX/=2; rngY/=2; }
+        else { offY+=rngY/2;  rngX/=2;  rngY-=rngY/2; }
+      }
+    }
+    SrcNId = offX;  DstNId = offY;
+  }
+};
+} // namespace TSnapDetail
+
+/// Parallel Barabasi-Albert model. Every node u creates NodeOutDeg edge slots;
+/// the target of a slot is a copy of a uniformly random earlier endpoint
+/// (or u itself), which gives linear preferential attachment. Self-loops and
+/// duplicate edges are dropped, so some nodes get fewer than NodeOutDeg edges.
+/// See: Scalable generation of scale-free graphs, Sanders and Schulz, 2016.
+/// URL: http://arxiv.org/abs/1602.07106
+PUNGraph GenPrefAttachMP(const int& Nodes, const int& NodeOutDeg, const int& Seed) {
+  const TCtrRnd Rnd(Seed);
+  const int64 Slots = int64(Nodes) * NodeOutDeg;
+  TVec<TInt, int64> SrcV(2*Slots), DstV(2*Slots);
+#ifdef USE_OPENMP
+  #pragma omp parallel for schedule(static)
+#endif
+  for (int64 e = 0; e < Slots; e++) {
+    const int SrcNId = int(e / NodeOutDeg);
+    const int DstNId = TSnapDetail::GetPrefAttachDst(Rnd, NodeOutDeg, e);
+    SrcV[2*e] = SrcNId;  DstV[2*e] = DstNId;
+    SrcV[2*e+1] = DstNId;  DstV[2*e+1] = SrcNId;
+  }
+  TVec<TInt64> OffV;
+  TVec<TInt, int64> NbrV;
+  TSnapDetail::GetCsrMP(Nodes, SrcV, DstV, false, OffV, NbrV);
+  PUNGraph Graph;
+  TSnapDetail::GetGraphFromCsr(OffV, NbrV, Graph);
+  return Graph;
+}
+
+/// Parallel Watts-Strogatz model, see GenSmallWorld().
+PUNGraph GenSmallWorldMP(const int& Nodes, const int& NodeOutDeg, const double& RewireProb, const int& Seed) {
+  IAssertR(Nodes > NodeOutDeg, TStr::Fmt("Insufficient nodes for out degree, %d!", NodeOutDeg));
+  const TCtrRnd Rnd(Seed);
+  const int64 Slots = int64(Nodes) * NodeOutDeg;
+  TVec<TInt, int64> SrcV(2*Slots), DstV(2*Slots);
+#ifdef USE_OPENMP
+  #pragma omp parallel for schedule(static)
+#endif
+  for (int64 e = 0; e < Slots; e++) {
+    const int SrcNId = int(e / NodeOutDeg);
+    int DstNId = (SrcNId + int(e % NodeOutDeg) + 1) % Nodes; // edge to next neighbor
+    if (Rnd.GetUniDev(e, 0) < RewireProb) { // random edge
+      for (int Draw = 1; (DstNId = Rnd.GetUniDevInt(Nodes, e, Draw)) == SrcNId; Draw++) { }
+    }
+    SrcV[2*e] = SrcNId;  DstV[2*e] = DstNId;
+    SrcV[2*e+1] = DstNId;  DstV[2*e+1] = SrcNId;
+  }
+  TVec<TInt64> OffV;
+  TVec<TInt, int64> NbrV;
+  TSnapDetail::GetCsrMP(Nodes, SrcV, DstV, false, OffV, NbrV);
+  PUNGraph Graph;
+  TSnapDetail::GetGraphFromCsr(OffV, NbrV, Graph);
+  return Graph;
+}
+
+/// Parallel configuration model. Degree stubs are given random keys, sorted
+/// by key in parallel buckets, and consecutive stubs are paired. Self-loops
+/// and multiple edges are dropped, so the degree sequence is approximate.
+PUNGraph GenConfModelMP(const TIntV& DegSeqV, const int& Seed) {
+  const int Nodes = DegSeqV.Len();
+  const TCtrRnd Rnd(Seed);
+  TVec<TInt64> StubOffV(Nodes+1);
+  for (int n = 0; n < Nodes; n++) { StubOffV[n+1] = StubOffV[n] + DegSeqV[n]; }
+  const int64 Stubs = StubOffV[Nodes];
+  if (Stubs % 2 != 0) { printf("Deg seq is odd [%d], last stub is unmatched.\n", DegSeqV.Len()); }
+  // random permutation of stubs: bucket by the top bits of the key, then sort each bucket
+  const int Buckets = int(TMath::Mx<int64>(1, TMath::Mn<int64>(Stubs / 1024, 1<<20)));
+  TVec<TInt64> BucketOffV(Buckets+1);
+#ifdef USE_OPENMP
+  #pragma omp parallel for schedule(dynamic, 10000)
+#endif
+  for (int n = 0; n < Nodes; n++) {
+    for (int64 s = StubOffV[n]; s < StubOffV[n+1]; s++) {
+      const int Bucket = int(((Rnd.GetUInt64(s) >> 32) * Buckets) >> 32);
+#ifdef USE_OPENMP
+      __sync_fetch_and_add(&BucketOffV[Bucket+1].Val, 1);
+#else
+      BucketOffV[Bucket+1].Val++;
+#endif
+    }
+  }
+  for (int b = 0; b < Buckets; b++) { BucketOffV[b+1] += BucketOffV[b]; }
+  TVec<TInt64> FillV(BucketOffV);
+  TVec<TPair<TUInt64, TInt>, int64> StubV(Stubs);
+#ifdef USE_OPENMP
+  #pragma omp parallel for schedule(dynamic, 10000)
+#endif
+  for (int n = 0; n < Nodes; n++) {
+    for (int64 s = StubOffV[n]; s < StubOffV[n+1]; s++) {
+      const uint64 Key = Rnd.GetUInt64(s);
+      const int Bucket = int(((Key >> 32) * Buckets) >> 32);
+#ifdef USE_OPENMP
+      const int64 Pos = __sync_fetch_and_add(&FillV[Bucket].Val, 1);
+#else
+      const int64 Pos = FillV[Bucket].Val++;
+#endif
+      StubV[Pos] = TPair<TUInt64, TInt>(Key, n);
+    }
+  }
+  // buckets are filled in arbitrary order, sorting makes the result independent of it
+#ifdef USE_OPENMP
+  #pragma omp parallel for schedule(dynamic, 16)
+#endif
+  for (int b = 0; b < Buckets; b++) {
+    if (BucketOffV[b+1] - BucketOffV[b] > 1) { StubV.QSort(BucketOffV[b], BucketOffV[b+1]-1, true); }
+  }
+  const int64 Pairs = Stubs / 2;
+  TVec<TInt, int64> SrcV(2*Pairs), DstV(2*Pairs);
+#ifdef USE_OPENMP
+  #pragma omp parallel for schedule(static)
+#endif
+  for (int64 p = 0; p < Pairs; p++) {
+    const int SrcNId = StubV[2*p].Val2, DstNId = StubV[2*p+1].Val2;
+    SrcV[2*p] = SrcNId;  DstV[2*p] = DstNId;
+    SrcV[2*p+1] = DstNId;  DstV[2*p+1] = SrcNId;
+  }
+  StubV.Clr();
+  TVec<TInt64> OffV;
+  TVec<TInt, int64> NbrV;
+  TSnapDetail::GetCsrMP(Nodes, SrcV, DstV, false, OffV, NbrV);
+  PUNGraph Graph;
+  TSnapDetail::GetGraphFromCsr(OffV, NbrV, Graph);
+  return Graph;
+}
+
+/// Parallel R-MAT generator, see GenRMat(). Edges are drawn in rounds until
+/// Edges distinct non-self-loop edges are found.
+PNGraph GenRMatMP(const int& Nodes, const int& Edges, const double& A, const double& B, const double& C, const int& Seed) {
+  IAssert(A+B+C < 1.0);
+  TVec<TInt64> OffV;
+  TVec<TInt, int64> NbrV;
+  TSnapDetail::GenCsrMP(Nodes, Edges, true, false, TSnapDetail::TRMatEdgeGen(Seed, Nodes, A, B, C), OffV, NbrV);
+  PNGraph Graph;
+  TSnapDetail::GetGraphFromCsr(OffV, NbrV, Graph);
+  return Graph;
+}
+
 } // namespace TSnap
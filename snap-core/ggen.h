@@ -49,6 +49,24 @@ PNGraph GenRMat(const int& Nodes, const int& Edges, const double& A, const doubl
 /// Generates a R-Mat graph, with a synthetic copy of the Epinions social network.
 PNGraph GenRMatEpinions();
 
+/////////////////////////////////////////////////
+// Parallel random graphs
+// Edges are drawn from a counter-based random stream (TCtrRnd) indexed by the
+// edge number, so for a given Seed the generated graph is identical for any
+// number of threads. Edges are generated in chunks, sorted and deduplicated
+// in CSR form, and the graph is built in bulk without IsEdge() checks.
+
+/// Generates an Erdos-Renyi random graph in parallel. PGraph is PUNGraph or PNGraph.
+template <class PGraph> PGraph GenRndGnmMP(const int& Nodes, const int& Edges, const bool& IsDir=true, const int& Seed=1);
+/// Generates a Barabasi-Albert preferential attachment graph in parallel. ##TSnap::GenPrefAttachMP
+PUNGraph GenPrefAttachMP(const int& Nodes, const int& NodeOutDeg, const int& Seed=1);
+/// Generates a Watts-Strogatz small-world graph in parallel. Rewired edges that duplicate an existing edge are dropped.
+PUNGraph GenSmallWorldMP(const int& Nodes, const int& NodeOutDeg, const double& RewireProb, const int& Seed=1);
+/// Generates a configuration model graph in parallel by sorting degree stubs on random keys. Self-loops and multiple edges are dropped.
+PUNGraph GenConfModelMP(const TIntV& DegSeqV, const int& Seed=1);
+/// Generates a R-MAT graph in parallel using recursive descent into a 2x2 matrix [A,B; C, 1-(A+B+C)].
+PNGraph GenRMatMP(const int& Nodes, const int& Edges, const double& A, const double& B, const double& C, const int& Seed=1);
+
   
 /// Rewire a random undirected graph. Keeps node degrees the same, but randomly rewires the edges.
 PUNGraph GenRewire(const PUNGraph& Graph, const int& NSwitch=100, TRnd& Rnd=TInt::Rnd);
@@ -262,6 +280,82 @@ TIntPr GetRndEdgeNonAdjNode(const PGraph& Graph, int NId1, int NId2) {
   return TIntPr(NI1.GetId(), NI2.GetId());
 }
 
+/// Sorts and deduplicates the edges (SrcV[i], DstV[i]) on nodes 0..Nodes-1 into CSR form. ##TSnapDetail::GetCsrMP
+void GetCsrMP(const int& Nodes, const TVec<TInt, int64>& SrcV, const TVec<TInt, int64>& DstV, const bool& SelfLoops, TVec<TInt64>& OffV, TVec<TInt, int64>& NbrV);
+/// Builds a directed graph on nodes 0..OffV.Len()-2 from CSR out-adjacency.
+void GetGraphFromCsr(const TVec<TInt64>& OffV, const TVec<TInt, int64>& NbrV, PNGraph& Graph);
+/// Builds an undirected graph on nodes 0..OffV.Len()-2 from symmetric CSR adjacency.
+void GetGraphFromCsr(const TVec<TInt64>& OffV, const TVec<TInt, int64>& NbrV, PUNGraph& Graph);
+
+/// Keeps the edges drawn from SrcV[Beg] on, in draw order, that add at most Missing new entries to the CSR OffV, NbrV of SrcV[0..Beg-1]. ##TSnapDetail::KeepNewCsrEdges
+void KeepNewCsrEdges(const TVec<TInt64>& OffV, const TVec<TInt, int64>& NbrV, const int64& Beg, const int64& Missing, const bool& IsDir, const bool& SelfLoops, TVec<TInt, int64>& SrcV, TVec<TInt, int64>& DstV);
+
+/// Draws edges from EdgeGen until the deduplicated CSR adjacency has exactly Entries entries. ##TSnapDetail::GenCsrMP
+template <class TEdgeGen>
+void GenCsrMP(const int& Nodes, const int64& Entries, const bool& IsDir, const bool& SelfLoops, const TEdgeGen& EdgeGen, TVec<TInt64>& OffV, TVec<TInt, int64>& NbrV) {
+  IAssertR(Entries <= int64(Nodes) * (SelfLoops ? Nodes : Nodes-1), TStr::Fmt("Not enough nodes (%d), for entries (%.0f).", Nodes, double(Entries)));
+  IAssertR(IsDir || SelfLoops || Entries % 2 == 0, TStr::Fmt("Odd number of undirected entries (%.0f) without self-loops.", double(Entries)));
+  TVec<TInt, int64> SrcV, DstV;
+  TVec<TInt64> NewOffV;
+  TVec<TInt, int64> NewNbrV;
+  OffV.Gen(Nodes+1);  NbrV.Clr();
+  int64 Ctr = 0, Draws = 0, StallDraws = 0;
+  while (NbrV.Len() < Entries) {
+    IAssertR(StallDraws <= 16*Entries+1024, TStr::Fmt("No new edge in %.0f draws, found %.0f of %.0f entries.",
+      double(StallDraws), double(NbrV.Len()), double(Entries)));
+    const int64 Missing = Entries-NbrV.Len();
+    // after a round without new entries the next one draws twice as many edges
+    Draws = StallDraws > 0 ? 2*Draws : (IsDir ? Missing : (Missing+1)/2);
+    const int64 Beg = SrcV.Len();
+    const int64 End = Beg + (IsDir ? Draws : 2*Draws);
+    SrcV.Reserve(End, End);  DstV.Reserve(End, End);
+#ifdef USE_OPENMP
+    #pragma omp parallel for schedule(static)
+#endif
+    for (int64 d = 0; d < Draws; d++) {
+      int SrcNId, DstNId;
+      EdgeGen(Ctr+d, SrcNId, DstNId);
+      const int64 i = IsDir ? Beg+d : Beg+2*d;
+      SrcV[i] = SrcNId;  DstV[i] = DstNId;
+      if (! IsDir) { SrcV[i+1] = DstNId;  DstV[i+1] = SrcNId; }
+    }
+    Ctr += Draws;
+    GetCsrMP(Nodes, SrcV, DstV, SelfLoops, NewOffV, NewNbrV);
+    if (NewNbrV.Len() > Entries) {
+      KeepNewCsrEdges(OffV, NbrV, Beg, Missing, IsDir, SelfLoops, SrcV, DstV);
+      GetCsrMP(Nodes, SrcV, DstV, SelfLoops, NewOffV, NewNbrV);
+    }
+    StallDraws = NewNbrV.Len() > NbrV.Len() ? 0 : StallDraws+Draws;
+    OffV.Swap(NewOffV);  NbrV.Swap(NewNbrV);
+  }
+}
+
+/// Uniform random edge of the G(n,m) model.
+class TGnmEdgeGen {
+private:
+  TCtrRnd Rnd;
+  int Nodes;
+public:
+  TGnmEdgeGen(const TCtrRnd& _Rnd, const int& _Nodes) : Rnd(_Rnd), Nodes(_Nodes) { }
+  void operator()(const int64& Ctr, int& SrcNId, int& DstNId) const {
+    SrcNId = Rnd.GetUniDevInt(Nodes, Ctr, 0);
+    DstNId = Rnd.GetUniDevInt(Nodes, Ctr, 1);
+  }
+};
+
 } // namespace TSnapDetail
 
+template <class PGraph>
+PGraph GenRndGnmMP(const int& Nodes, const int& Edges, const bool& IsDir, const int& Seed) {
+  PGraph GraphPt;
+  const bool IsSym = ! IsDir || ! HasGraphFlag(typename PGraph::TObj, gfDirected);
+  IAssertR((1.0 * (Nodes-1) / 2 * (IsSym ? 1 : 2)) >= (1.0 * Edges / Nodes), TStr::Fmt("Not enough nodes (%d), for edges (%d).", Nodes, Edges));
+  TVec<TInt64> OffV;
+  TVec<TInt, int64> NbrV;
+  TSnapDetail::GenCsrMP(Nodes, IsSym ? 2*int64(Edges) : int64(Edges), ! IsSym, false,
+    TSnapDetail::TGnmEdgeGen(TCtrRnd(Seed), Nodes), OffV, NbrV);
+  TSnapDetail::GetGraphFromCsr(OffV, NbrV, GraphPt);
+  return GraphPt;
+}
+
 }; // namespace TSnap
@@ -151,6 +151,434 @@ void TUNGraphMtx::PMultiplyT(const TFltV& Vec, TFltV& Result) const {
   }
 }
 
+/////////////////////////////////////////////////
+// Compressed Sparse Row Matrix
+void TCsrMtx::GenRows(const TIntV& RowLenV) {
+  RowStartV.Gen(RowN+1);
+  RowStartV[0] = 0;
+  for (int i = 0; i < RowN; i++) {
+    RowStartV[i+1] = RowStartV[i] + RowLenV[i];
+  }
+  ColIdV.Gen(RowStartV[RowN]);
+}
+
+TCsrMtx::TCsrMtx(const PNGraph& Graph, const bool& Transp) : RowN(Graph->GetNodes()), ColN(Graph->GetNodes()) {
+  Graph->GetNIdV(NIdV);
+  TIntH NIdRowH(RowN);
+  TIntV RowLenV(RowN);
+  for (int i = 0; i < RowN; i++) {
+    const TNGraph::TNodeI NI = Graph->GetNI(NIdV[i]);
+    NIdRowH.AddDat(NIdV[i], i);
+    RowLenV[i] = Transp ? NI.GetInDeg() : NI.GetOutDeg();
+  }
+  GenRows(RowLenV);
+  #pragma omp parallel for schedule(dynamic, 1024)
+  for (int i = 0; i < RowN; i++) {
+    const TNGraph::TNodeI NI = Graph->GetNI(NIdV[i]);
+    int64 e = RowStartV[i];
+    for (int n = 0; n < RowLenV[i]; n++, e++) {
+      ColIdV[e] = NIdRowH.GetDat(Transp ? NI.GetInNId(n) : NI.GetOutNId(n));
+    }
+  }
+}
+
+TCsrMtx::TCsrMtx(const PUNGraph& Graph) : RowN(Graph->GetNodes()), ColN(Graph->GetNodes()) {
+  Graph->GetNIdV(NIdV);
+  TIntH NIdRowH(RowN);
+  TIntV RowLenV(RowN);
+  for (int i = 0; i < RowN; i++) {
+    NIdRowH.AddDat(NIdV[i], i);
+    RowLenV[i] = Graph->GetNI(NIdV[i]).GetDeg();
+  }
+  GenRows(RowLenV);
+  #pragma omp parallel for schedule(dynamic, 1024)
+  for (int i = 0; i < RowN; i++) {
+    const TUNGraph::TNodeI NI = Graph->GetNI(NIdV[i]);
+    int64 e = RowStartV[i];
+    for (int n = 0; n < RowLenV[i]; n++, e++) {
+      ColIdV[e] = NIdRowH.GetDat(NI.GetNbrNId(n));
+    }
+  }
+}
+
+TCsrMtx::TCsrMtx(const TSparseColMatrix& Mtx) : RowN(Mtx.GetRows()), ColN(Mtx.GetCols()) {
+  NIdV.Gen(RowN);
+  for (int i = 0; i < RowN; i++) { NIdV[i] = i; }
+  TIntV RowLenV(RowN);
+  for (int j = 0; j < ColN; j++) {
+    const TIntFltKdV& ColV = Mtx.ColSpVV[j];
+    for (int i = 0; i < ColV.Len(); i++) { RowLenV[ColV[i].Key]++; }
+  }
+  GenRows(RowLenV);
+  ValV.Gen(ColIdV.Len());
+  TVec<TInt64> PosV(RowStartV);
+  for (int j = 0; j < ColN; j++) {
+    const TIntFltKdV& ColV = Mtx.ColSpVV[j];
+    for (int i = 0; i < ColV.Len(); i++) {
+      const int64 e = PosV[ColV[i].Key]++;
+      ColIdV[e] = j;
+      ValV[e] = ColV[i].Dat;
+    }
+  }
+}
+
+// Result = A * B(:,ColId)
+void TCsrMtx::PMultiply(const TFltVV& B, int ColId, TFltV& Result) const {
+  Assert(B.GetRows() >= ColN && Result.Len() >= RowN);
+  const int Rows = RowN;
+  const bool Weighted = ! ValV.Empty();
+  #pragma omp parallel for schedule(dynamic, 1024)
+  for (int i = 0; i < Rows; i++) {
+    double Sum = 0.0;
+    for (int64 e = RowStartV[i]; e < RowStartV[i+1]; e++) {
+      Sum += Weighted ? ValV[e] * B(ColIdV[e], ColId) : B(ColIdV[e], ColId).Val;
+    }
+    Result[i] = Sum;
+  }
+}
+
+// Result = A * Vec
+void TCsrMtx::PMultiply(const TFltV& Vec, TFltV& Result) const {
+  Assert(Vec.Len() >= ColN && Result.Len() >= RowN);
+  const int Rows = RowN;
+  const bool Weighted = ! ValV.Empty();
+  #pragma omp parallel for schedule(dynamic, 1024)
+  for (int i = 0; i < Rows; i++) {
+    double Sum = 0.0;
+    for (int64 e = RowStartV[i]; e < RowStartV[i+1]; e++) {
+      Sum += Weighted ? ValV[e] * Vec[ColIdV[e]] : Vec[ColIdV[e]].Val;
+    }
+    Result[i] = Sum;
+  }
+}
+
+// Result = A' * B(:,ColId)
+// A' is applied by scattering rows, which is sequential; build the transposed matrix for repeated use.
+void TCsrMtx::PMultiplyT(const TFltVV& B, int ColId, TFltV& Result) const {
+  Assert(B.GetRows() >= RowN && Result.Len() >= ColN);
+  const bool Weighted = ! ValV.Empty();
+  for (int j = 0; j < ColN; j++) { Result[j] = 0.0; }
+  for (int i = 0; i < RowN; i++) {
+    const double Val = B(i, ColId);
+    for (int64 e = RowStartV[i]; e < RowStartV[i+1]; e++) {
+      Result[ColIdV[e]] += Weighted ? ValV[e] * Val : Val;
+    }
+  }
+}
+
+// Result = A' * Vec
+void TCsrMtx::PMultiplyT(const TFltV& Vec, TFltV& Result) const {
+  Assert(Vec.Len() >= RowN && Result.Len() >= ColN);
+  const bool Weighted = ! ValV.Empty();
+  for (int j = 0; j < ColN; j++) { Result[j] = 0.0; }
+  for (int i = 0; i < RowN; i++) {
+    const double Val = Vec[i];
+    for (int64 e = RowStartV[i]; e < RowStartV[i+1]; e++) {
+      Result[ColIdV[e]] += Weighted ? ValV[e] * Val : Val;
+    }
+  }
+}
+
+/////////////////////////////////////////////////
+// Block Krylov Eigensolver
+const double TBlockKrylov::ConvTol = 1e-8;
+
+void TBlockKrylov::ApplyOp(const TCsrMtx& A, const TCsrMtx* At, const TBlock& X, TBlock& Y, TBlock& Tmp) {
+  if (At == NULL) {
+    A.MultiplyBlock(X, Y);
+  } else {
+    A.MultiplyBlock(X, Tmp);
+    At->MultiplyBlock(Tmp, Y);
+  }
+}
+
+// C = Q(:,0:QCols)' * Y and Y = Y - Q(:,0:QCols) * C.
+void TBlockKrylov::Project(const TBlock& Q, const int& QCols, TBlock& Y, TFltVV& C) {
+  const int64 N = Y.GetRows();
+  const int Cols = (int) Y.GetCols();
+  C.Gen(QCols, Cols);
+  #pragma omp parallel
+  {
+    TFltVV PartC(QCols, Cols);
+    #pragma omp for schedule(static)
+    for (int64 r = 0; r < N; r++) {
+      const TFlt* QRow = &Q(r, 0);
+      const TFlt* YRow = &Y(r, 0);
+      for (int i = 0; i < QCols; i++) {
+        const double QVal = QRow[i];
+        if (QVal == 0.0) { continue; }
+        TFlt* CRow = &PartC(i, 0);
+        for (int k = 0; k < Cols; k++) { CRow[k].Val += QVal * YRow[k].Val; }
+      }
+    }
+    #pragma omp critical
+    {
+      for (int i = 0; i < QCols; i++) {
+        for (int k = 0; k < Cols; k++) { C(i, k) += PartC(i, k); }
+      }
+    }
+  }
+  #pragma omp parallel for schedule(static)
+  for (int64 r = 0; r < N; r++) {
+    const TFlt* QRow = &Q(r, 0);
+    TFlt* YRow = &Y(r, 0);
+    for (int i = 0; i < QCols; i++) {
+      const double QVal = QRow[i];
+      if (QVal == 0.0) { continue; }
+      const TFlt* CRow = &C(i, 0);
+      for (int k = 0; k < Cols; k++) { YRow[k].Val -= QVal * CRow[k].Val; }
+    }
+  }
+}
+
+// Orthonormalizes the columns of Y, already orthogonal to Q(:,0:QCols), by two rounds
+// of Cholesky QR. Columns that are (numerically) in the span of the others are
+// replaced by random vectors orthogonal to Q and to the rest of the block.
+void TBlockKrylov::Orthonormalize(const TBlock& Q, const int& QCols, TBlock& Y, const TCtrRnd& Rnd, const int& Blk) {
+  const int64 N = Y.GetRows();
+  const int Cols = (int) Y.GetCols();
+  TFltV ScaleV(Cols);
+  for (int Round = 0; Round < 2; Round++) {
+    // Gram matrix G = Y' * Y
+    TFltVV G(Cols, Cols);
+    #pragma omp parallel
+    {
+      TFltVV PartG(Cols, Cols);
+      #pragma omp for schedule(static)
+      for (int64 r = 0; r < N; r++) {
+        const TFlt* YRow = &Y(r, 0);
+        for (int i = 0; i < Cols; i++) {
+          const double YVal = YRow[i];
+          TFlt* GRow = &PartG(i, 0);
+          for (int k = i; k < Cols; k++) { GRow[k].Val += YVal * YRow[k].Val; }
+        }
+      }
+      #pragma omp critical
+      {
+        for (int i = 0; i < Cols; i++) {
+          for (int k = i; k < Cols; k++) { G(i, k) += PartG(i, k); }
+        }
+      }
+    }
+    if (Round == 0) {
+      for (int i = 0; i < Cols; i++) { ScaleV[i] = G(i, i); }
+    }
+    // Cholesky factor G = R' * R, skipping deficient columns
+    TFltVV R(Cols, Cols);
+    TIntV DefV;
+    for (int j = 0; j < Cols; j++) {
+      for (int k = 0; k < j; k++) {
+        if (R(k, k) == 0.0) { continue; }
+        double Sum = G(k, j);
+        for (int l = 0; l < k; l++) { Sum -= R(l, k) * R(l, j); }
+        R(k, j) = Sum / R(k, k);
+      }
+      double Diag = G(j, j);
+      for (int l = 0; l < j; l++) { Diag -= R(l, j) * R(l, j); }
+      if (Diag <= 1e-12 * ScaleV[j] || Diag <= 0.0) { DefV.Add(j); }
+      else { R(j, j) = sqrt(Diag); }
+    }
+    // Y = Y * inv(R)
+    #pragma omp parallel for schedule(static)
+    for (int64 r = 0; r < N; r++) {
+      TFlt* YRow = &Y(r, 0);
+      for (int j = 0; j < Cols; j++) {
+        if (R(j, j) == 0.0) { YRow[j] = 0.0; continue; }
+        double Val = YRow[j];
+        for (int k = 0; k < j; k++) { Val -= YRow[k] * R(k, j); }
+        YRow[j] = Val / R(j, j);
+      }
+    }
+    // replace deficient columns
+    for (int d = 0; d < DefV.Len(); d++) {
+      const int j = DefV[d];
+      for (int Attempt = 0; ; Attempt++) {
+        IAssertR(Attempt < 10, "Krylov space is exhausted");
+        const uint64 SubCtr = (uint64(Blk+1) << 32) + uint64(Attempt) * Cols + j;
+        double Norm = 0.0;
+        for (int64 r = 0; r < N; r++) {
+          Y(r, j) = 2.0 * Rnd.GetUniDev(r, SubCtr) - 1.0;
+          Norm += TMath::Sqr(Y(r, j));
+        }
+        const double Norm0 = Norm;
+        for (int Pass = 0; Pass < 2; Pass++) {
+          for (int i = 0; i < QCols + Cols; i++) {
+            if (i == QCols + j) { continue; }
+            double Dot = 0.0;
+            for (int64 r = 0; r < N; r++) {
+              Dot += (i < QCols ? Q(r, i).Val : Y(r, i-QCols).Val) * Y(r, j);
+            }
+            if (Dot == 0.0) { continue; }
+            for (int64 r = 0; r < N; r++) {
+              Y(r, j) -= Dot * (i < QCols ? Q(r, i).Val : Y(r, i-QCols).Val);
+            }
+          }
+        }
+        Norm = 0.0;
+        for (int64 r = 0; r < N; r++) { Norm += TMath::Sqr(Y(r, j)); }
+        if (Norm > 1e-6 * Norm0) {
+          Norm = sqrt(Norm);
+          for (int64 r = 0; r < N; r++) { Y(r, j) /= Norm; }
+          break;
+        }
+      }
+      ScaleV[j] = 1.0;
+    }
+    for (int i = 0; i < Cols; i++) { ScaleV[i] = 1.0; }
+  }
+}
+
+void TBlockKrylov::GetRitz(const TCsrMtx& A, const TCsrMtx* At, const int& Vals, int BlockSz, int KrylovDim,
+    const int& Seed, TFltV& RitzValV, TFltVV* RitzVecVV) {
+  const int N = A.GetCols();
+  if (At == NULL) { IAssert(A.GetRows() == N); }
+  else { IAssert(At->GetRows() == N && At->GetCols() == A.GetRows()); }
+  RitzValV.Clr();
+  if (RitzVecVV != NULL) { RitzVecVV->Clr(); }
+  if (N == 0 || Vals <= 0) { return; }
+  // small blocks converge faster per product, 8 doubles still fill a cache line per row
+  if (BlockSz <= 0) { BlockSz = 8; }
+  if (KrylovDim <= 0) { KrylovDim = TMath::Mx(4*Vals, 8*BlockSz); }
+  const int Found = TMath::Mn(Vals, N);
+  // restarts begin with the leading Ritz vectors and need room for at least one more block
+  const int RestartSz = TMath::Mn(Found + BlockSz, N);
+  KrylovDim = TMath::Mn(TMath::Mx(KrylovDim, BlockSz, 2*RestartSz), N);
+  BlockSz = TMath::Mn(BlockSz, KrylovDim);
+  const int MxKrylovDim = TMath::Mn(4*KrylovDim, N);
+  const TCtrRnd Rnd(Seed);
+  TBlock Q, X(N, BlockSz), MX, V, Y, Tmp;
+  TFltVV T, C;
+  bool IsMX = false;
+  #pragma omp parallel for schedule(static)
+  for (int r = 0; r < N; r++) {
+    for (int k = 0; k < BlockSz; k++) { X(r, k) = 2.0 * Rnd.GetUniDev(r, k) - 1.0; }
+  }
+  Orthonormalize(Q, 0, X, Rnd, 0);
+  TFltV RitzV;
+  int Converged = 0;
+  for (int Cycle = 0, BlkN = 0; ; Cycle++) {
+    const int BlkSz = (int) X.GetCols();
+    const int Dim = KrylovDim;
+    Q.Gen(N, Dim);  T.Gen(Dim, Dim);
+    for (int Col0 = 0; ; ) {
+      const int Cols = (int) X.GetCols();
+      const int QCols = Col0 + Cols;
+      #pragma omp parallel for schedule(static)
+      for (int r = 0; r < N; r++) {
+        for (int k = 0; k < Cols; k++) { Q(r, Col0+k) = X(r, k); }
+      }
+      // M times the restart block is known from the residuals of the previous cycle
+      if (Col0 == 0 && IsMX) { Y = MX; }
+      else { ApplyOp(A, At, X, Y, Tmp); }
+      // the first projection gives block column Blk of T = Q' * M * Q,
+      // the second one restores orthogonality lost to rounding
+      Project(Q, QCols, Y, C);
+      for (int i = 0; i < QCols; i++) {
+        for (int k = 0; k < Cols; k++) { T(i, Col0+k) = C(i, k); }
+      }
+      if (QCols == Dim) { break; }
+      Project(Q, QCols, Y, C);
+      // the last block may be narrower
+      const int NextCols = TMath::Mn(BlkSz, Dim-QCols);
+      if (NextCols < Cols) {
+        X.Gen(N, NextCols);
+        for (int r = 0; r < N; r++) {
+          for (int k = 0; k < NextCols; k++) { X(r, k) = Y(r, k); }
+        }
+        Y = X;
+      }
+      Orthonormalize(Q, QCols, Y, Rnd, ++BlkN);
+      X = Y;
+      Col0 = QCols;
+    }
+    // Rayleigh-Ritz: eigen decomposition of the symmetric projected matrix
+    for (int i = 0; i < Dim; i++) {
+      for (int j = 0; j < i; j++) {
+        if (i / BlkSz == j / BlkSz) { T(i, j) = T(j, i) = 0.5 * (T(i, j) + T(j, i)); }
+        else { T(i, j) = T(j, i); }
+      }
+    }
+    TFltV d(Dim+1), e(Dim+1);
+    TNumericalStuff::SymetricToTridiag(T, Dim, d, e);
+    TNumericalStuff::EigSymmetricTridiag(d, e, Dim, T);
+    TFltIntKdV SortV(Dim);
+    for (int i = 0; i < Dim; i++) {
+      SortV[i] = TFltIntKd(TFlt::Abs(d[i+1]), i);
+    }
+    SortV.Sort(false);
+    // leading Ritz vectors V = Q * Z
+    const int Keep = TMath::Mn(RestartSz, Dim);
+    RitzV.Gen(Keep);
+    TFltVV Z(Dim, Keep);
+    for (int v = 0; v < Keep; v++) { RitzV[v] = d[SortV[v].Dat+1]; }
+    for (int i = 0; i < Dim; i++) {
+      for (int v = 0; v < Keep; v++) { Z(i, v) = T(i, SortV[v].Dat); }
+    }
+    V.Gen(N, Keep);
+    #pragma omp parallel for schedule(static)
+    for (int r = 0; r < N; r++) {
+      const TFlt* QRow = &Q(r, 0);
+      TFlt* VRow = &V(r, 0);
+      for (int i = 0; i < Dim; i++) {
+        const double QVal = QRow[i];
+        const TFlt* ZRow = &Z(i, 0);
+        for (int v = 0; v < Keep; v++) { VRow[v].Val += QVal * ZRow[v].Val; }
+      }
+    }
+    // residuals |M*v - val*v| of the wanted pairs, relative to the largest value
+    ApplyOp(A, At, V, MX, Tmp);
+    IsMX = true;
+    TFltV ResV(Found);
+    for (int r = 0; r < N; r++) {
+      for (int v = 0; v < Found; v++) { ResV[v] += TMath::Sqr(MX(r, v) - RitzV[v] * V(r, v)); }
+    }
+    const double MxRes = ConvTol * TMath::Mx(TFlt::Abs(RitzV[0]), 1e-300);
+    for (Converged = 0; Converged < Found && sqrt(ResV[Converged]) <= MxRes; Converged++) { }
+    // a basis of the whole space gives the eigenpairs up to rounding
+    if (Dim == N) { Converged = Found; }
+    if (Converged == Found || Cycle+1 == MxCycles) { break; }
+    // restart from the leading Ritz vectors, which are orthonormal, in a deeper space
+    X = V;
+    KrylovDim = TMath::Mn(2*KrylovDim, MxKrylovDim);
+  }
+  // only a converged prefix of the pairs is returned
+  for (int v = 0; v < Converged; v++) { RitzValV.Add(RitzV[v]); }
+  if (RitzVecVV == NULL) { return; }
+  RitzVecVV->Gen(N, Converged);
+  for (int r = 0; r < N; r++) {
+    for (int v = 0; v < Converged; v++) { RitzVecVV->At(r, v) = V(r, v); }
+  }
+}
+
+void TBlockKrylov::GetEigVals(const TCsrMtx& A, const int& Vals, TFltV& EigValV, const int& BlockSz, const int& KrylovDim, const int& Seed) {
+  GetRitz(A, NULL, Vals, BlockSz, KrylovDim, Seed, EigValV, NULL);
+}
+
+void TBlockKrylov::GetEigVec(const TCsrMtx& A, const int& Vals, TFltV& EigValV, TFltVV& EigVecVV, const int& BlockSz, const int& KrylovDim, const int& Seed) {
+  GetRitz(A, NULL, Vals, BlockSz, KrylovDim, Seed, EigValV, &EigVecVV);
+}
+
+void TBlockKrylov::GetSngVals(const TCsrMtx& A, const TCsrMtx& At, const int& Vals, TFltV& SngValV, const int& BlockSz, const int& KrylovDim, const int& Seed) {
+  GetRitz(A, &At, Vals, BlockSz, KrylovDim, Seed, SngValV, NULL);
+  for (int v = 0; v < SngValV.Len(); v++) {
+    SngValV[v] = sqrt(TMath::Mx(SngValV[v].Val, 0.0));
+  }
+}
+
+void TBlockKrylov::GetSngVec(const TCsrMtx& A, const TCsrMtx& At, const int& Vals, TFltV& SngValV, TFltVV& LSingVV, TFltVV& RSingVV, const int& BlockSz, const int& KrylovDim, const int& Seed) {
+  GetRitz(A, &At, Vals, BlockSz, KrylovDim, Seed, SngValV, &RSingVV);
+  for (int v = 0; v < SngValV.Len(); v++) {
+    SngValV[v] = sqrt(TMath::Mx(SngValV[v].Val, 0.0));
+  }
+  // left singular vectors u = A * v / s
+  A.MultiplyBlock(RSingVV, LSingVV);
+  for (int r = 0; r < LSingVV.GetRows(); r++) {
+    for (int v = 0; v < SngValV.Len(); v++) {
+      LSingVV(r, v) = SngValV[v] > 0.0 ? LSingVV(r, v) / SngValV[v] : 0.0;
+    }
+  }
+}
+
 /////////////////////////////////////////////////
 // Graphs Singular Value Decomposition
 namespace TSnap {
@@ -195,24 +623,11 @@ void GetSngVals(const PNGraph& Graph, const int& SngVals, TFltV& SngValV) {
     catch(...) {
       printf("\n***No SVD convergence: G(%d, %d)\n", Nodes, Graph->GetEdges()); }
   } else {
-    // Lanczos
-    TNGraphMtx GraphMtx(Graph);
-    int CalcVals = int(2*SngVals);
-    //if (CalcVals > Nodes) { CalcVals = int(2*Nodes); }
-    //if (CalcVals > Nodes) { CalcVals = Nodes; }
-    //while (SngValV.Len() < SngVals && CalcVals < 10*SngVals) {
-    try {
-      if (SngVals > 4) { 
-        TSparseSVD::SimpleLanczosSVD(GraphMtx, 2*SngVals, SngValV, false); }
-      else { TFltVV LSingV, RSingV;  // this is much more precise, but also much slower
-        TSparseSVD::LanczosSVD(GraphMtx, SngVals, 3*SngVals, ssotFull, SngValV, LSingV, RSingV); }
-    }
-    catch(...) {
-      printf("\n  ***EXCEPTION:  TRIED %d GOT %d values** \n", 2*SngVals, SngValV.Len()); }
+    // block Krylov
+    TCsrMtx GraphMtx(Graph), GraphMtxT(Graph, true);
+    TBlockKrylov::GetSngVals(GraphMtx, GraphMtxT, SngVals, SngValV);
     if (SngValV.Len() < SngVals) {
-      printf("  ***TRIED %d GOT %d values** \n", CalcVals, SngValV.Len()); }
-    //  CalcVals += SngVals;
-    //}
+      printf("  ***TRIED %d GOT %d values** \n", SngVals, SngValV.Len()); }
   }
   SngValV.Sort(false);
   //if (SngValV.Len() > SngVals) {
@@ -244,9 +659,9 @@ void GetSngVec(const PNGraph& Graph, TFltV& LeftSV, TFltV& RightSV) {
       TSvd::Svd1Based(AdjMtx, LSingV, SngValV, RSingV); }
     catch(...) {
       printf("\n***No SVD convergence: G(%d, %d)\n", Nodes, Graph->GetEdges()); }
-  } else { // Lanczos
-    TNGraphMtx GraphMtx(Graph);
-    TSparseSVD::LanczosSVD(GraphMtx, 1, 8, ssotFull, SngValV, LSingV, RSingV);
+  } else { // block Krylov
+    TCsrMtx GraphMtx(Graph), GraphMtxT(Graph, true);
+    TBlockKrylov::GetSngVec(GraphMtx, GraphMtxT, 1, SngValV, LSingV, RSingV);
   }
   TFlt MxSngVal = TFlt::Mn;
   int ValN = 0;
@@ -283,9 +698,9 @@ void GetSngVec(const PNGraph& Graph, const int& SngVecs, TFltV& SngValV, TVec<TF
     } catch(...) {
       printf("\n***No SVD convergence: G(%d, %d)\n", Nodes, Graph->GetEdges()); 
     }
-  } else { // Lanczos
-    TNGraphMtx GraphMtx(Graph);
-    TSparseSVD::LanczosSVD(GraphMtx, SngVecs, 2*SngVecs, ssotFull, SngValV, LSingV, RSingV);
+  } else { // block Krylov
+    TCsrMtx GraphMtx(Graph), GraphMtxT(Graph, true);
+    TBlockKrylov::GetSngVec(GraphMtx, GraphMtxT, SngVecs, SngValV, LSingV, RSingV);
     //TGAlg::SaveFullMtx(Graph, "adj_mtx.txt");
     //TLAMisc::DumpTFltVVMjrSubMtrx(LSingV, LSingV.GetRows(), LSingV.GetCols(), "LSingV2.txt"); // save MTX
   }
@@ -306,24 +721,11 @@ void GetSngVec(const PNGraph& Graph, const int& SngVecs, TFltV& SngValV, TVec<TF
 }
 
 void GetEigVals(const PUNGraph& Graph, const int& EigVals, TFltV& EigValV) {
-  // Lanczos
-  TUNGraphMtx GraphMtx(Graph);
-  //const int Nodes = Graph->GetNodes();
-  //int CalcVals = int(2*EigVals);
-  //if (CalcVals > Nodes) { CalcVals = Nodes; }
-  //while (EigValV.Len() < EigVals && CalcVals < 3*EigVals) {
-  try {
-    if (EigVals > 4) { 
-      TSparseSVD::SimpleLanczos(GraphMtx, 2*EigVals, EigValV, false); }
-    else { TFltVV EigVecVV; // this is much more precise, but also much slower
-      TSparseSVD::Lanczos(GraphMtx, EigVals, 3*EigVals, ssotFull, EigValV, EigVecVV, false); }
-  }
-  catch(...) {
-    printf("\n  ***EXCEPTION:  TRIED %d GOT %d values** \n", 2*EigVals, EigValV.Len()); }
+  // block Krylov
+  TCsrMtx GraphMtx(Graph);
+  TBlockKrylov::GetEigVals(GraphMtx, EigVals, EigValV);
   if (EigValV.Len() < EigVals) {
-    printf("  ***TRIED %d GOT %d values** \n", 2*EigVals, EigValV.Len()); }
-  //  CalcVals += EigVals;
-  //}
+    printf("  ***TRIED %d GOT %d values** \n", EigVals, EigValV.Len()); }
   EigValV.Sort(false);
   /*if (EigValV.Len() > EigVals) {
     EigValV.Del(EigVals, EigValV.Len()-1); }
@@ -334,31 +736,22 @@ void GetEigVals(const PUNGraph& Graph, const int& EigVals, TFltV& EigValV) {
 }
 
 void GetEigVec(const PUNGraph& Graph, TFltV& EigVecV) {
-  TUNGraphMtx GraphMtx(Graph);
+  TCsrMtx GraphMtx(Graph);
   TFltV EigValV;
   TFltVV EigVecVV;
-  TSparseSVD::Lanczos(GraphMtx, 1, 8, ssotFull, EigValV, EigVecVV, false);
+  TBlockKrylov::GetEigVec(GraphMtx, 1, EigValV, EigVecVV);
   EigVecVV.GetCol(0, EigVecV); // vector components are not sorted!!!
   IsAllValVNeg(EigVecV, true);
 }
 
 // to get first few eigenvectors
 void GetEigVec(const PUNGraph& Graph, const int& EigVecs, TFltV& EigValV, TVec<TFltV>& EigVecV) {
-  const int Nodes = Graph->GetNodes();
-  // Lanczos
-  TUNGraphMtx GraphMtx(Graph);
-  int CalcVals = int(2*EigVecs);
-  if (CalcVals > Nodes) { CalcVals = Nodes; }
+  // block Krylov
+  TCsrMtx GraphMtx(Graph);
   TFltVV EigVecVV;
-  //while (EigValV.Len() < EigVecs && CalcVals < 10*EigVecs) {
-  try {
-    TSparseSVD::Lanczos(GraphMtx, EigVecs, 2*EigVecs, ssotFull, EigValV, EigVecVV, false); }
-  catch(...) {
-    printf("\n  ***EXCEPTION:  TRIED %d GOT %d values** \n", CalcVals, EigValV.Len()); }
+  TBlockKrylov::GetEigVec(GraphMtx, EigVecs, EigValV, EigVecVV);
   if (EigValV.Len() < EigVecs) {
-    printf("  ***TRIED %d GOT %d values** \n", CalcVals, EigValV.Len()); }
-  //  CalcVals += EigVecs;
-  //}
+    printf("  ***TRIED %d GOT %d values** \n", EigVecs, EigValV.Len()); }
   TFltIntPrV EigValIdV;
   for (int i = 0; i < EigValV.Len(); i++) {
     EigValIdV.Add(TFltIntPr(EigValV[i], i)); 
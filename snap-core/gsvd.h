@@ -46,6 +46,106 @@ public:
   void PMultiplyT(const TFltV& Vec, TFltV& Result) const;
 };
 
+//#//////////////////////////////////////////////
+/// Sparse matrix in compressed sparse row (CSR) format.
+/// Row/column i of a graph adjacency matrix corresponds to node GetNId(i), so
+/// unlike TNGraphMtx and TUNGraphMtx node IDs do not need to be in the range 0...Nodes-1.
+/// Besides the single vector products of TMatrix the class multiplies a whole
+/// block of vectors at once (see MultiplyBlock()). Products are parallelized over rows.
+class TCsrMtx : public TMatrix {
+private:
+  TInt RowN, ColN;
+  TVec<TInt64> RowStartV;
+  TVec<TInt, int64> ColIdV;
+  TVec<TFlt, int64> ValV; // empty for {0,1} matrices
+  TIntV NIdV;
+  void GenRows(const TIntV& RowLenV);
+protected:
+  // Result = A * B(:,ColId)
+  void PMultiply(const TFltVV& B, int ColId, TFltV& Result) const;
+  // Result = A * Vec
+  void PMultiply(const TFltV& Vec, TFltV& Result) const;
+  // Result = A' * B(:,ColId)
+  void PMultiplyT(const TFltVV& B, int ColId, TFltV& Result) const;
+  // Result = A' * Vec
+  void PMultiplyT(const TFltV& Vec, TFltV& Result) const;
+  int PGetRows() const { return RowN; }
+  int PGetCols() const { return ColN; }
+public:
+  TCsrMtx() : RowN(0), ColN(0) { }
+  /// Adjacency matrix of a directed graph, A(i,j)=1 for an edge GetNId(i)->GetNId(j). If Transp=true the transposed matrix is built.
+  TCsrMtx(const PNGraph& Graph, const bool& Transp=false);
+  /// Adjacency matrix of an undirected graph.
+  TCsrMtx(const PUNGraph& Graph);
+  /// Copies a sparse column matrix. Row/column IDs are 0...Rows-1.
+  TCsrMtx(const TSparseColMatrix& Mtx);
+  /// Returns the node ID of row/column RowId.
+  int GetNId(const int& RowId) const { return NIdV[RowId]; }
+  /// Returns the node IDs of all rows/columns.
+  const TIntV& GetNIdV() const { return NIdV; }
+  /// Returns the number of non-zero entries.
+  int64 GetNonZeros() const { return ColIdV.Len(); }
+  /// Result = A * B for a block of vectors B (one vector per column).
+  template <class TSizeTy> void MultiplyBlock(const TVVec<TFlt, TSizeTy>& B, TVVec<TFlt, TSizeTy>& Result) const;
+};
+
+// Each row accumulates into its own contiguous row of Result; the inner loop runs over the block.
+template <class TSizeTy>
+void TCsrMtx::MultiplyBlock(const TVVec<TFlt, TSizeTy>& B, TVVec<TFlt, TSizeTy>& Result) const {
+  IAssert(B.GetRows() == ColN);
+  const int Rows = RowN;
+  const int Cols = (int) B.GetCols();
+  if (Result.GetRows() != Rows || Result.GetCols() != Cols) { Result.Gen(Rows, Cols); }
+  if (Rows == 0 || Cols == 0) { return; }
+  const bool Weighted = ! ValV.Empty();
+  #pragma omp parallel for schedule(dynamic, 1024)
+  for (int Row = 0; Row < Rows; Row++) {
+    TFlt* ResRow = &Result(Row, 0);
+    for (int k = 0; k < Cols; k++) { ResRow[k].Val = 0.0; }
+    for (int64 e = RowStartV[Row]; e < RowStartV[Row+1]; e++) {
+      const TFlt* BRow = &B(ColIdV[e], 0);
+      if (Weighted) {
+        const double Val = ValV[e];
+        for (int k = 0; k < Cols; k++) { ResRow[k].Val += Val * BRow[k].Val; }
+      } else {
+        for (int k = 0; k < Cols; k++) { ResRow[k].Val += BRow[k].Val; }
+      }
+    }
+  }
+}
+
+//#//////////////////////////////////////////////
+/// Randomized block Krylov eigensolver and SVD for sparse matrices.
+/// Builds an orthonormal basis of the block Krylov space [X, M*X, ..., M^(q-1)*X] of
+/// a random starting block X, where M=A for symmetric eigenproblems and M=A'*A for
+/// the SVD, and extracts Ritz pairs from the projected matrix. All products with M
+/// are block products and the basis is kept fully orthogonal. Until the residuals
+/// |M*v - val*v| of all wanted pairs are below ConvTol times the largest value, the
+/// space is restarted from the leading Ritz vectors with twice the dimension, up to
+/// four times the initial one. After MxCycles restarts only the leading pairs that
+/// converged are returned.
+class TBlockKrylov {
+private:
+  typedef TVVec<TFlt, int64> TBlock;
+  static const int MxCycles = 100;
+  static const double ConvTol;
+  static void GetRitz(const TCsrMtx& A, const TCsrMtx* At, const int& Vals, int BlockSz, int KrylovDim,
+    const int& Seed, TFltV& RitzValV, TFltVV* RitzVecVV);
+  static void ApplyOp(const TCsrMtx& A, const TCsrMtx* At, const TBlock& X, TBlock& Y, TBlock& Tmp);
+  static void Project(const TBlock& Q, const int& QCols, TBlock& Y, TFltVV& C);
+  static void Orthonormalize(const TBlock& Q, const int& QCols, TBlock& Y, const TCtrRnd& Rnd, const int& Blk);
+public:
+  /// Computes Vals eigenvalues of largest magnitude of a symmetric matrix A.
+  /// @param BlockSz Number of vectors per block (default 8). @param KrylovDim Dimension of the Krylov space between restarts (default max(4*Vals, 8*BlockSz), at least 2*(Vals+BlockSz)).
+  static void GetEigVals(const TCsrMtx& A, const int& Vals, TFltV& EigValV, const int& BlockSz=-1, const int& KrylovDim=-1, const int& Seed=1);
+  /// Computes Vals eigenvalues of largest magnitude of a symmetric matrix A and the corresponding eigenvectors (columns of EigVecVV).
+  static void GetEigVec(const TCsrMtx& A, const int& Vals, TFltV& EigValV, TFltVV& EigVecVV, const int& BlockSz=-1, const int& KrylovDim=-1, const int& Seed=1);
+  /// Computes Vals largest singular values of A. At is the transpose of A.
+  static void GetSngVals(const TCsrMtx& A, const TCsrMtx& At, const int& Vals, TFltV& SngValV, const int& BlockSz=-1, const int& KrylovDim=-1, const int& Seed=1);
+  /// Computes Vals largest singular values of A and the corresponding left (columns of LSingVV) and right (columns of RSingVV) singular vectors. At is the transpose of A.
+  static void GetSngVec(const TCsrMtx& A, const TCsrMtx& At, const int& Vals, TFltV& SngValV, TFltVV& LSingVV, TFltVV& RSingVV, const int& BlockSz=-1, const int& KrylovDim=-1, const int& Seed=1);
+};
+
 /////////////////////////////////////////////////
 // Graphs Singular Value Decomposition of Graph Adjacency Matrix
 namespace TSnap {
@@ -863,6 +863,288 @@ PMMNet TMMNet::GetSubgraphByModeNet(TStrV& ModeNetTypes) {
   return Result;
 }
 
+// Metapaths are evaluated as row-wise sparse products: the cross nets of the path are turned into
+// compressed adjacency arrays over node hash keys and each source node is expanded hop by hop
+// with a dense per-thread accumulator, sources are processed in parallel.
+int TMMNet::GetMetaPathCnt(const TStr& SrcModeName, const TStrV& CrossNetNames, const TIntV& SrcNIdV, TVec<TIntFltH>& PathCntHV, const int& TopK) const {
+  TIntV ModeIdV, HopAdjV;
+  TVec<TIntV> OffVV, NbrVV;
+  const int EndModeId = GetMetaPathAdj(SrcModeName, CrossNetNames, ModeIdV, HopAdjV, OffVV, NbrVV);
+  const TModeNet& SrcNet = GetModeNetById(ModeIdV[0]);
+  const TModeNet& EndNet = GetModeNetById(EndModeId);
+  const int Srcs = SrcNIdV.Len();
+  for (int i = 0; i < Srcs; i++) {
+    IAssertR(SrcNet.IsNode(SrcNIdV[i]), TStr::Fmt("NodeId %d does not exist", SrcNIdV[i].Val));
+  }
+  PathCntHV.Gen(Srcs);
+#ifdef USE_OPENMP
+  #pragma omp parallel
+#endif
+  {
+    TVec<TFltV> AccVV;
+    TIntV KeyV;
+    TFltV CntV;
+    GetMetaPathAcc(ModeIdV, AccVV);
+#ifdef USE_OPENMP
+    #pragma omp for schedule(dynamic, 16)
+#endif
+    for (int i = 0; i < Srcs; i++) {
+      GetMetaPathRow(HopAdjV, OffVV, NbrVV, 0, HopAdjV.Len(), SrcNet.NodeH.GetKeyId(SrcNIdV[i]), TopK, AccVV, KeyV, CntV);
+      TIntFltH& CntH = PathCntHV[i];
+      CntH.Gen(KeyV.Len());
+      for (int k = 0; k < KeyV.Len(); k++) {
+        CntH.AddDat(EndNet.NodeH.GetKey(KeyV[k]), CntV[k]);
+      }
+    }
+  }
+  return EndModeId;
+}
+
+int TMMNet::GetMetaPathNbrs(const TStr& SrcModeName, const TStrV& CrossNetNames, const TIntV& SrcNIdV, TVec<TIntV>& NbrNIdVV) const {
+  TIntV ModeIdV, HopAdjV;
+  TVec<TIntV> OffVV, NbrVV;
+  const int EndModeId = GetMetaPathAdj(SrcModeName, CrossNetNames, ModeIdV, HopAdjV, OffVV, NbrVV);
+  const TModeNet& SrcNet = GetModeNetById(ModeIdV[0]);
+  const TModeNet& EndNet = GetModeNetById(EndModeId);
+  const int Srcs = SrcNIdV.Len();
+  for (int i = 0; i < Srcs; i++) {
+    IAssertR(SrcNet.IsNode(SrcNIdV[i]), TStr::Fmt("NodeId %d does not exist", SrcNIdV[i].Val));
+  }
+  NbrNIdVV.Gen(Srcs);
+#ifdef USE_OPENMP
+  #pragma omp parallel
+#endif
+  {
+    TVec<TFltV> AccVV;
+    TIntV KeyV;
+    TFltV CntV;
+    GetMetaPathAcc(ModeIdV, AccVV);
+#ifdef USE_OPENMP
+    #pragma omp for schedule(dynamic, 16)
+#endif
+    for (int i = 0; i < Srcs; i++) {
+      GetMetaPathRow(HopAdjV, OffVV, NbrVV, 0, HopAdjV.Len(), SrcNet.NodeH.GetKeyId(SrcNIdV[i]), -1, AccVV, KeyV, CntV);
+      TIntV& NbrNIdV = NbrNIdVV[i];
+      NbrNIdV.Gen(KeyV.Len());
+      for (int k = 0; k < KeyV.Len(); k++) {
+        NbrNIdV[k] = EndNet.NodeH.GetKey(KeyV[k]);
+      }
+      NbrNIdV.Sort();
+    }
+  }
+  return EndModeId;
+}
+
+// PathSim(x,y) = 2*M(x,y) / (M(x,x) + M(y,y)), M being the commuting matrix of the metapath. For metapaths
+// whose second half retraces the first one, M(y,y) is the squared norm of the half-path counts of y.
+void TMMNet::GetPathSim(const TStr& ModeName, const TStrV& CrossNetNames, const TIntV& SrcNIdV, TVec<TIntFltH>& PathSimHV, const int& TopK) const {
+  TIntV ModeIdV, HopAdjV;
+  TVec<TIntV> OffVV, NbrVV;
+  const int EndModeId = GetMetaPathAdj(ModeName, CrossNetNames, ModeIdV, HopAdjV, OffVV, NbrVV);
+  IAssertR(EndModeId == ModeIdV[0], TStr::Fmt("Metapath does not end in mode %s", ModeName.CStr()));
+  const TModeNet& ModeNet = GetModeNetById(EndModeId);
+  const int Hops = CrossNetNames.Len();
+  bool IsSym = Hops % 2 == 0;
+  for (int h = 0; h < Hops/2 && IsSym; h++) {
+    const TCrossNet& CrossNet = GetCrossNetByName(CrossNetNames[h]);
+    IsSym = CrossNetNames[h] == CrossNetNames[Hops-1-h] && ! (CrossNet.GetMode1() == CrossNet.GetMode2() && CrossNet.IsDirected());
+  }
+  const int DiagHops = IsSym ? Hops/2 : Hops;
+  const int Srcs = SrcNIdV.Len();
+  for (int i = 0; i < Srcs; i++) {
+    IAssertR(ModeNet.IsNode(SrcNIdV[i]), TStr::Fmt("NodeId %d does not exist", SrcNIdV[i].Val));
+  }
+  TVec<TIntV> KeyVV(Srcs);
+  TVec<TFltV> CntVV(Srcs);
+#ifdef USE_OPENMP
+  #pragma omp parallel
+#endif
+  {
+    TVec<TFltV> AccVV;
+    GetMetaPathAcc(ModeIdV, AccVV);
+#ifdef USE_OPENMP
+    #pragma omp for schedule(dynamic, 16)
+#endif
+    for (int i = 0; i < Srcs; i++) {
+      GetMetaPathRow(HopAdjV, OffVV, NbrVV, 0, Hops, ModeNet.NodeH.GetKeyId(SrcNIdV[i]), TopK, AccVV, KeyVV[i], CntVV[i]);
+    }
+  }
+  // diagonal of the commuting matrix for the sources and all nodes they reach
+  TIntV DiagNV(ModeNet.NodeH.GetMxKeyIds());
+  TIntV DiagKeyV;
+  DiagNV.PutAll(-1);
+  for (int i = 0; i < Srcs; i++) {
+    const int SrcKeyId = ModeNet.NodeH.GetKeyId(SrcNIdV[i]);
+    if (DiagNV[SrcKeyId] == -1) { DiagNV[SrcKeyId] = DiagKeyV.Add(SrcKeyId); }
+    for (int k = 0; k < KeyVV[i].Len(); k++) {
+      if (DiagNV[KeyVV[i][k]] == -1) { DiagNV[KeyVV[i][k]] = DiagKeyV.Add(KeyVV[i][k]); }
+    }
+  }
+  TFltV DiagV(DiagKeyV.Len());
+#ifdef USE_OPENMP
+  #pragma omp parallel
+#endif
+  {
+    TVec<TFltV> AccVV;
+    TIntV KeyV;
+    TFltV CntV;
+    GetMetaPathAcc(ModeIdV, AccVV);
+#ifdef USE_OPENMP
+    #pragma omp for schedule(dynamic, 16)
+#endif
+    for (int d = 0; d < DiagKeyV.Len(); d++) {
+      GetMetaPathRow(HopAdjV, OffVV, NbrVV, 0, DiagHops, DiagKeyV[d], -1, AccVV, KeyV, CntV);
+      double Diag = 0.0;
+      for (int k = 0; k < KeyV.Len(); k++) {
+        if (IsSym) { Diag += CntV[k]*CntV[k]; }
+        else if (KeyV[k] == DiagKeyV[d]) { Diag = CntV[k]; }
+      }
+      DiagV[d] = Diag;
+    }
+  }
+  PathSimHV.Gen(Srcs);
+#ifdef USE_OPENMP
+  #pragma omp parallel for schedule(dynamic, 16)
+#endif
+  for (int i = 0; i < Srcs; i++) {
+    const double SrcDiag = DiagV[DiagNV[ModeNet.NodeH.GetKeyId(SrcNIdV[i])]];
+    TIntFltH& SimH = PathSimHV[i];
+    SimH.Gen(KeyVV[i].Len());
+    for (int k = 0; k < KeyVV[i].Len(); k++) {
+      const double Denom = SrcDiag + DiagV[DiagNV[KeyVV[i][k]]];
+      SimH.AddDat(ModeNet.NodeH.GetKey(KeyVV[i][k]), Denom > 0.0 ? 2.0*CntVV[i][k]/Denom : 0.0);
+    }
+  }
+}
+
+// Builds the adjacency of each hop of the metapath, hops over the same cross net in the same direction share it.
+// A hop goes from the current mode to the other mode of the cross net, directed same-mode cross nets are
+// followed along their edges and undirected ones in both directions. Returns the id of the last mode.
+int TMMNet::GetMetaPathAdj(const TStr& SrcModeName, const TStrV& CrossNetNames, TIntV& ModeIdV, TIntV& HopAdjV, TVec<TIntV>& OffVV, TVec<TIntV>& NbrVV) const {
+  const int Hops = CrossNetNames.Len();
+  IAssertR(Hops > 0, "Metapath has no cross nets");
+  ModeIdV.Gen(Hops+1);
+  HopAdjV.Gen(Hops);
+  OffVV.Clr();
+  NbrVV.Clr();
+  ModeIdV[0] = GetModeId(SrcModeName);
+  IAssertR(ModeIdV[0] != -1, TStr::Fmt("Mode %s does not exist", SrcModeName.CStr()));
+  THash<TIntPr, TInt> AdjH;
+  for (int h = 0; h < Hops; h++) {
+    const int CrossId = GetCrossId(CrossNetNames[h]);
+    IAssertR(CrossId != -1, TStr::Fmt("CrossNet %s does not exist", CrossNetNames[h].CStr()));
+    const TCrossNet& CrossNet = GetCrossNetById(CrossId);
+    const int Mode1 = CrossNet.GetMode1();
+    const int Mode2 = CrossNet.GetMode2();
+    IAssertR(Mode1 == ModeIdV[h] || Mode2 == ModeIdV[h], TStr::Fmt("CrossNet %s does not link mode %s",
+      CrossNetNames[h].CStr(), GetModeName(ModeIdV[h]).CStr()));
+    // 0: from Mode1 to Mode2, 1: from Mode2 to Mode1, 2: both ways within an undirected same-mode cross net
+    int Dir = 0;
+    if (Mode1 == Mode2) { Dir = CrossNet.IsDirected() ? 0 : 2; }
+    else if (Mode2 == ModeIdV[h]) { Dir = 1; }
+    ModeIdV[h+1] = Dir == 1 ? Mode1 : Mode2;
+    const TIntPr AdjKey(CrossId, Dir);
+    if (! AdjH.IsKey(AdjKey)) {
+      AdjH.AddDat(AdjKey, OffVV.Len());
+      OffVV.Add();
+      NbrVV.Add();
+      GetCrossNetAdj(CrossNet, Dir, OffVV.Last(), NbrVV.Last());
+    }
+    HopAdjV[h] = AdjH.GetDat(AdjKey);
+  }
+  return ModeIdV[Hops];
+}
+
+// Gets the compressed adjacency of a cross net over node hash keys, the links of the node with key k
+// are NbrV[OffV[k]..OffV[k+1]).
+void TMMNet::GetCrossNetAdj(const TCrossNet& CrossNet, const int& Dir, TIntV& OffV, TIntV& NbrV) const {
+  const TModeNet& Mode1Net = GetModeNetById(CrossNet.GetMode1());
+  const TModeNet& Mode2Net = GetModeNetById(CrossNet.GetMode2());
+  const TModeNet& FromNet = Dir == 1 ? Mode2Net : Mode1Net;
+  TIntV EKeyV(CrossNet.GetEdges(), 0);
+  for (int KeyId = CrossNet.CrossH.FFirstKeyId(); CrossNet.CrossH.FNextKeyId(KeyId); ) {
+    EKeyV.Add(KeyId);
+  }
+  const int Edges = EKeyV.Len();
+  TIntV FromV(Edges), ToV(Edges);
+#ifdef USE_OPENMP
+  #pragma omp parallel for schedule(static)
+#endif
+  for (int i = 0; i < Edges; i++) {
+    const TCrossNet::TCrossEdge& Edge = CrossNet.CrossH[EKeyV[i]];
+    const int SrcKeyId = Mode1Net.NodeH.GetKeyId(Edge.GetSrcNId());
+    const int DstKeyId = Mode2Net.NodeH.GetKeyId(Edge.GetDstNId());
+    FromV[i] = Dir == 1 ? DstKeyId : SrcKeyId;
+    ToV[i] = Dir == 1 ? SrcKeyId : DstKeyId;
+  }
+  // counting sort of the links by their source key
+  OffV.Gen(FromNet.NodeH.GetMxKeyIds()+1);
+  OffV.PutAll(0);
+  for (int i = 0; i < Edges; i++) {
+    OffV[FromV[i]+1] += 1;
+    if (Dir == 2 && FromV[i] != ToV[i]) { OffV[ToV[i]+1] += 1; }
+  }
+  for (int k = 1; k < OffV.Len(); k++) { OffV[k] += OffV[k-1]; }
+  NbrV.Gen(OffV.Last());
+  TIntV PosV(OffV);
+  for (int i = 0; i < Edges; i++) {
+    NbrV[PosV[FromV[i]]] = ToV[i];  PosV[FromV[i]] += 1;
+    if (Dir == 2 && FromV[i] != ToV[i]) { NbrV[PosV[ToV[i]]] = FromV[i];  PosV[ToV[i]] += 1; }
+  }
+}
+
+// Allocates the zeroed accumulators of one thread, AccVV[h] is indexed by the node keys of mode ModeIdV[h+1].
+void TMMNet::GetMetaPathAcc(const TIntV& ModeIdV, TVec<TFltV>& AccVV) const {
+  AccVV.Gen(ModeIdV.Len()-1);
+  for (int h = 0; h < AccVV.Len(); h++) {
+    AccVV[h].Gen(GetModeNetById(ModeIdV[h+1]).NodeH.GetMxKeyIds());
+    AccVV[h].PutAll(0.0);
+  }
+}
+
+// Expands node key SrcKeyId over hops BegHop..EndHop-1, KeyV and CntV get the reached node keys and path counts.
+void TMMNet::GetMetaPathRow(const TIntV& HopAdjV, const TVec<TIntV>& OffVV, const TVec<TIntV>& NbrVV, const int& BegHop, const int& EndHop,
+    const int& SrcKeyId, const int& TopK, TVec<TFltV>& AccVV, TIntV& KeyV, TFltV& CntV) {
+  TIntV NextKeyV;
+  KeyV.Clr(false);  KeyV.Add(SrcKeyId);
+  CntV.Clr(false);  CntV.Add(1.0);
+  for (int h = BegHop; h < EndHop && ! KeyV.Empty(); h++) {
+    const TIntV& OffV = OffVV[HopAdjV[h]];
+    const TIntV& NbrV = NbrVV[HopAdjV[h]];
+    TFltV& AccV = AccVV[h];
+    NextKeyV.Clr(false);
+    for (int k = 0; k < KeyV.Len(); k++) {
+      const double Cnt = CntV[k];
+      for (int n = OffV[KeyV[k]]; n < OffV[KeyV[k]+1]; n++) {
+        const int NbrKeyId = NbrV[n];
+        if (AccV[NbrKeyId] == 0.0) { NextKeyV.Add(NbrKeyId); }
+        AccV[NbrKeyId] += Cnt;
+      }
+    }
+    if (TopK > 0 && NextKeyV.Len() > TopK) {
+      TFltIntPrV CntKeyV(NextKeyV.Len(), 0);
+      for (int k = 0; k < NextKeyV.Len(); k++) {
+        CntKeyV.Add(TFltIntPr(AccV[NextKeyV[k]], NextKeyV[k]));
+        AccV[NextKeyV[k]] = 0.0;
+      }
+      CntKeyV.Sort(false);
+      KeyV.Gen(TopK, 0);
+      CntV.Gen(TopK, 0);
+      for (int k = 0; k < TopK; k++) {
+        KeyV.Add(CntKeyV[k].Val2);
+        CntV.Add(CntKeyV[k].Val1);
+      }
+    } else {
+      KeyV.Swap(NextKeyV);
+      CntV.Gen(KeyV.Len());
+      for (int k = 0; k < KeyV.Len(); k++) {
+        CntV[k] = AccV[KeyV[k]];
+        AccV[KeyV[k]] = 0.0;
+      }
+    }
+  }
+}
+
 PNEANet TMMNet::ToNetwork(TIntV& CrossNetTypes, TIntStrStrTrV& NodeAttrMap, TVec<TTriple<TInt, TStr, TStr> >& EdgeAttrMap) {
   TIntPrIntH NodeMap;
   THash<TIntPr, TIntPr> EdgeMap;
@@ -968,6 +1250,20 @@ PNEANet TMMNet::ToNetwork(TIntV& CrossNetTypes, TIntStrStrTrV& NodeAttrMap, TVec
         TStr Val = Net.GetStrAttrDatN(it.GetId(), OrigAttr);
         NewNet->AddStrAttrDatN(NewId, Val, NewAttr);
       }
+    } else if (type == TModeNet::DictStrType) {
+      // copy codes, each distinct string of the mode is interned into NewNet once
+      TIntV CodeMapV;
+      NewNet->GetStrCodeMap(Net, CodeMapV);
+      NewNet->AddStrAttrN(NewAttr, Net.GetStrAttrDefaultN(OrigAttr), true);
+      TModeNet::TIntAttrHnd OldCodeH = Net.GetStrCodeHndN(OrigAttr);
+      TNEANet::TIntAttrHnd NewCodeH = NewNet->GetStrCodeHndN(NewAttr);
+      const int NewDefaultCode = NewNet->GetStrCode(Net.GetStrAttrDefaultN(OrigAttr));
+      for(TModeNet::TNodeI it = Net.BegMMNI(); it != Net.EndMMNI(); it++) {
+        TIntPr OldNId(ModeId, it.GetId());
+        int NewId = NodeMap.GetDat(OldNId);
+        const int Code = OldCodeH.GetDat(it);
+        NewCodeH.GetDat(NewId) = Code < 0 ? NewDefaultCode : CodeMapV[Code].Val;
+      }
     } else if (type == TModeNet::IntVType) {
       NewNet->AddIntVAttrN(NewAttr);
       for(TModeNet::TNodeI it = Net.BegMMNI(); it != Net.EndMMNI(); it++) {
@@ -1112,6 +1408,249 @@ PNEANet TMMNet::ToNetwork2(TIntV& CrossNetTypes, TIntStrPrVH& NodeAttrMap, THash
   return NewNet;
 }
 
+// Nodes of each mode get a contiguous range of new ids in the order of their hash keys and
+// each cross edge gets one (directed) or two (undirected) consecutive new edge ids, so the
+// network is built with a single bulk AddEdgeV() and attribute columns are filled by key.
+PNEANet TMMNet::ToNetwork2MP(TIntV& CrossNetTypes, TIntStrPrVH& NodeAttrMap, THash<TInt, TVec<TPair<TStr, TStr> > >& EdgeAttrMap) {
+  const int CrossNets = CrossNetTypes.Len();
+  // modes in the order of their first appearance
+  TIntV ModeIdV;
+  TIntH ModeNH;
+  for (int c = 0; c < CrossNets; c++) {
+    TCrossNet& CrossNet = GetCrossNetById(CrossNetTypes[c]);
+    if (! ModeNH.IsKey(CrossNet.GetMode1())) { ModeNH.AddDat(CrossNet.GetMode1(), ModeIdV.Add(CrossNet.GetMode1())); }
+    if (! ModeNH.IsKey(CrossNet.GetMode2())) { ModeNH.AddDat(CrossNet.GetMode2(), ModeIdV.Add(CrossNet.GetMode2())); }
+  }
+  const int Modes = ModeIdV.Len();
+  TIntV NodeOffV(Modes+1);
+  NodeOffV[0] = 0;
+  for (int m = 0; m < Modes; m++) {
+    NodeOffV[m+1] = NodeOffV[m] + GetModeNetById(ModeIdV[m]).GetNodes();
+  }
+  const int Nodes = NodeOffV[Modes];
+  // KeyNIdVV[m][KeyId] is the new id of the node with hash key KeyId in mode m
+  TVec<TIntV> KeyNIdVV(Modes);
+  TIntV NodeModeV(Nodes), NodeIdV(Nodes);
+#ifdef USE_OPENMP
+  #pragma omp parallel for schedule(dynamic, 1)
+#endif
+  for (int m = 0; m < Modes; m++) {
+    TModeNet& ModeNet = GetModeNetById(ModeIdV[m]);
+    TIntV& KeyNIdV = KeyNIdVV[m];
+    KeyNIdV.Gen(ModeNet.NodeH.GetMxKeyIds());
+    KeyNIdV.PutAll(-1);
+    int NId = NodeOffV[m];
+    for (int KeyId = ModeNet.NodeH.FFirstKeyId(); ModeNet.NodeH.FNextKeyId(KeyId); ) {
+      KeyNIdV[KeyId] = NId;
+      NodeModeV[NId] = ModeIdV[m];
+      NodeIdV[NId] = ModeNet.NodeH.GetKey(KeyId);
+      NId++;
+    }
+  }
+  TIntV EdgeOffV(CrossNets+1);
+  TVec<TIntV> EKeyVV(CrossNets);
+  EdgeOffV[0] = 0;
+  for (int c = 0; c < CrossNets; c++) {
+    TCrossNet& CrossNet = GetCrossNetById(CrossNetTypes[c]);
+    EKeyVV[c].Reserve(CrossNet.GetEdges());
+    for (int KeyId = CrossNet.CrossH.FFirstKeyId(); CrossNet.CrossH.FNextKeyId(KeyId); ) {
+      EKeyVV[c].Add(KeyId);
+    }
+    const int Factor = CrossNet.IsDirected() ? 1 : 2;
+    EdgeOffV[c+1] = EdgeOffV[c] + Factor*EKeyVV[c].Len();
+  }
+  const int Edges = EdgeOffV[CrossNets];
+  TIntV SrcV(Edges), DstV(Edges), EIdV(Edges), EdgeCrossV(Edges), EdgeIdV(Edges);
+  for (int c = 0; c < CrossNets; c++) {
+    TCrossNet& CrossNet = GetCrossNetById(CrossNetTypes[c]);
+    const TModeNet& Mode1Net = GetModeNetById(CrossNet.GetMode1());
+    const TModeNet& Mode2Net = GetModeNetById(CrossNet.GetMode2());
+    const TIntV& KeyNIdV1 = KeyNIdVV[ModeNH.GetDat(CrossNet.GetMode1())];
+    const TIntV& KeyNIdV2 = KeyNIdVV[ModeNH.GetDat(CrossNet.GetMode2())];
+    const TIntV& EKeyV = EKeyVV[c];
+    const int Factor = CrossNet.IsDirected() ? 1 : 2;
+    const int EdgeOff = EdgeOffV[c];
+    const int CrossId = CrossNetTypes[c];
+#ifdef USE_OPENMP
+    #pragma omp parallel for schedule(static)
+#endif
+    for (int i = 0; i < EKeyV.Len(); i++) {
+      const TCrossNet::TCrossEdge& Edge = CrossNet.CrossH[EKeyV[i]];
+      const int SrcNId = KeyNIdV1[Mode1Net.NodeH.GetKeyId(Edge.GetSrcNId())];
+      const int DstNId = KeyNIdV2[Mode2Net.NodeH.GetKeyId(Edge.GetDstNId())];
+      const int EId = EdgeOff + Factor*i;
+      SrcV[EId] = SrcNId;  DstV[EId] = DstNId;
+      EIdV[EId] = EId;  EdgeCrossV[EId] = CrossId;  EdgeIdV[EId] = Edge.GetId();
+      if (Factor == 2) {
+        SrcV[EId+1] = DstNId;  DstV[EId+1] = SrcNId;
+        EIdV[EId+1] = EId+1;  EdgeCrossV[EId+1] = CrossId;  EdgeIdV[EId+1] = Edge.GetId();
+      }
+    }
+  }
+
+  PNEANet NewNet = TNEANet::New(Nodes, Edges);
+  for (int NId = 0; NId < Nodes; NId++) { NewNet->AddNode(NId); }
+  NewNet->AddEdgeV(SrcV, DstV, EIdV);
+  // node and edge ids equal their hash keys, so columns are filled in id order
+  NewNet->AddIntAttrN(TStr("Mode"));
+  NewNet->AddIntAttrN(TStr("Id"));
+  NewNet->AddIntAttrE(TStr("CrossNet"));
+  NewNet->AddIntAttrE(TStr("Id"));
+  NewNet->GetIntAttrHndN(TStr("Mode")).SetColV(NodeModeV);
+  NewNet->GetIntAttrHndN(TStr("Id")).SetColV(NodeIdV);
+  NewNet->GetIntAttrHndE(TStr("CrossNet")).SetColV(EdgeCrossV);
+  NewNet->GetIntAttrHndE(TStr("Id")).SetColV(EdgeIdV);
+
+  TStrIntH NodeAttrTypeH, EdgeAttrTypeH;
+  for (int m = 0; m < Modes; m++) {
+    if (! NodeAttrMap.IsKey(ModeIdV[m])) { continue; }
+    TModeNet& ModeNet = GetModeNetById(ModeIdV[m]);
+    const TStrPrV& Attrs = NodeAttrMap.GetDat(ModeIdV[m]);
+    for (int a = 0; a < Attrs.Len(); a++) {
+      CopyNodeAttrMP(NewNet, ModeNet, KeyNIdVV[m], Attrs[a].Val1, Attrs[a].Val2, NodeAttrTypeH);
+    }
+  }
+  for (int c = 0; c < CrossNets; c++) {
+    if (! EdgeAttrMap.IsKey(CrossNetTypes[c])) { continue; }
+    TCrossNet& CrossNet = GetCrossNetById(CrossNetTypes[c]);
+    const TStrPrV& Attrs = EdgeAttrMap.GetDat(CrossNetTypes[c]);
+    const int Factor = CrossNet.IsDirected() ? 1 : 2;
+    for (int a = 0; a < Attrs.Len(); a++) {
+      CopyEdgeAttrMP(NewNet, CrossNet, EKeyVV[c], EdgeOffV[c], Factor, Attrs[a].Val1, Attrs[a].Val2, EdgeAttrTypeH);
+    }
+  }
+  return NewNet;
+}
+
+// Copies node attribute OrigAttr of Net to NewAttr of NewNet, KeyNIdV maps node keys of Net to new node ids.
+// Int, Flt and dictionary-encoded columns are copied in parallel, TStr values are copied sequentially since
+// their reference counts are not thread safe.
+void TMMNet::CopyNodeAttrMP(PNEANet& NewNet, TModeNet& Net, const TIntV& KeyNIdV, const TStr& OrigAttr, const TStr& NewAttr, TStrIntH& NewAttrTypeH) {
+  const int Type = Net.GetAttrTypeN(OrigAttr);
+  if (Type == -1) { return; }
+  if (! NewAttrTypeH.IsKey(NewAttr)) {
+    NewAttrTypeH.AddDat(NewAttr, Type);
+    if (Type == TModeNet::IntType) {
+      NewNet->AddIntAttrN(NewAttr, Net.GetIntAttrDefaultN(OrigAttr));
+    } else if (Type == TModeNet::FltType) {
+      NewNet->AddFltAttrN(NewAttr, Net.GetFltAttrDefaultN(OrigAttr));
+    } else if (Type == TModeNet::StrType || Type == TModeNet::DictStrType) {
+      NewNet->AddStrAttrN(NewAttr, Net.GetStrAttrDefaultN(OrigAttr), Type == TModeNet::DictStrType);
+    } else if (Type == TModeNet::IntVType) {
+      NewNet->AddIntVAttrN(NewAttr);
+    }
+  }
+  const int NewType = NewAttrTypeH.GetDat(NewAttr);
+  const int Keys = KeyNIdV.Len();
+  if (Type == TModeNet::IntType && NewType == TNEANet::IntType) {
+    TNEANet::TIntAttrHnd SrcH = Net.GetIntAttrHndN(OrigAttr);
+    TNEANet::TIntAttrHnd DstH = NewNet->GetIntAttrHndN(NewAttr);
+#ifdef USE_OPENMP
+    #pragma omp parallel for schedule(static)
+#endif
+    for (int KeyId = 0; KeyId < Keys; KeyId++) {
+      if (KeyNIdV[KeyId] != -1) { DstH[KeyNIdV[KeyId]] = SrcH[KeyId]; }
+    }
+  } else if (Type == TModeNet::FltType && NewType == TNEANet::FltType) {
+    TNEANet::TFltAttrHnd SrcH = Net.GetFltAttrHndN(OrigAttr);
+    TNEANet::TFltAttrHnd DstH = NewNet->GetFltAttrHndN(NewAttr);
+#ifdef USE_OPENMP
+    #pragma omp parallel for schedule(static)
+#endif
+    for (int KeyId = 0; KeyId < Keys; KeyId++) {
+      if (KeyNIdV[KeyId] != -1) { DstH[KeyNIdV[KeyId]] = SrcH[KeyId]; }
+    }
+  } else if (Type == TModeNet::DictStrType && NewType == TNEANet::DictStrType) {
+    TIntV CodeMapV;
+    NewNet->GetStrCodeMap(Net, CodeMapV);
+    TNEANet::TIntAttrHnd SrcH = Net.GetStrCodeHndN(OrigAttr);
+    TNEANet::TIntAttrHnd DstH = NewNet->GetStrCodeHndN(NewAttr);
+#ifdef USE_OPENMP
+    #pragma omp parallel for schedule(static)
+#endif
+    for (int KeyId = 0; KeyId < Keys; KeyId++) {
+      if (KeyNIdV[KeyId] == -1) { continue; }
+      const int Code = SrcH[KeyId];
+      DstH[KeyNIdV[KeyId]] = Code < 0 ? Code : CodeMapV[Code].Val;
+    }
+  } else if (Type == TModeNet::StrType && NewType == TNEANet::StrType) {
+    TNEANet::TStrAttrHnd SrcH = Net.GetStrAttrHndN(OrigAttr);
+    TNEANet::TStrAttrHnd DstH = NewNet->GetStrAttrHndN(NewAttr);
+    for (int KeyId = 0; KeyId < Keys; KeyId++) {
+      if (KeyNIdV[KeyId] != -1) { DstH[KeyNIdV[KeyId]] = SrcH[KeyId]; }
+    }
+  } else {
+    // IntV values and string columns of differing encodings go through the attribute interface
+    IAssertR(NewType == Type || ((NewType == TNEANet::StrType || NewType == TNEANet::DictStrType) &&
+      (Type == TModeNet::StrType || Type == TModeNet::DictStrType)), TStr::Fmt("Attribute %s has differing types", NewAttr.CStr()));
+    for (int KeyId = 0; KeyId < Keys; KeyId++) {
+      if (KeyNIdV[KeyId] == -1) { continue; }
+      const int OldNId = Net.NodeH.GetKey(KeyId);
+      if (Type == TModeNet::IntVType) {
+        NewNet->AddIntVAttrDatN(KeyNIdV[KeyId], Net.GetIntVAttrDatN(OldNId, OrigAttr), NewAttr);
+      } else {
+        NewNet->AddStrAttrDatN(KeyNIdV[KeyId], Net.GetStrAttrDatN(OldNId, OrigAttr), NewAttr);
+      }
+    }
+  }
+}
+
+// Copies edge attribute OrigAttr of Net to NewAttr of NewNet, the i-th edge key of EKeyV maps to new edge id
+// EdgeOff+Factor*i and, for undirected cross nets, also to the reverse edge EdgeOff+Factor*i+1.
+void TMMNet::CopyEdgeAttrMP(PNEANet& NewNet, TCrossNet& Net, const TIntV& EKeyV, const int& EdgeOff, const int& Factor, const TStr& OrigAttr, const TStr& NewAttr, TStrIntH& NewAttrTypeH) {
+  if (! Net.KeyToIndexTypeE.IsKey(OrigAttr)) { return; }
+  const int Type = Net.KeyToIndexTypeE.GetDat(OrigAttr).Val1;
+  const int Index = Net.KeyToIndexTypeE.GetDat(OrigAttr).Val2;
+  if (! NewAttrTypeH.IsKey(NewAttr)) {
+    if (Type == TCrossNet::IntType) {
+      NewAttrTypeH.AddDat(NewAttr, TNEANet::IntType);
+      NewNet->AddIntAttrE(NewAttr, Net.GetIntAttrDefaultE(OrigAttr));
+    } else if (Type == TCrossNet::FltType) {
+      NewAttrTypeH.AddDat(NewAttr, TNEANet::FltType);
+      NewNet->AddFltAttrE(NewAttr, Net.GetFltAttrDefaultE(OrigAttr));
+    } else {
+      NewAttrTypeH.AddDat(NewAttr, TNEANet::StrType);
+      NewNet->AddStrAttrE(NewAttr, Net.GetStrAttrDefaultE(OrigAttr));
+    }
+  }
+  const int NewType = NewAttrTypeH.GetDat(NewAttr);
+  const int Keys = EKeyV.Len();
+  if (Type == TCrossNet::IntType) {
+    IAssertR(NewType == TNEANet::IntType, TStr::Fmt("Attribute %s has differing types", NewAttr.CStr()));
+    const TIntV& SrcV = Net.VecOfIntVecsE[Index];
+    TNEANet::TIntAttrHnd DstH = NewNet->GetIntAttrHndE(NewAttr);
+#ifdef USE_OPENMP
+    #pragma omp parallel for schedule(static)
+#endif
+    for (int i = 0; i < Keys; i++) {
+      const int EId = EdgeOff + Factor*i;
+      DstH[EId] = SrcV[EKeyV[i]];
+      if (Factor == 2) { DstH[EId+1] = SrcV[EKeyV[i]]; }
+    }
+  } else if (Type == TCrossNet::FltType) {
+    IAssertR(NewType == TNEANet::FltType, TStr::Fmt("Attribute %s has differing types", NewAttr.CStr()));
+    const TFltV& SrcV = Net.VecOfFltVecsE[Index];
+    TNEANet::TFltAttrHnd DstH = NewNet->GetFltAttrHndE(NewAttr);
+#ifdef USE_OPENMP
+    #pragma omp parallel for schedule(static)
+#endif
+    for (int i = 0; i < Keys; i++) {
+      const int EId = EdgeOff + Factor*i;
+      DstH[EId] = SrcV[EKeyV[i]];
+      if (Factor == 2) { DstH[EId+1] = SrcV[EKeyV[i]]; }
+    }
+  } else {
+    IAssertR(NewType == TNEANet::StrType, TStr::Fmt("Attribute %s has differing types", NewAttr.CStr()));
+    const TStrV& SrcV = Net.VecOfStrVecsE[Index];
+    TNEANet::TStrAttrHnd DstH = NewNet->GetStrAttrHndE(NewAttr);
+    for (int i = 0; i < Keys; i++) {
+      const int EId = EdgeOff + Factor*i;
+      DstH[EId] = SrcV[EKeyV[i]];
+      if (Factor == 2) { DstH[EId+1] = SrcV[EKeyV[i]]; }
+    }
+  }
+}
+
 void TMMNet::GetPartitionRanges(TIntPrV& Partitions, const TInt& NumPartitions, const TInt& MxLen) const {
   if (MxLen <= NumPartitions) {
       Partitions.Add(TIntPr(0,MxLen));
@@ -1325,7 +1864,7 @@ int TMMNet::AddNodeAttributes(PNEANet& NewNet, TModeNet& Net, TVec<TPair<TStr, T
       TIntPr OldNId(ModeId, oldId);
       TFlt Val = Net.GetFltAttrDatN(oldId, OrigAttr);
       NewNet->AddFltAttrDatN(NId, Val, NewAttr);
-    } else if (type == TModeNet::StrType) {
+    } else if (type == TModeNet::StrType || type == TModeNet::DictStrType) {
       TIntPr OldNId(ModeId, oldId);
       TStr Val = Net.GetStrAttrDatN(oldId, OrigAttr);
       NewNet->AddStrAttrDatN(NId, Val, NewAttr);
@@ -94,7 +94,7 @@ public:
       VecOfStrVecsN=Graph.VecOfStrVecsN; VecOfStrVecsE=Graph.VecOfStrVecsE; VecOfFltVecsN=Graph.VecOfFltVecsN; VecOfFltVecsE=Graph.VecOfFltVecsE;
       VecOfIntVecVecsN=Graph.VecOfIntVecVecsN; VecOfIntVecVecsE=Graph.VecOfIntVecVecsE; 
       VecOfIntHashVecsN = Graph.VecOfIntHashVecsN; VecOfIntHashVecsE = Graph.VecOfIntHashVecsE; SAttrN=Graph.SAttrN; SAttrE=Graph.SAttrE;
-      ModeId=Graph.ModeId; MMNet=Graph.MMNet; NeighborTypes=Graph.NeighborTypes;
+      StrPoolH=Graph.StrPoolH; ModeId=Graph.ModeId; MMNet=Graph.MMNet; NeighborTypes=Graph.NeighborTypes;
     }
     return *this; 
   }
@@ -657,10 +657,19 @@ public:
   ///Gets the induced subgraph given a vector of mode type names.
   PMMNet GetSubgraphByModeNet(TStrV& ModeNetTypes);
 
+  /// Counts the instances of metapath CrossNetNames from each node SrcNIdV[i] of mode SrcModeName into PathCntHV[i]. If TopK > 0, only the TopK largest counts are kept after each hop. Returns the id of the mode the metapath ends in. ##TMMNet::GetMetaPathCnt
+  int GetMetaPathCnt(const TStr& SrcModeName, const TStrV& CrossNetNames, const TIntV& SrcNIdV, TVec<TIntFltH>& PathCntHV, const int& TopK=-1) const;
+  /// Gets the sorted IDs of the nodes reachable by metapath CrossNetNames from each node SrcNIdV[i] of mode SrcModeName. Returns the id of the mode the metapath ends in. ##TMMNet::GetMetaPathNbrs
+  int GetMetaPathNbrs(const TStr& SrcModeName, const TStrV& CrossNetNames, const TIntV& SrcNIdV, TVec<TIntV>& NbrNIdVV) const;
+  /// Computes PathSim similarities between each node SrcNIdV[i] and the nodes it reaches by metapath CrossNetNames, which starts and ends in mode ModeName. ##TMMNet::GetPathSim
+  void GetPathSim(const TStr& ModeName, const TStrV& CrossNetNames, const TIntV& SrcNIdV, TVec<TIntFltH>& PathSimHV, const int& TopK=-1) const;
+
   /// Converts multimodal network to TNEANet; as attr names can collide, AttrMap specifies the (Mode/Cross Id, old att name, new attr name)
   PNEANet ToNetwork(TIntV& CrossNetTypes, TIntStrStrTrV& NodeAttrMap, TVec<TTriple<TInt, TStr, TStr> >& EdgeAttrMap);
   /// Converts multimodal network to TNEANet; as attr names can collide, AttrMap specifies the Mode/Cross Id -> vec of pairs (old att name, new attr name)
   PNEANet ToNetwork2(TIntV& CrossNetTypes, TIntStrPrVH& NodeAttrMap, THash<TInt, TVec<TPair<TStr, TStr> > >& EdgeAttrMap);
+  /// Converts multimodal network to TNEANet like ToNetwork2, but assigns node and edge ids up front and builds the network and its attribute columns in parallel. ##TMMNet::ToNetwork2MP
+  PNEANet ToNetwork2MP(TIntV& CrossNetTypes, TIntStrPrVH& NodeAttrMap, THash<TInt, TVec<TPair<TStr, TStr> > >& EdgeAttrMap);
 
   #ifdef GCC_ATOMIC
   PNEANetMP ToNetworkMP(TStrV& CrossNetNames);
@@ -672,6 +681,13 @@ private:
   int AddCrossNet(const TStr& CrossNetName, const TInt& CrossNetId, const TCrossNet& CrossNet);
   int AddNodeAttributes(PNEANet& NewNet, TModeNet& Net, TVec<TPair<TStr, TStr> >& Attrs, int ModeId, int oldId, int NId);
   int AddEdgeAttributes(PNEANet& NewNet, TCrossNet& Net, TVec<TPair<TStr, TStr> >& Attrs, int CrossId, int oldId, int EId);
+  void CopyNodeAttrMP(PNEANet& NewNet, TModeNet& Net, const TIntV& KeyNIdV, const TStr& OrigAttr, const TStr& NewAttr, TStrIntH& NewAttrTypeH);
+  void CopyEdgeAttrMP(PNEANet& NewNet, TCrossNet& Net, const TIntV& EKeyV, const int& EdgeOff, const int& Factor, const TStr& OrigAttr, const TStr& NewAttr, TStrIntH& NewAttrTypeH);
+  int GetMetaPathAdj(const TStr& SrcModeName, const TStrV& CrossNetNames, TIntV& ModeIdV, TIntV& HopAdjV, TVec<TIntV>& OffVV, TVec<TIntV>& NbrVV) const;
+  void GetCrossNetAdj(const TCrossNet& CrossNet, const int& Dir, TIntV& OffV, TIntV& NbrV) const;
+  void GetMetaPathAcc(const TIntV& ModeIdV, TVec<TFltV>& AccVV) const;
+  static void GetMetaPathRow(const TIntV& HopAdjV, const TVec<TIntV>& OffVV, const TVec<TIntV>& NbrVV, const int& BegHop, const int& EndHop,
+    const int& SrcKeyId, const int& TopK, TVec<TFltV>& AccVV, TIntV& KeyV, TFltV& CntV);
   void GetPartitionRanges(TIntPrV& Partitions, const TInt& NumPartitions, const TInt& MxVal) const;
 };
 
@@ -17,7 +17,7 @@ void TNEANet::LoadNetworkShM(TShMIn& ShMIn) {
   IntDefaultsE.LoadShM(ShMIn);
   StrDefaultsN.LoadShM(ShMIn);
   StrDefaultsE.LoadShM(ShMIn);
-  FltDefaultsE.LoadShM(ShMIn);
+  FltDefaultsN.LoadShM(ShMIn);
   FltDefaultsE.LoadShM(ShMIn);
 
   LoadVecFunctor vec_fn;
@@ -40,6 +40,7 @@ void TNEANet::LoadNetworkShM(TShMIn& ShMIn) {
   /* Attributes are complicated so load these straight */
   SAttrN.Load(ShMIn);
   SAttrE.Load(ShMIn);
+  StrPoolH.LoadShM(ShMIn, true);
 }
 
 // Attribute Node Edge Network
@@ -140,7 +141,7 @@ void TNEANet::IntVAttrValueNI(const TInt& NId, TStrIntPrH::TIter NodeHI, TVec<TI
 void TNEANet::StrAttrNameNI(const TInt& NId, TStrIntPrH::TIter NodeHI, TStrV& Names) const {
   Names = TVec<TStr>();
   while (!NodeHI.IsEnd()) {
-    if (NodeHI.GetDat().Val1 == StrType && !NodeAttrIsStrDeleted(NId, NodeHI)) {
+    if ((NodeHI.GetDat().Val1 == StrType || NodeHI.GetDat().Val1 == DictStrType) && !NodeAttrIsStrDeleted(NId, NodeHI)) {
       Names.Add(NodeHI.GetKey());
     }
     NodeHI++;
@@ -153,6 +154,8 @@ void TNEANet::StrAttrValueNI(const TInt& NId, TStrIntPrH::TIter NodeHI, TStrV& V
     if (NodeHI.GetDat().Val1 == StrType && !NodeAttrIsStrDeleted(NId, NodeHI)) {
       TStr val = this->VecOfStrVecsN.GetVal(NodeHI.GetDat().Val2).GetVal(NodeH.GetKeyId(NId));
       Values.Add(val);
+    } else if (NodeHI.GetDat().Val1 == DictStrType && !NodeAttrIsStrDeleted(NId, NodeHI)) {
+      Values.Add(GetStrByCode(this->VecOfIntVecsN.GetVal(NodeHI.GetDat().Val2).GetVal(NodeH.GetKeyId(NId))));
     }
     NodeHI++;
   }  
@@ -228,6 +231,10 @@ bool TNEANet::NodeAttrIsIntVDeleted(const int& NId, const TStrIntPrH::TIter& Nod
 }
 
 bool TNEANet::NodeAttrIsStrDeleted(const int& NId, const TStrIntPrH::TIter& NodeHI) const {
+  if (NodeHI.GetDat().Val1 == DictStrType) {
+    return IntDefaultsN.GetDat(NodeHI.GetKey()) == this->VecOfIntVecsN.GetVal(
+      NodeHI.GetDat().Val2).GetVal(NodeH.GetKeyId(NId));
+  }
   if (NodeHI.GetDat().Val1 != StrType) {
     return false;
   }
@@ -250,6 +257,8 @@ TStr TNEANet::GetNodeAttrValue(const int& NId, const TStrIntPrH::TIter& NodeHI)
   } else if(NodeHI.GetDat().Val1 == StrType) {
     return this->VecOfStrVecsN.GetVal(
     this->KeyToIndexTypeN.GetDat(NodeHI.GetKey()).Val2).GetVal(NodeH.GetKeyId(NId));
+  } else if (NodeHI.GetDat().Val1 == DictStrType) {
+    return GetStrByCode(this->VecOfIntVecsN.GetVal(NodeHI.GetDat().Val2).GetVal(NodeH.GetKeyId(NId)));
   } else if (NodeHI.GetDat().Val1 == FltType) {
     return (this->VecOfFltVecsN.GetVal(
       this->KeyToIndexTypeN.GetDat(NodeHI.GetKey()).Val2).GetVal(NodeH.GetKeyId(NId))).GetStr();
@@ -332,7 +341,7 @@ void TNEANet::IntVAttrValueEI(const TInt& EId, TStrIntPrH::TIter EdgeHI, TVec<TI
 void TNEANet::StrAttrNameEI(const TInt& EId, TStrIntPrH::TIter EdgeHI, TStrV& Names) const {
   Names = TVec<TStr>();
   while (!EdgeHI.IsEnd()) {
-    if (EdgeHI.GetDat().Val1 == StrType && !EdgeAttrIsStrDeleted(EId, EdgeHI)) {
+    if ((EdgeHI.GetDat().Val1 == StrType || EdgeHI.GetDat().Val1 == DictStrType) && !EdgeAttrIsStrDeleted(EId, EdgeHI)) {
       Names.Add(EdgeHI.GetKey());
     }
     EdgeHI++;
@@ -345,6 +354,8 @@ void TNEANet::StrAttrValueEI(const TInt& EId, TStrIntPrH::TIter EdgeHI, TStrV& V
     if (EdgeHI.GetDat().Val1 == StrType && !EdgeAttrIsStrDeleted(EId, EdgeHI)) {
       TStr val = this->VecOfStrVecsE.GetVal(EdgeHI.GetDat().Val2).GetVal(EId);
       Values.Add(val);
+    } else if (EdgeHI.GetDat().Val1 == DictStrType && !EdgeAttrIsStrDeleted(EId, EdgeHI)) {
+      Values.Add(GetStrByCode(this->VecOfIntVecsE.GetVal(EdgeHI.GetDat().Val2).GetVal(EdgeH.GetKeyId(EId))));
     }
     EdgeHI++;
   }  
@@ -416,6 +427,10 @@ bool TNEANet::EdgeAttrIsIntVDeleted(const int& EId, const TStrIntPrH::TIter& Edg
 }
 
 bool TNEANet::EdgeAttrIsStrDeleted(const int& EId, const TStrIntPrH::TIter& EdgeHI) const {
+  if (EdgeHI.GetDat().Val1 == DictStrType) {
+    return IntDefaultsE.GetDat(EdgeHI.GetKey()) == this->VecOfIntVecsE.GetVal(
+      EdgeHI.GetDat().Val2).GetVal(EdgeH.GetKeyId(EId));
+  }
   return (EdgeHI.GetDat().Val1 == StrType &&
     GetStrAttrDefaultE(EdgeHI.GetKey()) == this->VecOfStrVecsE.GetVal(
     this->KeyToIndexTypeE.GetDat(EdgeHI.GetKey()).Val2).GetVal(EdgeH.GetKeyId(EId)));
@@ -434,6 +449,8 @@ TStr TNEANet::GetEdgeAttrValue(const int& EId, const TStrIntPrH::TIter& EdgeHI)
   } else if(EdgeHI.GetDat().Val1 == StrType) {
     return this->VecOfStrVecsE.GetVal(
     this->KeyToIndexTypeE.GetDat(EdgeHI.GetKey()).Val2).GetVal(EdgeH.GetKeyId(EId));
+  } else if (EdgeHI.GetDat().Val1 == DictStrType) {
+    return GetStrByCode(this->VecOfIntVecsE.GetVal(EdgeHI.GetDat().Val2).GetVal(EdgeH.GetKeyId(EId)));
   } else if (EdgeHI.GetDat().Val1 == FltType) {
     return (this->VecOfFltVecsE.GetVal(
       this->KeyToIndexTypeE.GetDat(EdgeHI.GetKey()).Val2).GetVal(EdgeH.GetKeyId(EId))).GetStr();
@@ -689,6 +706,55 @@ int TNEANet::AddEdge(const int& SrcNId, const int& DstNId, int EId) {
   return EId;
 }
 
+void TNEANet::AddEdgeV(const TIntV& SrcNIdV, const TIntV& DstNIdV, const TIntV& EIdV) {
+  const int Edges = EIdV.Len();
+  IAssert(SrcNIdV.Len() == Edges && DstNIdV.Len() == Edges);
+  // attribute columns are extended one edge at a time
+  if (! KeyToIndexTypeE.Empty()) {
+    for (int e = 0; e < Edges; e++) { AddEdge(SrcNIdV[e], DstNIdV[e], EIdV[e]); }
+    return;
+  }
+  TIntV SrcKeyV(Edges), DstKeyV(Edges);
+#ifdef USE_OPENMP
+  #pragma omp parallel for schedule(static)
+#endif
+  for (int e = 0; e < Edges; e++) {
+    SrcKeyV[e] = NodeH.GetKeyId(SrcNIdV[e]);
+    DstKeyV[e] = NodeH.GetKeyId(DstNIdV[e]);
+  }
+  if (EdgeH.Empty()) { EdgeH.Gen(Edges); }
+  for (int e = 0; e < Edges; e++) {
+    const int EId = EIdV[e];
+    IAssertR(SrcKeyV[e] != -1 && DstKeyV[e] != -1, TStr::Fmt("%d or %d not a node.", SrcNIdV[e].Val, DstNIdV[e].Val).CStr());
+    IAssertR(! IsEdge(EId), TStr::Fmt("EdgeId %d already exists", EId));
+    EdgeH.AddDat(EId, TEdge(EId, SrcNIdV[e], DstNIdV[e]));
+    MxEId = TMath::Mx(EId+1, MxEId());
+  }
+  // bucket the edges by node, then append each bucket to the node's edge list
+  const int MxKeyId = NodeH.GetMxKeyIds();
+  for (int Dir = 0; Dir < 2; Dir++) {
+    const TIntV& KeyV = Dir == 0 ? SrcKeyV : DstKeyV;
+    TIntV StartV(MxKeyId+1);  StartV.PutAll(0);
+    for (int e = 0; e < Edges; e++) { StartV[KeyV[e]+1] += 1; }
+    for (int k = 0; k < MxKeyId; k++) { StartV[k+1] += StartV[k]; }
+    TIntV PosV(StartV), BucketV(Edges);
+    for (int e = 0; e < Edges; e++) {
+      const int KeyId = KeyV[e];
+      BucketV[PosV[KeyId]] = EIdV[e];  PosV[KeyId] += 1;
+    }
+#ifdef USE_OPENMP
+    #pragma omp parallel for schedule(dynamic, 1024)
+#endif
+    for (int k = 0; k < MxKeyId; k++) {
+      if (StartV[k] == StartV[k+1]) { continue; }
+      TIntV& EIdV1 = Dir == 0 ? NodeH[k].OutEIdV : NodeH[k].InEIdV;
+      EIdV1.Reserve(EIdV1.Len() + StartV[k+1] - StartV[k]);
+      for (int i = StartV[k]; i < StartV[k+1]; i++) { EIdV1.Add(BucketV[i]); }
+      if (! EIdV1.IsSorted()) { EIdV1.Sort(); }
+    }
+  }
+}
+
 void TNEANet::DelEdge(const int& EId) {
   int i;
 
@@ -991,7 +1057,9 @@ int TNEANet::AddStrAttrDatN(const int& NId, const TStr& value, const TStr& attr)
     // AddNode(NId);
     return -1;
   }
-  if (KeyToIndexTypeN.IsKey(attr)) {
+  if (KeyToIndexTypeN.IsKey(attr) && KeyToIndexTypeN.GetDat(attr).Val1 == DictStrType) {
+    VecOfIntVecsN[KeyToIndexTypeN.GetDat(attr).Val2][NodeH.GetKeyId(NId)] = StrPoolH.AddKey(value);
+  } else if (KeyToIndexTypeN.IsKey(attr)) {
     TVec<TStr>& NewVec = VecOfStrVecsN[KeyToIndexTypeN.GetDat(attr).Val2];
     NewVec[NodeH.GetKeyId(NId)] = value;
   } else {
@@ -1102,7 +1170,9 @@ int TNEANet::AddStrAttrDatE(const int& EId, const TStr& value, const TStr& attr)
     //AddEdge(EId);
      return -1;
   }
-  if (KeyToIndexTypeE.IsKey(attr)) {
+  if (KeyToIndexTypeE.IsKey(attr) && KeyToIndexTypeE.GetDat(attr).Val1 == DictStrType) {
+    VecOfIntVecsE[KeyToIndexTypeE.GetDat(attr).Val2][EdgeH.GetKeyId(EId)] = StrPoolH.AddKey(value);
+  } else if (KeyToIndexTypeE.IsKey(attr)) {
     TVec<TStr>& NewVec = VecOfStrVecsE[KeyToIndexTypeE.GetDat(attr).Val2];
     NewVec[EdgeH.GetKeyId(EId)] = value;
   } else {
@@ -1161,7 +1231,11 @@ TIntV TNEANet::GetIntVAttrDatN(const int& NId, const TStr& attr) const {
 }
 
 TStr TNEANet::GetStrAttrDatN(const int& NId, const TStr& attr) {
-  return VecOfStrVecsN[KeyToIndexTypeN.GetDat(attr).Val2][NodeH.GetKeyId(NId)];
+  const TIntPr& TypeIdx = KeyToIndexTypeN.GetDat(attr);
+  if (TypeIdx.Val1 == DictStrType) {
+    return GetStrByCode(VecOfIntVecsN[TypeIdx.Val2][NodeH.GetKeyId(NId)]);
+  }
+  return VecOfStrVecsN[TypeIdx.Val2][NodeH.GetKeyId(NId)];
 }
 
 TFlt TNEANet::GetFltAttrDatN(const int& NId, const TStr& attr) {
@@ -1199,7 +1273,11 @@ TIntV TNEANet::GetIntVAttrDatE(const int& EId, const TStr& attr) {
 }
 
 TStr TNEANet::GetStrAttrDatE(const int& EId, const TStr& attr) {
-  return VecOfStrVecsE[KeyToIndexTypeE.GetDat(attr).Val2][EdgeH.GetKeyId(EId)];
+  const TIntPr& TypeIdx = KeyToIndexTypeE.GetDat(attr);
+  if (TypeIdx.Val1 == DictStrType) {
+    return GetStrByCode(VecOfIntVecsE[TypeIdx.Val2][EdgeH.GetKeyId(EId)]);
+  }
+  return VecOfStrVecsE[TypeIdx.Val2][EdgeH.GetKeyId(EId)];
 }
 
 TFlt TNEANet::GetFltAttrDatE(const int& EId, const TStr& attr) {
@@ -1232,6 +1310,8 @@ int TNEANet::DelAttrDatN(const int& NId, const TStr& attr) {
     VecOfIntVecsN[KeyToIndexTypeN.GetDat(attr).Val2][NodeH.GetKeyId(NId)] = GetIntAttrDefaultN(attr);
   } else if (vecType == StrType) {
     VecOfStrVecsN[KeyToIndexTypeN.GetDat(attr).Val2][NodeH.GetKeyId(NId)] = GetStrAttrDefaultN(attr);
+  } else if (vecType == DictStrType) {
+    VecOfIntVecsN[KeyToIndexTypeN.GetDat(attr).Val2][NodeH.GetKeyId(NId)] = IntDefaultsN.GetDat(attr);
   } else if (vecType == FltType) {
     VecOfFltVecsN[KeyToIndexTypeN.GetDat(attr).Val2][NodeH.GetKeyId(NId)] = GetFltAttrDefaultN(attr);
   } else if (vecType ==IntVType) {
@@ -1251,6 +1331,8 @@ int TNEANet::DelAttrDatE(const int& EId, const TStr& attr) {
     VecOfIntVecsE[KeyToIndexTypeE.GetDat(attr).Val2][EdgeH.GetKeyId(EId)] = GetIntAttrDefaultE(attr);
   } else if (vecType == StrType) {
     VecOfStrVecsE[KeyToIndexTypeE.GetDat(attr).Val2][EdgeH.GetKeyId(EId)] = GetStrAttrDefaultE(attr);
+  } else if (vecType == DictStrType) {
+    VecOfIntVecsE[KeyToIndexTypeE.GetDat(attr).Val2][EdgeH.GetKeyId(EId)] = IntDefaultsE.GetDat(attr);
   } else if (vecType == FltType) {
     VecOfFltVecsE[KeyToIndexTypeE.GetDat(attr).Val2][EdgeH.GetKeyId(EId)] = GetFltAttrDefaultE(attr);
   } else if (vecType == IntVType) {
@@ -1300,10 +1382,23 @@ int TNEANet::AddIntVAttrN(const TStr& attr, TBool UseDense){
   return 0;
 }
 
-int TNEANet::AddStrAttrN(const TStr& attr, TStr defaultValue) {
+int TNEANet::AddStrAttrN(const TStr& attr, TStr defaultValue, TBool UseDict) {
   int i;
   TInt CurrLen;
   TVec<TStr> NewVec;
+  if (UseDict) {
+    if (KeyToIndexTypeN.IsKey(attr)) {
+      return -1;
+    }
+    const int DefaultCode = StrPoolH.AddKey(defaultValue);
+    CurrLen = VecOfIntVecsN.Len();
+    KeyToIndexTypeN.AddDat(attr, TIntPr(DictStrType, CurrLen));
+    TIntV CodeV(MxNId);
+    CodeV.PutAll(DefaultCode);
+    VecOfIntVecsN.Add(CodeV);
+    IntDefaultsN.AddDat(attr, DefaultCode);
+    return 0;
+  }
   CurrLen = VecOfStrVecsN.Len();
   KeyToIndexTypeN.AddDat(attr, TIntPr(StrType, CurrLen));
   NewVec = TVec<TStr>();
@@ -1377,10 +1472,23 @@ int TNEANet::AddIntVAttrE(const TStr& attr, TBool UseDense){
   return 0;
 }
 
-int TNEANet::AddStrAttrE(const TStr& attr, TStr defaultValue) {
+int TNEANet::AddStrAttrE(const TStr& attr, TStr defaultValue, TBool UseDict) {
   int i;
   TInt CurrLen;
   TVec<TStr> NewVec;
+  if (UseDict) {
+    if (KeyToIndexTypeE.IsKey(attr)) {
+      return -1;
+    }
+    const int DefaultCode = StrPoolH.AddKey(defaultValue);
+    CurrLen = VecOfIntVecsE.Len();
+    KeyToIndexTypeE.AddDat(attr, TIntPr(DictStrType, CurrLen));
+    TIntV CodeV(MxEId);
+    CodeV.PutAll(DefaultCode);
+    VecOfIntVecsE.Add(CodeV);
+    IntDefaultsE.AddDat(attr, DefaultCode);
+    return 0;
+  }
   CurrLen = VecOfStrVecsE.Len();
   KeyToIndexTypeE.AddDat(attr, TIntPr(StrType, CurrLen));
   NewVec = TVec<TStr>();
@@ -1427,6 +1535,9 @@ int TNEANet::DelAttrN(const TStr& attr) {
     if (StrDefaultsN.IsKey(attr)) {
       StrDefaultsN.DelKey(attr);
     }
+  } else if (vecType == DictStrType) {
+    VecOfIntVecsN[KeyToIndexTypeN.GetDat(attr).Val2] = TVec<TInt>();
+    IntDefaultsN.DelKey(attr);
   } else if (vecType == FltType) {
     VecOfFltVecsN[KeyToIndexTypeN.GetDat(attr).Val2] = TVec<TFlt>();
     if (FltDefaultsN.IsKey(attr)) {
@@ -1455,7 +1566,10 @@ int TNEANet::DelAttrE(const TStr& attr) {
     VecOfStrVecsE[KeyToIndexTypeE.GetDat(attr).Val2] = TVec<TStr>();
     if (StrDefaultsE.IsKey(attr)) {
       StrDefaultsE.DelKey(attr);
-    }  
+    }
+  } else if (vecType == DictStrType) {
+    VecOfIntVecsE[KeyToIndexTypeE.GetDat(attr).Val2] = TVec<TInt>();
+    IntDefaultsE.DelKey(attr);  
   } else if (vecType == FltType) {
     VecOfFltVecsE[KeyToIndexTypeE.GetDat(attr).Val2] = TVec<TFlt>();
     if (FltDefaultsE.IsKey(attr)) {
@@ -1486,7 +1600,7 @@ void TNEANet::GetAttrNNames(TStrV& IntAttrNames, TStrV& FltAttrNames, TStrV& Str
     if (it.GetDat().GetVal1() == FltType) {
       FltAttrNames.Add(it.GetKey());
     }
-    if (it.GetDat().GetVal1() == StrType) {
+    if (it.GetDat().GetVal1() == StrType || it.GetDat().GetVal1() == DictStrType) {
       StrAttrNames.Add(it.GetKey());
     }
   }
@@ -1500,7 +1614,7 @@ void TNEANet::GetAttrENames(TStrV& IntAttrNames, TStrV& FltAttrNames, TStrV& Str
     if (it.GetDat().GetVal1() == FltType) {
       FltAttrNames.Add(it.GetKey());
     }
-    if (it.GetDat().GetVal1() == StrType) {
+    if (it.GetDat().GetVal1() == StrType || it.GetDat().GetVal1() == DictStrType) {
       StrAttrNames.Add(it.GetKey());
     }
   }
@@ -1525,6 +1639,12 @@ void TNEANet::GetWeightOutEdgesV(TFltV& OutWeights, const TFltV& AttrVal) {
   }
 }
 
+void TNEANet::GetWeightOutEdgesV(TFltV& OutWeights, const TFltAttrHnd& WeightH) const {
+  for (TEdgeI EI = BegEI(); EI < EndEI(); EI++) {
+    OutWeights[EI.GetSrcNId()] += WeightH.GetDat(EI);
+  }
+}
+
 bool TNEANet::IsFltAttrE(const TStr& attr) {
   return (KeyToIndexTypeE.IsKey(attr) &&
     KeyToIndexTypeE.GetDat(attr).Val1 == FltType);
@@ -1537,7 +1657,53 @@ bool TNEANet::IsIntAttrE(const TStr& attr) {
 
 bool TNEANet::IsStrAttrE(const TStr& attr) {
   return (KeyToIndexTypeE.IsKey(attr) &&
-    KeyToIndexTypeE.GetDat(attr).Val1 == StrType);
+    (KeyToIndexTypeE.GetDat(attr).Val1 == StrType || KeyToIndexTypeE.GetDat(attr).Val1 == DictStrType));
+}
+
+void TNEANet::GetStrAttrEqNIdV(const TStr& attr, const TStr& Val, TIntV& NIdV) const {
+  NIdV.Clr();
+  const TIntPr& TypeIdx = KeyToIndexTypeN.GetDat(attr);
+  if (TypeIdx.Val1 == DictStrType) {
+    // compare codes, a value that was never interned matches no node
+    const int Code = GetStrCode(Val);
+    if (Code == -1) { return; }
+    const TIntV& CodeV = VecOfIntVecsN[TypeIdx.Val2];
+    for (TNodeI NI = BegNI(); NI < EndNI(); NI++) {
+      if (CodeV[GetNKeyId(NI)] == Code) { NIdV.Add(NI.GetId()); }
+    }
+    return;
+  }
+  IAssert(TypeIdx.Val1 == StrType);
+  const TStrV& StrV = VecOfStrVecsN[TypeIdx.Val2];
+  for (TNodeI NI = BegNI(); NI < EndNI(); NI++) {
+    if (StrV[GetNKeyId(NI)] == Val) { NIdV.Add(NI.GetId()); }
+  }
+}
+
+void TNEANet::GetStrAttrEqEIdV(const TStr& attr, const TStr& Val, TIntV& EIdV) const {
+  EIdV.Clr();
+  const TIntPr& TypeIdx = KeyToIndexTypeE.GetDat(attr);
+  if (TypeIdx.Val1 == DictStrType) {
+    const int Code = GetStrCode(Val);
+    if (Code == -1) { return; }
+    const TIntV& CodeV = VecOfIntVecsE[TypeIdx.Val2];
+    for (TEdgeI EI = BegEI(); EI < EndEI(); EI++) {
+      if (CodeV[GetEKeyId(EI)] == Code) { EIdV.Add(EI.GetId()); }
+    }
+    return;
+  }
+  IAssert(TypeIdx.Val1 == StrType);
+  const TStrV& StrV = VecOfStrVecsE[TypeIdx.Val2];
+  for (TEdgeI EI = BegEI(); EI < EndEI(); EI++) {
+    if (StrV[GetEKeyId(EI)] == Val) { EIdV.Add(EI.GetId()); }
+  }
+}
+
+void TNEANet::GetStrCodeMap(const TNEANet& Net, TIntV& CodeMapV) {
+  CodeMapV.Gen(Net.StrPoolH.Len());
+  for (int Code = 0; Code < Net.StrPoolH.Len(); Code++) {
+    CodeMapV[Code] = StrPoolH.AddKey(Net.StrPoolH.GetKey(Code));
+  }
 }
 
 int TNEANet::AddSAttrDatN(const TInt& NId, const TStr& AttrName, const TInt& Val) {
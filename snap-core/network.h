@@ -1798,22 +1798,25 @@ public:
   class TAStrI {
   private:
     typedef TStrV::TIter TStrVecIter;
+    typedef TIntV::TIter TIntVecIter;
     TStrVecIter HI;
+    TIntVecIter CodeI; // codes of a dictionary-encoded attribute, NULL otherwise
     bool isNode;
     TStr attr;
     const TNEANet *Graph;
   public:
-    TAStrI() : HI(), attr(), Graph(NULL) { }
-    TAStrI(const TStrVecIter& HIter, TStr attribute, bool isEdgeIter, const TNEANet* GraphPt) : HI(HIter), attr(), Graph(GraphPt) { isNode = !isEdgeIter; attr = attribute; }
-    TAStrI(const TAStrI& I) : HI(I.HI), attr(I.attr), Graph(I.Graph) { isNode = I.isNode; }
-    TAStrI& operator = (const TAStrI& I) { HI = I.HI; Graph=I.Graph; isNode = I.isNode; attr = I.attr; return *this; }
-    bool operator < (const TAStrI& I) const { return HI < I.HI; }
-    bool operator == (const TAStrI& I) const { return HI == I.HI; }
+    TAStrI() : HI(), CodeI(NULL), attr(), Graph(NULL) { }
+    TAStrI(const TStrVecIter& HIter, TStr attribute, bool isEdgeIter, const TNEANet* GraphPt) : HI(HIter), CodeI(NULL), attr(), Graph(GraphPt) { isNode = !isEdgeIter; attr = attribute; }
+    TAStrI(const TIntVecIter& CodeIter, TStr attribute, bool isEdgeIter, const TNEANet* GraphPt) : HI(NULL), CodeI(CodeIter), attr(), Graph(GraphPt) { isNode = !isEdgeIter; attr = attribute; }
+    TAStrI(const TAStrI& I) : HI(I.HI), CodeI(I.CodeI), attr(I.attr), Graph(I.Graph) { isNode = I.isNode; }
+    TAStrI& operator = (const TAStrI& I) { HI = I.HI; CodeI = I.CodeI; Graph=I.Graph; isNode = I.isNode; attr = I.attr; return *this; }
+    bool operator < (const TAStrI& I) const { return HI < I.HI || (HI == I.HI && CodeI < I.CodeI); }
+    bool operator == (const TAStrI& I) const { return HI == I.HI && CodeI == I.CodeI; }
     /// Returns an attribute of the node.
-    TStr GetDat() const { return HI[0]; }
+    TStr GetDat() const { return CodeI == NULL ? HI[0] : Graph->GetStrByCode(CodeI[0]); }
     /// Returns true if the attribute has been deleted.
     bool IsDeleted() const { return isNode ? GetDat() == Graph->GetStrAttrDefaultN(attr) : GetDat() == Graph->GetStrAttrDefaultE(attr); };
-    TAStrI& operator++(int) { HI++; return *this; }
+    TAStrI& operator++(int) { if (CodeI == NULL) { HI++; } else { CodeI++; } return *this; }
     friend class TNEANet;
   };
 
@@ -1840,6 +1843,44 @@ public:
     friend class TNEANet;
   };
 
+  /// Node/edge attribute handle. Resolves an Int, Flt or Str attribute by name once and then gives direct typed access to its values. ##TNEANet::TAttrHnd
+  template <class TVal>
+  class TAttrHnd {
+  private:
+    TVec<TVec<TVal> >* VecOfVecs;
+    int AttrIdx;
+    bool IsNode;
+    const TNEANet *Graph;
+  public:
+    TAttrHnd() : VecOfVecs(NULL), AttrIdx(-1), IsNode(true), Graph(NULL) { }
+    TAttrHnd(TVec<TVec<TVal> >* VecOfVecsPt, const int& Idx, const bool& IsNodeAttr, const TNEANet* GraphPt) :
+      VecOfVecs(VecOfVecsPt), AttrIdx(Idx), IsNode(IsNodeAttr), Graph(GraphPt) { }
+    TAttrHnd(const TAttrHnd& Hnd) : VecOfVecs(Hnd.VecOfVecs), AttrIdx(Hnd.AttrIdx), IsNode(Hnd.IsNode), Graph(Hnd.Graph) { }
+    TAttrHnd& operator = (const TAttrHnd& Hnd) { VecOfVecs=Hnd.VecOfVecs; AttrIdx=Hnd.AttrIdx; IsNode=Hnd.IsNode; Graph=Hnd.Graph; return *this; }
+    /// Tests whether the handle does not refer to an attribute.
+    bool Empty() const { return VecOfVecs == NULL; }
+    /// Returns the value at internal slot KeyId (see TNEANet::GetNKeyId() and TNEANet::GetEKeyId()).
+    const TVal& operator [] (const int& KeyId) const { return (*VecOfVecs)[AttrIdx][KeyId]; }
+    TVal& operator [] (const int& KeyId) { return (*VecOfVecs)[AttrIdx][KeyId]; }
+    /// Returns the value of the node or edge with ID Id.
+    const TVal& GetDat(const int& Id) const { return (*this)[IsNode ? Graph->NodeH.GetKeyId(Id) : Graph->EdgeH.GetKeyId(Id)]; }
+    TVal& GetDat(const int& Id) { return (*this)[IsNode ? Graph->NodeH.GetKeyId(Id) : Graph->EdgeH.GetKeyId(Id)]; }
+    /// Returns the value of the node NodeI points to, without a hash lookup.
+    const TVal& GetDat(const TNodeI& NodeI) const { Assert(IsNode); return (*this)[Graph->GetNKeyId(NodeI)]; }
+    TVal& GetDat(const TNodeI& NodeI) { Assert(IsNode); return (*this)[Graph->GetNKeyId(NodeI)]; }
+    /// Returns the value of the edge EdgeI points to, without a hash lookup.
+    const TVal& GetDat(const TEdgeI& EdgeI) const { Assert(!IsNode); return (*this)[Graph->GetEKeyId(EdgeI)]; }
+    TVal& GetDat(const TEdgeI& EdgeI) { Assert(!IsNode); return (*this)[Graph->GetEKeyId(EdgeI)]; }
+    /// Copies the whole attribute column to ColV, aligned with node (edge) iteration order. ##TNEANet::TAttrHnd::GetColV
+    void GetColV(TVec<TVal>& ColV) const;
+    /// Sets the whole attribute column from ColV, aligned with node (edge) iteration order. ##TNEANet::TAttrHnd::SetColV
+    void SetColV(const TVec<TVal>& ColV);
+    friend class TNEANet;
+  };
+  typedef TAttrHnd<TInt> TIntAttrHnd;
+  typedef TAttrHnd<TFlt> TFltAttrHnd;
+  typedef TAttrHnd<TStr> TStrAttrHnd;
+
 protected:
   TNode& GetNode(const int& NId) { return NodeH.GetDat(NId); }
   const TNode& GetNode(const int& NId) const { return NodeH.GetDat(NId); }
@@ -1851,13 +1892,15 @@ protected:
   /// Gets Int node attribute val.  If not a proper attr, return default.
   TInt GetIntAttrDefaultN(const TStr& attribute) const { return IntDefaultsN.IsKey(attribute) ? IntDefaultsN.GetDat(attribute) : (TInt) TInt::Mn; }
   /// Gets Str node attribute val.  If not a proper attr, return default.
-  TStr GetStrAttrDefaultN(const TStr& attribute) const { return StrDefaultsN.IsKey(attribute) ? StrDefaultsN.GetDat(attribute) : (TStr) TStr::GetNullStr(); }
+  TStr GetStrAttrDefaultN(const TStr& attribute) const { return StrDefaultsN.IsKey(attribute) ? StrDefaultsN.GetDat(attribute) :
+    (IsDictStrAttrN(attribute) ? GetStrByCode(IntDefaultsN.GetDat(attribute)) : (TStr) TStr::GetNullStr()); }
   /// Gets Flt node attribute val.  If not a proper attr, return default.
   TFlt GetFltAttrDefaultN(const TStr& attribute) const { return FltDefaultsN.IsKey(attribute) ? FltDefaultsN.GetDat(attribute) : (TFlt) TFlt::Mn; }
   /// Gets Int edge attribute val.  If not a proper attr, return default.
   TInt GetIntAttrDefaultE(const TStr& attribute) const { return IntDefaultsE.IsKey(attribute) ? IntDefaultsE.GetDat(attribute) : (TInt) TInt::Mn; }
   /// Gets Str edge attribute val.  If not a proper attr, return default.
-  TStr GetStrAttrDefaultE(const TStr& attribute) const { return StrDefaultsE.IsKey(attribute) ? StrDefaultsE.GetDat(attribute) : (TStr) TStr::GetNullStr(); }
+  TStr GetStrAttrDefaultE(const TStr& attribute) const { return StrDefaultsE.IsKey(attribute) ? StrDefaultsE.GetDat(attribute) :
+    (IsDictStrAttrE(attribute) ? GetStrByCode(IntDefaultsE.GetDat(attribute)) : (TStr) TStr::GetNullStr()); }
   /// Gets Flt edge attribute val.  If not a proper attr, return default.
   TFlt GetFltAttrDefaultE(const TStr& attribute) const { return FltDefaultsE.IsKey(attribute) ? FltDefaultsE.GetDat(attribute) : (TFlt) TFlt::Mn; }
 public:
@@ -1879,10 +1922,13 @@ protected:
   TVec<TFltV> VecOfFltVecsN, VecOfFltVecsE;
   TVec<TVec<TIntV> > VecOfIntVecVecsN, VecOfIntVecVecsE;
   TVec<THash<TInt, TIntV> > VecOfIntHashVecsN, VecOfIntHashVecsE;
-  enum { IntType, StrType, FltType, IntVType };
+  /// DictStrType attributes keep their codes in VecOfIntVecs[N|E] and their default code in IntDefaults[N|E].
+  enum { IntType, StrType, FltType, IntVType, DictStrType };
 
   TAttr SAttrN;
   TAttr SAttrE;
+  /// String pool shared by all dictionary-encoded node and edge attributes, maps strings to codes.
+  TStrHash<TInt, TBigStrPool> StrPoolH;
 private:
   class LoadTNodeFunctor {
   public:
@@ -1930,6 +1976,13 @@ protected:
     if (KeyToDenseE.GetDat(attr)) return 1;
     return 0;
   }
+
+  template <class TVal>
+  TAttrHnd<TVal> GetAttrHnd(TVec<TVec<TVal> >& VecOfVecs, const TStrIntPrH& KeyToIndexType, const int& Type, const TStr& attr, const bool& IsNode) {
+    const int KeyId = KeyToIndexType.GetKeyId(attr);
+    if (KeyId == -1 || KeyToIndexType[KeyId].Val1 != Type) { return TAttrHnd<TVal>(); }
+    return TAttrHnd<TVal>(&VecOfVecs, KeyToIndexType[KeyId].Val2, IsNode, this);
+  }
   
 
 public:
@@ -1938,41 +1991,42 @@ public:
     StrDefaultsN(), StrDefaultsE(), FltDefaultsN(), FltDefaultsE(),
     VecOfIntVecsN(), VecOfIntVecsE(), VecOfStrVecsN(), VecOfStrVecsE(),
     VecOfFltVecsN(), VecOfFltVecsE(),  VecOfIntVecVecsN(), VecOfIntVecVecsE(),
-    VecOfIntHashVecsN(), VecOfIntHashVecsE(), SAttrN(), SAttrE(){ }
+    VecOfIntHashVecsN(), VecOfIntHashVecsE(), SAttrN(), SAttrE(), StrPoolH() { }
   /// Constructor that reserves enough memory for a graph of nodes and edges.
   explicit TNEANet(const int& Nodes, const int& Edges) : CRef(),
     MxNId(0), MxEId(0), NodeH(), EdgeH(), KeyToIndexTypeN(), KeyToIndexTypeE(), KeyToDenseN(), KeyToDenseE(),
     IntDefaultsN(), IntDefaultsE(), StrDefaultsN(), StrDefaultsE(),
     FltDefaultsN(), FltDefaultsE(), VecOfIntVecsN(), VecOfIntVecsE(),
     VecOfStrVecsN(), VecOfStrVecsE(), VecOfFltVecsN(), VecOfFltVecsE(), VecOfIntVecVecsN(), VecOfIntVecVecsE(),
-    VecOfIntHashVecsN(), VecOfIntHashVecsE(), SAttrN(), SAttrE()
+    VecOfIntHashVecsN(), VecOfIntHashVecsE(), SAttrN(), SAttrE(), StrPoolH()
     { Reserve(Nodes, Edges); }
   TNEANet(const TNEANet& Graph) : MxNId(Graph.MxNId), MxEId(Graph.MxEId),
     NodeH(Graph.NodeH), EdgeH(Graph.EdgeH), KeyToIndexTypeN(), KeyToIndexTypeE(), KeyToDenseN(), KeyToDenseE(),
     IntDefaultsN(), IntDefaultsE(), StrDefaultsN(), StrDefaultsE(),
     FltDefaultsN(), FltDefaultsE(), VecOfIntVecsN(), VecOfIntVecsE(),
     VecOfStrVecsN(), VecOfStrVecsE(), VecOfFltVecsN(), VecOfFltVecsE(), VecOfIntVecVecsN(), VecOfIntVecVecsE(),
-    VecOfIntHashVecsN(), VecOfIntHashVecsE(), SAttrN(), SAttrE() { }
+    VecOfIntHashVecsN(), VecOfIntHashVecsE(), SAttrN(), SAttrE(), StrPoolH() { }
   /// Constructor for loading the graph from a (binary) stream SIn.
   TNEANet(TSIn& SIn) : MxNId(SIn), MxEId(SIn), NodeH(SIn), EdgeH(SIn),
     KeyToIndexTypeN(SIn), KeyToIndexTypeE(SIn), KeyToDenseN(SIn), KeyToDenseE(SIn), IntDefaultsN(SIn), IntDefaultsE(SIn),
     StrDefaultsN(SIn), StrDefaultsE(SIn), FltDefaultsN(SIn), FltDefaultsE(SIn),
     VecOfIntVecsN(SIn), VecOfIntVecsE(SIn), VecOfStrVecsN(SIn),VecOfStrVecsE(SIn),
     VecOfFltVecsN(SIn), VecOfFltVecsE(SIn), VecOfIntVecVecsN(SIn), VecOfIntVecVecsE(SIn), VecOfIntHashVecsN(SIn), VecOfIntHashVecsE(SIn),
-    SAttrN(SIn), SAttrE(SIn) { }
+    SAttrN(SIn), SAttrE(SIn), StrPoolH(SIn) { }
 protected:
   TNEANet(const TNEANet& Graph, bool modeSubGraph) : MxNId(Graph.MxNId), MxEId(Graph.MxEId),
     NodeH(Graph.NodeH), EdgeH(Graph.EdgeH), KeyToIndexTypeN(), KeyToIndexTypeE(Graph.KeyToIndexTypeE), KeyToDenseN(), KeyToDenseE(Graph.KeyToDenseE),
     IntDefaultsN(Graph.IntDefaultsN), IntDefaultsE(Graph.IntDefaultsE), StrDefaultsN(Graph.StrDefaultsN), StrDefaultsE(Graph.StrDefaultsE),
     FltDefaultsN(Graph.FltDefaultsN), FltDefaultsE(Graph.FltDefaultsE), VecOfIntVecsN(Graph.VecOfIntVecsN), VecOfIntVecsE(Graph.VecOfIntVecsE),
     VecOfStrVecsN(Graph.VecOfStrVecsN), VecOfStrVecsE(Graph.VecOfStrVecsE), VecOfFltVecsN(Graph.VecOfFltVecsN), VecOfFltVecsE(Graph.VecOfFltVecsE),
-    VecOfIntVecVecsN(), VecOfIntVecVecsE(Graph.VecOfIntVecVecsE), VecOfIntHashVecsN(), VecOfIntHashVecsE(Graph.VecOfIntHashVecsE) { }
+    VecOfIntVecVecsN(), VecOfIntVecVecsE(Graph.VecOfIntVecVecsE), VecOfIntHashVecsN(), VecOfIntHashVecsE(Graph.VecOfIntHashVecsE), StrPoolH(Graph.StrPoolH) { }
   TNEANet(bool copyAll, const TNEANet& Graph) : MxNId(Graph.MxNId), MxEId(Graph.MxEId),
     NodeH(Graph.NodeH), EdgeH(Graph.EdgeH), KeyToIndexTypeN(Graph.KeyToIndexTypeN), KeyToIndexTypeE(Graph.KeyToIndexTypeE), KeyToDenseN(Graph.KeyToDenseN), KeyToDenseE(Graph.KeyToDenseE),
     IntDefaultsN(Graph.IntDefaultsN), IntDefaultsE(Graph.IntDefaultsE), StrDefaultsN(Graph.StrDefaultsN), StrDefaultsE(Graph.StrDefaultsE),
     FltDefaultsN(Graph.FltDefaultsN), FltDefaultsE(Graph.FltDefaultsE), VecOfIntVecsN(Graph.VecOfIntVecsN), VecOfIntVecsE(Graph.VecOfIntVecsE),
     VecOfStrVecsN(Graph.VecOfStrVecsN), VecOfStrVecsE(Graph.VecOfStrVecsE), VecOfFltVecsN(Graph.VecOfFltVecsN), VecOfFltVecsE(Graph.VecOfFltVecsE),
-    VecOfIntVecVecsN(Graph.VecOfIntVecVecsN), VecOfIntVecVecsE(Graph.VecOfIntVecVecsE), VecOfIntHashVecsN(Graph.VecOfIntHashVecsN), VecOfIntHashVecsE(Graph.VecOfIntHashVecsE), SAttrN(Graph.SAttrN), SAttrE(Graph.SAttrE) { }
+    VecOfIntVecVecsN(Graph.VecOfIntVecVecsN), VecOfIntVecVecsE(Graph.VecOfIntVecVecsE), VecOfIntHashVecsN(Graph.VecOfIntHashVecsN), VecOfIntHashVecsE(Graph.VecOfIntHashVecsE), SAttrN(Graph.SAttrN), SAttrE(Graph.SAttrE),
+    StrPoolH(Graph.StrPoolH) { }
   // virtual ~TNEANet() { }
 public:
   /// Saves the graph to a (binary) stream SOut. Expects data structures for sparse attributes.
@@ -1988,6 +2042,20 @@ public:
     VecOfFltVecsN.Save(SOut); VecOfFltVecsE.Save(SOut);
     VecOfIntVecVecsN.Save(SOut); VecOfIntVecVecsE.Save(SOut);
     VecOfIntHashVecsN.Save(SOut); VecOfIntHashVecsE.Save(SOut); 
+    SAttrN.Save(SOut); SAttrE.Save(SOut); StrPoolH.Save(SOut); }
+  /// Saves the graph without the string pool of dictionary-encoded attributes. Available for backwards compatibility.
+  void Save_V3(TSOut& SOut) const {
+    MxNId.Save(SOut); MxEId.Save(SOut); NodeH.Save(SOut); EdgeH.Save(SOut);
+    KeyToIndexTypeN.Save(SOut); KeyToIndexTypeE.Save(SOut);
+    KeyToDenseN.Save(SOut); KeyToDenseE.Save(SOut);
+    IntDefaultsN.Save(SOut); IntDefaultsE.Save(SOut);
+    StrDefaultsN.Save(SOut); StrDefaultsE.Save(SOut);
+    FltDefaultsN.Save(SOut); FltDefaultsE.Save(SOut);
+    VecOfIntVecsN.Save(SOut); VecOfIntVecsE.Save(SOut);
+    VecOfStrVecsN.Save(SOut); VecOfStrVecsE.Save(SOut);
+    VecOfFltVecsN.Save(SOut); VecOfFltVecsE.Save(SOut);
+    VecOfIntVecVecsN.Save(SOut); VecOfIntVecVecsE.Save(SOut);
+    VecOfIntHashVecsN.Save(SOut); VecOfIntHashVecsE.Save(SOut);
     SAttrN.Save(SOut); SAttrE.Save(SOut); }
   /// Saves the graph to a (binary) stream SOut. Available for backwards compatibility.
   void Save_V1(TSOut& SOut) const {
@@ -2015,6 +2083,9 @@ public:
   static PNEANet New() { return PNEANet(new TNEANet()); }
   /// Static constructor that returns a pointer to the graph and reserves enough memory for Nodes nodes and Edges edges. ##TNEANet::New
   static PNEANet New(const int& Nodes, const int& Edges) { return PNEANet(new TNEANet(Nodes, Edges)); }
+  /// Static constructor that returns a pointer to a copy of Graph, including its node and edge attributes if CopyAttrs is true.
+  static PNEANet New(const TNEANet& Graph, const bool& CopyAttrs) {
+    return CopyAttrs ? PNEANet(new TNEANet(true, Graph)) : PNEANet(new TNEANet(Graph)); }
   /// Static constructor that loads the graph from a stream SIn and returns a pointer to it.
   static PNEANet Load(TSIn& SIn) { return PNEANet(new TNEANet(SIn)); }
   /// Static constructor that loads the graph from a stream SIn and returns a pointer to it. Backwards compatible.
@@ -2049,6 +2120,25 @@ public:
     return Graph;
   }
 
+  /// Static constructor that loads the graph from a stream SIn and returns a pointer to it. Backwards compatible without the string pool
+  static PNEANet Load_V3(TSIn& SIn) {
+    PNEANet Graph = PNEANet(new TNEANet());
+    Graph->MxNId.Load(SIn); Graph->MxEId.Load(SIn);
+    Graph->NodeH.Load(SIn); Graph->EdgeH.Load(SIn);
+    Graph->KeyToIndexTypeN.Load(SIn); Graph->KeyToIndexTypeE.Load(SIn);
+    Graph->KeyToDenseN.Load(SIn); Graph->KeyToDenseE.Load(SIn);
+    Graph->IntDefaultsN.Load(SIn); Graph->IntDefaultsE.Load(SIn);
+    Graph->StrDefaultsN.Load(SIn); Graph->StrDefaultsE.Load(SIn);
+    Graph->FltDefaultsN.Load(SIn); Graph->FltDefaultsE.Load(SIn);
+    Graph->VecOfIntVecsN.Load(SIn); Graph->VecOfIntVecsE.Load(SIn);
+    Graph->VecOfStrVecsN.Load(SIn); Graph->VecOfStrVecsE.Load(SIn);
+    Graph->VecOfFltVecsN.Load(SIn); Graph->VecOfFltVecsE.Load(SIn);
+    Graph->VecOfIntVecVecsN.Load(SIn); Graph->VecOfIntVecVecsE.Load(SIn);
+    Graph->VecOfIntHashVecsN.Load(SIn); Graph->VecOfIntHashVecsE.Load(SIn);
+    Graph->SAttrN.Load(SIn); Graph->SAttrE.Load(SIn);
+    return Graph;
+  }
+
   /// load network from shared memory for this network
   void LoadNetworkShM(TShMIn& ShMIn);
   /// Static constructor that loads the network from memory. ##TNEANet::LoadShM(TShMIn& ShMIn)
@@ -2193,13 +2283,15 @@ public:
 
   /// Returns an iterator referring to the first node's str attribute.
   TAStrI BegNAStrI(const TStr& attr) const {
-
+    if (IsDictStrAttrN(attr)) { return TAStrI(VecOfIntVecsN[KeyToIndexTypeN.GetDat(attr).Val2].BegI(), attr, false, this); }
     return TAStrI(VecOfStrVecsN[KeyToIndexTypeN.GetDat(attr).Val2].BegI(), attr, false, this); }
   /// Returns an iterator referring to the past-the-end node's attribute.
   TAStrI EndNAStrI(const TStr& attr) const {
+    if (IsDictStrAttrN(attr)) { return TAStrI(VecOfIntVecsN[KeyToIndexTypeN.GetDat(attr).Val2].EndI(), attr, false, this); }
     return TAStrI(VecOfStrVecsN[KeyToIndexTypeN.GetDat(attr).Val2].EndI(), attr, false, this); }
   /// Returns an iterator referring to the node of ID NId in the graph.
   TAStrI GetNAStrI(const TStr& attr, const int& NId) const {
+    if (IsDictStrAttrN(attr)) { return TAStrI(VecOfIntVecsN[KeyToIndexTypeN.GetDat(attr).Val2].GetI(NodeH.GetKeyId(NId)), attr, false, this); }
     return TAStrI(VecOfStrVecsN[KeyToIndexTypeN.GetDat(attr).Val2].GetI(NodeH.GetKeyId(NId)), attr, false, this); }
   /// Returns an iterator referring to the first node's flt attribute.
   TAFltI BegNAFltI(const TStr& attr) const {
@@ -2369,13 +2461,16 @@ public:
 
   /// Returns an iterator referring to the first edge's str attribute.
   TAStrI BegEAStrI(const TStr& attr) const {
+    if (IsDictStrAttrE(attr)) { return TAStrI(VecOfIntVecsE[KeyToIndexTypeE.GetDat(attr).Val2].BegI(), attr, true, this); }
     return TAStrI(VecOfStrVecsE[KeyToIndexTypeE.GetDat(attr).Val2].BegI(), attr, true, this);   }
   /// Returns an iterator referring to the past-the-end edge's attribute.
   TAStrI EndEAStrI(const TStr& attr) const {
+    if (IsDictStrAttrE(attr)) { return TAStrI(VecOfIntVecsE[KeyToIndexTypeE.GetDat(attr).Val2].EndI(), attr, true, this); }
     return TAStrI(VecOfStrVecsE[KeyToIndexTypeE.GetDat(attr).Val2].EndI(), attr, true, this);
   }
   /// Returns an iterator referring to the edge of ID EId in the graph.
   TAStrI GetEAStrI(const TStr& attr, const int& EId) const {
+    if (IsDictStrAttrE(attr)) { return TAStrI(VecOfIntVecsE[KeyToIndexTypeE.GetDat(attr).Val2].GetI(EdgeH.GetKeyId(EId)), attr, true, this); }
     return TAStrI(VecOfStrVecsE[KeyToIndexTypeE.GetDat(attr).Val2].GetI(EdgeH.GetKeyId(EId)), attr, true, this);
   }
   /// Returns an iterator referring to the first edge's flt attribute.
@@ -2401,6 +2496,8 @@ public:
   int AddEdge(const int& SrcNId, const int& DstNId, int EId  = -1);
   /// Adds an edge between EdgeI.GetSrcNId() and EdgeI.GetDstNId() to the graph.
   int AddEdge(const TEdgeI& EdgeI) { return AddEdge(EdgeI.GetSrcNId(), EdgeI.GetDstNId(), EdgeI.GetId()); }
+  /// Adds edges with IDs EIdV[i] between node IDs SrcNIdV[i] and DstNIdV[i], node adjacency is built in parallel. ##TNEANet::AddEdgeV
+  void AddEdgeV(const TIntV& SrcNIdV, const TIntV& DstNIdV, const TIntV& EIdV);
   /// Deletes an edge with edge ID EId from the graph.
   void DelEdge(const int& EId);
   /// Deletes all edges between node IDs SrcNId and DstNId from the graph. ##TNEANet::DelEdge
@@ -2443,7 +2540,7 @@ public:
     StrDefaultsN.Clr(); StrDefaultsE.Clr(); FltDefaultsN.Clr(); FltDefaultsE.Clr();
     VecOfIntVecsN.Clr(); VecOfIntVecsE.Clr(); VecOfStrVecsN.Clr(); VecOfStrVecsE.Clr();
     VecOfFltVecsN.Clr(); VecOfFltVecsE.Clr(); VecOfIntVecVecsN.Clr(); VecOfIntVecVecsE.Clr(); 
-    SAttrN.Clr(); SAttrE.Clr();}
+    SAttrN.Clr(); SAttrE.Clr(); StrPoolH = TStrHash<TInt, TBigStrPool>(); }
   /// Reserves memory for a graph of Nodes nodes and Edges edges.
   void Reserve(const int& Nodes, const int& Edges) {
     if (Nodes>0) { NodeH.Gen(Nodes/2); } if (Edges>0) { EdgeH.Gen(Edges/2); } }
@@ -2563,8 +2660,8 @@ public:
 
   /// Adds a new Int node attribute to the hashmap.
   int AddIntAttrN(const TStr& attr, TInt defaultValue=TInt::Mn);
-  /// Adds a new Str node attribute to the hashmap.
-  int AddStrAttrN(const TStr& attr, TStr defaultValue=TStr::GetNullStr());
+  /// Adds a new Str node attribute to the hashmap. ##TNEANet::AddStrAttrN
+  int AddStrAttrN(const TStr& attr, TStr defaultValue=TStr::GetNullStr(), TBool UseDict=false);
   /// Adds a new Flt node attribute to the hashmap.
   int AddFltAttrN(const TStr& attr, TFlt defaultValue=TFlt::Mn);
   /// Adds a new IntV node attribute to the hashmap.
@@ -2572,8 +2669,8 @@ public:
 
   /// Adds a new Int edge attribute to the hashmap.
   int AddIntAttrE(const TStr& attr, TInt defaultValue=TInt::Mn);
-  /// Adds a new Str edge attribute to the hashmap.
-  int AddStrAttrE(const TStr& attr, TStr defaultValue=TStr::GetNullStr());
+  /// Adds a new Str edge attribute to the hashmap. If UseDict, the values are dictionary-encoded (see TNEANet::AddStrAttrN).
+  int AddStrAttrE(const TStr& attr, TStr defaultValue=TStr::GetNullStr(), TBool UseDict=false);
   /// Adds a new Flt edge attribute to the hashmap.
   int AddFltAttrE(const TStr& attr, TFlt defaultValue=TFlt::Mn);
   /// Adds a new IntV edge attribute to the hashmap.
@@ -2648,6 +2745,50 @@ public:
 
   /// Fills OutWeights with the outgoing weight from each node.
   void GetWeightOutEdgesV(TFltV& OutWeights, const TFltV& AttrVal) ;
+  /// Fills OutWeights with the outgoing weight from each node.
+  void GetWeightOutEdgesV(TFltV& OutWeights, const TFltAttrHnd& WeightH) const;
+
+  /// Returns the internal slot of the node NodeI points to, the index of its attribute values.
+  int GetNKeyId(const TNodeI& NodeI) const { return NodeH.GetIterKeyId(NodeI.NodeHI); }
+  /// Returns the internal slot of the node with ID NId, the index of its attribute values.
+  int GetNKeyId(const int& NId) const { return NodeH.GetKeyId(NId); }
+  /// Returns the internal slot of the edge EdgeI points to, the index of its attribute values.
+  int GetEKeyId(const TEdgeI& EdgeI) const { return EdgeH.GetIterKeyId(EdgeI.EdgeHI); }
+  /// Returns the internal slot of the edge with ID EId, the index of its attribute values.
+  int GetEKeyId(const int& EId) const { return EdgeH.GetKeyId(EId); }
+  /// Returns a handle to the Int node attribute attr. The handle is empty if there is no such attribute. ##TNEANet::GetIntAttrHndN
+  TIntAttrHnd GetIntAttrHndN(const TStr& attr) { return GetAttrHnd(VecOfIntVecsN, KeyToIndexTypeN, IntType, attr, true); }
+  /// Returns a handle to the Flt node attribute attr. The handle is empty if there is no such attribute.
+  TFltAttrHnd GetFltAttrHndN(const TStr& attr) { return GetAttrHnd(VecOfFltVecsN, KeyToIndexTypeN, FltType, attr, true); }
+  /// Returns a handle to the Str node attribute attr. The handle is empty if there is no such attribute.
+  TStrAttrHnd GetStrAttrHndN(const TStr& attr) { return GetAttrHnd(VecOfStrVecsN, KeyToIndexTypeN, StrType, attr, true); }
+  /// Returns a handle to the Int edge attribute attr. The handle is empty if there is no such attribute.
+  TIntAttrHnd GetIntAttrHndE(const TStr& attr) { return GetAttrHnd(VecOfIntVecsE, KeyToIndexTypeE, IntType, attr, false); }
+  /// Returns a handle to the Flt edge attribute attr. The handle is empty if there is no such attribute.
+  TFltAttrHnd GetFltAttrHndE(const TStr& attr) { return GetAttrHnd(VecOfFltVecsE, KeyToIndexTypeE, FltType, attr, false); }
+  /// Returns a handle to the Str edge attribute attr. The handle is empty if there is no such attribute.
+  TStrAttrHnd GetStrAttrHndE(const TStr& attr) { return GetAttrHnd(VecOfStrVecsE, KeyToIndexTypeE, StrType, attr, false); }
+
+  /// Checks if attr is a dictionary-encoded Str node attribute.
+  bool IsDictStrAttrN(const TStr& attr) const { const int KeyId = KeyToIndexTypeN.GetKeyId(attr); return KeyId != -1 && KeyToIndexTypeN[KeyId].Val1 == DictStrType; }
+  /// Checks if attr is a dictionary-encoded Str edge attribute.
+  bool IsDictStrAttrE(const TStr& attr) const { const int KeyId = KeyToIndexTypeE.GetKeyId(attr); return KeyId != -1 && KeyToIndexTypeE[KeyId].Val1 == DictStrType; }
+  /// Returns the code of string Val in the pool of dictionary-encoded attributes, -1 if no attribute value equals Val.
+  int GetStrCode(const TStr& Val) const { return StrPoolH.GetKeyId(Val); }
+  /// Returns the string of dictionary code Code.
+  TStr GetStrByCode(const int& Code) const { return Code < 0 ? TStr::GetNullStr() : TStr(StrPoolH.GetKey(Code)); }
+  /// Returns the number of distinct strings in the pool of dictionary-encoded attributes.
+  int GetStrCodes() const { return StrPoolH.Len(); }
+  /// Returns a handle to the codes of the dictionary-encoded Str node attribute attr. The handle is empty if there is no such attribute.
+  TIntAttrHnd GetStrCodeHndN(const TStr& attr) { return GetAttrHnd(VecOfIntVecsN, KeyToIndexTypeN, DictStrType, attr, true); }
+  /// Returns a handle to the codes of the dictionary-encoded Str edge attribute attr. The handle is empty if there is no such attribute.
+  TIntAttrHnd GetStrCodeHndE(const TStr& attr) { return GetAttrHnd(VecOfIntVecsE, KeyToIndexTypeE, DictStrType, attr, false); }
+  /// Gets IDs of the nodes whose Str attribute attr equals Val. Compares codes if the attribute is dictionary-encoded.
+  void GetStrAttrEqNIdV(const TStr& attr, const TStr& Val, TIntV& NIdV) const;
+  /// Gets IDs of the edges whose Str attribute attr equals Val. Compares codes if the attribute is dictionary-encoded.
+  void GetStrAttrEqEIdV(const TStr& attr, const TStr& Val, TIntV& EIdV) const;
+  /// Maps the dictionary codes of Net to codes of this network, interning each distinct string of Net once.
+  void GetStrCodeMap(const TNEANet& Net, TIntV& CodeMapV);
   /// Fills each of the vectors with the names of node attributes of the given type.
   void GetAttrNNames(TStrV& IntAttrNames, TStrV& FltAttrNames, TStrV& StrAttrNames) const;
   /// Fills each of the vectors with the names of edge attributes of the given type.
@@ -2900,6 +3041,41 @@ template <> struct IsMultiGraph<TNEANet> { enum { Val = 1 }; };
 template <> struct IsDirected<TNEANet> { enum { Val = 1 }; };
 }
 
+template <class TVal>
+void TNEANet::TAttrHnd<TVal>::GetColV(TVec<TVal>& ColV) const {
+  const TVec<TVal>& ValV = (*VecOfVecs)[AttrIdx];
+  const int Len = IsNode ? Graph->GetNodes() : Graph->GetEdges();
+  ColV.Gen(Len);
+  if (IsNode ? Graph->NodeH.IsKeyIdEqKeyN() : Graph->EdgeH.IsKeyIdEqKeyN()) {
+    // no deleted nodes (edges), the i-th slot holds the i-th node (edge)
+    #pragma omp parallel for schedule(static) if(Len > 100000)
+    for (int i = 0; i < Len; i++) { ColV[i] = ValV[i]; }
+  } else if (IsNode) {
+    int i = 0;
+    for (TNodeI NI = Graph->BegNI(); NI < Graph->EndNI(); NI++, i++) { ColV[i] = ValV[Graph->GetNKeyId(NI)]; }
+  } else {
+    int i = 0;
+    for (TEdgeI EI = Graph->BegEI(); EI < Graph->EndEI(); EI++, i++) { ColV[i] = ValV[Graph->GetEKeyId(EI)]; }
+  }
+}
+
+template <class TVal>
+void TNEANet::TAttrHnd<TVal>::SetColV(const TVec<TVal>& ColV) {
+  TVec<TVal>& ValV = (*VecOfVecs)[AttrIdx];
+  const int Len = IsNode ? Graph->GetNodes() : Graph->GetEdges();
+  IAssertR(ColV.Len() == Len, TStr::Fmt("Column has %d values, expected %d", ColV.Len(), Len));
+  if (IsNode ? Graph->NodeH.IsKeyIdEqKeyN() : Graph->EdgeH.IsKeyIdEqKeyN()) {
+    #pragma omp parallel for schedule(static) if(Len > 100000)
+    for (int i = 0; i < Len; i++) { ValV[i] = ColV[i]; }
+  } else if (IsNode) {
+    int i = 0;
+    for (TNodeI NI = Graph->BegNI(); NI < Graph->EndNI(); NI++, i++) { ValV[Graph->GetNKeyId(NI)] = ColV[i]; }
+  } else {
+    int i = 0;
+    for (TEdgeI EI = Graph->BegEI(); EI < Graph->EndEI(); EI++, i++) { ValV[Graph->GetEKeyId(EI)] = ColV[i]; }
+  }
+}
+
  //#//////////////////////////////////////////////
 /// Undirected networks
 
@@ -0,0 +1,228 @@
+namespace TSnap {
+
+namespace TSnapDetail {
+
+void GetDegOrder(const TVec<TInt64>& OffV, TIntV& OrderV) {
+  const int Nodes = TMath::Mx(OffV.Len()-1, 0);
+  int MxDeg = 0;
+  for (int n = 0; n < Nodes; n++) { MxDeg = TMath::Mx(MxDeg, int(OffV[n+1]-OffV[n])); }
+  // counting sort on MxDeg-Deg is stable
+  TIntV PosV(MxDeg+2);
+  for (int n = 0; n < Nodes; n++) { PosV[MxDeg-int(OffV[n+1]-OffV[n])+1].Val++; }
+  for (int d = 0; d <= MxDeg; d++) { PosV[d+1] += PosV[d]; }
+  OrderV.Gen(Nodes);
+  for (int n = 0; n < Nodes; n++) {
+    OrderV[PosV[MxDeg-int(OffV[n+1]-OffV[n])].Val++] = n; }
+}
+
+void GetBfsOrder(const TVec<TInt64>& OffV, const TVec<TInt, int64>& NbrV, TIntV& OrderV) {
+  const int Nodes = TMath::Mx(OffV.Len()-1, 0);
+  TIntV DegOrderV;
+  GetDegOrder(OffV, DegOrderV);
+  TBoolV SeenV(Nodes);
+  OrderV.Gen(Nodes, 0);
+  for (int s = 0; s < Nodes; s++) {
+    if (SeenV[DegOrderV[s]]) { continue; }
+    SeenV[DegOrderV[s]] = true;
+    OrderV.Add(DegOrderV[s]);
+    // OrderV is the queue
+    for (int q = OrderV.Len()-1; q < OrderV.Len(); q++) {
+      const int n = OrderV[q];
+      for (int64 e = OffV[n]; e < OffV[n+1]; e++) {
+        const int m = NbrV[e];
+        if (! SeenV[m]) { SeenV[m] = true;  OrderV.Add(m); }
+      }
+    }
+  }
+}
+
+// Breadth first search over the component of Start, nodes with MarkV[n]==Stamp
+// are visited. Returns the number of levels, LastV gets the nodes of the last level.
+int GetBfsLevels(const TVec<TInt64>& OffV, const TVec<TInt, int64>& NbrV, const int& Start,
+ const int& Stamp, TIntV& MarkV, TIntV& QueueV, TIntV& LastV) {
+  QueueV.Clr(false);
+  QueueV.Add(Start);
+  MarkV[Start] = Stamp;
+  int Levels = 0, LevelBeg = 0;
+  while (LevelBeg < QueueV.Len()) {
+    const int LevelEnd = QueueV.Len();
+    for (int q = LevelBeg; q < LevelEnd; q++) {
+      const int n = QueueV[q];
+      for (int64 e = OffV[n]; e < OffV[n+1]; e++) {
+        const int m = NbrV[e];
+        if (MarkV[m] != Stamp) { MarkV[m] = Stamp;  QueueV.Add(m); }
+      }
+    }
+    LastV.Clr(false);
+    for (int q = LevelBeg; q < LevelEnd; q++) { LastV.Add(QueueV[q]); }
+    LevelBeg = LevelEnd;
+    Levels++;
+  }
+  return Levels;
+}
+
+void GetRcmOrder(const TVec<TInt64>& OffV, const TVec<TInt, int64>& NbrV, TIntV& OrderV) {
+  const int Nodes = TMath::Mx(OffV.Len()-1, 0);
+  TIntV DegOrderV;
+  GetDegOrder(OffV, DegOrderV);
+  TIntV MarkV(Nodes), QueueV(Nodes, 0), LastV(Nodes, 0);
+  TBoolV SeenV(Nodes);
+  TIntPrV DegNbrV;
+  int Stamp = 0;
+  OrderV.Gen(Nodes, 0);
+  // components are started from their smallest degree node
+  for (int s = Nodes-1; s >= 0; s--) {
+    if (SeenV[DegOrderV[s]]) { continue; }
+    // pseudo-peripheral start node (George and Liu): move to the smallest degree
+    // node of the last BFS level while the eccentricity grows
+    int Start = DegOrderV[s];
+    int Levels = GetBfsLevels(OffV, NbrV, Start, ++Stamp, MarkV, QueueV, LastV);
+    for (int i = 0; i < 8; i++) {
+      int Next = LastV[0];
+      for (int l = 1; l < LastV.Len(); l++) {
+        if (OffV[LastV[l]+1]-OffV[LastV[l]] < OffV[Next+1]-OffV[Next]) { Next = LastV[l]; }
+      }
+      const int NextLevels = GetBfsLevels(OffV, NbrV, Next, ++Stamp, MarkV, QueueV, LastV);
+      if (NextLevels <= Levels) { break; }
+      Start = Next;  Levels = NextLevels;
+    }
+    // Cuthill-McKee: breadth first search visiting neighbors by increasing degree
+    SeenV[Start] = true;
+    OrderV.Add(Start);
+    for (int q = OrderV.Len()-1; q < OrderV.Len(); q++) {
+      const int n = OrderV[q];
+      DegNbrV.Clr(false);
+      for (int64 e = OffV[n]; e < OffV[n+1]; e++) {
+        const int m = NbrV[e];
+        if (! SeenV[m]) {
+          SeenV[m] = true;
+          DegNbrV.Add(TIntPr(int(OffV[m+1]-OffV[m]), m));
+        }
+      }
+      DegNbrV.Sort();
+      for (int i = 0; i < DegNbrV.Len(); i++) { OrderV.Add(DegNbrV[i].Val2); }
+    }
+  }
+  OrderV.Reverse();
+}
+
+// Unit heap of Gorder: nodes are kept in doubly linked lists, one for every
+// score. Scores change by one, so every update takes constant time.
+class TGorderHeap {
+private:
+  TIntV KeyV, PrevV, NextV, HeadV;
+  int Top;
+private:
+  void Push(const int& n) {
+    const int Key = KeyV[n];
+    if (Key >= HeadV.Len()) { HeadV.Add(-1); }
+    PrevV[n] = -1;  NextV[n] = HeadV[Key];
+    if (HeadV[Key] != -1) { PrevV[HeadV[Key]] = n; }
+    HeadV[Key] = n;
+    if (Key > Top) { Top = Key; }
+  }
+  void Remove(const int& n) {
+    if (PrevV[n] != -1) { NextV[PrevV[n]] = NextV[n]; } else { HeadV[KeyV[n]] = NextV[n]; }
+    if (NextV[n] != -1) { PrevV[NextV[n]] = PrevV[n]; }
+  }
+public:
+  TGorderHeap(const int& Nodes) : KeyV(Nodes), PrevV(Nodes), NextV(Nodes), HeadV(1), Top(0) { HeadV[0] = -1; }
+  // Nodes are popped in the reverse order of their Add() among equal scores.
+  void Add(const int& n) { Push(n); }
+  void Inc(const int& n) { Remove(n);  KeyV[n]++;  Push(n); }
+  void Dec(const int& n) { Remove(n);  KeyV[n]--;  Push(n); }
+  int PopMx() {
+    while (HeadV[Top] == -1) { Top--; }
+    const int n = HeadV[Top];
+    Remove(n);
+    return n;
+  }
+};
+
+// Adds Diff to the Gorder score of the nodes that are not placed yet and are
+// neighbors of n (edge score) or share a neighbor with n (sibling score).
+// Neighbors with more than HubDeg neighbors are skipped as siblings.
+void UpdateGorder(const TVec<TInt64>& OffV, const TVec<TInt, int64>& NbrV, const int& n, const int& Diff,
+ const int64& HubDeg, const TBoolV& PlacedV, TGorderHeap& Heap) {
+  for (int64 e = OffV[n]; e < OffV[n+1]; e++) {
+    const int u = NbrV[e];
+    if (! PlacedV[u]) {
+      if (Diff > 0) { Heap.Inc(u); } else { Heap.Dec(u); }
+    }
+    if (OffV[u+1]-OffV[u] > HubDeg) { continue; }
+    for (int64 f = OffV[u]; f < OffV[u+1]; f++) {
+      const int x = NbrV[f];
+      if (PlacedV[x]) { continue; }
+      if (Diff > 0) { Heap.Inc(x); } else { Heap.Dec(x); }
+    }
+  }
+}
+
+void GetGorder(const TVec<TInt64>& OffV, const TVec<TInt, int64>& NbrV, const int& Window, TIntV& OrderV) {
+  const int Nodes = TMath::Mx(OffV.Len()-1, 0);
+  const int64 HubDeg = TMath::Mx(int64(sqrt(double(Nodes))), int64(16));
+  TIntV DegOrderV;
+  GetDegOrder(OffV, DegOrderV);
+  // ties are broken by decreasing degree
+  TGorderHeap Heap(Nodes);
+  for (int i = Nodes-1; i >= 0; i--) { Heap.Add(DegOrderV[i]); }
+  TBoolV PlacedV(Nodes);
+  OrderV.Gen(Nodes, 0);
+  for (int i = 0; i < Nodes; i++) {
+    if (i > Window) { UpdateGorder(OffV, NbrV, OrderV[i-Window-1], -1, HubDeg, PlacedV, Heap); }
+    const int n = Heap.PopMx();
+    PlacedV[n] = true;
+    OrderV.Add(n);
+    UpdateGorder(OffV, NbrV, n, 1, HubDeg, PlacedV, Heap);
+  }
+}
+
+// Out-neighbors of the nodes in the new order in CSR form over new ids, sorted
+// in parallel. NewIdV is a dense workspace of length Graph->GetMxNId().
+template <class PGraph>
+void GetReorderedCsr(const PGraph& Graph, const TIntV& NIdV, TIntH& NewNIdH, TVec<TInt64>& OffV, TVec<TInt, int64>& NbrV) {
+  const int Nodes = NIdV.Len();
+  IAssertR(Nodes == Graph->GetNodes(), "NIdV is not an order of all nodes.");
+  TIntV NewIdV(Graph->GetMxNId());
+  NewIdV.PutAll(-1);
+  NewNIdH.Gen(Nodes);
+  OffV.Gen(Nodes+1);
+  for (int n = 0; n < Nodes; n++) {
+    IAssertR(Graph->IsNode(NIdV[n]) && NewIdV[NIdV[n]] == -1, "NIdV is not an order of all nodes.");
+    NewIdV[NIdV[n]] = n;
+    NewNIdH.AddDat(NIdV[n], n);
+    OffV[n+1] = OffV[n] + Graph->GetNI(NIdV[n]).GetOutDeg();
+  }
+  NbrV.Gen(OffV[Nodes]);
+#ifdef USE_OPENMP
+  #pragma omp parallel for schedule(dynamic, 10000)
+#endif
+  for (int n = 0; n < Nodes; n++) {
+    const typename PGraph::TObj::TNodeI NI = Graph->GetNI(NIdV[n]);
+    const int64 Off = OffV[n];
+    for (int e = 0; e < NI.GetOutDeg(); e++) { NbrV[Off+e] = NewIdV[NI.GetOutNId(e)]; }
+    if (NI.GetOutDeg() > 1) { NbrV.QSort(Off, OffV[n+1]-1, true); }
+  }
+}
+
+} // namespace TSnapDetail
+
+PUNGraph GetReorderedGraph(const PUNGraph& Graph, const TIntV& NIdV, TIntH& NewNIdH) {
+  TVec<TInt64> OffV;
+  TVec<TInt, int64> NbrV;
+  TSnapDetail::GetReorderedCsr(Graph, NIdV, NewNIdH, OffV, NbrV);
+  PUNGraph NewGraph;
+  TSnapDetail::GetGraphFromCsr(OffV, NbrV, NewGraph);
+  return NewGraph;
+}
+
+PNGraph GetReorderedGraph(const PNGraph& Graph, const TIntV& NIdV, TIntH& NewNIdH) {
+  TVec<TInt64> OffV;
+  TVec<TInt, int64> NbrV;
+  TSnapDetail::GetReorderedCsr(Graph, NIdV, NewNIdH, OffV, NbrV);
+  PNGraph NewGraph;
+  TSnapDetail::GetGraphFromCsr(OffV, NbrV, NewGraph);
+  return NewGraph;
+}
+
+} // namespace TSnap
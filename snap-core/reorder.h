@@ -0,0 +1,132 @@
+/*! \file reorder.h
+    \brief Node orders that improve the cache locality of graph traversals.
+*/
+
+namespace TSnap {
+
+/////////////////////////////////////////////////
+// Node reordering
+// Nodes of SNAP graphs are kept in a hash table in the order in which they
+// were added. Renumbering the nodes so that nodes which are close in the graph
+// get close ids (and close hash slots) reduces the cache misses of loops over
+// neighborhoods, e.g. in PageRank, BFS and triad counting.
+// An order is a vector NIdV of all node ids, node NIdV[i] gets the new id i.
+
+/// Node orders of GetNodeOrder().
+typedef enum TNodeOrder_ { noDeg, noBfs, noRcm, noGorder } TNodeOrder;
+
+/// Orders nodes by decreasing degree. ##TSnap::GetDegOrder
+template <class PGraph> void GetDegOrder(const PGraph& Graph, TIntV& NIdV);
+/// Orders nodes by breadth first search from the largest degree node of each component. ##TSnap::GetBfsOrder
+template <class PGraph> void GetBfsOrder(const PGraph& Graph, TIntV& NIdV);
+/// Orders nodes by the reverse Cuthill-McKee algorithm. ##TSnap::GetRcmOrder
+template <class PGraph> void GetRcmOrder(const PGraph& Graph, TIntV& NIdV);
+/// Orders nodes by a greedy windowed approximation of Gorder. ##TSnap::GetGorder
+template <class PGraph> void GetGorder(const PGraph& Graph, TIntV& NIdV, const int& Window=5);
+/// Orders nodes by the node order Order.
+template <class PGraph> void GetNodeOrder(const PGraph& Graph, const TNodeOrder& Order, TIntV& NIdV);
+
+/// Returns a copy of Graph in which node NIdV[i] has id i. ##TSnap::GetReorderedGraph
+PUNGraph GetReorderedGraph(const PUNGraph& Graph, const TIntV& NIdV, TIntH& NewNIdH);
+/// Returns a copy of Graph in which node NIdV[i] has id i. ##TSnap::GetReorderedGraph
+PNGraph GetReorderedGraph(const PNGraph& Graph, const TIntV& NIdV, TIntH& NewNIdH);
+/// Returns a copy of Graph renumbered by the node order Order. ##TSnap::Reorder
+template <class PGraph> PGraph Reorder(const PGraph& Graph, const TNodeOrder& Order, TIntV& NIdV, TIntH& NewNIdH);
+/// Translates node data of a reordered graph to the original node ids. ##TSnap::GetOrigNIdDat
+template <class TDat> void GetOrigNIdDat(const THash<TInt, TDat>& NewDatH, const TIntV& NIdV, THash<TInt, TDat>& DatH);
+
+/////////////////////////////////////////////////
+// Implementation
+namespace TSnapDetail {
+/// Gets neighbors of all nodes (in and out for directed graphs) in CSR form over node indices. ##TSnapDetail::GetNbrCsr
+template <class PGraph> void GetNbrCsr(const PGraph& Graph, TIntV& NIdV, TVec<TInt64>& OffV, TVec<TInt, int64>& NbrV);
+/// Orders node indices by decreasing degree, ties keep the index order.
+void GetDegOrder(const TVec<TInt64>& OffV, TIntV& OrderV);
+/// Orders node indices of a CSR adjacency by breadth first search.
+void GetBfsOrder(const TVec<TInt64>& OffV, const TVec<TInt, int64>& NbrV, TIntV& OrderV);
+/// Orders node indices of a CSR adjacency by reverse Cuthill-McKee.
+void GetRcmOrder(const TVec<TInt64>& OffV, const TVec<TInt, int64>& NbrV, TIntV& OrderV);
+/// Orders node indices of a CSR adjacency by windowed Gorder.
+void GetGorder(const TVec<TInt64>& OffV, const TVec<TInt, int64>& NbrV, const int& Window, TIntV& OrderV);
+
+template <class PGraph>
+void GetNbrCsr(const PGraph& Graph, TIntV& NIdV, TVec<TInt64>& OffV, TVec<TInt, int64>& NbrV) {
+  const int Nodes = Graph->GetNodes();
+  TIntV IdxV(Graph->GetMxNId());
+  NIdV.Gen(Nodes, 0);
+  OffV.Gen(Nodes+1);
+  for (typename PGraph::TObj::TNodeI NI = Graph->BegNI(); NI < Graph->EndNI(); NI++) {
+    const int n = NIdV.Add(NI.GetId());
+    IdxV[NI.GetId()] = n;
+    OffV[n+1] = OffV[n] + NI.GetDeg();
+  }
+  NbrV.Gen(OffV[Nodes]);
+#ifdef USE_OPENMP
+  #pragma omp parallel for schedule(dynamic, 10000)
+#endif
+  for (int n = 0; n < Nodes; n++) {
+    const typename PGraph::TObj::TNodeI NI = Graph->GetNI(NIdV[n]);
+    const int64 Off = OffV[n];
+    for (int e = 0; e < NI.GetDeg(); e++) { NbrV[Off+e] = IdxV[NI.GetNbrNId(e)]; }
+  }
+}
+} // namespace TSnapDetail
+
+template <class PGraph>
+void GetDegOrder(const PGraph& Graph, TIntV& NIdV) {
+  GetNodeOrder(Graph, noDeg, NIdV);
+}
+
+template <class PGraph>
+void GetBfsOrder(const PGraph& Graph, TIntV& NIdV) {
+  GetNodeOrder(Graph, noBfs, NIdV);
+}
+
+template <class PGraph>
+void GetRcmOrder(const PGraph& Graph, TIntV& NIdV) {
+  GetNodeOrder(Graph, noRcm, NIdV);
+}
+
+template <class PGraph>
+void GetGorder(const PGraph& Graph, TIntV& NIdV, const int& Window) {
+  TIntV IdxNIdV, OrderV;
+  TVec<TInt64> OffV;
+  TVec<TInt, int64> NbrV;
+  TSnapDetail::GetNbrCsr(Graph, IdxNIdV, OffV, NbrV);
+  TSnapDetail::GetGorder(OffV, NbrV, Window, OrderV);
+  NIdV.Gen(OrderV.Len());
+  for (int i = 0; i < OrderV.Len(); i++) { NIdV[i] = IdxNIdV[OrderV[i]]; }
+}
+
+template <class PGraph>
+void GetNodeOrder(const PGraph& Graph, const TNodeOrder& Order, TIntV& NIdV) {
+  if (Order == noGorder) { GetGorder(Graph, NIdV);  return; }
+  TIntV IdxNIdV, OrderV;
+  TVec<TInt64> OffV;
+  TVec<TInt, int64> NbrV;
+  TSnapDetail::GetNbrCsr(Graph, IdxNIdV, OffV, NbrV);
+  switch (Order) {
+    case noDeg: TSnapDetail::GetDegOrder(OffV, OrderV); break;
+    case noBfs: TSnapDetail::GetBfsOrder(OffV, NbrV, OrderV); break;
+    case noRcm: TSnapDetail::GetRcmOrder(OffV, NbrV, OrderV); break;
+    default: FailR("Unknown node order.");
+  }
+  NIdV.Gen(OrderV.Len());
+  for (int i = 0; i < OrderV.Len(); i++) { NIdV[i] = IdxNIdV[OrderV[i]]; }
+}
+
+template <class PGraph>
+PGraph Reorder(const PGraph& Graph, const TNodeOrder& Order, TIntV& NIdV, TIntH& NewNIdH) {
+  GetNodeOrder(Graph, Order, NIdV);
+  return GetReorderedGraph(Graph, NIdV, NewNIdH);
+}
+
+template <class TDat>
+void GetOrigNIdDat(const THash<TInt, TDat>& NewDatH, const TIntV& NIdV, THash<TInt, TDat>& DatH) {
+  DatH.Gen(NewDatH.Len());
+  for (int KeyId = NewDatH.FFirstKeyId(); NewDatH.FNextKeyId(KeyId); ) {
+    DatH.AddDat(NIdV[NewDatH.GetKey(KeyId)], NewDatH[KeyId]);
+  }
+}
+
+} // namespace TSnap
@@ -264,3 +264,150 @@ PNEANet KNNJaccard(PNGraph Graph, int K) {
   return KNN;
 }
 
+
+// Mixes a 64-bit value (splitmix64 finalizer), used as a seeded MinHash function.
+static uint64 MinHashMix(uint64 X) {
+  X += 0x9E3779B97F4A7C15ULL;
+  X = (X ^ (X >> 30)) * 0xBF58476D1CE4E5B9ULL;
+  X = (X ^ (X >> 27)) * 0x94D049BB133111EBULL;
+  return X ^ (X >> 31);
+}
+
+// Inserts (Sim, NId) into a descending top-K list, as in KNNJaccard.
+static void AddTopK(TVec<TPair<TFlt, TInt> >& TopK, const float& Sim, const int& NId) {
+  const int K = TopK.Len();
+  if (TopK[K-1].GetVal1() >= Sim) { return; }
+  int index = 0;
+  for (int i = K-2; i >= 0; i--) {
+    if (TopK[i].GetVal1() < Sim) {
+      TopK.SetVal(i+1, TopK[i]);
+    } else {
+      index = i+1;
+      break;
+    }
+  }
+  TopK.SetVal(index, TPair<TFlt, TInt>(Sim, NId));
+}
+
+PNEANet KNNJaccardLSH(PNGraph Graph, int K, int Bands, int Rows, int MxBucketSz, int Seed) {
+  IAssert(K > 0 && Bands > 0 && Rows > 0 && MxBucketSz > 0);
+  PNEANet KNN = TNEANet::New();
+  TIntV NIdV;
+  Graph->GetNIdV(NIdV);
+  for (int ind = 0; ind < NIdV.Len(); ind++) {
+    KNN->AddNode(NIdV[ind]);
+  }
+  KNN->AddFltAttrE("sim");
+
+  // source side of the bipartite graph: nodes with out-edges only
+  TIntV SrcV;
+  for (int ind = 0; ind < NIdV.Len(); ind++) {
+    TNGraph::TNodeI NI = Graph->GetNI(NIdV[ind]);
+    if (NI.GetInDeg() == 0  &&  NI.GetOutDeg() > 0) {
+      SrcV.Add(NIdV[ind]);
+    }
+  }
+  const int Srcs = SrcV.Len();
+  const int Hashes = Bands * Rows;
+
+  TRnd Rnd(Seed);
+  TVec<uint64> HashSeedV(Hashes);
+  for (int h = 0; h < Hashes; h++) {
+    HashSeedV[h] = Rnd.GetUniDevUInt64();
+  }
+
+  // MinHash signatures, Hashes values per source node
+  TVec<uint64, int64> SigV((int64) Srcs * Hashes);
+#ifdef USE_OPENMP
+  #pragma omp parallel for schedule(dynamic, 1000)
+#endif
+  for (int s = 0; s < Srcs; s++) {
+    TNGraph::TNodeI NI = Graph->GetNI(SrcV[s]);
+    uint64* Sig = &SigV[(int64) s * Hashes];
+    for (int h = 0; h < Hashes; h++) {
+      uint64 MnHash = TUInt64::Mx.Val;
+      for (int i = 0; i < NI.GetOutDeg(); i++) {
+        const uint64 Hash = MinHashMix((uint64) NI.GetOutNId(i) ^ HashSeedV[h]);
+        if (Hash < MnHash) { MnHash = Hash; }
+      }
+      Sig[h] = MnHash;
+    }
+  }
+
+  // banded LSH: per band, sort (band key, source) pairs so that buckets are contiguous
+  TVec<TVec<TPair<TUInt64, TInt> > > BandKeyVV(Bands);
+  TVec<TIntV> BandPosVV(Bands);
+#ifdef USE_OPENMP
+  #pragma omp parallel for schedule(dynamic, 1)
+#endif
+  for (int b = 0; b < Bands; b++) {
+    TVec<TPair<TUInt64, TInt> >& KeyV = BandKeyVV[b];
+    KeyV.Gen(Srcs);
+    for (int s = 0; s < Srcs; s++) {
+      const uint64* Sig = &SigV[(int64) s * Hashes + b * Rows];
+      uint64 Key = 0;
+      for (int r = 0; r < Rows; r++) {
+        Key = MinHashMix(Key ^ Sig[r]);
+      }
+      KeyV[s] = TPair<TUInt64, TInt>(Key, s);
+    }
+    KeyV.Sort();
+    TIntV& PosV = BandPosVV[b];
+    PosV.Gen(Srcs);
+    for (int p = 0; p < Srcs; p++) {
+      PosV[KeyV[p].Val2] = p;
+    }
+  }
+  SigV.Clr();
+
+  // candidates from shared buckets, verified with the exact Jaccard similarity
+  TVec<TVec<TPair<TFlt, TInt> > > TopKV(Srcs);
+#ifdef USE_OPENMP
+  #pragma omp parallel
+#endif
+  {
+    TIntV SeenV(Srcs);
+    SeenV.PutAll(-1);
+#ifdef USE_OPENMP
+    #pragma omp for schedule(dynamic, 1000)
+#endif
+    for (int s = 0; s < Srcs; s++) {
+      TNGraph::TNodeI NI = Graph->GetNI(SrcV[s]);
+      TVec<TPair<TFlt, TInt> >& TopK = TopKV[s];
+      TopK.Gen(K);
+      TopK.PutAll(TPair<TFlt, TInt>(0.0, -1));
+      for (int b = 0; b < Bands; b++) {
+        const TVec<TPair<TUInt64, TInt> >& KeyV = BandKeyVV[b];
+        const int Pos = BandPosVV[b][s];
+        const uint64 Key = KeyV[Pos].Val1;
+        // scan the bucket outwards from the node, at most MxBucketSz entries
+        int Beg = Pos, End = Pos + 1;
+        while (End - Beg < MxBucketSz) {
+          const bool CanDown = Beg > 0  &&  KeyV[Beg-1].Val1 == Key;
+          const bool CanUp = End < Srcs  &&  KeyV[End].Val1 == Key;
+          if (!CanDown  &&  !CanUp) { break; }
+          if (CanDown) { Beg--; }
+          if (CanUp  &&  End - Beg < MxBucketSz) { End++; }
+        }
+        for (int p = Beg; p < End; p++) {
+          const int Cand = KeyV[p].Val2;
+          if (SeenV[Cand] == s) { continue; }
+          SeenV[Cand] = s;
+          const float similarity = JaccardSim(NI, Graph->GetNI(SrcV[Cand]));
+          AddTopK(TopK, similarity, SrcV[Cand]);
+        }
+      }
+    }
+  }
+
+  for (int s = 0; s < Srcs; s++) {
+    for (int j = 0; j < K; j++) {
+      if (TopKV[s][j].GetVal2() <= -1) {
+        break;
+      }
+      int EId = KNN->AddEdge(SrcV[s], TopKV[s][j].GetVal2());
+      KNN->AddFltAttrDatE(EId, TopKV[s][j].GetVal1(), "sim");
+    }
+  }
+  return KNN;
+}
@@ -12,6 +12,13 @@
 
 PNGraph GetBiGraph(PTable P, int index_col_1, int index_col_2);
 PNEANet KNNJaccard(PNGraph Graph,int K);
+/// Approximate KNNJaccard using MinHash signatures and banded LSH.
+/// Candidates are nodes sharing at least one band bucket and are verified
+/// with the exact Jaccard similarity. A pair with similarity s becomes a
+/// candidate with probability 1-(1-s^Rows)^Bands, so more Bands (or fewer
+/// Rows) raise recall at the cost of time. At most MxBucketSz bucket entries
+/// around a node are examined per band.
+PNEANet KNNJaccardLSH(PNGraph Graph, int K, int Bands=20, int Rows=2, int MxBucketSz=1000, int Seed=1);
 #ifdef GCC_ATOMIC
 PNEANet KNNJaccardParallel(PNGraph Graph,int K);
 #endif
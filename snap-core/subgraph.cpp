@@ -1,17 +1,135 @@
 namespace TSnap {
 
+namespace TSnapDetail {
+
+// Induced subgraph on the nodes of NIdV. MarkV and NewIdV are dense workspaces
+// indexed by node id (length Graph->GetMxNId()), MarkV[NId]==Stamp marks a member.
+// Edges are appended in increasing order of source ids, so adjacency vectors come
+// out sorted without per-edge checks. BndEdges returns the number of edges between
+// a member and a non-member.
+PUNGraph GetMarkedSubGraph(const PUNGraph& Graph, const TIntV& NIdV, const int& Stamp,
+ TIntV& MarkV, TIntV& NewIdV, const bool& RenumberNodes, int& BndEdges) {
+  TIntV SrcV(NIdV.Len(), 0);
+  for (int n = 0; n < NIdV.Len(); n++) {
+    const int NId = NIdV[n];
+    if (Graph->IsNode(NId) && MarkV[NId] != Stamp) {
+      MarkV[NId] = Stamp;
+      if (RenumberNodes) { NewIdV[NId] = SrcV.Len(); }
+      SrcV.Add(NId);
+    }
+  }
+  PUNGraph NewGraphPt = TUNGraph::New();
+  TUNGraph& NewGraph = *NewGraphPt;
+  NewGraph.Reserve(SrcV.Len(), -1);
+  BndEdges = 0;
+  for (int n = 0; n < SrcV.Len(); n++) {
+    const TUNGraph::TNodeI NI = Graph->GetNI(SrcV[n]);
+    int Deg = 0;
+    for (int e = 0; e < NI.GetDeg(); e++) {
+      if (MarkV[NI.GetNbrNId(e)] == Stamp) { Deg++; }
+    }
+    BndEdges += NI.GetDeg() - Deg;
+    const int NewNId = RenumberNodes ? n : SrcV[n].Val;
+    NewGraph.AddNode(NewNId);
+    NewGraph.ReserveNIdDeg(NewNId, Deg);
+  }
+  TIntV SortedV(SrcV);
+  SortedV.Sort();
+  for (int n = 0; n < SortedV.Len(); n++) {
+    const int SrcNId = SortedV[n];
+    const TUNGraph::TNodeI NI = Graph->GetNI(SrcNId);
+    for (int e = 0; e < NI.GetDeg(); e++) {
+      const int DstNId = NI.GetNbrNId(e);
+      if (DstNId < SrcNId || MarkV[DstNId] != Stamp) { continue; }
+      if (! RenumberNodes) { NewGraph.AddEdgeUnchecked(SrcNId, DstNId); }
+      else { NewGraph.AddEdgeUnchecked(NewIdV[SrcNId], NewIdV[DstNId]); }
+    }
+  }
+  if (RenumberNodes) { NewGraph.SortNodeAdjV(); }
+  return NewGraphPt;
+}
+
+// Directed version of GetMarkedSubGraph(). InBndEdges (OutBndEdges) returns the
+// number of edges pointing into (out of) the member set.
+PNGraph GetMarkedSubGraph(const PNGraph& Graph, const TIntV& NIdV, const int& Stamp,
+ TIntV& MarkV, TIntV& NewIdV, const bool& RenumberNodes, int& InBndEdges, int& OutBndEdges) {
+  TIntV SrcV(NIdV.Len(), 0);
+  for (int n = 0; n < NIdV.Len(); n++) {
+    const int NId = NIdV[n];
+    if (Graph->IsNode(NId) && MarkV[NId] != Stamp) {
+      MarkV[NId] = Stamp;
+      if (RenumberNodes) { NewIdV[NId] = SrcV.Len(); }
+      SrcV.Add(NId);
+    }
+  }
+  PNGraph NewGraphPt = TNGraph::New();
+  TNGraph& NewGraph = *NewGraphPt;
+  NewGraph.Reserve(SrcV.Len(), -1);
+  InBndEdges = 0;  OutBndEdges = 0;
+  for (int n = 0; n < SrcV.Len(); n++) {
+    const TNGraph::TNodeI NI = Graph->GetNI(SrcV[n]);
+    int InDeg = 0, OutDeg = 0;
+    for (int e = 0; e < NI.GetInDeg(); e++) {
+      if (MarkV[NI.GetInNId(e)] == Stamp) { InDeg++; }
+    }
+    for (int e = 0; e < NI.GetOutDeg(); e++) {
+      if (MarkV[NI.GetOutNId(e)] == Stamp) { OutDeg++; }
+    }
+    InBndEdges += NI.GetInDeg() - InDeg;
+    OutBndEdges += NI.GetOutDeg() - OutDeg;
+    const int NewNId = RenumberNodes ? n : SrcV[n].Val;
+    NewGraph.AddNode(NewNId);
+    NewGraph.ReserveNIdInDeg(NewNId, InDeg);
+    NewGraph.ReserveNIdOutDeg(NewNId, OutDeg);
+  }
+  TIntV SortedV(SrcV);
+  SortedV.Sort();
+  for (int n = 0; n < SortedV.Len(); n++) {
+    const int SrcNId = SortedV[n];
+    const TNGraph::TNodeI NI = Graph->GetNI(SrcNId);
+    for (int e = 0; e < NI.GetOutDeg(); e++) {
+      const int DstNId = NI.GetOutNId(e);
+      if (MarkV[DstNId] != Stamp) { continue; }
+      if (! RenumberNodes) { NewGraph.AddEdgeUnchecked(SrcNId, DstNId); }
+      else { NewGraph.AddEdgeUnchecked(NewIdV[SrcNId], NewIdV[DstNId]); }
+    }
+  }
+  if (RenumberNodes) { NewGraph.SortNodeAdjV(); }
+  return NewGraphPt;
+}
+
+// Node set of the egonet of CtrNId: the center followed by its distinct neighbors.
+template <class PGraph>
+void GetEgonetNIdV(const PGraph& Graph, const int& CtrNId, TIntV& NIdV) {
+  const typename PGraph::TObj::TNodeI CtrNI = Graph->GetNI(CtrNId);
+  NIdV.Gen(CtrNI.GetDeg()+1, 0);
+  NIdV.Add(CtrNId);
+  for (int e = 0; e < CtrNI.GetDeg(); e++) {
+    NIdV.Add(CtrNI.GetNbrNId(e));
+  }
+}
+
+} // namespace TSnapDetail
+
 /////////////////////////////////////////////////
 // Graph Algorithms
 
 // RenumberNodes ... Renumber node ids in the subgraph to 0...N-1
 PUNGraph GetSubGraph(const PUNGraph& Graph, const TIntV& NIdV, const bool& RenumberNodes) {
   //if (! RenumberNodes) { return TSnap::GetSubGraph(Graph, NIdV); }
+  if (NIdV.Len() >= Graph->GetMxNId() / 16) {
+    // large node sets: dense membership marks instead of a hash set
+    TIntV MarkV(Graph->GetMxNId()), NewIdV(RenumberNodes ? Graph->GetMxNId() : 0);
+    MarkV.PutAll(-1);
+    int BndEdges;
+    return TSnapDetail::GetMarkedSubGraph(Graph, NIdV, 0, MarkV, NewIdV, RenumberNodes, BndEdges);
+  }
   PUNGraph NewGraphPt = TUNGraph::New();
   TUNGraph& NewGraph = *NewGraphPt;
   NewGraph.Reserve(NIdV.Len(), -1);
   TIntSet NIdSet(NIdV.Len());
   for (int n = 0; n < NIdV.Len(); n++) {
-    if (Graph->IsNode(NIdV[n])) {
+    if (Graph->IsNode(NIdV[n]) && ! NIdSet.IsKey(NIdV[n])) {
       NIdSet.AddKey(NIdV[n]);
       if (! RenumberNodes) { NewGraph.AddNode(NIdV[n]); }
       else { NewGraph.AddNode(NIdSet.GetKeyId(NIdV[n])); }
@@ -44,12 +162,19 @@ PUNGraph GetSubGraph(const PUNGraph& Graph, const TIntV& NIdV, const bool& Renum
 // RenumberNodes ... Renumber node ids in the subgraph to 0...N-1
 PNGraph GetSubGraph(const PNGraph& Graph, const TIntV& NIdV, const bool& RenumberNodes) {
   //if (! RenumberNodes) { return TSnap::GetSubGraph(Graph, NIdV); }
+  if (NIdV.Len() >= Graph->GetMxNId() / 16) {
+    // large node sets: dense membership marks instead of a hash set
+    TIntV MarkV(Graph->GetMxNId()), NewIdV(RenumberNodes ? Graph->GetMxNId() : 0);
+    MarkV.PutAll(-1);
+    int InBndEdges, OutBndEdges;
+    return TSnapDetail::GetMarkedSubGraph(Graph, NIdV, 0, MarkV, NewIdV, RenumberNodes, InBndEdges, OutBndEdges);
+  }
   PNGraph NewGraphPt = TNGraph::New();
   TNGraph& NewGraph = *NewGraphPt;
   NewGraph.Reserve(NIdV.Len(), -1);
   TIntSet NIdSet(NIdV.Len());
   for (int n = 0; n < NIdV.Len(); n++) {
-    if (Graph->IsNode(NIdV[n])) {
+    if (Graph->IsNode(NIdV[n]) && ! NIdSet.IsKey(NIdV[n])) {
       NIdSet.AddKey(NIdV[n]);
       if (! RenumberNodes) { NewGraph.AddNode(NIdV[n]); }
       else { NewGraph.AddNode(NIdSet.GetKeyId(NIdV[n])); }
@@ -140,4 +265,148 @@ PNGraph GetEgonet(const PNGraph& Graph, const int CtrNId, int& InEdges, int& Out
   return NewGraphPt;
 }
 
+PUNGraph GetMaskSubGraph(const PUNGraph& Graph, const TBoolV& NodeMaskV, const bool& RenumberNodes) {
+  TIntV NIdV;
+  for (TUNGraph::TNodeI NI = Graph->BegNI(); NI < Graph->EndNI(); NI++) {
+    if (NI.GetId() < NodeMaskV.Len() && NodeMaskV[NI.GetId()]) { NIdV.Add(NI.GetId()); }
+  }
+  TIntV MarkV(Graph->GetMxNId()), NewIdV(RenumberNodes ? Graph->GetMxNId() : 0);
+  MarkV.PutAll(-1);
+  int BndEdges;
+  return TSnapDetail::GetMarkedSubGraph(Graph, NIdV, 0, MarkV, NewIdV, RenumberNodes, BndEdges);
+}
+
+PNGraph GetMaskSubGraph(const PNGraph& Graph, const TBoolV& NodeMaskV, const bool& RenumberNodes) {
+  TIntV NIdV;
+  for (TNGraph::TNodeI NI = Graph->BegNI(); NI < Graph->EndNI(); NI++) {
+    if (NI.GetId() < NodeMaskV.Len() && NodeMaskV[NI.GetId()]) { NIdV.Add(NI.GetId()); }
+  }
+  TIntV MarkV(Graph->GetMxNId()), NewIdV(RenumberNodes ? Graph->GetMxNId() : 0);
+  MarkV.PutAll(-1);
+  int InBndEdges, OutBndEdges;
+  return TSnapDetail::GetMarkedSubGraph(Graph, NIdV, 0, MarkV, NewIdV, RenumberNodes, InBndEdges, OutBndEdges);
+}
+
+// Each thread owns one pair of dense workspaces, the index of the node list is the mark stamp.
+void GetSubGraphs(const PUNGraph& Graph, const TVec<TIntV>& NIdVV, TVec<PUNGraph>& SubGraphV, const bool& RenumberNodes) {
+  const int MxNId = Graph->GetMxNId();
+  SubGraphV.Gen(NIdVV.Len());
+#ifdef USE_OPENMP
+  #pragma omp parallel
+#endif
+  {
+    TIntV MarkV(MxNId), NewIdV(RenumberNodes ? MxNId : 0);
+    MarkV.PutAll(-1);
+    int BndEdges;
+#ifdef USE_OPENMP
+    #pragma omp for schedule(dynamic, 16)
+#endif
+    for (int i = 0; i < NIdVV.Len(); i++) {
+      SubGraphV[i] = TSnapDetail::GetMarkedSubGraph(Graph, NIdVV[i], i, MarkV, NewIdV, RenumberNodes, BndEdges);
+    }
+  }
+}
+
+void GetSubGraphs(const PNGraph& Graph, const TVec<TIntV>& NIdVV, TVec<PNGraph>& SubGraphV, const bool& RenumberNodes) {
+  const int MxNId = Graph->GetMxNId();
+  SubGraphV.Gen(NIdVV.Len());
+#ifdef USE_OPENMP
+  #pragma omp parallel
+#endif
+  {
+    TIntV MarkV(MxNId), NewIdV(RenumberNodes ? MxNId : 0);
+    MarkV.PutAll(-1);
+    int InBndEdges, OutBndEdges;
+#ifdef USE_OPENMP
+    #pragma omp for schedule(dynamic, 16)
+#endif
+    for (int i = 0; i < NIdVV.Len(); i++) {
+      SubGraphV[i] = TSnapDetail::GetMarkedSubGraph(Graph, NIdVV[i], i, MarkV, NewIdV, RenumberNodes, InBndEdges, OutBndEdges);
+    }
+  }
+}
+
+void GetEgonets(const PUNGraph& Graph, const TIntV& CtrNIdV, TVec<PUNGraph>& EgonetV, TIntV& ArndEdgesV) {
+  const int MxNId = Graph->GetMxNId();
+  EgonetV.Gen(CtrNIdV.Len());
+  ArndEdgesV.Gen(CtrNIdV.Len());
+#ifdef USE_OPENMP
+  #pragma omp parallel
+#endif
+  {
+    TIntV MarkV(MxNId), NewIdV, NIdV;
+    MarkV.PutAll(-1);
+#ifdef USE_OPENMP
+    #pragma omp for schedule(dynamic, 16)
+#endif
+    for (int i = 0; i < CtrNIdV.Len(); i++) {
+      TSnapDetail::GetEgonetNIdV(Graph, CtrNIdV[i], NIdV);
+      int BndEdges;
+      EgonetV[i] = TSnapDetail::GetMarkedSubGraph(Graph, NIdV, i, MarkV, NewIdV, false, BndEdges);
+      ArndEdgesV[i] = BndEdges;
+    }
+  }
+}
+
+void GetEgonets(const PNGraph& Graph, const TIntV& CtrNIdV, TVec<PNGraph>& EgonetV, TIntV& InEdgesV, TIntV& OutEdgesV) {
+  const int MxNId = Graph->GetMxNId();
+  EgonetV.Gen(CtrNIdV.Len());
+  InEdgesV.Gen(CtrNIdV.Len());
+  OutEdgesV.Gen(CtrNIdV.Len());
+#ifdef USE_OPENMP
+  #pragma omp parallel
+#endif
+  {
+    TIntV MarkV(MxNId), NewIdV, NIdV;
+    MarkV.PutAll(-1);
+#ifdef USE_OPENMP
+    #pragma omp for schedule(dynamic, 16)
+#endif
+    for (int i = 0; i < CtrNIdV.Len(); i++) {
+      TSnapDetail::GetEgonetNIdV(Graph, CtrNIdV[i], NIdV);
+      int InBndEdges, OutBndEdges;
+      EgonetV[i] = TSnapDetail::GetMarkedSubGraph(Graph, NIdV, i, MarkV, NewIdV, false, InBndEdges, OutBndEdges);
+      InEdgesV[i] = InBndEdges;  OutEdgesV[i] = OutBndEdges;
+    }
+  }
+}
+
+// Only counts, the egonets are never materialized.
+void GetEgonetStats(const PUNGraph& Graph, const TIntV& CtrNIdV, TIntTrV& NodesEdgesArndV) {
+  const int MxNId = Graph->GetMxNId();
+  NodesEdgesArndV.Gen(CtrNIdV.Len());
+#ifdef USE_OPENMP
+  #pragma omp parallel
+#endif
+  {
+    TIntV MarkV(MxNId);
+    MarkV.PutAll(-1);
+#ifdef USE_OPENMP
+    #pragma omp for schedule(dynamic, 64)
+#endif
+    for (int i = 0; i < CtrNIdV.Len(); i++) {
+      const TUNGraph::TNodeI CtrNI = Graph->GetNI(CtrNIdV[i]);
+      int Nodes = 1;
+      MarkV[CtrNIdV[i]] = i;
+      for (int e = 0; e < CtrNI.GetDeg(); e++) {
+        if (MarkV[CtrNI.GetNbrNId(e)] != i) { MarkV[CtrNI.GetNbrNId(e)] = i;  Nodes++; }
+      }
+      // each inner edge is seen from both endpoints, self-loops once
+      int InnerEnds = 0, SelfLoops = 0, ArndEdges = 0;
+      for (int e = -1; e < CtrNI.GetDeg(); e++) {
+        const int NId = e == -1 ? CtrNIdV[i].Val : CtrNI.GetNbrNId(e);
+        if (e != -1 && NId == CtrNIdV[i]) { continue; }
+        const TUNGraph::TNodeI NI = Graph->GetNI(NId);
+        for (int j = 0; j < NI.GetDeg(); j++) {
+          const int NbrNId = NI.GetNbrNId(j);
+          if (MarkV[NbrNId] != i) { ArndEdges++; }
+          else if (NbrNId == NId) { SelfLoops++; }
+          else { InnerEnds++; }
+        }
+      }
+      NodesEdgesArndV[i] = TIntTr(Nodes, InnerEnds/2 + SelfLoops, ArndEdges);
+    }
+  }
+}
+
 } // namespace TSnap
@@ -17,6 +17,14 @@ PUNGraph GetSubGraph(const PUNGraph& Graph, const TIntV& NIdV, const bool& Renum
 PNGraph GetSubGraph(const PNGraph& Graph, const TIntV& NIdV, const bool& RenumberNodes=false);
 // TODO ROK 2012/08/15 PNGraph GetSubGraph is not documented by doxygen.
 //  It is combined with PUNGraph GetSubGraph.
+/// Returns an induced subgraph of an undirected graph Graph on nodes NId with NodeMaskV[NId] set. ##TSnap::GetMaskSubGraph
+PUNGraph GetMaskSubGraph(const PUNGraph& Graph, const TBoolV& NodeMaskV, const bool& RenumberNodes=false);
+/// Returns an induced subgraph of a directed graph Graph on nodes NId with NodeMaskV[NId] set.
+PNGraph GetMaskSubGraph(const PNGraph& Graph, const TBoolV& NodeMaskV, const bool& RenumberNodes=false);
+/// Returns induced subgraphs of an undirected graph Graph, one for each node list in NIdVV, extracted in parallel. ##TSnap::GetSubGraphs
+void GetSubGraphs(const PUNGraph& Graph, const TVec<TIntV>& NIdVV, TVec<PUNGraph>& SubGraphV, const bool& RenumberNodes=false);
+/// Returns induced subgraphs of a directed graph Graph, one for each node list in NIdVV, extracted in parallel.
+void GetSubGraphs(const PNGraph& Graph, const TVec<TIntV>& NIdVV, TVec<PNGraph>& SubGraphV, const bool& RenumberNodes=false);
 
 // edge subgraphs
 /// Returns a subgraph of graph Graph with EIdV edges. ##TSnap::GetESubGraph
@@ -35,7 +43,6 @@ template<class PGraph, class TEdgeDat> PGraph GetEDatSubGraph(const PGraph& Grap
 template<class POutGraph, class PInGraph> POutGraph ConvertGraph(const PInGraph& InGraph, const bool& RenumberNodes=false);
 /// Returns an induced subgraph of graph InGraph with NIdV nodes with an optional node renumbering. ##TSnap::ConvertSubGraph
 template<class POutGraph, class PInGraph> POutGraph ConvertSubGraph(const PInGraph& InGraph, const TIntV& NIdV, const bool& RenumberNodes=false);
-// TODO RS 2012/08/14 find out why TSnap::ConvertSubGraph<PUNGraph>(NGraph, NIdV, true) aborts
 /// Returns a subgraph of graph InGraph with EIdV edges with an optional node renumbering. ##TSnap::ConvertESubGraph
 template<class POutGraph, class PInGraph> POutGraph ConvertESubGraph(const PInGraph& InGraph, const TIntV& EIdV, const bool& RenumberNodes=false);
 // does not work on multigraphs
@@ -51,6 +58,12 @@ template<class PGraph> PGraph GetRndESubGraph(const PGraph& Graph, const int& NE
 PUNGraph GetEgonet(const PUNGraph& Graph, const int CtrNId, int& ArndEdges);
 /// Returns the egonet of node CtrNId as center in directed graph Graph. And returns number of edges go in and out the egonet.
 PNGraph GetEgonet(const PNGraph& Graph, const int CtrNId, int& InEdges, int& OutEdges);
+/// Returns the egonets of all centers CtrNIdV in undirected graph Graph, extracted in parallel. ##TSnap::GetEgonets
+void GetEgonets(const PUNGraph& Graph, const TIntV& CtrNIdV, TVec<PUNGraph>& EgonetV, TIntV& ArndEdgesV);
+/// Returns the egonets of all centers CtrNIdV in directed graph Graph, extracted in parallel. ##TSnap::GetEgonets-1
+void GetEgonets(const PNGraph& Graph, const TIntV& CtrNIdV, TVec<PNGraph>& EgonetV, TIntV& InEdgesV, TIntV& OutEdgesV);
+/// Returns (nodes, edges, edges around) of the egonet of each center CtrNIdV without building the egonets. ##TSnap::GetEgonetStats
+void GetEgonetStats(const PUNGraph& Graph, const TIntV& CtrNIdV, TIntTrV& NodesEdgesArndV);
 
 /////////////////////////////////////////////////
 // Implementation
@@ -284,17 +297,21 @@ struct TConvertSubGraph<POutGraph, PInGraph, false> { // InGraph is not multigra
         }
       }
     } else { // renumber nodes so that node ids are 0...N-1
-      TIntSet NIdSet(InGraph->GetNodes());
+      // dense old-to-new id map, -1 marks nodes outside of the subgraph
+      TIntV NewNIdV(InGraph->GetMxNId());
+      NewNIdV.PutAll(-1);
+      int NNodes = 0;
       for (int n = 0; n < NIdV.Len(); n++) {
-        const int NId = NIdSet.AddKey(NIdV[n]);
-        OutGraph.AddNode(NId);
+        if (NewNIdV[NIdV[n]] != -1) { continue; }
+        NewNIdV[NIdV[n]] = NNodes;
+        OutGraph.AddNode(NNodes++);
       }
       for (int n = 0; n < NIdV.Len(); n++) {
         typename PInGraph::TObj::TNodeI NI = InGraph->GetNI(NIdV[n]);
-        const int src = NIdSet.GetKey(NIdV[n]);
+        const int src = NewNIdV[NIdV[n]];
         for (int e = 0; e < NI.GetOutDeg(); e++) {
-          const int dst = NIdSet.GetKey(NI.GetOutNId(e));
-          if (! OutGraph.IsNode(dst)) { continue; }
+          const int dst = NewNIdV[NI.GetOutNId(e)];
+          if (dst == -1) { continue; }
           OutGraph.AddEdge(src, dst);
         }
       }
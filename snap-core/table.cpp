@@ -570,6 +570,7 @@ void TTable::LoadSSPar(PTable& T, const Schema& S, const TStr& InFNm, const TInt
   // allocate memory for columns
   TInt IntColIdx = 0;
   TInt FltColIdx = 0;
+  TInt StrColIdx = 0;
   for (TInt i = 0; i < RowLen; i++) {
     switch (ColTypes[i]) {
       case atInt:
@@ -581,10 +582,19 @@ void TTable::LoadSSPar(PTable& T, const Schema& S, const TStr& InFNm, const TInt
         FltColIdx++;
         break;
       case atStr:
+        StrColIdx++;
         break;
     }
   }
 
+  // string cells are interned concurrently, the ids are mapped to the
+  // context below in row order, so KeyIds match the sequential loader
+  TStrHashMP StrH;
+  TVec<TVec<TInt64> > StrIdVV(StrColIdx);
+  for (int i = 0; i < StrIdVV.Len(); i++) {
+    StrIdVV[i].Gen(Cnt);
+  }
+
   Cnt = 0;
   omp_set_num_threads(NumThreads);
   #pragma omp parallel for schedule(dynamic) reduction(+:Cnt)
@@ -601,7 +611,9 @@ void TTable::LoadSSPar(PTable& T, const Schema& S, const TStr& InFNm, const TInt
       }
       TInt IntColIdx = 0;
       TInt FltColIdx = 0;
+      TInt StrColIdx = 0;
       TInt RowIdx = PrefixSumV[i] + k;
+      int ColIdx;
 
       for (TInt j = 0; j < RowLen; j++) {
         switch (ColTypes[j]) {
@@ -626,7 +638,10 @@ void TTable::LoadSSPar(PTable& T, const Schema& S, const TStr& InFNm, const TInt
             FltColIdx++;
             break;
           case atStr:
-            TExcept::Throw("TTable::LoadSS:: Str Col found\n");
+            ColIdx = RelevantCols.Len() == 0 ? j.Val : RelevantCols[j].Val;
+            StrIdVV[StrColIdx][RowIdx] = StrH.AddKey(FieldsV[ColIdx],
+              Ss.GetStrLenFromFldV(FieldsV, ColIdx));
+            StrColIdx++;
             break;
         }
       }
@@ -634,6 +649,24 @@ void TTable::LoadSSPar(PTable& T, const Schema& S, const TStr& InFNm, const TInt
     }
   }
 
+  // assign context KeyIds in order of first appearance
+  if (! StrIdVV.Empty()) {
+    TVec<TInt, int64> KeyIdV(StrH.GetMxKeyIds());
+    KeyIdV.PutAll(-1);
+    for (int i = 0; i < StrIdVV.Len(); i++) {
+      T->StrColMaps[i].Gen(Cnt);
+    }
+    for (int64 RowIdx = 0; RowIdx < Cnt; RowIdx++) {
+      for (int i = 0; i < StrIdVV.Len(); i++) {
+        const int64 StrId = StrIdVV[i][RowIdx];
+        if (KeyIdV[StrId] == -1) {
+          KeyIdV[StrId] = T->Context->StringVals.AddKey(StrH.GetKey(StrId));
+        }
+        T->StrColMaps[i][RowIdx] = KeyIdV[StrId];
+      }
+    }
+  }
+
   // set number of rows and "Next" vector
   T->NumRows = Cnt;
   T->NumValidRows = T->NumRows;
@@ -757,7 +790,6 @@ void TTable::LoadSSSeq(
 PTable TTable::LoadSS(const Schema& S, const TStr& InFNm, TTableContext* Context,
  const TIntV& RelevantCols, const char& Separator, TBool HasTitleLine) {
   TVec<uint64> IntGroupByCols;
-  bool NoStringCols = true;
 
   // find the schema for the new table which contains only relevant columns
   Schema SR;
@@ -770,17 +802,9 @@ PTable TTable::LoadSS(const Schema& S, const TStr& InFNm, TTableContext* Context
   }
   PTable T = New(SR, Context);
 
-  // find col types and check for string cols
-  for (int i = 0; i < SR.Len(); i++) {
-    if (T->GetSchemaColType(i) == atStr) {
-      NoStringCols = false;
-      break;
-    }
-  }
-
-  if (GetMP() && NoStringCols) {
-    // Right now, can load in parallel only in Linux (for mmap) and if
-    // there are no string columns
+  // compressed files are streamed, parallel loading needs mmap
+  if (GetMP() && ! TZipIn::IsZipFNm(InFNm)) {
+    // Right now, can load in parallel only in Linux (for mmap)
 #ifdef GLib_LINUX
     LoadSSPar(T, S, InFNm, RelevantCols, Separator, HasTitleLine);
 #else
@@ -884,6 +908,305 @@ void TTable::Save(TSOut& SOut) {
   SOut.Flush();
 }
 
+// Compares ids of the string pool by their strings.
+class TStrIdCmp {
+private:
+  const TStrHash<TInt, TBigStrPool>& StrH;
+public:
+  TStrIdCmp(const TStrHash<TInt, TBigStrPool>& _StrH) : StrH(_StrH) { }
+  bool operator () (const TInt& Id1, const TInt& Id2) const {
+    return strcmp(StrH.GetKey(Id1), StrH.GetKey(Id2)) < 0; }
+};
+
+// Columnar binary format (SaveColBin, LoadColBin):
+//   header: magic, int Version, int Rows, int Cols, for each column
+//     int NameLen, name, int Type, uint64 Ofs, double Mn, double Mx, int Nulls,
+//     followed by uint64 DictOfs, int DictStrs
+//   column segments at Ofs: a saved TVec (int MxVals, int Vals, values) with the
+//     values at a ColBinAlign boundary, string columns hold dictionary ranks
+//   dictionary at DictOfs: uint64 offsets of DictStrs+1 strings followed by the
+//     sorted null terminated strings
+static const char ColBinMagic[] = "SNAPCTAB";
+static const int ColBinVersion = 1;
+static const uint64 ColBinAlign = 64;
+
+static uint64 GetColBinAlign(const uint64& Pos) {
+  return (Pos + ColBinAlign - 1) / ColBinAlign * ColBinAlign;
+}
+
+static void PutColBinPad(TSOut& SOut, uint64& Pos, const uint64& NewPos) {
+  for (; Pos < NewPos; Pos++) { SOut.PutCh(0); }
+}
+
+// Loads the header of a columnar file of FLen bytes, checks that the column
+// segments and the dictionary offsets lie within the file.
+static void LoadColBinHdr(TSIn& SIn, const TStr& FNm, const uint64& FLen, int& Rows, Schema& S,
+ TVec<uint64>& OfsV, TFltPrV& MnMxV, TIntV& NullsV, uint64& DictOfs, int& DictStrs) {
+  const TStr CorruptStr = "Corrupt columnar table file: " + FNm;
+  char Magic[8];
+  SIn.GetBf(Magic, 8);
+  if (memcmp(Magic, ColBinMagic, 8) != 0) {
+    TExcept::Throw("Not a columnar table file: " + FNm);
+  }
+  int Version = 0, Cols = 0;
+  SIn.Load(Version);
+  if (Version != ColBinVersion) {
+    TExcept::Throw(TStr::Fmt("Unsupported columnar table version %d: ", Version) + FNm);
+  }
+  SIn.Load(Rows);  SIn.Load(Cols);
+  // a column takes at least 36 bytes of the header
+  if (Rows < 0 || Cols < 0 || uint64(Cols) > FLen / 36) { TExcept::Throw(CorruptStr); }
+  S.Clr();  OfsV.Gen(Cols);  MnMxV.Gen(Cols);  NullsV.Gen(Cols);
+  for (int c = 0; c < Cols; c++) {
+    int NameLen = 0, Type = 0, Nulls = 0;
+    double Mn = 0, Mx = 0;
+    SIn.Load(NameLen);
+    if (NameLen < 0 || uint64(NameLen) > FLen) { TExcept::Throw(CorruptStr); }
+    TChA Name(NameLen);
+    for (int i = 0; i < NameLen; i++) { Name += SIn.GetCh(); }
+    SIn.Load(Type);  SIn.Load(OfsV[c]);
+    SIn.Load(Mn);  SIn.Load(Mx);  SIn.Load(Nulls);
+    if (Type != atInt && Type != atFlt && Type != atStr) { TExcept::Throw(CorruptStr); }
+    const uint64 ValSize = Type == atFlt ? sizeof(double) : sizeof(int);
+    if (OfsV[c] > FLen || FLen - OfsV[c] < 2*sizeof(int) + Rows*ValSize) { TExcept::Throw(CorruptStr); }
+    S.Add(TPair<TStr,TAttrType>(Name, TAttrType(Type)));
+    MnMxV[c] = TFltPr(Mn, Mx);
+    NullsV[c] = Nulls;
+  }
+  SIn.Load(DictOfs);  SIn.Load(DictStrs);
+  if (DictStrs < 0 || DictOfs > FLen || (FLen - DictOfs) / sizeof(uint64) < uint64(DictStrs) + 1) {
+    TExcept::Throw(CorruptStr); }
+}
+
+void TTable::SaveColBin(const TStr& OutFNm) {
+  // rows are saved in their logical order
+  TIntV RowV(NumValidRows, 0);
+  for (TRowIterator RI = BegRI(); RI < EndRI(); RI++) { RowV.Add(RI.GetRowIdx()); }
+  const int Rows = RowV.Len();
+  bool InOrder = Rows == NumRows;
+  for (int r = 0; r < Rows && InOrder; r++) { InOrder = RowV[r] == r; }
+  // sorted dictionary of the strings of string columns
+  TIntV RankV, StrIdV;
+  if (! StrColMaps.Empty()) {
+    RankV.Gen(Context->StringVals.GetMxKeyIds());
+    for (int c = 0; c < StrColMaps.Len(); c++) {
+      for (int r = 0; r < Rows; r++) { RankV[StrColMaps[c][RowV[r]]] = 1; }
+    }
+    for (int s = 0; s < RankV.Len(); s++) {
+      if (RankV[s] != 0) { StrIdV.Add(s); }
+    }
+    StrIdV.SortCmp(TStrIdCmp(Context->StringVals));
+    for (int s = 0; s < StrIdV.Len(); s++) { RankV[StrIdV[s]] = s; }
+  }
+
+  // column statistics and segment offsets, the header size does not depend on them
+  const int Cols = Sch.Len();
+  TStrV NameV(Cols);
+  TFltPrV MnMxV(Cols);
+  TIntV NullsV(Cols);
+  TVec<uint64> OfsV(Cols);
+  uint64 Pos = 8 + 3*sizeof(int) + sizeof(uint64) + sizeof(int);
+  for (int c = 0; c < Cols; c++) {
+    NameV[c] = DenormalizeColName(Sch[c].Val1);
+    Pos += 3*sizeof(int) + NameV[c].Len() + sizeof(uint64) + 2*sizeof(double);
+  }
+  const uint64 HdrLen = Pos;
+  for (int c = 0; c < Cols; c++) {
+    const TPair<TAttrType, TInt> ColType = GetColTypeMap(Sch[c].Val1);
+    double Mn = 0, Mx = 0;
+    int Nulls = 0;
+    bool Empty = true;
+    for (int r = 0; r < Rows; r++) {
+      double Val = 0;
+      switch (ColType.Val1) {
+        case atInt: Val = IntCols[ColType.Val2][RowV[r]]; break;
+        case atFlt: Val = FltCols[ColType.Val2][RowV[r]]; break;
+        case atStr: Val = RankV[StrColMaps[ColType.Val2][RowV[r]]]; break;
+      }
+      if (Val != Val) { Nulls++;  continue; } // NaN
+      if (Empty || Val < Mn) { Mn = Val; }
+      if (Empty || Val > Mx) { Mx = Val; }
+      Empty = false;
+    }
+    MnMxV[c] = TFltPr(Mn, Mx);
+    NullsV[c] = Nulls;
+    const uint64 ValSize = ColType.Val1 == atFlt ? sizeof(double) : sizeof(int);
+    OfsV[c] = GetColBinAlign(Pos + 2*sizeof(int)) - 2*sizeof(int);
+    Pos = OfsV[c] + 2*sizeof(int) + Rows*ValSize;
+  }
+  const uint64 DictOfs = GetColBinAlign(Pos);
+
+  TFOut SOut(OutFNm);
+  SOut.PutBf(ColBinMagic, 8);
+  SOut.Save(ColBinVersion);  SOut.Save(Rows);  SOut.Save(Cols);
+  for (int c = 0; c < Cols; c++) {
+    SOut.Save(NameV[c].Len());
+    SOut.PutBf(NameV[c].CStr(), NameV[c].Len());
+    SOut.Save(int(Sch[c].Val2));  SOut.Save(OfsV[c]);
+    SOut.Save(MnMxV[c].Val1.Val);  SOut.Save(MnMxV[c].Val2.Val);  SOut.Save(NullsV[c].Val);
+  }
+  SOut.Save(DictOfs);  SOut.Save(StrIdV.Len());
+  Pos = HdrLen;
+  for (int c = 0; c < Cols; c++) {
+    const TPair<TAttrType, TInt> ColType = GetColTypeMap(Sch[c].Val1);
+    PutColBinPad(SOut, Pos, OfsV[c]);
+    SOut.Save(Rows);  SOut.Save(Rows);
+    uint64 BfL = 0;
+    if (ColType.Val1 == atFlt) {
+      const TFltV& ColV = FltCols[ColType.Val2];
+      BfL = Rows*sizeof(double);
+      if (InOrder) { SOut.PutBf(ColV.BegI(), BfL); }
+      else {
+        TFltV ValV(Rows);
+        for (int r = 0; r < Rows; r++) { ValV[r] = ColV[RowV[r]]; }
+        SOut.PutBf(ValV.BegI(), BfL);
+      }
+    } else {
+      const TIntV& ColV = ColType.Val1 == atInt ? IntCols[ColType.Val2] : StrColMaps[ColType.Val2];
+      BfL = Rows*sizeof(int);
+      if (InOrder && ColType.Val1 == atInt) { SOut.PutBf(ColV.BegI(), BfL); }
+      else {
+        TIntV ValV(Rows);
+        for (int r = 0; r < Rows; r++) {
+          ValV[r] = ColType.Val1 == atInt ? ColV[RowV[r]] : RankV[ColV[RowV[r]]]; }
+        SOut.PutBf(ValV.BegI(), BfL);
+      }
+    }
+    Pos += 2*sizeof(int) + BfL;
+  }
+  // dictionary
+  PutColBinPad(SOut, Pos, DictOfs);
+  uint64 StrOfs = 0;
+  for (int s = 0; s < StrIdV.Len(); s++) {
+    SOut.Save(StrOfs);
+    StrOfs += strlen(Context->StringVals.GetKey(StrIdV[s])) + 1;
+  }
+  SOut.Save(StrOfs);
+  for (int s = 0; s < StrIdV.Len(); s++) {
+    const char* Str = Context->StringVals.GetKey(StrIdV[s]);
+    SOut.PutBf(Str, strlen(Str) + 1);
+  }
+  SOut.Flush();
+}
+
+PTable TTable::LoadColBin(const TStr& InFNm, TTableContext* Context, const TStrV& Cols) {
+  const TStr CorruptStr = "Corrupt columnar table file: " + InFNm;
+  const uint64 FLen = TFile::GetSize(InFNm);
+  int Rows = 0, DictStrs = 0;
+  Schema S;
+  TVec<uint64> OfsV;
+  TFltPrV MnMxV;
+  TIntV NullsV;
+  uint64 DictOfs = 0;
+  { // reads from the mapping are not checked, TFIn throws on a truncated header
+    TFIn FIn(InFNm);
+    LoadColBinHdr(FIn, InFNm, FLen, Rows, S, OfsV, MnMxV, NullsV, DictOfs, DictStrs);
+  }
+  TShMIn ShMIn(InFNm);
+  const char* Bf = ShMIn.getCursor();
+  // requested columns
+  TIntV ColNV;
+  for (int i = 0; i < Cols.Len(); i++) {
+    const TStr NCol = NormalizeColName(Cols[i]);
+    int c = 0;
+    while (c < S.Len() && NormalizeColName(S[c].Val1) != NCol) { c++; }
+    if (c == S.Len()) { TExcept::Throw(Cols[i] + ": no such column"); }
+    ColNV.Add(c);
+  }
+  if (Cols.Empty()) {
+    for (int c = 0; c < S.Len(); c++) { ColNV.Add(c); }
+  }
+  // strings are added to the context, ranks are context ids if the context
+  // is empty or already holds the dictionary in the same order
+  TIntV DictIdV;
+  bool DictIsId = true;
+  for (int i = 0; i < ColNV.Len() && DictIdV.Empty(); i++) {
+    if (S[ColNV[i]].Val2 != atStr) { continue; }
+    const uint64* StrOfs = (const uint64*) (Bf + DictOfs);
+    const char* StrBf = (const char*) (StrOfs + DictStrs + 1);
+    // strings are null terminated and end within the file
+    const uint64 StrBfL = FLen - (DictOfs + (DictStrs+1)*sizeof(uint64));
+    if (StrOfs[DictStrs] > StrBfL) { TExcept::Throw(CorruptStr); }
+    for (int s = 0; s < DictStrs; s++) {
+      if (StrOfs[s] >= StrOfs[s+1] || StrBf[StrOfs[s+1]-1] != 0) { TExcept::Throw(CorruptStr); }
+    }
+    DictIdV.Gen(DictStrs);
+    for (int s = 0; s < DictStrs; s++) {
+      DictIdV[s] = Context->StringVals.AddKey(StrBf + StrOfs[s]);
+      DictIsId = DictIsId && DictIdV[s] == s;
+    }
+  }
+
+  PTable T = TTable::New(Context);
+  for (int i = 0; i < ColNV.Len(); i++) {
+    const int c = ColNV[i];
+    const uint64 ValSize = S[c].Val2 == atFlt ? sizeof(double) : sizeof(int);
+    int SegHdr[2];
+    memcpy(SegHdr, Bf + OfsV[c], sizeof(SegHdr));
+    if (SegHdr[0] != Rows || SegHdr[1] != Rows) { TExcept::Throw(CorruptStr); }
+    TShMIn SegIn((void*) (Bf + OfsV[c]), 2*sizeof(int) + Rows*ValSize);
+    switch (S[c].Val2) {
+      case atInt:
+        T->IntCols.Add();
+        T->IntCols.Last().LoadShM(SegIn);
+        T->AddColType(S[c].Val1, atInt, T->IntCols.Len()-1);
+        break;
+      case atFlt:
+        T->FltCols.Add();
+        T->FltCols.Last().LoadShM(SegIn);
+        T->AddColType(S[c].Val1, atFlt, T->FltCols.Len()-1);
+        break;
+      case atStr: {
+        TIntV RankV;
+        RankV.LoadShM(SegIn);
+        for (int r = 0; r < Rows; r++) {
+          if (RankV[r] < 0 || RankV[r] >= DictStrs) { TExcept::Throw(CorruptStr); }
+        }
+        T->StrColMaps.Add();
+        TIntV& ColV = T->StrColMaps.Last();
+        if (DictIsId) {
+          TShMIn ColIn((void*) (Bf + OfsV[c]), 2*sizeof(int) + Rows*ValSize);
+          ColV.LoadShM(ColIn);
+        } else {
+          ColV.Gen(Rows);
+          for (int r = 0; r < Rows; r++) { ColV[r] = DictIdV[RankV[r]]; }
+        }
+        T->AddColType(S[c].Val1, atStr, T->StrColMaps.Len()-1);
+        break;
+      }
+    }
+    T->AddSchemaCol(S[c].Val1, S[c].Val2);
+    if (T->Sch.Last().Val1 == "_id") {
+      // permanent row ids
+      T->IdColName = "_id";
+      const TIntV& IdV = T->IntCols.Last();
+      for (int r = 0; r < Rows; r++) { T->RowIdMap.AddDat(IdV[r], r); }
+    }
+  }
+  T->NumRows = Rows;
+  T->NumValidRows = Rows;
+  T->Next.Gen(Rows);
+  for (int r = 0; r < Rows; r++) { T->Next[r] = r+1; }
+  if (Rows > 0) {
+    T->Next[Rows-1] = Last;
+    T->FirstValidRow = 0;
+    T->LastValidRow = Rows-1;
+  } else {
+    T->FirstValidRow = Last;
+    T->LastValidRow = Last;
+  }
+  T->IsNextDirty = 0;
+  return T;
+}
+
+void TTable::GetColBinInfo(const TStr& InFNm, Schema& S, TFltPrV& MnMxV, TIntV& NullsV) {
+  TFIn SIn(InFNm);
+  int Rows = 0, DictStrs = 0;
+  TVec<uint64> OfsV;
+  uint64 DictOfs = 0;
+  LoadColBinHdr(SIn, InFNm, TFile::GetSize(InFNm), Rows, S, OfsV, MnMxV, NullsV, DictOfs, DictStrs);
+}
+
 void TTable::Dump(FILE *OutF) const {
   TInt L = Sch.Len();
   Schema DSch = DenormalizeSchema();
@@ -1264,35 +1587,12 @@ void TTable::GroupByIntColMP(const TStr& GroupBy, THashMP<TInt, TIntV>& Grouping
 #endif // GCC_ATOMIC
 
 void TTable::Unique(const TStr& Col) {
-  TIntV RemainingRows;
-  TStr NCol = NormalizeColName(Col);
-  switch (GetColType(NCol)) {
-    case atInt: {
-      TIntIntVH Grouping;
-      GroupByIntCol(NCol, Grouping, TIntV(), true, true);
-      for (TIntIntVH::TIter it = Grouping.BegI(); it < Grouping.EndI(); it++) {
-        RemainingRows.Add(it->Dat[0]);
-      }
-      break;
-    }
-    case atFlt: {
-      THash<TFlt,TIntV> Grouping;
-      GroupByFltCol(NCol, Grouping, TIntV(), true, true);
-      for (THash<TFlt,TIntV>::TIter it = Grouping.BegI(); it < Grouping.EndI(); it++) {
-        RemainingRows.Add(it->Dat[0]);
-      }
-      break;
-    } 
-    case atStr: {
-      TIntIntVH Grouping;
-      GroupByStrCol(NCol, Grouping, TIntV(), true, true);
-      for (TIntIntVH::TIter it = Grouping.BegI(); it < Grouping.EndI(); it++) {
-        RemainingRows.Add(it->Dat[0]);
-      }
-      break;
-    }
-  }
-  KeepSortedRows(RemainingRows);
+  TStrV NCols;
+  NCols.Add(NormalizeColName(Col));
+  THash<TGroupKey, TPair<TInt, TIntV> > Grouping;
+  TIntV UniqueVec;
+  GroupAux(NCols, Grouping, true, "", true, UniqueVec, true);
+  KeepSortedRows(UniqueVec);
 }
 
 void TTable::Unique(const TStrV& Cols, TBool Ordered) {
@@ -1328,6 +1628,8 @@ void TTable::GroupAux(const TStrV& GroupBy, THash<TGroupKey, TPair<TInt, TIntV>
   TIntV IntGroupByCols;
   TIntV FltGroupByCols;
   TIntV StrGroupByCols;
+  TVec<TAttrType> GroupByTypes;
+  TIntV GroupByIndices;
   // get indices for each column type
   for (TInt c = 0; c < GroupBy.Len(); c++) {
   	//printf("GroupBy col %d: %s\n", c.Val, GroupBy[c].CStr());
@@ -1336,6 +1638,8 @@ void TTable::GroupAux(const TStrV& GroupBy, THash<TGroupKey, TPair<TInt, TIntV>
     }
 
     TPair<TAttrType, TInt> ColType = GetColTypeMap(GroupBy[c]);
+    GroupByTypes.Add(ColType.Val1);
+    GroupByIndices.Add(ColType.Val2);
     switch (ColType.Val1) {
       case atInt:
         IntGroupByCols.Add(ColType.Val2);
@@ -1357,56 +1661,119 @@ void TTable::GroupAux(const TStrV& GroupBy, THash<TGroupKey, TPair<TInt, TIntV>
   TVec<TPair<TInt, TInt> > GroupAndRowIds;
   //printf("done GroupAux initialization\n");
 
-  // iterate over rows
-  for (TRowIterator it = BegRI(); it < EndRI(); it++) {
-    TIntV IKey(IKLen + SKLen, 0);
-    TFltV FKey(FKLen, 0);
-    TIntV SKey(SKLen, 0);
-
-    // find group key
-    for (TInt c = 0; c < IKLen; c++) {
-      IKey.Add(it.GetIntAttr(IntGroupByCols[c])); 
-    }
-    for (TInt c = 0; c < FKLen; c++) {
-      FKey.Add(it.GetFltAttr(FltGroupByCols[c])); 
-    }
-    for (TInt c = 0; c < SKLen; c++) {
-      SKey.Add(it.GetStrMapById(StrGroupByCols[c])); 
-    }
-    if (!Ordered) {
-      if (IKLen > 0) { IKey.ISort(0, IKey.Len()-1, true); }
-      if (FKLen > 0) { FKey.ISort(0, FKey.Len()-1, true); }
-      if (SKLen > 0) { SKey.ISort(0, SKey.Len()-1, true); }
-    }
-    for (TInt c = 0; c < SKLen; c++) {
-      IKey.Add(SKey[c]);
+  // ordered keys that fit into sort keys are grouped by sorting the rows
+  TIntV RowV;
+  TVec<TVec<uint64> > KeyVV;
+  TIntV KeyBitsV;
+  if (Ordered) {
+    RowV.Reserve(NumValidRows);
+    for (TRowIterator it = BegRI(); it < EndRI(); it++) { RowV.Add(it.GetRowIdx()); }
+  }
+  if (Ordered && GetSortKeys(RowV, GroupByTypes, GroupByIndices, true, KeyVV, KeyBitsV)) {
+    TIntV PosV;
+    SortKeys(KeyVV, KeyBitsV, PosV);
+    // runs of equal keys are the groups
+    TIntV RunV(PosV.Len());
+    int Runs = 0;
+    for (int i = 0; i < PosV.Len(); i++) {
+      bool NewRun = i == 0;
+      for (int w = 0; w < KeyVV.Len() && ! NewRun; w++) {
+        NewRun = KeyVV[w][PosV[i]] != KeyVV[w][PosV[i-1]];
+      }
+      if (NewRun) { Runs++; }
+      RunV[PosV[i]] = Runs-1;
+    }
+    // iterate over rows, the group of each run is created at its first row
+    TIntV RunKeyIdV(Runs);
+    RunKeyIdV.PutAll(-1);
+    for (int i = 0; i < RowV.Len(); i++) {
+      const TInt RowIdx = RowV[i];
+      const TInt idx = UsePhysicalIds ? RowIdx : IntCols[IdColIdx][RowIdx];
+      TInt& KeyId = RunKeyIdV[RunV[i]];
+      if (KeyId == -1) {
+        TGroupKey GroupKey;
+        GroupKey.Val1.Reserve(IKLen + SKLen);
+        GroupKey.Val2.Reserve(FKLen);
+        for (TInt c = 0; c < IKLen; c++) {
+          GroupKey.Val1.Add(IntCols[IntGroupByCols[c]][RowIdx]);
+        }
+        for (TInt c = 0; c < FKLen; c++) {
+          GroupKey.Val2.Add(FltCols[FltGroupByCols[c]][RowIdx]);
+        }
+        for (TInt c = 0; c < SKLen; c++) {
+          GroupKey.Val1.Add(StrColMaps[StrGroupByCols[c]][RowIdx]);
+        }
+        KeyId = Grouping.AddKey(GroupKey);
+        TPair<TInt, TIntV>& NewGroup = Grouping[KeyId];
+        NewGroup.Val1 = GroupNum;
+        NewGroup.Val2.Add(idx);
+        if (GroupColName != "") {
+          GroupAndRowIds.Add(TPair<TInt, TInt>(GroupNum, RowIdx));
+        }
+        if (KeepUnique) {
+          UniqueVec.Add(idx);
+        }
+        GroupNum++;
+      } else if (!KeepUnique) {
+        TPair<TInt, TIntV>& NewGroup = Grouping[KeyId];
+        NewGroup.Val2.Add(idx);
+        if (GroupColName != "") {
+          GroupAndRowIds.Add(TPair<TInt, TInt>(NewGroup.Val1, RowIdx));
+        }
+      }
     }
-    
-    // look for group matching the key
-    TGroupKey GroupKey = TGroupKey(IKey, FKey);
-
-    TInt RowIdx = it.GetRowIdx();
-    TInt idx = UsePhysicalIds ? it.GetRowIdx() : IntCols[IdColIdx][it.GetRowIdx()];
-    if (!Grouping.IsKey(GroupKey)) {
-      // Grouping key hasn't been seen before, create a new group
-      TPair<TInt, TIntV> NewGroup;
-      NewGroup.Val1 = GroupNum;
-      NewGroup.Val2.Add(idx);
-      Grouping.AddDat(GroupKey, NewGroup);
-      if (GroupColName != "") {
-        GroupAndRowIds.Add(TPair<TInt, TInt>(GroupNum, RowIdx));
+  } else {
+    // iterate over rows
+    for (TRowIterator it = BegRI(); it < EndRI(); it++) {
+      TIntV IKey(IKLen + SKLen, 0);
+      TFltV FKey(FKLen, 0);
+      TIntV SKey(SKLen, 0);
+
+      // find group key
+      for (TInt c = 0; c < IKLen; c++) {
+        IKey.Add(it.GetIntAttr(IntGroupByCols[c])); 
       }
-      if (KeepUnique) { 
-        UniqueVec.Add(idx);
+      for (TInt c = 0; c < FKLen; c++) {
+        FKey.Add(it.GetFltAttr(FltGroupByCols[c])); 
       }
-      GroupNum++;
-    } else {
-      // Grouping key has been seen before, update corresponding group
-      if (!KeepUnique) {
-        TPair<TInt, TIntV>& NewGroup = Grouping.GetDat(GroupKey);
+      for (TInt c = 0; c < SKLen; c++) {
+        SKey.Add(it.GetStrMapById(StrGroupByCols[c])); 
+      }
+      if (!Ordered) {
+        if (IKLen > 0) { IKey.ISort(0, IKey.Len()-1, true); }
+        if (FKLen > 0) { FKey.ISort(0, FKey.Len()-1, true); }
+        if (SKLen > 0) { SKey.ISort(0, SKey.Len()-1, true); }
+      }
+      for (TInt c = 0; c < SKLen; c++) {
+        IKey.Add(SKey[c]);
+      }
+    
+      // look for group matching the key
+      TGroupKey GroupKey = TGroupKey(IKey, FKey);
+
+      TInt RowIdx = it.GetRowIdx();
+      TInt idx = UsePhysicalIds ? it.GetRowIdx() : IntCols[IdColIdx][it.GetRowIdx()];
+      if (!Grouping.IsKey(GroupKey)) {
+        // Grouping key hasn't been seen before, create a new group
+        TPair<TInt, TIntV> NewGroup;
+        NewGroup.Val1 = GroupNum;
         NewGroup.Val2.Add(idx);
+        Grouping.AddDat(GroupKey, NewGroup);
         if (GroupColName != "") {
-          GroupAndRowIds.Add(TPair<TInt, TInt>(NewGroup.Val1, RowIdx));
+          GroupAndRowIds.Add(TPair<TInt, TInt>(GroupNum, RowIdx));
+        }
+        if (KeepUnique) { 
+          UniqueVec.Add(idx);
+        }
+        GroupNum++;
+      } else {
+        // Grouping key has been seen before, update corresponding group
+        if (!KeepUnique) {
+          TPair<TInt, TIntV>& NewGroup = Grouping.GetDat(GroupKey);
+          NewGroup.Val2.Add(idx);
+          if (GroupColName != "") {
+            GroupAndRowIds.Add(TPair<TInt, TInt>(NewGroup.Val1, RowIdx));
+          }
         }
       }
     }
@@ -3237,6 +3604,197 @@ void TTable::QSortPar(TIntV& V, const TVec<TAttrType>& SortByTypes, const TIntV&
 }
 #endif // USE_OPENMP
 
+// Number of threads for sorting N keys.
+static int GetSortThreads(const int& N) {
+#ifdef USE_OPENMP
+  if (TTable::GetMP() && N >= 100000) { return omp_get_max_threads(); }
+#endif
+  return 1;
+}
+
+bool TTable::GetSortKeys(const TIntV& RowV, const TVec<TAttrType>& SortByTypes, const TIntV& SortByIndices,
+ TBool Asc, TVec<TVec<uint64> >& KeyVV, TIntV& KeyBitsV) const {
+  const int N = RowV.Len();
+  const int NThreads = GetSortThreads(N);
+  KeyVV.Clr();  KeyBitsV.Clr();
+  TVec<uint64> ColKeyV(N);
+  TVec<uint64> MnV(NThreads), MxV(NThreads);
+  for (int c = 0; c < SortByTypes.Len() && N > 0; c++) {
+    const TAttrType Type = SortByTypes[c];
+    const int ColIdx = SortByIndices[c];
+    // strings are replaced by their rank among the distinct strings of the column
+    TIntV RankV;
+    if (Type == atStr) {
+      RankV.Gen(Context->StringVals.GetMxKeyIds());
+      for (int i = 0; i < N; i++) { RankV[StrColMaps[ColIdx][RowV[i]]] = 1; }
+      TIntV StrIdV;
+      for (int s = 0; s < RankV.Len(); s++) {
+        if (RankV[s] != 0) { StrIdV.Add(s); }
+      }
+      StrIdV.SortCmp(TStrIdCmp(Context->StringVals));
+      for (int s = 0; s < StrIdV.Len(); s++) { RankV[StrIdV[s]] = s; }
+    }
+    // map the values to unsigned keys of the same order
+#ifdef USE_OPENMP
+    #pragma omp parallel for schedule(static, 1)
+#endif
+    for (int t = 0; t < NThreads; t++) {
+      uint64 Mn = TUInt64::Mx, Mx = 0;
+      const int EndN = int(int64(N) * (t+1) / NThreads);
+      for (int i = int(int64(N) * t / NThreads); i < EndN; i++) {
+        uint64 Key = 0;
+        switch (Type) {
+          case atInt:
+            Key = uint64(uint(IntCols[ColIdx][RowV[i]].Val) ^ 0x80000000u);
+            break;
+          case atFlt: {
+            double Val = FltCols[ColIdx][RowV[i]];
+            if (Val == 0.0) { Val = 0.0; } // -0.0 equals 0.0
+            memcpy(&Key, &Val, sizeof(uint64));
+            Key = (Key >> 63) != 0 ? ~Key : Key | (uint64(1) << 63);
+            break;
+          }
+          case atStr:
+            Key = RankV[StrColMaps[ColIdx][RowV[i]]];
+            break;
+        }
+        ColKeyV[i] = Key;
+        if (Key < Mn) { Mn = Key; }
+        if (Key > Mx) { Mx = Key; }
+      }
+      MnV[t] = Mn;  MxV[t] = Mx;
+    }
+    uint64 Mn = MnV[0], Mx = MxV[0];
+    for (int t = 1; t < NThreads; t++) {
+      if (MnV[t] < Mn) { Mn = MnV[t]; }
+      if (MxV[t] > Mx) { Mx = MxV[t]; }
+    }
+    // the column takes as many bits as its range needs
+    int Bits = 0;
+    while (Bits < 64 && ((Mx - Mn) >> Bits) != 0) { Bits++; }
+    if (Bits == 0) { continue; }
+    if (KeyVV.Empty() || KeyBitsV.Last() + Bits > 64) {
+      if (KeyVV.Len() == 2) { return false; }
+      KeyVV.Add();  KeyVV.Last().Gen(N);
+      KeyBitsV.Add(0);
+    }
+    TVec<uint64>& KeyV = KeyVV.Last();
+    const bool FirstCol = KeyBitsV.Last() == 0;
+#ifdef USE_OPENMP
+    #pragma omp parallel for schedule(static, 1)
+#endif
+    for (int t = 0; t < NThreads; t++) {
+      const int EndN = int(int64(N) * (t+1) / NThreads);
+      for (int i = int(int64(N) * t / NThreads); i < EndN; i++) {
+        KeyV[i] = FirstCol ? ColKeyV[i] - Mn : (KeyV[i] << Bits) | (ColKeyV[i] - Mn);
+      }
+    }
+    KeyBitsV.Last() += Bits;
+  }
+  if (KeyVV.Empty()) { // all rows are equal
+    KeyVV.Add(TVec<uint64>(N));
+    KeyVV.Last().PutAll(0);
+    KeyBitsV.Add(0);
+  }
+  if (! Asc) {
+    for (int w = 0; w < KeyVV.Len(); w++) {
+      const uint64 Mask = KeyBitsV[w] == 64 ? TUInt64::Mx.Val : (uint64(1) << KeyBitsV[w]) - 1;
+      TVec<uint64>& KeyV = KeyVV[w];
+      for (int i = 0; i < N; i++) { KeyV[i] ^= Mask; }
+    }
+  }
+  return true;
+}
+
+void TTable::RadixSortKeyVal(TVec<uint64>& KeyV, TIntV& ValV, const int& KeyBits) {
+  const int N = KeyV.Len();
+  if (N < 2) { return; }
+  const int NThreads = GetSortThreads(N);
+  TVec<uint64> TmpKeyV(N);
+  TIntV TmpValV(N);
+  TIntV CntV(256*NThreads);
+  for (int Shift = 0; Shift < KeyBits; Shift += 8) {
+    const uint64* Key = KeyV.BegI();
+    const TInt* Val = ValV.BegI();
+    uint64* TmpKey = TmpKeyV.BegI();
+    TInt* TmpVal = TmpValV.BegI();
+    // count the digits of each range
+#ifdef USE_OPENMP
+    #pragma omp parallel for schedule(static, 1)
+#endif
+    for (int t = 0; t < NThreads; t++) {
+      TInt* Cnt = CntV.BegI() + 256*t;
+      for (int d = 0; d < 256; d++) { Cnt[d] = 0; }
+      const int EndN = int(int64(N) * (t+1) / NThreads);
+      for (int i = int(int64(N) * t / NThreads); i < EndN; i++) {
+        Cnt[int(Key[i] >> Shift) & 255].Val++; }
+    }
+    // skip the digit if all keys agree on it
+    bool Skip = false;
+    for (int d = 0; d < 256 && ! Skip; d++) {
+      int DigitCnt = 0;
+      for (int t = 0; t < NThreads; t++) { DigitCnt += CntV[256*t+d]; }
+      Skip = DigitCnt == N;
+    }
+    if (Skip) { continue; }
+    // ranges scatter to consecutive slots of each digit
+    int Ofs = 0;
+    for (int d = 0; d < 256; d++) {
+      for (int t = 0; t < NThreads; t++) {
+        const int Cnt = CntV[256*t+d];
+        CntV[256*t+d] = Ofs;  Ofs += Cnt;
+      }
+    }
+#ifdef USE_OPENMP
+    #pragma omp parallel for schedule(static, 1)
+#endif
+    for (int t = 0; t < NThreads; t++) {
+      TInt* Pos = CntV.BegI() + 256*t;
+      const int EndN = int(int64(N) * (t+1) / NThreads);
+      for (int i = int(int64(N) * t / NThreads); i < EndN; i++) {
+        const int j = Pos[int(Key[i] >> Shift) & 255].Val++;
+        TmpKey[j] = Key[i];  TmpVal[j] = Val[i];
+      }
+    }
+    KeyV.Swap(TmpKeyV);
+    ValV.Swap(TmpValV);
+  }
+}
+
+void TTable::SortKeys(const TVec<TVec<uint64> >& KeyVV, const TIntV& KeyBitsV, TIntV& PosV) {
+  const int N = KeyVV[0].Len();
+  PosV.Gen(N);
+  for (int i = 0; i < N; i++) { PosV[i] = i; }
+  // least significant word first, each pass keeps the order of equal words
+  TVec<uint64> KeyV(N);
+  for (int w = KeyVV.Len()-1; w >= 0; w--) {
+    const TVec<uint64>& WordV = KeyVV[w];
+    for (int i = 0; i < N; i++) { KeyV[i] = WordV[PosV[i]]; }
+    RadixSortKeyVal(KeyV, PosV, KeyBitsV[w]);
+  }
+}
+
+void TTable::SortRows(TIntV& V, const TVec<TAttrType>& SortByTypes, const TIntV& SortByIndices, TBool Asc) {
+  TVec<TVec<uint64> > KeyVV;
+  TIntV KeyBitsV;
+  if (GetSortKeys(V, SortByTypes, SortByIndices, Asc, KeyVV, KeyBitsV)) {
+    TIntV PosV;
+    SortKeys(KeyVV, KeyBitsV, PosV);
+    TIntV SortedV(V.Len());
+    for (int i = 0; i < V.Len(); i++) { SortedV[i] = V[PosV[i]]; }
+    V.Swap(SortedV);
+    return;
+  }
+  // wide keys
+#ifdef USE_OPENMP
+  if (GetMP()) {
+    QSortPar(V, SortByTypes, SortByIndices, Asc);
+    return;
+  }
+#endif
+  QSort(V, 0, V.Len()-1, SortByTypes, SortByIndices, Asc);
+}
+
 void TTable::Order(const TStrV& OrderBy, TStr OrderColName, TBool ResetRankByMSC, TBool Asc) {
   // get a vector of all valid row indices
   TIntV ValidRows = TIntV(NumValidRows);
@@ -3259,15 +3817,7 @@ void TTable::Order(const TStrV& OrderBy, TStr OrderColName, TBool ResetRankByMSC
   }
 
   // sort that vector according to the attributes given in "OrderBy" in lexicographic order
-#ifdef USE_OPENMP
-  if (GetMP()) {
-    QSortPar(ValidRows, OrderByTypes, OrderByIndices, Asc);
-  } else {
-#endif
-    QSort(ValidRows, 0, NumValidRows-1, OrderByTypes, OrderByIndices, Asc);
-#ifdef USE_OPENMP
-  }
-#endif
+  SortRows(ValidRows, OrderByTypes, OrderByIndices, Asc);
 
   // rewire Next vector
   IsNextDirty = 1;
@@ -3294,8 +3844,7 @@ void TTable::Order(const TStrV& OrderBy, TStr OrderColName, TBool ResetRankByMSC
     }
     if (ResetRankByMSC) {
       for (TInt i = 1; i < NumValidRows; i++) {
-        TStr GroupName = OrderBy[0];
-        if (GetStrVal(GroupName, ValidRows[i]) != GetStrVal(GroupName, ValidRows[i-1])) { 
+        if (CompareRows(ValidRows[i], ValidRows[i-1], OrderByTypes[0], OrderByIndices[0]) != 0) { 
           RankCol[ValidRows[i]] = 0;
         } else {
           RankCol[ValidRows[i]] = RankCol[ValidRows[i-1]] + 1;
@@ -3613,13 +4162,240 @@ void TTable::FillBucketsByInterval(TStr SplitAttr, TIntPrV SplitIntervals) {
   }
 }
 
+void TTable::GetGraphCols(TGraphCols& Cols) const {
+  Cols.NodeType = GetColType(SrcCol);
+  Assert(Cols.NodeType == GetColType(DstCol));
+  Cols.SrcColIdx = GetColIdx(SrcCol);
+  Cols.DstColIdx = GetColIdx(DstCol);
+  Cols.EdgeAttrs.Clr();
+  for (TInt i = 0; i < EdgeAttrV.Len(); i++) {
+    Cols.EdgeAttrs.Add(TGraphAttrCol(GetColIdx(EdgeAttrV[i]), GetColType(EdgeAttrV[i]), EdgeAttrV[i]));
+  }
+  for (int Dst = 0; Dst < 2; Dst++) {
+    const TStrV& NodeAttrV = Dst ? DstNodeAttrV : SrcNodeAttrV;
+    TVec<TGraphAttrCol>& NodeAttrs = Dst ? Cols.DstNodeAttrs : Cols.SrcNodeAttrs;
+    NodeAttrs.Clr();
+    for (TInt i = 0; i < NodeAttrV.Len(); i++) {
+      // common src-dst attributes go by their common name
+      TStr AttrName = NodeAttrV[i];
+      for (TInt j = 0; j < CommonNodeAttrs.Len(); j++) {
+        if (CommonNodeAttrs[j].Val1 == AttrName || CommonNodeAttrs[j].Val2 == AttrName) {
+          AttrName = CommonNodeAttrs[j].Val3;
+          break;
+        }
+      }
+      NodeAttrs.Add(TGraphAttrCol(GetColIdx(NodeAttrV[i]), GetColType(NodeAttrV[i]), AttrName));
+    }
+  }
+}
+
+bool TTable::IsIncrementalStep(const TIntV& PrevRowIds, const TIntV& RowIds) {
+  int Common = 0;
+  for (int i = 0, j = 0; i < PrevRowIds.Len() && j < RowIds.Len(); ) {
+    if (PrevRowIds[i] < RowIds[j]) { i++; }
+    else if (RowIds[j] < PrevRowIds[i]) { j++; }
+    else { Common++; i++; j++; }
+  }
+  // updating costs a deletion per expiring row, so require that most rows carry over
+  return Common > 0 && 2 * Common >= RowIds.Len();
+}
+
+// Updates State to the graph that BuildGraph would return for RowIds, by deleting
+// the edges of the expiring rows and adding the edges of the arriving ones.
+// Attributes are re-aggregated only for the nodes whose rows have changed.
+void TTable::UpdateGraph(TGraphSeqState& State, const TIntV& RowIds, const TGraphCols& Cols,
+ TAttrAggr AggrPolicy) {
+  IAssert(Cols.NodeType == atInt || Cols.NodeType == atStr);
+  IAssert(RowIds.IsSorted());
+  TIntV ExpRowIds, NewRowIds;
+  if (State.Graph.Empty() || !IsIncrementalStep(State.RowIds, RowIds)) {
+    State.Clr();
+    State.Graph = TNEANet::New();
+    NewRowIds = RowIds;
+  } else {
+    const TIntV& PrevRowIds = State.RowIds;
+    for (int i = 0, j = 0; i < PrevRowIds.Len() || j < RowIds.Len(); ) {
+      if (j == RowIds.Len() || (i < PrevRowIds.Len() && PrevRowIds[i] < RowIds[j])) {
+        ExpRowIds.Add(PrevRowIds[i++]);
+      } else if (i == PrevRowIds.Len() || RowIds[j] < PrevRowIds[i]) {
+        NewRowIds.Add(RowIds[j++]);
+      } else {
+        i++; j++;
+      }
+    }
+  }
+  PNEANet& Graph = State.Graph;
+
+  // remove expiring rows; rows with illegal node values have no edge
+  THash<TInt, TIntPrV> ExpNodeRows, NewNodeRows;
+  for (int i = 0; i < ExpRowIds.Len(); i++) {
+    const TInt RowId = ExpRowIds[i];
+    if (!Graph->IsEdge(RowId)) { continue; }
+    const TNEANet::TEdgeI EdgeI = Graph->GetEI(RowId);
+    ExpNodeRows.AddDat(EdgeI.GetSrcNId()).Add(TIntPr(RowId, 0));
+    ExpNodeRows.AddDat(EdgeI.GetDstNId()).Add(TIntPr(RowId, 1));
+    Graph->DelEdge(RowId);
+  }
+
+  // add arriving rows
+  for (int i = 0; i < NewRowIds.Len(); i++) {
+    const TInt RowId = NewRowIds[i];
+    TInt SVal, DVal;
+    if (Cols.NodeType == atInt) {
+      SVal = IntCols[Cols.SrcColIdx][RowId];
+      DVal = IntCols[Cols.DstColIdx][RowId];
+    } else {
+      SVal = StrColMaps[Cols.SrcColIdx][RowId];
+      if (strlen(Context->StringVals.GetKey(SVal)) == 0) { continue; }  //illegal value
+      DVal = StrColMaps[Cols.DstColIdx][RowId];
+      if (strlen(Context->StringVals.GetKey(DVal)) == 0) { continue; }  //illegal value
+    }
+    if (!Graph->IsNode(SVal)) { Graph->AddNode(SVal); }
+    if (!Graph->IsNode(DVal)) { Graph->AddNode(DVal); }
+    Graph->AddEdge(SVal, DVal, RowId);
+    for (int j = 0; j < Cols.EdgeAttrs.Len(); j++) {
+      const TGraphAttrCol& Col = Cols.EdgeAttrs[j];
+      switch (Col.ColType) {
+        case atInt:
+          Graph->AddIntAttrDatE(RowId, IntCols[Col.ColIdx][RowId], Col.AttrName);
+          break;
+        case atFlt:
+          Graph->AddFltAttrDatE(RowId, FltCols[Col.ColIdx][RowId], Col.AttrName);
+          break;
+        case atStr:
+          Graph->AddStrAttrDatE(RowId, GetStrVal(Col.ColIdx, RowId), Col.AttrName);
+          break;
+      }
+    }
+    NewNodeRows.AddDat(SVal).Add(TIntPr(RowId, 0));
+    NewNodeRows.AddDat(DVal).Add(TIntPr(RowId, 1));
+  }
+
+  // update the rows of the affected nodes, dropping nodes that have none left
+  TIntV NIdV;
+  ExpNodeRows.GetKeyV(NIdV);
+  for (THash<TInt, TIntPrV>::TIter it = NewNodeRows.BegI(); it < NewNodeRows.EndI(); it++) {
+    if (!ExpNodeRows.IsKey(it.GetKey())) { NIdV.Add(it.GetKey()); }
+  }
+  const bool NodeAttrs = Cols.SrcNodeAttrs.Len() > 0 || Cols.DstNodeAttrs.Len() > 0;
+  TStrIntVH IntAttrVals;
+  TStrFltVH FltAttrVals;
+  TStrStrVH StrAttrVals;
+  for (int n = 0; n < NIdV.Len(); n++) {
+    const TInt NId = NIdV[n];
+    TIntPrV& NodeRows = State.NodeRows.AddDat(NId);
+    const int ExpKeyId = ExpNodeRows.GetKeyId(NId);
+    const int NewKeyId = NewNodeRows.GetKeyId(NId);
+    TIntPrV Rows;
+    if (ExpKeyId == -1) {
+      Rows = NodeRows;
+    } else {
+      const TIntPrV& ExpRows = ExpNodeRows[ExpKeyId];
+      for (int i = 0, j = 0; i < NodeRows.Len(); i++) {
+        if (j < ExpRows.Len() && NodeRows[i] == ExpRows[j]) { j++; }
+        else { Rows.Add(NodeRows[i]); }
+      }
+    }
+    if (NewKeyId != -1) {
+      NodeRows.Clr(false);
+      const TIntPrV& NewRows = NewNodeRows[NewKeyId];
+      for (int i = 0, j = 0; i < Rows.Len() || j < NewRows.Len(); ) {
+        if (j == NewRows.Len() || (i < Rows.Len() && Rows[i] < NewRows[j])) {
+          NodeRows.Add(Rows[i++]);
+        } else {
+          NodeRows.Add(NewRows[j++]);
+        }
+      }
+    } else {
+      NodeRows.Swap(Rows);
+    }
+    if (NodeRows.Empty()) {
+      State.NodeRows.DelKey(NId);
+      Graph->DelNode(NId);
+      continue;
+    }
+    if (!NodeAttrs) { continue; }
+
+    // aggregate the node attributes over the rows of the node, as BuildGraph does
+    IntAttrVals.Clr();
+    FltAttrVals.Clr();
+    StrAttrVals.Clr();
+    for (int i = 0; i < NodeRows.Len(); i++) {
+      const TInt RowId = NodeRows[i].Val1;
+      const TVec<TGraphAttrCol>& AttrCols = NodeRows[i].Val2 == 0 ? Cols.SrcNodeAttrs : Cols.DstNodeAttrs;
+      for (int j = 0; j < AttrCols.Len(); j++) {
+        const TGraphAttrCol& Col = AttrCols[j];
+        if (Col.ColType == atInt) {
+          IntAttrVals.AddDat(Col.AttrName).Add(IntCols[Col.ColIdx][RowId]);
+        } else if (Col.ColType == atFlt) {
+          FltAttrVals.AddDat(Col.AttrName).Add(FltCols[Col.ColIdx][RowId]);
+        } else {
+          StrAttrVals.AddDat(Col.AttrName).Add(GetStrVal(Col.ColIdx, RowId));
+        }
+      }
+    }
+    for (TStrIntVH::TIter it = IntAttrVals.BegI(); it < IntAttrVals.EndI(); it++) {
+      Graph->AddIntAttrDatN(NId, AggregateVector<TInt>(it.GetDat(), AggrPolicy), it.GetKey());
+      State.NodeAttrNames.AddKey(it.GetKey());
+    }
+    for (TStrFltVH::TIter it = FltAttrVals.BegI(); it < FltAttrVals.EndI(); it++) {
+      Graph->AddFltAttrDatN(NId, AggregateVector<TFlt>(it.GetDat(), AggrPolicy), it.GetKey());
+      State.NodeAttrNames.AddKey(it.GetKey());
+    }
+    for (TStrStrVH::TIter it = StrAttrVals.BegI(); it < StrAttrVals.EndI(); it++) {
+      Graph->AddStrAttrDatN(NId, AggregateVector<TStr>(it.GetDat(), AggrPolicy), it.GetKey());
+      State.NodeAttrNames.AddKey(it.GetKey());
+    }
+    // reset attributes that the node had only through expired rows
+    for (THashSet<TStr>::TIter it = State.NodeAttrNames.BegI(); it < State.NodeAttrNames.EndI(); it++) {
+      const TStr& AttrName = it.GetKey();
+      if (!IntAttrVals.IsKey(AttrName) && !FltAttrVals.IsKey(AttrName) &&
+       !StrAttrVals.IsKey(AttrName)) {
+        Graph->DelAttrDatN(NId, AttrName);
+      }
+    }
+  }
+  State.RowIds = RowIds;
+}
+
+// Graphs over consecutive buckets are derived from each other when the buckets
+// overlap (sliding or expanding windows) and built independently otherwise. The
+// sequence is split into contiguous runs of buckets that are processed in parallel.
 TVec<PNEANet> TTable::GetGraphsFromSequence(TAttrAggr AggrPolicy) {
-  //call BuildGraph on each row id set - parallelizable!
-  TVec<PNEANet> GraphSequence;
+  TIntV BucketV;
   for (TInt i = 0; i < RowIdBuckets.Len(); i++) {
-    if (RowIdBuckets[i].Len() == 0) { continue; }
-    PNEANet PNet = BuildGraph(RowIdBuckets[i], AggrPolicy);
-    GraphSequence.Add(PNet);
+    if (RowIdBuckets[i].Len() > 0) { BucketV.Add(i); }
+  }
+  TVec<PNEANet> GraphSequence(BucketV.Len());
+  if (GetColType(SrcCol) == atFlt) {
+    for (int i = 0; i < BucketV.Len(); i++) {
+      GraphSequence[i] = BuildGraph(RowIdBuckets[BucketV[i]], AggrPolicy);
+    }
+    return GraphSequence;
+  }
+  int NumRuns = 1;
+#ifdef USE_OPENMP
+  NumRuns = omp_get_max_threads();
+#endif
+  NumRuns = MIN(NumRuns, BucketV.Len());
+  // each run gets its own copies of the attribute names, as TStr reference counts are not atomic
+  TVec<TGraphCols> RunCols(NumRuns);
+  for (int r = 0; r < NumRuns; r++) { GetGraphCols(RunCols[r]); }
+  #pragma omp parallel for schedule(static, 1)
+  for (int r = 0; r < NumRuns; r++) {
+    const int RunBeg = int(int64(BucketV.Len()) * r / NumRuns);
+    const int RunEnd = int(int64(BucketV.Len()) * (r + 1) / NumRuns);
+    TGraphSeqState State;
+    for (int i = RunBeg; i < RunEnd; i++) {
+      const TIntV& RowIds = RowIdBuckets[BucketV[i]];
+      UpdateGraph(State, RowIds, RunCols[r], AggrPolicy);
+      if (i + 1 < RunEnd && IsIncrementalStep(RowIds, RowIdBuckets[BucketV[i + 1]])) {
+        GraphSequence[i] = TNEANet::New(*State.Graph, true);
+      } else {
+        GraphSequence[i] = State.Graph;
+        State.Clr();
+      }
+    }
   }
 
   return GraphSequence;
@@ -3628,6 +4404,8 @@ TVec<PNEANet> TTable::GetGraphsFromSequence(TAttrAggr AggrPolicy) {
 PNEANet TTable::GetFirstGraphFromSequence(TAttrAggr AggrPolicy) {
   CurrBucket = -1;
   this->AggrPolicy = AggrPolicy;
+  GraphSeq.Clr();
+  GetGraphCols(GraphSeqCols);
   return GetNextGraphFromSequence();
 }
 
@@ -3636,8 +4414,24 @@ PNEANet TTable::GetNextGraphFromSequence() {
   while (CurrBucket < RowIdBuckets.Len() && RowIdBuckets[CurrBucket].Len() == 0) {
     CurrBucket++;
   }
-  if (CurrBucket >= RowIdBuckets.Len()) { return NULL; }
-  return BuildGraph(RowIdBuckets[CurrBucket], AggrPolicy);
+  if (CurrBucket >= RowIdBuckets.Len()) {
+    GraphSeq.Clr();
+    return NULL;
+  }
+  if (GraphSeqCols.NodeType == atFlt) { return BuildGraph(RowIdBuckets[CurrBucket], AggrPolicy); }
+  UpdateGraph(GraphSeq, RowIdBuckets[CurrBucket], GraphSeqCols, AggrPolicy);
+  // keep the graph only if the next one is derived from it
+  int NextBucket = CurrBucket + 1;
+  while (NextBucket < RowIdBuckets.Len() && RowIdBuckets[NextBucket].Len() == 0) {
+    NextBucket++;
+  }
+  if (NextBucket < RowIdBuckets.Len() &&
+   IsIncrementalStep(RowIdBuckets[CurrBucket], RowIdBuckets[NextBucket])) {
+    return TNEANet::New(*GraphSeq.Graph, true);
+  }
+  PNEANet Graph = GraphSeq.Graph;
+  GraphSeq.Clr();
+  return Graph;
 }
 
 // Only integer SplitAttr supported
@@ -3917,7 +4711,7 @@ PTable TTable::IsNextK(const TStr& OrderCol, TInt K, const TStr& GroupBy, const
           if (GetFltVal(GroupBy, Succ) != RI.GetFltAttr(GroupBy)) { OutOfGroup = true; }
           break;
         case atStr:
-          if (GetStrVal(GroupBy, Succ) != RI.GetStrAttr(GroupBy)) { OutOfGroup = true; }
+          if (GetStrMapByName(GroupBy, Succ) != RI.GetStrMapByName(GroupBy)) { OutOfGroup = true; }
           break;
       }
       if (OutOfGroup) { break; }  // break out of inner for loop
@@ -576,6 +576,42 @@ protected:
   TInt CurrBucket; ///< Current row id bucket - used when generating a sequence of graphs using an iterator.
   TAttrAggr AggrPolicy; ///< Aggregation policy used for solving conflicts between different values of an attribute of the same node.
 
+  /// Column of the table that serves as a graph attribute.
+  class TGraphAttrCol {
+  public:
+    TInt ColIdx; ///< Index of the column within the columns of its type.
+    TAttrType ColType; ///< Type of the column.
+    TStr AttrName; ///< Name of the attribute in the graph.
+  public:
+    TGraphAttrCol() : ColIdx(-1), ColType(atInt), AttrName() { }
+    TGraphAttrCol(const TInt& Idx, const TAttrType& Type, const TStr& Name) :
+      ColIdx(Idx), ColType(Type), AttrName(Name.CStr()) { }
+  };
+  /// Columns used when building graphs from rows, resolved once per graph sequence.
+  class TGraphCols {
+  public:
+    TAttrType NodeType; ///< Type of the src and dst columns.
+    TInt SrcColIdx; ///< Index of the src column.
+    TInt DstColIdx; ///< Index of the dst column.
+    TVec<TGraphAttrCol> EdgeAttrs; ///< Edge attribute columns.
+    TVec<TGraphAttrCol> SrcNodeAttrs; ///< Src node attribute columns.
+    TVec<TGraphAttrCol> DstNodeAttrs; ///< Dst node attribute columns.
+  public:
+    TGraphCols() : NodeType(atInt), SrcColIdx(-1), DstColIdx(-1) { }
+  };
+  /// Graph of a sequence that is updated from one set of row ids to the next.
+  class TGraphSeqState {
+  public:
+    PNEANet Graph; ///< Graph over the rows in RowIds.
+    TIntV RowIds; ///< Sorted ids of the rows in the graph.
+    THash<TInt, TIntPrV> NodeRows; ///< Node id --> sorted (row id, 0 if src or 1 if dst) pairs of the rows of the node.
+    THashSet<TStr> NodeAttrNames; ///< Names of the node attributes set in the graph.
+  public:
+    void Clr() { Graph.Clr(); RowIds.Clr(); NodeRows.Clr(); NodeAttrNames.Clr(); }
+  };
+  TGraphCols GraphSeqCols; ///< Columns used when generating a sequence of graphs using an iterator.
+  TGraphSeqState GraphSeq; ///< Current graph when generating a sequence of graphs using an iterator.
+
   TInt IsNextDirty; ///< Flag to signify whether the rows are stored in logical sequence or reordered. Used for optimizing GetPartitionRanges.
 
 /***** Utility functions *****/
@@ -680,6 +716,13 @@ protected:
    THash<TInt, TStrStrVH>& NodeStrAttrs);
   /// Makes a single pass over the rows in the given row id set, and creates nodes, edges, assigns node and edge attributes.
   PNEANet BuildGraph(const TIntV& RowIds, TAttrAggr AggrPolicy);
+  /// Resolves the columns used for building graphs from the rows of the table.
+  void GetGraphCols(TGraphCols& Cols) const;
+  /// Updates the graph in \c State to the graph over the rows in \c RowIds. ##TTable::UpdateGraph
+  void UpdateGraph(TGraphSeqState& State, const TIntV& RowIds, const TGraphCols& Cols,
+   TAttrAggr AggrPolicy);
+  /// Checks if the graph over \c RowIds should be derived from the graph over \c PrevRowIds rather than built from scratch.
+  static bool IsIncrementalStep(const TIntV& PrevRowIds, const TIntV& RowIds);
   /// Initializes the RowIdBuckets vector which will be used for the graph sequence creation.
   void InitRowIdBuckets(int NumBuckets);
   /// Fills RowIdBuckets with sets of row ids. ##TTable::FillBucketsByWindow
@@ -750,6 +793,15 @@ protected:
   void QSortPar(TIntV& V, const TVec<TAttrType>& SortByTypes, const TIntV& SortByIndices,
     TBool Asc = true);
 #endif // USE_OPENMP
+  /// Encodes the sort columns of rows \c RowV into normalized keys. ##TTable::GetSortKeys
+  bool GetSortKeys(const TIntV& RowV, const TVec<TAttrType>& SortByTypes, const TIntV& SortByIndices,
+    TBool Asc, TVec<TVec<uint64> >& KeyVV, TIntV& KeyBitsV) const;
+  /// Stable radix sort of \c ValV by the low \c KeyBits bits of \c KeyV. ##TTable::RadixSortKeyVal
+  static void RadixSortKeyVal(TVec<uint64>& KeyV, TIntV& ValV, const int& KeyBits);
+  /// Gets positions of keys \c KeyVV in stable sorted order.
+  static void SortKeys(const TVec<TVec<uint64> >& KeyVV, const TIntV& KeyBitsV, TIntV& PosV);
+  /// Sorts rows \c V by the given columns. ##TTable::SortRows
+  void SortRows(TIntV& V, const TVec<TAttrType>& SortByTypes, const TIntV& SortByIndices, TBool Asc = true);
 
 /***** Utility functions for removing rows (not through iterator) *****/
   /// Checks if \c RowIdx corresponds to a valid (i.e. not deleted) row.
@@ -926,6 +978,12 @@ public:
   }
   /// Saves table schema and content to a binary format. ##TTable::Save
   void Save(TSOut& SOut);
+  /// Saves table columns to a memory mappable columnar file. ##TTable::SaveColBin
+  void SaveColBin(const TStr& OutFNm);
+  /// Loads columns \c Cols (all if empty) of a columnar file as views of its mapping. ##TTable::LoadColBin
+  static PTable LoadColBin(const TStr& InFNm, TTableContext* Context, const TStrV& Cols = TStrV());
+  /// Gets schema and per-column statistics of a columnar file. ##TTable::GetColBinInfo
+  static void GetColBinInfo(const TStr& InFNm, Schema& S, TFltPrV& MnMxV, TIntV& NullsV);
   /// Prints table contents to a text file.
   void Dump(FILE *OutF=stdout) const;
 
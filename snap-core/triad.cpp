@@ -98,4 +98,180 @@ int GetCommon(TIntV& A, TIntV& B) {
   return ret;
 }
 
+namespace TSnapDetail {
+// Returns the estimate and the 95% confidence interval of the mean of ValV.
+TFltTr GetMeanCI(const TFltV& ValV) {
+  const int Runs = ValV.Len();
+  double Mean = 0.0, Var = 0.0;
+  for (int r = 0; r < Runs; r++) { Mean += ValV[r]; }
+  Mean /= TMath::Mx(Runs, 1);
+  for (int r = 0; r < Runs; r++) { Var += TMath::Sqr(ValV[r] - Mean); }
+  const double Err = Runs < 2 ? 0.0 : 1.96 * sqrt(Var / (Runs - 1) / Runs);
+  return TFltTr(Mean, Mean - Err, Mean + Err);
+}
+
+void GetStreamTriads(const TStr& InFNm, const int& MxEdges, const int& Runs, TFltTr& TriadsCI, TFltTr& ClustCfCI, TIntFltH* NIdTriadH) {
+  const int BlockLen = 1<<20;
+  TVec<TStreamTriads> StreamV(Runs);
+  for (int r = 0; r < Runs; r++) {
+    StreamV[r] = TStreamTriads(MxEdges, NIdTriadH != NULL, r+1);
+  }
+  // the stream is read once in blocks, each block is fed to all reservoirs in parallel
+  TSsParser Ss(InFNm, ssfWhiteSep, true, true, true);
+  TIntPrV EdgeV(BlockLen, 0);
+  int SrcNId, DstNId;
+  bool Eof = false;
+  while (! Eof) {
+    EdgeV.Clr(false);
+    while (EdgeV.Len() < BlockLen && ! (Eof = ! Ss.Next())) {
+      if (! Ss.GetInt(0, SrcNId) || ! Ss.GetInt(1, DstNId)) { continue; }
+      EdgeV.Add(TIntPr(SrcNId, DstNId));
+    }
+#ifdef USE_OPENMP
+    #pragma omp parallel for schedule(dynamic, 1)
+#endif
+    for (int r = 0; r < Runs; r++) {
+      for (int e = 0; e < EdgeV.Len(); e++) {
+        StreamV[r].AddEdge(EdgeV[e].Val1, EdgeV[e].Val2);
+      }
+    }
+  }
+  TFltV TriadsV(Runs), ClustCfV(Runs);
+  for (int r = 0; r < Runs; r++) {
+    TriadsV[r] = StreamV[r].GetTriads();
+    ClustCfV[r] = StreamV[r].GetGlobClustCf();
+  }
+  TriadsCI = GetMeanCI(TriadsV);
+  ClustCfCI = GetMeanCI(ClustCfV);
+  if (NIdTriadH != NULL) {
+    NIdTriadH->Clr();
+    for (int r = 0; r < Runs; r++) {
+      const TIntFltH& TriadH = StreamV[r].GetNodeTriadH();
+      for (int i = TriadH.FFirstKeyId(); TriadH.FNextKeyId(i); ) {
+        NIdTriadH->AddDat(TriadH.GetKey(i)) += TriadH[i] / double(Runs);
+      }
+    }
+  }
+}
+} // namespace TSnapDetail
+
+void GetStreamTriads(const TStr& InFNm, const int& MxEdges, const int& Runs, TFltTr& TriadsCI, TFltTr& ClustCfCI) {
+  TSnapDetail::GetStreamTriads(InFNm, MxEdges, Runs, TriadsCI, ClustCfCI, NULL);
+}
+
+void GetStreamTriads(const TStr& InFNm, const int& MxEdges, const int& Runs, TFltTr& TriadsCI, TFltTr& ClustCfCI, TIntFltH& NIdTriadH) {
+  TSnapDetail::GetStreamTriads(InFNm, MxEdges, Runs, TriadsCI, ClustCfCI, &NIdTriadH);
+}
+
 } // namespace TSnap
+
+/////////////////////////////////////////////////
+// Streaming Triangle Estimation
+TStreamTriads::TStreamTriads(const int& _MxEdges, const bool& _LocalP, const int& RndSeed) :
+  MxEdges(_MxEdges), LocalP(_LocalP), Rnd(RndSeed), Edges(0), Triads(0.0), Wedges(0),
+  EdgeV(), SmplGraph(TUNGraph::New()), DegH(), NIdTriadH() {
+  IAssertR(MxEdges >= 2, "Reservoir must hold at least 2 edges");
+}
+
+TStreamTriads::TStreamTriads(const TStreamTriads& Stream) :
+  MxEdges(Stream.MxEdges), LocalP(Stream.LocalP), Rnd(Stream.Rnd), Edges(Stream.Edges),
+  Triads(Stream.Triads), Wedges(Stream.Wedges), EdgeV(Stream.EdgeV),
+  SmplGraph(TUNGraph::New()), DegH(Stream.DegH), NIdTriadH(Stream.NIdTriadH) {
+  *SmplGraph = *Stream.SmplGraph;
+}
+
+TStreamTriads& TStreamTriads::operator = (const TStreamTriads& Stream) {
+  if (this != &Stream) {
+    MxEdges = Stream.MxEdges;  LocalP = Stream.LocalP;  Rnd = Stream.Rnd;
+    Edges = Stream.Edges;  Triads = Stream.Triads;  Wedges = Stream.Wedges;
+    EdgeV = Stream.EdgeV;  DegH = Stream.DegH;  NIdTriadH = Stream.NIdTriadH;
+    SmplGraph = TUNGraph::New();  *SmplGraph = *Stream.SmplGraph;
+  }
+  return *this;
+}
+
+void TStreamTriads::Clr() {
+  Edges = 0;  Triads = 0.0;  Wedges = 0;
+  EdgeV.Clr();  SmplGraph->Clr();  DegH.Clr();  NIdTriadH.Clr();
+}
+
+// Triangles closed by the new edge are counted in the reservoir before it is
+// sampled, each one weighted by the inverse probability that both of its
+// other edges are in the reservoir.
+void TStreamTriads::AddEdge(const int& NId1, const int& NId2) {
+  if (NId1 == NId2) { return; }
+  if (SmplGraph->IsEdge(NId1, NId2)) { return; }
+  Edges++;
+  const double T = double(Edges);
+  const double Weight = TMath::Mx(1.0, (T-1.0)*(T-2.0) / (double(MxEdges)*double(MxEdges-1)));
+  if (SmplGraph->IsNode(NId1) && SmplGraph->IsNode(NId2)) {
+    const TUNGraph::TNodeI NI1 = SmplGraph->GetNI(NId1);
+    const TUNGraph::TNodeI NI2 = SmplGraph->GetNI(NId2);
+    int i = 0, j = 0, Cmn = 0;
+    while (i < NI1.GetDeg() && j < NI2.GetDeg()) {
+      const int Nbr1 = NI1.GetNbrNId(i), Nbr2 = NI2.GetNbrNId(j);
+      if (Nbr1 < Nbr2) { i++; }
+      else if (Nbr1 > Nbr2) { j++; }
+      else {
+        if (LocalP) { NIdTriadH.AddDat(Nbr1) += Weight; }
+        Cmn++;  i++;  j++;
+      }
+    }
+    if (Cmn > 0) {
+      Triads += Weight * Cmn;
+      if (LocalP) {
+        NIdTriadH.AddDat(NId1) += Weight * Cmn;
+        NIdTriadH.AddDat(NId2) += Weight * Cmn;
+      }
+    }
+  }
+  TInt& Deg1 = DegH.AddDat(NId1);
+  Wedges += Deg1.Val;  Deg1++;
+  TInt& Deg2 = DegH.AddDat(NId2);
+  Wedges += Deg2.Val;  Deg2++;
+  // reservoir sampling
+  int EdgeN = EdgeV.Len();
+  if (EdgeN >= MxEdges) {
+    if (Rnd.GetUniDev() * T >= double(MxEdges)) { return; }
+    EdgeN = Rnd.GetUniDevInt(MxEdges);
+    const int OldNId1 = EdgeV[EdgeN].Val1, OldNId2 = EdgeV[EdgeN].Val2;
+    SmplGraph->DelEdge(OldNId1, OldNId2);
+    if (SmplGraph->GetNI(OldNId1).GetDeg() == 0) { SmplGraph->DelNode(OldNId1); }
+    if (SmplGraph->GetNI(OldNId2).GetDeg() == 0) { SmplGraph->DelNode(OldNId2); }
+    EdgeV[EdgeN] = TIntPr(NId1, NId2);
+  } else {
+    EdgeV.Add(TIntPr(NId1, NId2));
+  }
+  if (! SmplGraph->IsNode(NId1)) { SmplGraph->AddNode(NId1); }
+  if (! SmplGraph->IsNode(NId2)) { SmplGraph->AddNode(NId2); }
+  SmplGraph->AddEdge(NId1, NId2);
+}
+
+void TStreamTriads::AddEdges(TSsParser& Ss, const int& SrcColId, const int& DstColId) {
+  int SrcNId, DstNId;
+  while (Ss.Next()) {
+    if (! Ss.GetInt(SrcColId, SrcNId) || ! Ss.GetInt(DstColId, DstNId)) { continue; }
+    AddEdge(SrcNId, DstNId);
+  }
+}
+
+double TStreamTriads::GetClustCf() const {
+  IAssertR(LocalP, "Per node triangles are not estimated");
+  if (DegH.Empty()) { return 0.0; }
+  double SumCcf = 0.0;
+  for (int i = NIdTriadH.FFirstKeyId(); NIdTriadH.FNextKeyId(i); ) {
+    SumCcf += GetNodeClustCf(NIdTriadH.GetKey(i));
+  }
+  return SumCcf / double(DegH.Len());
+}
+
+double TStreamTriads::GetNodeTriads(const int& NId) const {
+  IAssertR(LocalP, "Per node triangles are not estimated");
+  return NIdTriadH.IsKey(NId) ? NIdTriadH.GetDat(NId).Val : 0.0;
+}
+
+double TStreamTriads::GetNodeClustCf(const int& NId) const {
+  const int Deg = DegH.IsKey(NId) ? DegH.GetDat(NId).Val : 0;
+  if (Deg < 2) { return 0.0; }
+  return GetNodeTriads(NId) / (Deg*(Deg-1)/2.0);
+}
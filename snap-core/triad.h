@@ -55,6 +55,11 @@ template <class PGraph> void GetUniqueNbrV(const PGraph& Graph, const int& NId,
 /// Returns the number of common elements in two sorted TInt vectors
 int GetCommon(TIntV& A, TIntV& B);
 
+/// Estimates the triangles of an edge list file in one pass with Runs independent reservoirs of MxEdges edges. ##TSnap::GetStreamTriads
+void GetStreamTriads(const TStr& InFNm, const int& MxEdges, const int& Runs, TFltTr& TriadsCI, TFltTr& ClustCfCI);
+/// Estimates the global and per node triangles of an edge list file in one pass. ##TSnap::GetStreamTriads1
+void GetStreamTriads(const TStr& InFNm, const int& MxEdges, const int& Runs, TFltTr& TriadsCI, TFltTr& ClustCfCI, TIntFltH& NIdTriadH);
+
 /////////////////////////////////////////////////
 // Implementation
 
@@ -889,5 +894,50 @@ void TNetConstraint<PGraph>::Test() {
   printf("middle node network constraint: %f\n", NetConstraint.GetNodeC(0));
 }
 
+/////////////////////////////////////////////////
+// Streaming Triangle Estimation (TRIEST-IMPR by De Stefani et al.)
+/// Estimates triangle counts of an undirected edge stream from a fixed size edge reservoir. ##TStreamTriads
+class TStreamTriads {
+private:
+  TInt MxEdges;           // reservoir size
+  TBool LocalP;           // estimate per node triangles
+  TRnd Rnd;
+  TInt64 Edges;           // edges seen in the stream
+  TFlt Triads;            // estimated number of triangles
+  TInt64 Wedges;          // exact number of wedges (paths of length 2)
+  TIntPrV EdgeV;          // edge reservoir
+  PUNGraph SmplGraph;     // graph of the reservoir edges
+  TIntH DegH;             // stream degree of each node
+  TIntFltH NIdTriadH;     // estimated triangles of each node
+public:
+  TStreamTriads(const int& _MxEdges=1000000, const bool& _LocalP=false, const int& RndSeed=1);
+  TStreamTriads(const TStreamTriads& Stream);
+  TStreamTriads& operator = (const TStreamTriads& Stream);
+  /// Clears the estimates and the reservoir.
+  void Clr();
+  /// Processes edge (NId1, NId2) of the stream. Self loops and edges already in the reservoir are skipped.
+  void AddEdge(const int& NId1, const int& NId2);
+  /// Processes all remaining lines of Ss, each line is an edge given by columns SrcColId and DstColId.
+  void AddEdges(TSsParser& Ss, const int& SrcColId=0, const int& DstColId=1);
+  /// Returns the number of edges seen in the stream.
+  int64 GetEdges() const { return Edges; }
+  /// Returns the number of nodes seen in the stream.
+  int GetNodes() const { return DegH.Len(); }
+  /// Returns the reservoir size.
+  int GetMxEdges() const { return MxEdges; }
+  /// Returns the estimated number of triangles.
+  double GetTriads() const { return Triads; }
+  /// Returns the global clustering coefficient (transitivity), 3 * triangles / wedges.
+  double GetGlobClustCf() const { return Wedges == 0 ? 0.0 : 3.0 * Triads / double(Wedges); }
+  /// Returns the estimated average clustering coefficient, the same quantity as TSnap::GetClustCf(). Requires LocalP.
+  double GetClustCf() const;
+  /// Returns the estimated number of triangles of node NId. Requires LocalP.
+  double GetNodeTriads(const int& NId) const;
+  /// Returns the estimated clustering coefficient of node NId. Requires LocalP.
+  double GetNodeClustCf(const int& NId) const;
+  /// Returns the estimated triangles of all nodes in at least one triangle. Requires LocalP.
+  const TIntFltH& GetNodeTriadH() const { return NIdTriadH; }
+};
+
 #endif // TRIAD_H
 
@@ -0,0 +1,7 @@
+#
+#	configuration variables for the example
+
+## Main application file
+MAIN = linalgbench
+DEPH = $(EXSNAPADV)/rolx.h
+DEPCPP = $(EXSNAPADV)/rolx.cpp
@@ -0,0 +1,93 @@
+#include "stdafx.h"
+#include "rolx.h"
+
+// C = op(A) * B with the plain triple loop the dense kernels replaced
+void NaiveMultiply(const TFltVV& A, const bool& TransA, const TFltVV& B, TFltVV& C) {
+  const int N = TransA ? A.GetCols() : A.GetRows();
+  const int L = TransA ? A.GetRows() : A.GetCols();
+  const int M = B.GetCols();
+  C.Gen(N, M);
+  for (int i = 0; i < N; i++) {
+    for (int j = 0; j < M; j++) {
+      double Sum = 0.0;
+      for (int k = 0; k < L; k++) {
+        Sum += (TransA ? A(k, i) : A(i, k)) * B(k, j);
+      }
+      C(i, j) = Sum;
+    }
+  }
+}
+
+// largest element difference relative to the largest element of the reference A
+double GetRelDiff(const TFltVV& A, const TFltVV& B) {
+  double MxDiff = 0.0, MxVal = 0.0;
+  for (int i = 0; i < A.GetRows(); i++) {
+    for (int j = 0; j < A.GetCols(); j++) {
+      MxDiff = TMath::Mx(MxDiff, TFlt::Abs(A(i, j) - B(i, j)));
+      MxVal = TMath::Mx(MxVal, TFlt::Abs(A(i, j)));
+    }
+  }
+  return MxVal > 0.0 ? MxDiff / MxVal : MxDiff;
+}
+
+// Times op(A) * B with the naive loop and with TLinAlg and prints GFLOP/s of both.
+void BenchProduct(const TStr& Name, const TFltVV& A, const bool& TransA, const TFltVV& B, const int& Reps) {
+  const int N = TransA ? A.GetCols() : A.GetRows();
+  const int L = TransA ? A.GetRows() : A.GetCols();
+  const int M = B.GetCols();
+  const double GFlop = 2.0 * N * M * L / 1e9;
+  TFltVV NaiveC, C(N, M), Empty;
+  TExeTm ExeTm;
+  for (int r = 0; r < Reps; r++) { NaiveMultiply(A, TransA, B, NaiveC); }
+  const double NaiveSecs = TMath::Mx(ExeTm.GetSecs(), 1e-6) / Reps;
+  ExeTm.Tick();
+  for (int r = 0; r < Reps; r++) {
+    if (TransA) { TLinAlg::Gemm(1.0, A, B, 0.0, Empty, C, TLinAlg::GEMM_A_T); }
+    else { TLinAlg::Multiply(A, B, C); }
+  }
+  const double Secs = TMath::Mx(ExeTm.GetSecs(), 1e-6) / Reps;
+  printf("%-12s %8d x %5d x %5d   naive %7.2f GFLOP/s   TLinAlg %7.2f GFLOP/s   speedup %6.1fx   rel diff %.2g\n",
+    Name.CStr(), N, L, M, GFlop/NaiveSecs, GFlop/Secs, NaiveSecs/Secs, GetRelDiff(NaiveC, C));
+}
+
+int main(int argc, char* argv[]) {
+  Env = TEnv(argc, argv, TNotify::StdNotify);
+  Env.PrepArgs(TStr::Fmt("Dense linear algebra benchmark. build: %s, %s. Time: %s", __TIME__, __DATE__, TExeTm::GetCurTm()));
+  TExeTm ExeTm;
+  Try
+  const TStr InFNm = Env.GetIfArgPrefixStr("-i:", "", "Input graph for the RolX features (empty: preferential attachment graph)");
+  const int Nodes = Env.GetIfArgPrefixInt("-n:", 20000, "Nodes of the generated graph");
+  const int Roles = Env.GetIfArgPrefixInt("-r:", 8, "Number of roles");
+  const int Size = Env.GetIfArgPrefixInt("-s:", 512, "Size of the square matrix product");
+  const int Reps = Env.GetIfArgPrefixInt("-t:", 3, "Repetitions of each product");
+#ifdef USE_CBLAS
+  printf("kernel: CBLAS\n");
+#else
+  printf("kernel: built-in\n");
+#endif
+#ifdef USE_OPENMP
+  printf("threads: %d\n", omp_get_max_threads());
+#endif
+  PUNGraph Graph;
+  if (InFNm.Empty()) {
+    TRnd Rnd(1);
+    Graph = TSnap::GenPrefAttach(Nodes, 5, Rnd);
+  } else {
+    Graph = TSnap::LoadEdgeList<PUNGraph>(InFNm, 0, 1);
+  }
+  printf("extracting RolX features of G(%d, %d)...\n", Graph->GetNodes(), Graph->GetEdges());
+  TIntFtrH Features = ExtractFeatures(Graph);
+  TIntIntH NodeIdMtxIdH = CreateNodeIdMtxIdxHash(Features);
+  const TFltVV V = ConvertFeatureToMatrix(Features, NodeIdMtxIdH);
+  const TFltVV W = CreateRandMatrix(V.GetRows(), Roles);
+  const TFltVV H = CreateRandMatrix(Roles, V.GetCols());
+  const TFltVV S = CreateRandMatrix(Size, Size);
+  printf("feature matrix: %d x %d\n", V.GetRows(), V.GetCols());
+  // the NMF product of CalcNonNegativeFactorization, the feature Gram matrix and a square product
+  BenchProduct("W*H", W, false, H, Reps);
+  BenchProduct("V'*V", V, true, V, Reps);
+  BenchProduct("square", S, false, S, Reps);
+  Catch
+  printf("\nrun time: %s (%s)\n", ExeTm.GetTmStr(), TSecTm::GetCurTm().GetTmStr().CStr());
+  return 0;
+}
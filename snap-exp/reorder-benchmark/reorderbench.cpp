@@ -0,0 +1,88 @@
+#include "stdafx.h"
+
+// Copy of Graph with nodes added in random order, as if the edge list arrived
+// unsorted. Node ids are kept.
+PNGraph GetShuffledGraph(const PNGraph& Graph) {
+  TIntV NIdV;
+  Graph->GetNIdV(NIdV);
+  TRnd Rnd(1);
+  NIdV.Shuffle(Rnd);
+  PNGraph NewGraph = TNGraph::New(Graph->GetNodes(), Graph->GetEdges());
+  for (int n = 0; n < NIdV.Len(); n++) { NewGraph->AddNode(NIdV[n]); }
+  for (int n = 0; n < NIdV.Len(); n++) {
+    const TNGraph::TNodeI NI = Graph->GetNI(NIdV[n]);
+    for (int e = 0; e < NI.GetOutDeg(); e++) { NewGraph->AddEdge(NIdV[n], NI.GetOutNId(e)); }
+  }
+  return NewGraph;
+}
+
+// Times GetPageRank on Graph and GetTriads on its undirected version.
+void BenchAlgs(const PNGraph& Graph, const PUNGraph& UGraph, const int& Reps, double& PRankSecs, double& TriadSecs, double& PRankSum, int64& Triads) {
+  TExeTm Tm;
+  for (int r = 0; r < Reps; r++) {
+    TIntFltH PRankH;
+    TSnap::GetPageRank(Graph, PRankH);
+    PRankSum = 0;
+    for (int i = 0; i < PRankH.Len(); i++) { PRankSum += PRankH[i]; }
+  }
+  PRankSecs = Tm.GetSecs() / Reps;
+  Tm.Tick();
+  for (int r = 0; r < Reps; r++) { Triads = TSnap::GetTriads(UGraph); }
+  TriadSecs = Tm.GetSecs() / Reps;
+}
+
+int main(int argc, char* argv[]) {
+  Env = TEnv(argc, argv, TNotify::StdNotify);
+  Env.PrepArgs(TStr::Fmt("Graph reordering benchmark. build: %s, %s. Time: %s", __TIME__, __DATE__, TExeTm::GetCurTm()));
+  TExeTm ExeTm;
+  Try
+  const TStr InFNm = Env.GetIfArgPrefixStr("-i:", "", "Input edge list (empty: generate an R-MAT graph)");
+  const int Nodes = Env.GetIfArgPrefixInt("-n:", 1<<20, "Nodes of the generated graph");
+  const int Edges = Env.GetIfArgPrefixInt("-e:", 10000000, "Edges of the generated graph");
+  const int Window = Env.GetIfArgPrefixInt("-w:", 5, "Gorder window");
+  const int Reps = Env.GetIfArgPrefixInt("-t:", 3, "Repetitions of each algorithm");
+  PNGraph Graph;
+  if (InFNm.Empty()) {
+    printf("generating R-MAT graph with %d nodes and %d edges...\n", Nodes, Edges);
+    Graph = TSnap::GenRMatMP(Nodes, Edges, 0.57, 0.19, 0.19);
+  } else {
+    Graph = TSnap::LoadEdgeList<PNGraph>(InFNm, 0, 1);
+  }
+  Graph = GetShuffledGraph(Graph);
+#ifdef USE_OPENMP
+  printf("nodes %d, edges %d, threads %d\n\n", Graph->GetNodes(), Graph->GetEdges(), omp_get_max_threads());
+#else
+  printf("nodes %d, edges %d\n\n", Graph->GetNodes(), Graph->GetEdges());
+#endif
+
+  const char* NameV[] = { "input", "degree", "bfs", "rcm", "gorder" };
+  const TSnap::TNodeOrder OrderV[] = { TSnap::noDeg, TSnap::noDeg, TSnap::noBfs, TSnap::noRcm, TSnap::noGorder };
+  double InPRankSecs = 0, InTriadSecs = 0;
+  printf("order      order+relabel   PageRank  speedup     triads  speedup\n");
+  for (int o = 0; o < 5; o++) {
+    TExeTm Tm;
+    PNGraph OrdGraph = Graph;
+    if (o > 0) {
+      TIntV NIdV;
+      TIntH NewNIdH;
+      if (OrderV[o] == TSnap::noGorder) {
+        TSnap::GetGorder(Graph, NIdV, Window);
+        OrdGraph = TSnap::GetReorderedGraph(Graph, NIdV, NewNIdH);
+      } else {
+        OrdGraph = TSnap::Reorder(Graph, OrderV[o], NIdV, NewNIdH);
+      }
+    }
+    const double OrderSecs = Tm.GetSecs();
+    PUNGraph UGraph = TSnap::ConvertGraph<PUNGraph>(OrdGraph);
+    double PRankSecs = 0, TriadSecs = 0, PRankSum = 0;
+    int64 Triads = 0;
+    BenchAlgs(OrdGraph, UGraph, Reps, PRankSecs, TriadSecs, PRankSum, Triads);
+    if (o == 0) { InPRankSecs = PRankSecs;  InTriadSecs = TriadSecs; }
+    printf("%-8s %13.3fs %9.3fs %7.2fx %9.3fs %7.2fx   (rank sum %.6f, triads %s)\n", NameV[o], OrderSecs,
+      PRankSecs, InPRankSecs / TMath::Mx(PRankSecs, 1e-6), TriadSecs, InTriadSecs / TMath::Mx(TriadSecs, 1e-6),
+      PRankSum, TUInt64::GetStr(Triads).CStr());
+  }
+  Catch
+  printf("\nrun time: %s (%s)\n", ExeTm.GetTmStr(), TSecTm::GetCurTm().GetTmStr().CStr());
+  return 0;
+}
@@ -0,0 +1,5 @@
+#pragma once
+
+#include "targetver.h"
+
+#include "Snap.h"
@@ -0,0 +1,7 @@
+#
+#	configuration variables for the example
+
+## Main application file
+MAIN = ssparserbench
+DEPH = 
+DEPCPP = 
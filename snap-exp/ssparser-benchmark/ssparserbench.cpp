@@ -0,0 +1,116 @@
+#include "stdafx.h"
+
+// Writes an as20graph-style edge list: comment header, then "src<tab>dst" or
+// "src<tab>dst<tab>weight" lines.
+void GenEdgeList(const TStr& FNm, const int& Edges, const bool& Weights) {
+  TRnd Rnd(1);
+  const int Nodes = TMath::Mx(Edges / 4, 1);
+  FILE* F = fopen(FNm.CStr(), "wt");
+  fprintf(F, "# Directed graph (each unordered pair of nodes is saved once)\n");
+  fprintf(F, "# Generated by ssparserbench\n");
+  fprintf(F, "# Nodes: %d Edges: %d\n", Nodes, Edges);
+  fprintf(F, Weights ? "# FromNodeId\tToNodeId\tWeight\n" : "# FromNodeId\tToNodeId\n");
+  for (int e = 0; e < Edges; e++) {
+    if (Weights) { fprintf(F, "%d\t%d\t%.6f\n", Rnd.GetUniDevInt(Nodes), Rnd.GetUniDevInt(Nodes), Rnd.GetUniDev()); }
+    else { fprintf(F, "%d\t%d\n", Rnd.GetUniDevInt(Nodes), Rnd.GetUniDevInt(Nodes)); }
+  }
+  fclose(F);
+}
+
+// the previous TSsParser::GetInt
+bool GetLnInt(const char* c, int& Val) {
+  while (TCh::IsWs(*c)) { c++; }
+  bool Minus = false;
+  if (*c=='-') { Minus = true;  c++; }
+  if (! TCh::IsNum(*c)) { return false; }
+  int _Val = TCh::GetNum(*c);  c++;
+  while (TCh::IsNum(*c)) { _Val = 10 * _Val + TCh::GetNum(*c);  c++; }
+  if (*c != 0) { return false; }
+  Val = Minus ? -_Val : _Val;
+  return true;
+}
+
+// Sums the integer fields and the remaining (float) fields of FNm with the
+// previous TSsParser::Next: a line at a time from TFIn, split char by char.
+void ParseLn(const TStr& FNm, int64& IntSum, double& FltSum, int64& Lines) {
+  PSIn SIn = TFIn::New(FNm);
+  TChA LineStr;
+  TVec<char*> FldV;
+  while (SIn->GetNextLnBf(LineStr)) {
+    if (! LineStr.Empty() && LineStr[0] == '#') { continue; }
+    FldV.Clr(false);
+    char* cur = LineStr.CStr();
+    char* last = cur;
+    while (*cur) {
+      while (*cur && *cur != '\t') { cur++; }
+      if (*cur == 0) { break; }
+      *cur = 0;  cur++;
+      FldV.Add(last);  last = cur;
+    }
+    if (*last != 0) { FldV.Add(last); }
+    for (int f = 0; f < FldV.Len(); f++) {
+      int Val;
+      if (f < 2 && GetLnInt(FldV[f], Val)) { IntSum += Val; }
+      else { FltSum += atof(FldV[f]); }
+    }
+    Lines++;
+  }
+}
+
+// Same sums with TSsParser.
+void ParseSs(const TStr& FNm, int64& IntSum, double& FltSum, int64& Lines) {
+  TSsParser Ss(FNm, ssfTabSep);
+  while (Ss.Next()) {
+    for (int f = 0; f < Ss.Len(); f++) {
+      int Val;
+      if (f < 2 && Ss.GetInt(f, Val)) { IntSum += Val; }
+      else { FltSum += Ss.GetFlt(f); }
+    }
+    Lines++;
+  }
+}
+
+int main(int argc, char* argv[]) {
+  Env = TEnv(argc, argv, TNotify::StdNotify);
+  Env.PrepArgs(TStr::Fmt("TSsParser benchmark. build: %s, %s. Time: %s", __TIME__, __DATE__, TExeTm::GetCurTm()));
+  TExeTm ExeTm;
+  Try
+  TStr InFNm = Env.GetIfArgPrefixStr("-i:", "", "Input edge list (empty: generate one)");
+  const int Edges = Env.GetIfArgPrefixInt("-e:", 10000000, "Edges of the generated edge list");
+  const bool Weights = Env.GetIfArgPrefixBool("-w:", false, "Add a float weight column to the generated edge list");
+  const int Reps = Env.GetIfArgPrefixInt("-t:", 3, "Repetitions of each parser");
+#if defined(__AVX2__)
+  printf("separator scan: AVX2\n");
+#elif defined(__SSE2__) || defined(_M_X64)
+  printf("separator scan: SSE2\n");
+#else
+  printf("separator scan: scalar\n");
+#endif
+  if (InFNm.Empty()) {
+    InFNm = "ssparserbench.txt";
+    printf("generating %d edges to %s...\n", Edges, InFNm.CStr());
+    GenEdgeList(InFNm, Edges, Weights);
+  }
+  const double MBytes = TFile::GetSize(InFNm) / (1024.0*1024.0);
+  int64 LnIntSum = 0, SsIntSum = 0, LnLines = 0, SsLines = 0;
+  double LnFltSum = 0, SsFltSum = 0;
+  TExeTm Tm;
+  for (int r = 0; r < Reps; r++) {
+    LnIntSum = 0;  LnFltSum = 0;  LnLines = 0;
+    ParseLn(InFNm, LnIntSum, LnFltSum, LnLines);
+  }
+  const double LnSecs = TMath::Mx(Tm.GetSecs(), 1e-6) / Reps;
+  Tm.Tick();
+  for (int r = 0; r < Reps; r++) {
+    SsIntSum = 0;  SsFltSum = 0;  SsLines = 0;
+    ParseSs(InFNm, SsIntSum, SsFltSum, SsLines);
+  }
+  const double SsSecs = TMath::Mx(Tm.GetSecs(), 1e-6) / Reps;
+  printf("%s: %.1f MB, %s lines\n", InFNm.CStr(), MBytes, TUInt64::GetStr(SsLines).CStr());
+  printf("line at a time  %7.3fs  %8.1f MB/s\n", LnSecs, MBytes/LnSecs);
+  printf("TSsParser       %7.3fs  %8.1f MB/s   speedup %.2fx\n", SsSecs, MBytes/SsSecs, LnSecs/SsSecs);
+  printf("sums %s\n", LnIntSum == SsIntSum && LnFltSum == SsFltSum && LnLines == SsLines ? "match" : "DIFFER");
+  Catch
+  printf("\nrun time: %s (%s)\n", ExeTm.GetTmStr(), TSecTm::GetCurTm().GetTmStr().CStr());
+  return 0;
+}
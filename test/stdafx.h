@@ -0,0 +1,4 @@
+#pragma once
+
+// snap-adv sources under test include stdafx.h
+#include "Snap.h"
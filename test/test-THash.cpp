@@ -540,3 +540,62 @@ bool IsPrime(const int& d) {
   return true;
 }
 
+#ifdef GCC_ATOMIC
+// Tests concurrent and bulk interning, save/load and shared memory load
+TEST(TStrHashMP, ManipulateTable) {
+  const int NElems = 100000;
+  const char *FName = "test.hashstrmp.dat";
+  TStrHashMP StrH(4);
+  TVec<TInt64> IdV(NElems);
+
+  EXPECT_EQ(1,StrH.Empty());
+  #pragma omp parallel for schedule(dynamic, 1000)
+  for (int i = 0; i < 2*NElems; i++) {
+    const int64 Id = StrH.AddKey(TStr::Fmt("key%d", i % NElems));
+    if (i < NElems) { IdV[i] = Id; }
+  }
+  EXPECT_EQ(NElems,StrH.Len());
+  for (int i = 0; i < NElems; i++) {
+    EXPECT_EQ(IdV[i].Val,StrH.GetKeyId(TStr::Fmt("key%d", i)));
+    EXPECT_STREQ(TStr::Fmt("key%d", i).CStr(),StrH.GetKey(IdV[i]));
+  }
+  EXPECT_EQ(-1,StrH.GetKeyId("key-1"));
+  EXPECT_EQ(1,StrH.GetMxKeyIds() >= StrH.Len());
+
+  // bulk interning returns existing ids and adds new keys
+  TStrV KeyV;
+  for (int i = NElems/2; i < NElems + NElems/2; i++) {
+    KeyV.Add(TStr::Fmt("key%d", i));
+  }
+  TVec<TInt64> KeyIdV;
+  StrH.AddKeyV(KeyV, KeyIdV);
+  EXPECT_EQ(NElems + NElems/2,StrH.Len());
+  for (int i = 0; i < KeyV.Len(); i++) {
+    EXPECT_STREQ(KeyV[i].CStr(),StrH.GetKey(KeyIdV[i]));
+    if (i < NElems/2) { EXPECT_EQ(IdV[i + NElems/2].Val,KeyIdV[i].Val); }
+  }
+
+  {
+    TFOut FOut(FName);
+    StrH.Save(FOut);
+  }
+  {
+    TFIn FIn(FName);
+    TStrHashMP StrH1(FIn);
+    EXPECT_EQ(StrH.Len(),StrH1.Len());
+    EXPECT_EQ(KeyIdV[7].Val,StrH1.GetKeyId(KeyV[7]));
+    EXPECT_EQ(KeyIdV[7].Val,StrH1.AddKey(KeyV[7]));
+    EXPECT_EQ(StrH.Len(),StrH1.Len());
+  }
+  {
+    TShMIn ShMIn(FName);
+    TStrHashMP StrH2;
+    StrH2.LoadShM(ShMIn);
+    EXPECT_EQ(StrH.Len(),StrH2.Len());
+    for (int i = 0; i < KeyV.Len(); i++) {
+      EXPECT_EQ(KeyIdV[i].Val,StrH2.GetKeyId(KeyV[i]));
+      EXPECT_STREQ(KeyV[i].CStr(),StrH2.GetKey(KeyIdV[i]));
+    }
+  }
+}
+#endif // GCC_ATOMIC
@@ -1364,6 +1364,178 @@ TEST(TNEANet, AddEdgeNodeAfterAttrAdded) {
   }
 }
 
+// Test typed attribute handles and whole column access
+TEST(TNEANet, AttrHnd) {
+  PNEANet Graph = TNEANet::New();
+  Graph->AddFltAttrE("weight", 0.5);
+  Graph->AddIntAttrN("color");
+  Graph->AddStrAttrN("name");
+  for (int i = 0; i < 10; i++) {
+    Graph->AddNode(i);
+    Graph->AddIntAttrDatN(i, 2*i, "color");
+  }
+  for (int i = 0; i < 10; i++) {
+    const int EId = Graph->AddEdge(i, (i+1) % 10);
+    Graph->AddFltAttrDatE(EId, i*0.25, "weight");
+  }
+
+  EXPECT_TRUE(Graph->GetFltAttrHndE("missing").Empty());
+  EXPECT_TRUE(Graph->GetIntAttrHndE("weight").Empty());
+  EXPECT_TRUE(Graph->GetFltAttrHndN("weight").Empty());
+
+  TNEANet::TFltAttrHnd WeightH = Graph->GetFltAttrHndE("weight");
+  TNEANet::TIntAttrHnd ColorH = Graph->GetIntAttrHndN("color");
+  TNEANet::TStrAttrHnd NameH = Graph->GetStrAttrHndN("name");
+  ASSERT_FALSE(WeightH.Empty());
+  for (TNEANet::TEdgeI EI = Graph->BegEI(); EI < Graph->EndEI(); EI++) {
+    EXPECT_EQ(Graph->GetFltAttrDatE(EI, "weight"), WeightH.GetDat(EI));
+    EXPECT_EQ(Graph->GetFltAttrDatE(EI, "weight"), WeightH.GetDat(EI.GetId()));
+    EXPECT_EQ(Graph->GetFltAttrDatE(EI, "weight"), WeightH[Graph->GetEKeyId(EI)]);
+  }
+  for (TNEANet::TNodeI NI = Graph->BegNI(); NI < Graph->EndNI(); NI++) {
+    EXPECT_EQ(2*NI.GetId(), ColorH.GetDat(NI));
+    NameH.GetDat(NI) = TStr::Fmt("n%d", NI.GetId());
+  }
+  EXPECT_EQ(TStr("n3"), Graph->GetStrAttrDatN(3, "name"));
+
+  // handles stay valid while nodes, edges and attributes are added
+  Graph->AddFltAttrE("other");
+  Graph->AddNode(10);
+  const int EId = Graph->AddEdge(9, 10);
+  WeightH.GetDat(EId) = 7.0;
+  EXPECT_EQ(7.0, Graph->GetFltAttrDatE(EId, "weight"));
+  EXPECT_EQ(TInt::Mn, ColorH.GetDat(10));
+
+  // columns are aligned with node and edge iteration order
+  Graph->DelNode(4);
+  TIntV ColorV;
+  ColorH.GetColV(ColorV);
+  ASSERT_EQ(Graph->GetNodes(), ColorV.Len());
+  int i = 0;
+  for (TNEANet::TNodeI NI = Graph->BegNI(); NI < Graph->EndNI(); NI++, i++) {
+    EXPECT_EQ(Graph->GetIntAttrDatN(NI, "color"), ColorV[i]);
+    ColorV[i] = NI.GetId() + 100;
+  }
+  ColorH.SetColV(ColorV);
+  for (TNEANet::TNodeI NI = Graph->BegNI(); NI < Graph->EndNI(); NI++) {
+    EXPECT_EQ(NI.GetId() + 100, Graph->GetIntAttrDatN(NI, "color"));
+  }
+
+  TFltV WeightV;
+  WeightH.GetColV(WeightV);
+  ASSERT_EQ(Graph->GetEdges(), WeightV.Len());
+  i = 0;
+  for (TNEANet::TEdgeI EI = Graph->BegEI(); EI < Graph->EndEI(); EI++, i++) {
+    EXPECT_EQ(Graph->GetFltAttrDatE(EI, "weight"), WeightV[i]);
+    WeightV[i] = 1.0;
+  }
+  WeightH.SetColV(WeightV);
+
+  // with unit weights weighted PageRank equals PageRank
+  TIntFltH PRankH, WPRankH;
+  TSnap::GetPageRank(Graph, PRankH);
+  EXPECT_EQ(0, TSnap::GetWeightedPageRank(Graph, WPRankH, "weight"));
+  EXPECT_EQ(-1, TSnap::GetWeightedPageRank(Graph, WPRankH, "missing"));
+  TSnap::GetWeightedPageRank(Graph, WPRankH, "weight");
+  ASSERT_EQ(PRankH.Len(), WPRankH.Len());
+  for (int n = 0; n < PRankH.Len(); n++) {
+    EXPECT_NEAR(PRankH[n], WPRankH.GetDat(PRankH.GetKey(n)), 1e-6);
+  }
+}
+
+TEST(TNEANet, DictStrAttr) {
+  const char *FName = "dictstr.graph.dat";
+  PNEANet Graph = TNEANet::New();
+  EXPECT_EQ(0, Graph->AddStrAttrN("city", "none", true));
+  EXPECT_EQ(-1, Graph->AddStrAttrN("city", "none", true));
+  Graph->AddStrAttrN("plain");
+  Graph->AddStrAttrE("label", TStr::GetNullStr(), true);
+  EXPECT_TRUE(Graph->IsDictStrAttrN("city"));
+  EXPECT_FALSE(Graph->IsDictStrAttrN("plain"));
+  EXPECT_TRUE(Graph->IsStrAttrE("label"));
+  const char* Cities[] = { "paris", "rome", "oslo" };
+  for (int i = 0; i < 30; i++) {
+    Graph->AddNode(i);
+    if (i % 5 != 0) {
+      Graph->AddStrAttrDatN(i, Cities[i % 3], "city");
+      Graph->AddStrAttrDatN(i, Cities[i % 3], "plain");
+    }
+  }
+  for (int i = 0; i < 29; i++) {
+    Graph->AddEdge(i, i+1, i);
+    Graph->AddStrAttrDatE(i, i % 2 == 0 ? "even" : "odd", "label");
+  }
+  // the pool holds every distinct value once
+  EXPECT_EQ(7, Graph->GetStrCodes());
+  EXPECT_EQ(-1, Graph->GetStrCode("berlin"));
+  EXPECT_EQ(TStr("none"), Graph->GetStrAttrDatN(0, "city"));
+  EXPECT_EQ(TStr("rome"), Graph->GetStrAttrDatN(1, "city"));
+  EXPECT_EQ(TStr("odd"), Graph->GetStrAttrDatE(3, "label"));
+
+  TIntV DictIdV, PlainIdV;
+  Graph->GetStrAttrEqNIdV("city", "oslo", DictIdV);
+  Graph->GetStrAttrEqNIdV("plain", "oslo", PlainIdV);
+  EXPECT_EQ(8, DictIdV.Len());
+  EXPECT_EQ(PlainIdV, DictIdV);
+  Graph->GetStrAttrEqNIdV("city", "berlin", DictIdV);
+  EXPECT_EQ(0, DictIdV.Len());
+  Graph->GetStrAttrEqEIdV("label", "even", DictIdV);
+  EXPECT_EQ(15, DictIdV.Len());
+
+  // generic attribute accessors see the decoded strings
+  TStrV Names, Values;
+  Graph->StrAttrNameNI(2, Names);
+  Graph->StrAttrValueNI(2, Values);
+  EXPECT_EQ(2, Names.Len());
+  EXPECT_EQ(TStr("oslo"), Values[0]);
+  Graph->StrAttrNameNI(5, Names);
+  EXPECT_EQ(0, Names.Len());
+  EXPECT_TRUE(Graph->IsStrAttrDeletedN(10, "city"));
+  EXPECT_FALSE(Graph->IsStrAttrDeletedN(11, "city"));
+  int Count = 0;
+  for (TNEANet::TAStrI I = Graph->BegNAStrI("city"); I < Graph->EndNAStrI("city"); I++) {
+    if (!I.IsDeleted()) { Count++; }
+  }
+  EXPECT_EQ(24, Count);
+  Graph->DelAttrDatN(11, "city");
+  EXPECT_EQ(TStr("none"), Graph->GetStrAttrDatN(11, "city"));
+  TStrV IntNames, FltNames, StrNames;
+  Graph->GetAttrNNames(IntNames, FltNames, StrNames);
+  EXPECT_EQ(0, IntNames.Len());
+  EXPECT_EQ(2, StrNames.Len());
+
+  // codes survive save and load
+  {
+    TFOut FOut(FName);
+    Graph->Save(FOut);
+    FOut.Flush();
+  }
+  {
+    TFIn FIn(FName);
+    PNEANet Graph2 = TNEANet::Load(FIn);
+    EXPECT_TRUE(Graph2->IsDictStrAttrN("city"));
+    for (TNEANet::TNodeI NI = Graph->BegNI(); NI < Graph->EndNI(); NI++) {
+      EXPECT_EQ(Graph->GetStrAttrDatN(NI.GetId(), "city"), Graph2->GetStrAttrDatN(NI.GetId(), "city"));
+    }
+    EXPECT_EQ(TStr("odd"), Graph2->GetStrAttrDatE(5, "label"));
+  }
+  {
+    TFOut FOut(FName);
+    Graph->Save_V3(FOut);
+    FOut.Flush();
+  }
+  {
+    TFIn FIn(FName);
+    PNEANet Graph3 = TNEANet::Load_V3(FIn);
+    EXPECT_EQ(Graph->GetNodes(), Graph3->GetNodes());
+    EXPECT_EQ(TStr("rome"), Graph3->GetStrAttrDatN(1, "plain"));
+  }
+
+  Graph->DelAttrN("city");
+  EXPECT_FALSE(Graph->IsDictStrAttrN("city"));
+  EXPECT_EQ(TStr("odd"), Graph->GetStrAttrDatE(1, "label"));
+}
+
 TEST(TNEANet, AddNodeAttributeError) {
   PNEANet Graph;
   Graph = TNEANet::New();
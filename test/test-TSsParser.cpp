@@ -0,0 +1,181 @@
+#include <gtest/gtest.h>
+
+#include "Snap.h"
+
+class TSsParserTest { };  // For gtest highlighting
+
+// Writes Str to FNm as is, without line ending conversions
+static void WriteSsFile(const TStr& FNm, const TChA& Str) {
+  TFOut FOut(FNm);
+  FOut.PutBf(Str.CStr(), Str.Len());
+}
+
+// Fields of the next line of Ss joined with '|'
+static TStr GetSsLn(const TSsParser& Ss) {
+  TChA LnChA;
+  for (int f = 0; f < Ss.Len(); f++) {
+    if (f > 0) { LnChA += '|'; }
+    LnChA += Ss[f];
+    EXPECT_EQ((int) strlen(Ss[f]), Ss.GetFldLen(f));
+  }
+  return LnChA;
+}
+
+// A line longer than the 1MB block is read whole, the lines around it are not affected
+TEST(TSsParser, LongLine) {
+  const int LongFlds = 300000;
+  TChA Str = "first\tline\n";
+  for (int f = 0; f < LongFlds; f++) {
+    if (f > 0) { Str += '\t'; }
+    Str += TInt::GetStr(f);
+  }
+  Str += "\nlast\tline\n";
+  EXPECT_LT(1024*1024, Str.Len());
+  WriteSsFile("test-ssparser-long.dat", Str);
+
+  TSsParser Ss("test-ssparser-long.dat", ssfTabSep);
+  ASSERT_TRUE(Ss.Next());
+  EXPECT_EQ(TStr("first|line"), GetSsLn(Ss));
+  ASSERT_TRUE(Ss.Next());
+  ASSERT_EQ(LongFlds, Ss.Len());
+  for (int f = 0; f < LongFlds; f++) {
+    EXPECT_EQ(f, Ss.GetInt(f));
+  }
+  ASSERT_TRUE(Ss.Next());
+  EXPECT_EQ(TStr("last|line"), GetSsLn(Ss));
+  EXPECT_FALSE(Ss.Next());
+}
+
+// The last line is parsed when the file does not end with a newline
+TEST(TSsParser, NoFinalNewline) {
+  WriteSsFile("test-ssparser-eof.dat", "1\t2\n3\t4");
+  TSsParser Ss("test-ssparser-eof.dat", ssfTabSep);
+  ASSERT_TRUE(Ss.Next());
+  EXPECT_EQ(TStr("1|2"), GetSsLn(Ss));
+  ASSERT_TRUE(Ss.Next());
+  EXPECT_EQ(TStr("3|4"), GetSsLn(Ss));
+  EXPECT_EQ(4, Ss.GetInt(1));
+  EXPECT_FALSE(Ss.Next());
+
+  WriteSsFile("test-ssparser-eof.dat", "");
+  TSsParser Ss2("test-ssparser-eof.dat", ssfTabSep);
+  EXPECT_FALSE(Ss2.Next());
+}
+
+// Carriage returns of CRLF line endings are not part of the last field
+TEST(TSsParser, CrLf) {
+  WriteSsFile("test-ssparser-crlf.dat", "a\tb\r\n\r\nc\t1.5\r\n#x\r\nd\te\r");
+  TSsParser Ss("test-ssparser-crlf.dat", ssfTabSep);
+  ASSERT_TRUE(Ss.Next());
+  EXPECT_EQ(TStr("a|b"), GetSsLn(Ss));
+  ASSERT_TRUE(Ss.Next());
+  EXPECT_EQ(0, Ss.Len());
+  ASSERT_TRUE(Ss.Next());
+  EXPECT_EQ(TStr("c|1.5"), GetSsLn(Ss));
+  EXPECT_EQ(1.5, Ss.GetFlt(1));
+  ASSERT_TRUE(Ss.Next());
+  EXPECT_EQ(TStr("d|e"), GetSsLn(Ss));
+  EXPECT_FALSE(Ss.Next());
+
+  TSsParser SsWs("test-ssparser-crlf.dat", ssfWhiteSep, true, true, true);
+  ASSERT_TRUE(SsWs.Next());
+  EXPECT_EQ(TStr("a|b"), GetSsLn(SsWs));
+  ASSERT_TRUE(SsWs.Next());
+  EXPECT_EQ(TStr("c|1.5"), GetSsLn(SsWs));
+  ASSERT_TRUE(SsWs.Next());
+  EXPECT_EQ(TStr("d|e"), GetSsLn(SsWs));
+  EXPECT_FALSE(SsWs.Next());
+}
+
+// ssfWhiteSep splits on runs of spaces and tabs
+TEST(TSsParser, WhiteSep) {
+  WriteSsFile("test-ssparser-ws.dat", "  1 2\t\t3 \n4\t \t5\n\t \n");
+  TSsParser Ss("test-ssparser-ws.dat", ssfWhiteSep, true, false, true);
+  ASSERT_TRUE(Ss.Next());
+  EXPECT_EQ(TStr("1|2|3"), GetSsLn(Ss));
+  ASSERT_TRUE(Ss.Next());
+  EXPECT_EQ(TStr("4|5"), GetSsLn(Ss));
+  EXPECT_EQ(5, Ss.GetInt(1));
+  EXPECT_FALSE(Ss.Next());
+
+  // without skipping, every separator ends a field
+  TSsParser SsAll("test-ssparser-ws.dat", ssfWhiteSep, false, false, false);
+  ASSERT_TRUE(SsAll.Next());
+  EXPECT_EQ(TStr("||1|2||3"), GetSsLn(SsAll));
+  ASSERT_TRUE(SsAll.Next());
+  EXPECT_EQ(TStr("4|||5"), GetSsLn(SsAll));
+  ASSERT_TRUE(SsAll.Next());
+  EXPECT_EQ(TStr("|"), GetSsLn(SsAll));
+  EXPECT_FALSE(SsAll.Next());
+}
+
+// SkipEmptyFld drops empty fields and the lines that have no other fields
+TEST(TSsParser, SkipEmptyFld) {
+  WriteSsFile("test-ssparser-empty.dat", "a\t\tb\t\n\t\n\nc\n");
+  TSsParser Ss("test-ssparser-empty.dat", ssfTabSep, false, false, false);
+  ASSERT_TRUE(Ss.Next());
+  EXPECT_EQ(TStr("a||b"), GetSsLn(Ss));
+  ASSERT_TRUE(Ss.Next());
+  EXPECT_EQ(TStr(""), GetSsLn(Ss));
+  EXPECT_EQ(1, Ss.Len());
+  ASSERT_TRUE(Ss.Next());
+  EXPECT_EQ(0, Ss.Len());
+  ASSERT_TRUE(Ss.Next());
+  EXPECT_EQ(TStr("c"), GetSsLn(Ss));
+  EXPECT_FALSE(Ss.Next());
+
+  TSsParser SsSkip("test-ssparser-empty.dat", ssfTabSep, false, false, true);
+  ASSERT_TRUE(SsSkip.Next());
+  EXPECT_EQ(TStr("a|b"), GetSsLn(SsSkip));
+  ASSERT_TRUE(SsSkip.Next());
+  EXPECT_EQ(TStr("c"), GetSsLn(SsSkip));
+  EXPECT_FALSE(SsSkip.Next());
+}
+
+// GetFlt gives the same values as atof, on its exact path and on the atof fallback
+TEST(TSsParser, GetFlt) {
+  const char* FltStr[] = { "0", "-0", "+0.0", "1", "-1", "+42", "0.1", "-0.5", "+3.25",
+    ".5", "5.", "000123.4500", "3.14159265358979", "123456789012345", "1234567890123456",
+    "12345678901234567890123", "0.000000000000000000001234", "1e10", "1E-5", "-2.5e+3",
+    "1e22", "1e23", "1e-22", "1e-23", "9007199254740993", "0.30000000000000004",
+    "2.2250738585072014e-308", "4.9e-324", "-1.7976931348623157e308", "1e400", "1e-400",
+    "  7.25", "6.02214076e23", "1.602176634e-19" };
+  const int Flts = sizeof(FltStr) / sizeof(FltStr[0]);
+  TChA Str;
+  for (int i = 0; i < Flts; i++) {
+    if (i > 0) { Str += '\t'; }
+    Str += FltStr[i];
+  }
+  Str += "\nabc\t1.5x\t--1\t1e\t-\t+e5\n";
+  WriteSsFile("test-ssparser-flt.dat", Str);
+
+  TSsParser Ss("test-ssparser-flt.dat", ssfTabSep);
+  ASSERT_TRUE(Ss.Next());
+  ASSERT_EQ(Flts, Ss.Len());
+  for (int i = 0; i < Flts; i++) {
+    double Val = 0;
+    EXPECT_TRUE(Ss.GetFlt(i, Val)) << FltStr[i];
+    const double ExpVal = atof(FltStr[i]);
+    EXPECT_EQ(0, memcmp(&ExpVal, &Val, sizeof(double))) << FltStr[i];
+  }
+  ASSERT_TRUE(Ss.Next());
+  for (int i = 0; i < Ss.Len(); i++) {
+    EXPECT_FALSE(Ss.IsFlt(i)) << Ss[i];
+  }
+
+  // random values printed with 6 to 17 significant digits
+  TRnd Rnd(1);
+  TStrV ValStrV;
+  Str.Clr();
+  for (int i = 0; i < 10000; i++) {
+    const double Flt = (Rnd.GetUniDev() - 0.5) * pow(10.0, Rnd.GetUniDevInt(-30, 30));
+    ValStrV.Add(TStr::Fmt(i % 2 == 0 ? "%.*g" : "%.*e", 6 + i % 12, Flt));
+    Str += ValStrV.Last();  Str += '\n';
+  }
+  WriteSsFile("test-ssparser-flt.dat", Str);
+  TSsParser SsRnd("test-ssparser-flt.dat", ssfTabSep);
+  for (int i = 0; i < ValStrV.Len(); i++) {
+    ASSERT_TRUE(SsRnd.Next());
+    EXPECT_EQ(atof(ValStrV[i].CStr()), SsRnd.GetFlt(0)) << ValStrV[i].CStr();
+  }
+}
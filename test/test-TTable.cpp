@@ -141,6 +141,70 @@ TEST(TTable, ToGraph) {
   EXPECT_EQ(1,Graph->IsOk());
 }
 
+// Tests sliding window graph sequences against the rows of each window.
+TEST(TTable, ToGraphSequence) {
+  TTableContext Context;
+  TRnd Rnd(1);
+  {
+    TFOut FOut("table/sequence.txt");
+    for (int i = 0; i < 200; i++) {
+      FOut.PutStr(TStr::Fmt("%d\t%d\t%d\t%d\n", Rnd.GetUniDevInt(10),
+        Rnd.GetUniDevInt(10), i / 2, Rnd.GetUniDevInt(100)));
+    }
+  }
+  Schema SeqS;
+  SeqS.Add(TPair<TStr,TAttrType>("Src", atInt));
+  SeqS.Add(TPair<TStr,TAttrType>("Dst", atInt));
+  SeqS.Add(TPair<TStr,TAttrType>("Time", atInt));
+  SeqS.Add(TPair<TStr,TAttrType>("Val", atInt));
+  PTable T = TTable::LoadSS(SeqS, "table/sequence.txt", &Context);
+  T->SetSrcCol("Src");
+  T->SetDstCol("Dst");
+  T->AddEdgeAttr("Val");
+  T->AddSrcNodeAttr("Val");
+
+  // windows [5j, 5j + 20) over times 0..99
+  TVec<PNEANet> Seq = T->ToGraphSequence("Time", aaSum, 20, 5);
+  ASSERT_EQ(20, Seq.Len());
+  PNEANet Iter = T->ToGraphSequenceIterator("Time", aaSum, 20, 5);
+  for (int j = 0; j < Seq.Len(); j++) {
+    ASSERT_FALSE(Iter.Empty());
+    THashSet<TInt> NIdSet;
+    THash<TInt, TInt> SrcSum;
+    int Edges = 0;
+    for (int r = 0; r < T->GetNumRows(); r++) {
+      const int Time = T->GetIntVal("Time", r);
+      if (Time < 5 * j || Time >= 5 * j + 20) { continue; }
+      const int Src = T->GetIntVal("Src", r);
+      const int Dst = T->GetIntVal("Dst", r);
+      const int Val = T->GetIntVal("Val", r);
+      Edges++;
+      NIdSet.AddKey(Src);
+      NIdSet.AddKey(Dst);
+      SrcSum.AddDat(Src) += Val;
+      for (int g = 0; g < 2; g++) {
+        PNEANet Graph = g == 0 ? Seq[j] : Iter;
+        ASSERT_TRUE(Graph->IsEdge(r));
+        EXPECT_EQ(Src, Graph->GetEI(r).GetSrcNId());
+        EXPECT_EQ(Dst, Graph->GetEI(r).GetDstNId());
+        EXPECT_EQ(Val, Graph->GetIntAttrDatE(r, "Val").Val);
+      }
+    }
+    for (int g = 0; g < 2; g++) {
+      PNEANet Graph = g == 0 ? Seq[j] : Iter;
+      EXPECT_EQ(Edges, Graph->GetEdges());
+      EXPECT_EQ(NIdSet.Len(), Graph->GetNodes());
+      for (THashSet<TInt>::TIter it = NIdSet.BegI(); it < NIdSet.EndI(); it++) {
+        const int NId = it.GetKey();
+        const int Sum = SrcSum.IsKey(NId) ? SrcSum.GetDat(NId).Val : TInt::Mn;
+        EXPECT_EQ(Sum, Graph->GetIntAttrDatN(NId, "Val").Val);
+      }
+    }
+    Iter = T->NextGraphIterator();
+  }
+  EXPECT_TRUE(Iter.Empty());
+}
+
 #ifdef GCC_ATOMIC
 // Tests parallel table to graph function.
 TEST(TTable, ToGraphMP) {
@@ -163,4 +227,388 @@ TEST(TTable, ToGraphMP) {
   EXPECT_EQ(499,Graph->GetEdges());
   EXPECT_EQ(1,Graph->IsOk());
 }
+// Tests that parallel and sequential loading of string columns agree.
+TEST(TTable, LoadSSStrMP) {
+  {
+    TFOut FOut("table/strs.txt");
+    for (int i = 0; i < 1000; i++) {
+      FOut.PutStr(TStr::Fmt("url%d\t%d\thost%d\r\n", (i*7) % 301, i, i % 13));
+    }
+  }
+  Schema S;
+  S.Add(TPair<TStr,TAttrType>("Url", atStr));
+  S.Add(TPair<TStr,TAttrType>("Val", atInt));
+  S.Add(TPair<TStr,TAttrType>("Host", atStr));
+
+  TTableContext ContextMP;
+  TTable::SetMP(1);
+  PTable T1 = TTable::LoadSS(S, "table/strs.txt", &ContextMP);
+  TTableContext ContextSeq;
+  TTable::SetMP(0);
+  PTable T2 = TTable::LoadSS(S, "table/strs.txt", &ContextSeq);
+  TTable::SetMP(1);
+
+  EXPECT_EQ(1000, T1->GetNumRows().Val);
+  EXPECT_EQ(T2->GetNumRows().Val, T1->GetNumRows().Val);
+  for (int i = 0; i < 1000; i++) {
+    EXPECT_EQ(T2->GetStrMapByName("Url", i).Val, T1->GetStrMapByName("Url", i).Val);
+    EXPECT_EQ(T2->GetStrMapByName("Host", i).Val, T1->GetStrMapByName("Host", i).Val);
+    EXPECT_EQ(i, T1->GetIntVal("Val", i).Val);
+  }
+  EXPECT_STREQ("url7", T1->GetStrVal("Url", 1).CStr());
+  EXPECT_STREQ("host12", T1->GetStrVal("Host", 12).CStr());
+}
 #endif // GCC_ATOMIC
+
+// Tests ordering and grouping by multiple columns against direct comparisons.
+TEST(TTable, OrderGroup) {
+  TRnd Rnd(1);
+  {
+    TFOut FOut("table/order.txt");
+    for (int i = 0; i < 5000; i++) {
+      FOut.PutStr(TStr::Fmt("k%d\t%d\t%g\n", Rnd.GetUniDevInt(40),
+        Rnd.GetUniDevInt(200) - 100, Rnd.GetUniDevInt(50) / 4.0 - 5));
+    }
+  }
+  Schema S;
+  S.Add(TPair<TStr,TAttrType>("Key", atStr));
+  S.Add(TPair<TStr,TAttrType>("Val", atInt));
+  S.Add(TPair<TStr,TAttrType>("Wgt", atFlt));
+  TStrV OrderBy;
+  OrderBy.Add("Key");  OrderBy.Add("Val");
+
+  TTableContext Context;
+  PTable T = TTable::LoadSS(S, "table/order.txt", &Context);
+  T->Order(OrderBy);
+  TStr PrevKey;  int PrevVal = 0, Rows = 0;
+  for (TRowIterator RI = T->BegRI(); RI < T->EndRI(); RI++) {
+    const TStr Key = RI.GetStrAttr("Key");
+    const int Val = RI.GetIntAttr("Val");
+    if (Rows > 0) {
+      EXPECT_TRUE(PrevKey < Key || (PrevKey == Key && PrevVal <= Val));
+    }
+    PrevKey = Key;  PrevVal = Val;  Rows++;
+  }
+  EXPECT_EQ(5000, Rows);
+
+  TStrV WgtV;
+  WgtV.Add("Wgt");
+  T->Order(WgtV, "", false, false);
+  double PrevWgt = TFlt::Mx;
+  for (TRowIterator RI = T->BegRI(); RI < T->EndRI(); RI++) {
+    EXPECT_TRUE(RI.GetFltAttr("Wgt") <= PrevWgt);
+    PrevWgt = RI.GetFltAttr("Wgt");
+  }
+
+  // group ids are assigned in the order of first appearance
+  PTable G = TTable::LoadSS(S, "table/order.txt", &Context);
+  G->Group(OrderBy, "GroupId");
+  THash<TStr, TInt> KeyToGroupH;
+  for (TRowIterator RI = G->BegRI(); RI < G->EndRI(); RI++) {
+    const TStr Key = RI.GetStrAttr("Key") + TStr::Fmt("|%d", RI.GetIntAttr("Val").Val);
+    if (! KeyToGroupH.IsKey(Key)) {
+      EXPECT_EQ(KeyToGroupH.Len(), RI.GetIntAttr("GroupId").Val);
+      KeyToGroupH.AddDat(Key, RI.GetIntAttr("GroupId"));
+    }
+    EXPECT_EQ(KeyToGroupH.GetDat(Key).Val, RI.GetIntAttr("GroupId").Val);
+  }
+
+  PTable U = TTable::LoadSS(S, "table/order.txt", &Context);
+  U->Unique(OrderBy);
+  EXPECT_EQ(KeyToGroupH.Len(), U->GetNumValidRows().Val);
+}
+
+// Reference order of rows by the values of the given columns, ties by row index
+class TOrderRowCmp {
+private:
+  PTable T;
+  TStrV ColV;
+  bool Asc;
+public:
+  TOrderRowCmp(const PTable& _T, const TStrV& _ColV, const bool& _Asc) : T(_T), ColV(_ColV), Asc(_Asc) { }
+  int CmpKeys(const int& Row1, const int& Row2) const {
+    for (int c = 0; c < ColV.Len(); c++) {
+      int Cmp = 0;
+      switch (T->GetColType(ColV[c])) {
+        case atInt: {
+          const int Val1 = T->GetIntVal(ColV[c], Row1), Val2 = T->GetIntVal(ColV[c], Row2);
+          Cmp = Val1 < Val2 ? -1 : (Val2 < Val1 ? 1 : 0);  break; }
+        case atFlt: {
+          const double Val1 = T->GetFltVal(ColV[c], Row1), Val2 = T->GetFltVal(ColV[c], Row2);
+          Cmp = Val1 < Val2 ? -1 : (Val2 < Val1 ? 1 : 0);  break; }
+        case atStr:
+          Cmp = strcmp(T->GetStrVal(ColV[c], Row1).CStr(), T->GetStrVal(ColV[c], Row2).CStr());  break;
+        default: break;
+      }
+      if (Cmp != 0) { return Asc ? Cmp : -Cmp; }
+    }
+    return 0;
+  }
+  bool operator () (const TInt& Row1, const TInt& Row2) const {
+    const int Cmp = CmpKeys(Row1, Row2);
+    return Cmp < 0 || (Cmp == 0 && Row1 < Row2);
+  }
+};
+
+// Order T by OrderBy with a rank column reset by the first column and compare
+// with the reference order. The radix sort keeps rows with equal keys in their
+// original order, QSort only has to agree on the keys.
+static void TestOrder(const PTable& T, const TStrV& OrderBy, const bool& Asc, const bool& Stable) {
+  TIntV RowV;
+  for (int i = 0; i < T->GetNumRows(); i++) { RowV.Add(i); }
+  const TOrderRowCmp Cmp(T, OrderBy, Asc);
+  RowV.SortCmp(Cmp);
+  TStrV MscV;
+  MscV.Add(OrderBy[0]);
+  const TOrderRowCmp MscCmp(T, MscV, Asc);
+
+  const TStr RankCol = TStr::Fmt("Rank%d", T->GetSchema().Len());
+  T->Order(OrderBy, RankCol, true, Asc);
+  int Rows = 0, PrevRow = -1;
+  for (TRowIterator RI = T->BegRI(); RI < T->EndRI(); RI++) {
+    const int Row = RI.GetRowIdx();
+    ASSERT_LT(Rows, RowV.Len());
+    if (Stable) {
+      EXPECT_EQ(RowV[Rows].Val, Row) << "position " << Rows;
+    } else {
+      EXPECT_EQ(0, Cmp.CmpKeys(RowV[Rows], Row)) << "position " << Rows;
+    }
+    if (PrevRow == -1 || MscCmp.CmpKeys(PrevRow, Row) != 0) {
+      EXPECT_EQ(0, RI.GetIntAttr(RankCol).Val);
+    } else {
+      EXPECT_EQ(T->GetIntVal(RankCol, PrevRow).Val + 1, RI.GetIntAttr(RankCol).Val);
+    }
+    PrevRow = Row;  Rows++;
+  }
+  EXPECT_EQ(RowV.Len(), Rows);
+}
+
+// Tests the parallel radix sort of narrow keys on a large table.
+TEST(TTable, OrderRadixMP) {
+  TRnd Rnd(1);
+  {
+    TFOut FOut("table/orderbig.txt");
+    for (int i = 0; i < 120000; i++) {
+      FOut.PutStr(TStr::Fmt("k%d\t%d\t%g\n", Rnd.GetUniDevInt(3000),
+        Rnd.GetUniDevInt(100) - 50, Rnd.GetUniDevInt(1000) / 8.0 - 60));
+    }
+  }
+  Schema S;
+  S.Add(TPair<TStr,TAttrType>("Key", atStr));
+  S.Add(TPair<TStr,TAttrType>("Val", atInt));
+  S.Add(TPair<TStr,TAttrType>("Wgt", atFlt));
+  TStrV KeyValV;
+  KeyValV.Add("Key");  KeyValV.Add("Val");
+  TStrV WgtKeyV;
+  WgtKeyV.Add("Wgt");  WgtKeyV.Add("Key");
+
+  const TInt UseMP = TTable::GetMP();
+#ifdef USE_OPENMP
+  const int MxThreads = omp_get_max_threads();
+  omp_set_num_threads(4);
+#endif
+  TTable::SetMP(1);
+  TTableContext Context;
+  PTable T = TTable::LoadSS(S, "table/orderbig.txt", &Context);
+  TestOrder(T, KeyValV, true, true);
+  TestOrder(T, KeyValV, false, true);
+  TestOrder(T, WgtKeyV, true, true);
+  TestOrder(T, WgtKeyV, false, true);
+  TTable::SetMP(UseMP);
+#ifdef USE_OPENMP
+  omp_set_num_threads(MxThreads);
+#endif
+}
+
+// Tests keys wider than two words, which are sorted by QSort (QSortPar with MP).
+TEST(TTable, OrderWideKeys) {
+  TRnd Rnd(1);
+  // few distinct full range ints and floats, so that all columns decide some rows
+  TIntV IntV;
+  TFltV FltV;
+  for (int i = 0; i < 40; i++) {
+    IntV.Add(int(Rnd.GetUniDevUInt()));
+    FltV.Add((Rnd.GetUniDev() - 0.5) * pow(10.0, Rnd.GetUniDevInt(600) - 300));
+  }
+  IntV[0] = TInt::Mn;  IntV[1] = TInt::Mx;  IntV[2] = 0;
+  FltV[0] = -TFlt::Mx;  FltV[1] = TFlt::Mx;  FltV[2] = 0.0;
+  {
+    TFOut FOut("table/orderwide.txt");
+    for (int i = 0; i < 20000; i++) {
+      FOut.PutStr(TStr::Fmt("%d\t%.17g\ts%d\t%d\n", IntV[Rnd.GetUniDevInt(IntV.Len())].Val,
+        FltV[Rnd.GetUniDevInt(FltV.Len())].Val, Rnd.GetUniDevInt(100000), Rnd.GetUniDevInt(10)));
+    }
+  }
+  Schema S;
+  S.Add(TPair<TStr,TAttrType>("Int", atInt));
+  S.Add(TPair<TStr,TAttrType>("Flt", atFlt));
+  S.Add(TPair<TStr,TAttrType>("Str", atStr));
+  S.Add(TPair<TStr,TAttrType>("Val", atInt));
+  TStrV IntFltStrV;
+  IntFltStrV.Add("Int");  IntFltStrV.Add("Flt");  IntFltStrV.Add("Str");
+  TStrV StrFltIntV;
+  StrFltIntV.Add("Str");  StrFltIntV.Add("Flt");  StrFltIntV.Add("Int");  StrFltIntV.Add("Val");
+
+  const TInt UseMP = TTable::GetMP();
+#ifdef USE_OPENMP
+  const int MxThreads = omp_get_max_threads();
+#endif
+  TTableContext Context;
+  PTable T = TTable::LoadSS(S, "table/orderwide.txt", &Context);
+  for (int MP = 0; MP < 2; MP++) {
+    TTable::SetMP(MP);
+    TestOrder(T, IntFltStrV, true, false);
+    TestOrder(T, IntFltStrV, false, false);
+    TestOrder(T, StrFltIntV, true, false);
+    TestOrder(T, StrFltIntV, false, false);
+  }
+  TTable::SetMP(UseMP);
+#ifdef USE_OPENMP
+  omp_set_num_threads(MxThreads);
+#endif
+}
+
+// Write the input of the columnar file tests to table/colbin.txt
+static void SaveColBinSS() {
+  TRnd Rnd(1);
+  TFOut FOut("table/colbin.txt");
+  for (int i = 0; i < 3000; i++) {
+    FOut.PutStr(TStr::Fmt("s%d\t%d\t%g\n", Rnd.GetUniDevInt(100),
+      Rnd.GetUniDevInt(1000) - 500, Rnd.GetUniDevInt(80) / 8.0 - 5));
+  }
+}
+
+// Write and load table/colbin.txt, the single threaded loader also parses the float column
+static PTable LoadColBinSS(TTableContext* Context) {
+  SaveColBinSS();
+  Schema S;
+  S.Add(TPair<TStr,TAttrType>("Name", atStr));
+  S.Add(TPair<TStr,TAttrType>("Val", atInt));
+  S.Add(TPair<TStr,TAttrType>("Wgt", atFlt));
+  const TInt UseMP = TTable::GetMP();
+  TTable::SetMP(0);
+  PTable T = TTable::LoadSS(S, "table/colbin.txt", Context);
+  TTable::SetMP(UseMP);
+  return T;
+}
+
+// Save columns in the logical row order and map them back
+TEST(TTable, ColBin) {
+  TTableContext Context;
+  PTable T = LoadColBinSS(&Context);
+  TStrV OrderBy;
+  OrderBy.Add("Val");
+  T->Order(OrderBy);
+  T->SaveColBin("table/colbin.bin");
+
+  Schema S2;
+  TFltPrV MnMxV;
+  TIntV NullsV;
+  TTable::GetColBinInfo("table/colbin.bin", S2, MnMxV, NullsV);
+  const Schema TS = T->GetSchema();
+  ASSERT_EQ(TS.Len(), S2.Len());
+  int MnVal = TInt::Mx, MxVal = TInt::Mn;
+  for (TRowIterator RI = T->BegRI(); RI < T->EndRI(); RI++) {
+    MnVal = TMath::Mn(MnVal, RI.GetIntAttr("Val").Val);
+    MxVal = TMath::Mx(MxVal, RI.GetIntAttr("Val").Val);
+  }
+  for (int c = 0; c < TS.Len(); c++) {
+    EXPECT_EQ(TS[c].Val1, S2[c].Val1);
+    EXPECT_EQ(TS[c].Val2, S2[c].Val2);
+    EXPECT_EQ(0, NullsV[c].Val);
+    if (S2[c].Val1 == "Val") {
+      EXPECT_EQ(MnVal, MnMxV[c].Val1.Val);
+      EXPECT_EQ(MxVal, MnMxV[c].Val2.Val);
+    }
+    if (S2[c].Val1 == "Wgt") { EXPECT_EQ(-5.0, MnMxV[c].Val1.Val); }
+  }
+
+  // an empty context takes the string column as a view
+  TTableContext Context2;
+  PTable T2 = TTable::LoadColBin("table/colbin.bin", &Context2);
+  ASSERT_EQ(T->GetNumValidRows(), T2->GetNumValidRows());
+  TRowIterator RI2 = T2->BegRI();
+  for (TRowIterator RI = T->BegRI(); RI < T->EndRI(); RI++, RI2++) {
+    EXPECT_EQ(RI.GetStrAttr("Name"), RI2.GetStrAttr("Name"));
+    EXPECT_EQ(RI.GetIntAttr("Val"), RI2.GetIntAttr("Val"));
+    EXPECT_EQ(RI.GetFltAttr("Wgt"), RI2.GetFltAttr("Wgt"));
+  }
+  T2->Order(OrderBy, "", false, false);
+  EXPECT_EQ(MxVal, T2->BegRI().GetIntAttr("Val").Val);
+}
+
+// Load a subset of the columns into a context with other strings
+TEST(TTable, ColBinProject) {
+  TTableContext Context;
+  PTable T = LoadColBinSS(&Context);
+  T->SelectAtomicConst("Val", TInt(0), GT);
+  EXPECT_TRUE(T->GetNumValidRows() < T->GetNumRows());
+  T->SaveColBin("table/colbin.bin");
+
+  TStrV Cols;
+  Cols.Add("Wgt");  Cols.Add("Name");
+  PTable T2 = TTable::LoadColBin("table/colbin.bin", &Context, Cols);
+  Schema S2 = T2->GetSchema();
+  ASSERT_EQ(2, S2.Len());
+  EXPECT_EQ(TStr("Wgt"), S2[0].Val1);
+  EXPECT_EQ(TStr("Name"), S2[1].Val1);
+  ASSERT_EQ(T->GetNumValidRows(), T2->GetNumValidRows());
+  TRowIterator RI2 = T2->BegRI();
+  for (TRowIterator RI = T->BegRI(); RI < T->EndRI(); RI++, RI2++) {
+    EXPECT_EQ(RI.GetStrAttr("Name"), RI2.GetStrAttr("Name"));
+    EXPECT_EQ(RI.GetFltAttr("Wgt"), RI2.GetFltAttr("Wgt"));
+  }
+
+  Cols.Add("Missing");
+  EXPECT_ANY_THROW(TTable::LoadColBin("table/colbin.bin", &Context, Cols));
+}
+
+// Writes Bf to FNm and checks that loading it as a columnar file throws
+static void CheckColBinThrow(const TMem& Bf, const int& BfL) {
+  {
+    TFOut FOut("table/colbin.bin");
+    FOut.PutBf(Bf(), BfL);
+  }
+  TTableContext Context;
+  EXPECT_ANY_THROW(TTable::LoadColBin("table/colbin.bin", &Context));
+}
+
+// Truncated files and offsets past the end of the file throw instead of crashing
+TEST(TTable, ColBinCorrupt) {
+  TTableContext Context;
+  PTable T = LoadColBinSS(&Context);
+  T->SaveColBin("table/colbin.bin");
+  TMem Bf;
+  TMem::LoadMem(TFIn::New("table/colbin.bin"), Bf);
+  // header: magic, version, rows, cols, then NameLen, name, type, offset of the first column
+  const int RowsPos = 12, OfsPos = 20 + 4 + 4 + 4;
+  ASSERT_EQ(4, *(int*) (Bf() + 20));
+  ASSERT_EQ(0, memcmp(Bf() + 24, "Name", 4));
+  // the column segments and the dictionary end at the end of the file
+  CheckColBinThrow(Bf, 10);
+  CheckColBinThrow(Bf, OfsPos + 4);
+  CheckColBinThrow(Bf, Bf.Len() / 2);
+  CheckColBinThrow(Bf, Bf.Len() - 1);
+  TMem BadBf = Bf;
+  *(int*) (BadBf() + RowsPos) = 4000;
+  CheckColBinThrow(BadBf, BadBf.Len());
+  BadBf = Bf;
+  *(int*) (BadBf() + RowsPos) = -1;
+  CheckColBinThrow(BadBf, BadBf.Len());
+  BadBf = Bf;
+  *(uint64*) (BadBf() + OfsPos) = uint64(1) << 62;
+  CheckColBinThrow(BadBf, BadBf.Len());
+  // a string rank outside of the dictionary
+  BadBf = Bf;
+  const uint64 Ofs = *(uint64*) (Bf() + OfsPos);
+  *(int*) (BadBf() + Ofs + 8) = 1000;
+  CheckColBinThrow(BadBf, BadBf.Len());
+  // the unchanged file still loads
+  {
+    TFOut FOut("table/colbin.bin");
+    FOut.PutBf(Bf(), Bf.Len());
+  }
+  TTableContext Context2;
+  PTable T2 = TTable::LoadColBin("table/colbin.bin", &Context2);
+  EXPECT_EQ(T->GetNumValidRows(), T2->GetNumValidRows());
+}
@@ -0,0 +1,105 @@
+#include <gtest/gtest.h>
+
+#include "Snap.h"
+
+class TZipInTest { };  // For gtest highlighting
+
+// extensions with an in-process codec in this build
+static void GetCodecExtV(TStrV& ExtV) {
+  const char* Ext[] = { ".gz", ".zlib", ".zst", ".lz4" };
+  for (int i = 0; i < 4; i++) {
+    if (TZipIn::IsCodecExt(Ext[i])) { ExtV.Add(Ext[i]); }
+  }
+}
+
+static void GetTestLnV(TStrV& LnV) {
+  TRnd Rnd(1);
+  for (int i = 0; i < 200000; i++) {
+    LnV.Add(TStr::Fmt("%d\t%d\t%s", i, Rnd.GetUniDevInt(1000000), i % 7 == 0 ? "" : "text"));
+  }
+}
+
+// Write lines through TZipOut and read them back with TZipIn
+TEST(TZipIn, RoundTrip) {
+  TStrV ExtV;  GetCodecExtV(ExtV);
+  TStrV LnV;  GetTestLnV(LnV);
+  for (int e = 0; e < ExtV.Len(); e++) {
+    const TStr FNm = "test-zipin" + ExtV[e];
+    uint64 FLen = 0;
+    {
+      PSOut SOut = TZipOut::New(FNm);
+      for (int i = 0; i < LnV.Len(); i++) {
+        SOut->PutStrLn(LnV[i]);  FLen += LnV[i].Len()+1; }
+    }
+    EXPECT_TRUE(TZipIn::IsZipFNm(FNm));
+    EXPECT_EQ(FLen, TZipIn::GetFLen(FNm));
+
+    PSIn SIn = TZipIn::New(FNm);
+    EXPECT_EQ((int) FLen, SIn->Len());
+    TChA LnChA;
+    int LnN = 0;
+    while (SIn->GetNextLnBf(LnChA)) {
+      ASSERT_TRUE(LnN < LnV.Len());
+      EXPECT_EQ(LnV[LnN], TStr(LnChA));
+      LnN++;
+    }
+    EXPECT_EQ(LnV.Len(), LnN);
+    EXPECT_TRUE(SIn->Eof());
+  }
+}
+
+// Concatenated gzip members read as one stream, truncated files fail
+TEST(TZipIn, GzipMembers) {
+  if (! TZipIn::IsCodecExt(".gz")) { return; }
+  TChA ChA;
+  for (int m = 0; m < 2; m++) {
+    {
+      PSOut SOut = TZipOut::New("test-zipin-member.gz");
+      SOut->PutStrLn(TStr::Fmt("member %d", m));
+    }
+    PSIn SIn = TFIn::New("test-zipin-member.gz");
+    while (! SIn->Eof()) { ChA += SIn->GetCh(); }
+  }
+  {
+    PSOut SOut = TFOut::New("test-zipin-members.gz");
+    SOut->PutBf(ChA.CStr(), ChA.Len());
+  }
+  PSIn SIn = TZipIn::New("test-zipin-members.gz");
+  TStr LnStr;
+  EXPECT_TRUE(SIn->GetNextLn(LnStr));
+  EXPECT_EQ(TStr("member 0"), LnStr);
+  EXPECT_TRUE(SIn->GetNextLn(LnStr));
+  EXPECT_EQ(TStr("member 1"), LnStr);
+  EXPECT_FALSE(SIn->GetNextLn(LnStr));
+
+  {
+    PSOut SOut = TFOut::New("test-zipin-truncated.gz");
+    SOut->PutBf(ChA.CStr(), ChA.Len()/2-4);
+  }
+  EXPECT_ANY_THROW({
+    PSIn SIn = TZipIn::New("test-zipin-truncated.gz");
+    while (SIn->GetNextLn(LnStr)) { }
+  });
+}
+
+// Load a compressed edge list
+TEST(TZipIn, LoadEdgeList) {
+  TStrV ExtV;  GetCodecExtV(ExtV);
+  PNGraph Graph = TSnap::GenRndGnm<PNGraph>(1000, 10000);
+  TSnap::SaveEdgeList(Graph, "test-zipin-edges.txt");
+  for (int e = 0; e < ExtV.Len(); e++) {
+    const TStr FNm = "test-zipin-edges" + ExtV[e];
+    {
+      PSIn SIn = TFIn::New("test-zipin-edges.txt");
+      PSOut SOut = TZipOut::New(FNm);
+      TChA LnChA;
+      while (SIn->GetNextLnBf(LnChA)) { SOut->PutStrLn(LnChA); }
+    }
+    PNGraph Graph2 = TSnap::LoadEdgeList<PNGraph>(FNm, 0, 1);
+    EXPECT_EQ(Graph->GetNodes(), Graph2->GetNodes());
+    EXPECT_EQ(Graph->GetEdges(), Graph2->GetEdges());
+    for (TNGraph::TEdgeI EI = Graph->BegEI(); EI < Graph->EndEI(); EI++) {
+      EXPECT_TRUE(Graph2->IsEdge(EI.GetSrcNId(), EI.GetDstNId()));
+    }
+  }
+}
@@ -0,0 +1,447 @@
+#include <gtest/gtest.h>
+
+#include "Snap.h"
+#include "agmfast.h"
+#include "agmdirected.h"
+
+// Reference BigCLAM likelihood, gradient and gradient ascent over hash table
+// memberships, as computed before TAGMMembV. The state is read from a saved
+// TAGMFast, which keeps the memberships as hash tables.
+class TRefBigClam {
+public:
+  PUNGraph G;
+  TVec<TIntFltH> F;
+  TFltV SumFV;
+  TVec<TIntSet> HOVIDSV;
+  TFlt RegCoef, MinVal, MaxVal, NegWgt, PNoCom;
+  TInt NumComs;
+  TRnd Rnd;
+public:
+  TRefBigClam(TSIn& SIn, const int& RndSeed) : Rnd(RndSeed) {
+    G = TUNGraph::Load(SIn);
+    F.Load(SIn);
+    TIntV NIDV(SIn);
+    RegCoef.Load(SIn);
+    SumFV.Load(SIn);
+    TBool NodesOk(SIn);
+    MinVal.Load(SIn);  MaxVal.Load(SIn);  NegWgt.Load(SIn);
+    NumComs.Load(SIn);
+    HOVIDSV.Load(SIn);
+    PNoCom.Load(SIn);
+  }
+  double GetCom(const int& NID, const int& CID) const {
+    return F[NID].IsKey(CID) ? F[NID].GetDat(CID).Val : 0.0; }
+  void AddCom(const int& NID, const int& CID, const double& Val) {
+    SumFV[CID] += Val - GetCom(NID, CID);
+    F[NID].AddDat(CID) = Val;
+  }
+  void DelCom(const int& NID, const int& CID) {
+    if (F[NID].IsKey(CID)) { SumFV[CID] -= F[NID].GetDat(CID);  F[NID].DelKey(CID); }
+  }
+  static double DotProduct(const TIntFltH& UV, const TIntFltH& VV) {
+    double DP = 0;
+    for (TIntFltH::TIter HI = UV.BegI(); HI < UV.EndI(); HI++) {
+      if (VV.IsKey(HI.GetKey())) { DP += VV.GetDat(HI.GetKey()) * HI.GetDat(); }
+    }
+    return DP;
+  }
+  double Prediction(const TIntFltH& FU, const TIntFltH& FV) const {
+    return exp(- (log(1.0 / (1.0 - PNoCom)) + DotProduct(FU, FV)));
+  }
+  static double Sum(const TIntFltH& UV) {
+    double N = 0.0;
+    for (TIntFltH::TIter HI = UV.BegI(); HI < UV.EndI(); HI++) { N += HI.GetDat(); }
+    return N;
+  }
+  static double Norm2(const TIntFltH& UV) {
+    double N = 0.0;
+    for (TIntFltH::TIter HI = UV.BegI(); HI < UV.EndI(); HI++) { N += HI.GetDat() * HI.GetDat(); }
+    return N;
+  }
+  void GetHoldOutSumFV(const int& UID, TFltV& HOSumFV) const {
+    HOSumFV.Gen(SumFV.Len());
+    for (int e = 0; e < HOVIDSV[UID].Len(); e++) {
+      for (int c = 0; c < SumFV.Len(); c++) { HOSumFV[c] += GetCom(HOVIDSV[UID][e], c); }
+    }
+  }
+  double LikelihoodForRow(const int& UID, const TIntFltH& FU) const {
+    double L = 0.0;
+    TFltV HOSumFV;
+    GetHoldOutSumFV(UID, HOSumFV);
+    TUNGraph::TNodeI NI = G->GetNI(UID);
+    for (int e = 0; e < NI.GetDeg(); e++) {
+      const int v = NI.GetNbrNId(e);
+      if (v == UID || HOVIDSV[UID].IsKey(v)) { continue; }
+      L += log(1.0 - Prediction(FU, F[v])) + NegWgt * DotProduct(FU, F[v]);
+    }
+    for (TIntFltH::TIter HI = FU.BegI(); HI < FU.EndI(); HI++) {
+      L -= NegWgt * (SumFV[HI.GetKey()] - HOSumFV[HI.GetKey()] - GetCom(UID, HI.GetKey())) * HI.GetDat();
+    }
+    if (RegCoef > 0.0) { L -= RegCoef * Sum(FU); }
+    if (RegCoef < 0.0) { L += RegCoef * Norm2(FU); }
+    return L;
+  }
+  double Likelihood() const {
+    double L = 0.0;
+    for (int u = 0; u < F.Len(); u++) { L += LikelihoodForRow(u, F[u]); }
+    return L;
+  }
+  void GradientForRow(const int& UID, TIntFltH& GradU, const TIntSet& CIDSet) const {
+    GradU.Gen(CIDSet.Len());
+    TFltV HOSumFV;
+    GetHoldOutSumFV(UID, HOSumFV);
+    TUNGraph::TNodeI NI = G->GetNI(UID);
+    TFltV PredV(NI.GetDeg());
+    for (int e = 0; e < NI.GetDeg(); e++) {
+      const int VID = NI.GetNbrNId(e);
+      if (VID == UID || HOVIDSV[UID].IsKey(VID)) { continue; }
+      PredV[e] = Prediction(F[UID], F[VID]);
+    }
+    for (int c = 0; c < CIDSet.Len(); c++) {
+      const int CID = CIDSet.GetKey(c);
+      double Val = 0.0;
+      for (int e = 0; e < NI.GetDeg(); e++) {
+        const int VID = NI.GetNbrNId(e);
+        if (VID == UID || HOVIDSV[UID].IsKey(VID)) { continue; }
+        Val += PredV[e] * GetCom(VID, CID) / (1.0 - PredV[e]) + NegWgt * GetCom(VID, CID);
+      }
+      Val -= NegWgt * (SumFV[CID] - HOSumFV[CID] - GetCom(UID, CID));
+      if (RegCoef > 0.0) { Val -= RegCoef; }
+      if (RegCoef < 0.0) { Val += 2 * RegCoef * GetCom(UID, CID); }
+      if (GetCom(UID, CID) == 0.0 && Val < 0.0) { continue; }
+      if (fabs(Val) < 0.0001) { continue; }
+      GradU.AddDat(CID, TMath::Mx(TMath::Mn(Val, 10.0), -10.0));
+    }
+  }
+  double GetStepSizeByLineSearch(const int& UID, const TIntFltH& GradV, const double& Alpha, const double& Beta) const {
+    const int MaxIter = 10;
+    double StepSize = 1.0;
+    const double InitLikelihood = LikelihoodForRow(UID, F[UID]);
+    TIntFltH NewVarV(GradV.Len());
+    for (int iter = 0; iter < MaxIter; iter++) {
+      for (int i = 0; i < GradV.Len(); i++) {
+        const int CID = GradV.GetKey(i);
+        const double NewVal = TMath::Mx(TMath::Mn(GetCom(UID, CID) + StepSize * GradV[i], MaxVal.Val), MinVal.Val);
+        NewVarV.AddDat(CID, NewVal);
+      }
+      if (LikelihoodForRow(UID, NewVarV) >= InitLikelihood + Alpha * StepSize * DotProduct(GradV, GradV)) { break; }
+      StepSize *= Beta;
+      if (iter == MaxIter - 1) { StepSize = 0.0; }
+    }
+    return StepSize;
+  }
+  void MLEGradAscent(const int& MaxIter, const double& StepAlpha, const double& StepBeta) {
+    TIntV NIdxV(F.Len(), 0);
+    for (int i = 0; i < F.Len(); i++) { NIdxV.Add(i); }
+    TIntFltH GradV;
+    for (int iter = 0; iter < MaxIter; ) {
+      NIdxV.Shuffle(Rnd);
+      for (int ui = 0; ui < F.Len(); ui++, iter++) {
+        const int u = NIdxV[ui];
+        TUNGraph::TNodeI UI = G->GetNI(u);
+        TIntSet CIDSet;
+        for (int e = 0; e < UI.GetDeg(); e++) {
+          if (HOVIDSV[u].IsKey(UI.GetNbrNId(e))) { continue; }
+          const TIntFltH& NbhCIDH = F[UI.GetNbrNId(e)];
+          for (TIntFltH::TIter CI = NbhCIDH.BegI(); CI < NbhCIDH.EndI(); CI++) { CIDSet.AddKey(CI.GetKey()); }
+        }
+        TIntV CIDV;
+        F[u].GetKeyV(CIDV);
+        for (int c = 0; c < CIDV.Len(); c++) {
+          if (! CIDSet.IsKey(CIDV[c])) { DelCom(u, CIDV[c]); } }
+        if (CIDSet.Empty()) { continue; }
+        GradientForRow(u, GradV, CIDSet);
+        if (Norm2(GradV) < 1e-4) { continue; }
+        const double LearnRate = GetStepSizeByLineSearch(u, GradV, StepAlpha, StepBeta);
+        if (LearnRate == 0.0) { continue; }
+        for (int ci = 0; ci < GradV.Len(); ci++) {
+          const int CID = GradV.GetKey(ci);
+          const double NewFuc = GetCom(u, CID) + LearnRate * GradV[ci];
+          if (NewFuc <= 0.0) { DelCom(u, CID); } else { AddCom(u, CID, NewFuc); }
+        }
+      }
+    }
+  }
+};
+
+// Reference Coda over hash table memberships, read from a saved TCoda
+class TRefCoda {
+public:
+  PNGraph G;
+  TVec<TIntFltH> F, H;
+  TFltV SumFV, SumHV;
+  TVec<TIntSet> HOVIDSV;
+  TFlt RegCoef, MinVal, MaxVal, NegWgt, PNoCom;
+  TInt NumComs;
+  TRnd Rnd;
+public:
+  TRefCoda(TSIn& SIn, const int& RndSeed) : Rnd(RndSeed) {
+    G = TNGraph::Load(SIn);
+    F.Load(SIn);  H.Load(SIn);
+    TIntV NIDV(SIn);
+    RegCoef.Load(SIn);
+    SumFV.Load(SIn);  SumHV.Load(SIn);
+    TBool NodesOk(SIn);
+    MinVal.Load(SIn);  MaxVal.Load(SIn);  NegWgt.Load(SIn);
+    NumComs.Load(SIn);
+    HOVIDSV.Load(SIn);
+    PNoCom.Load(SIn);
+  }
+  TIntFltH& GetMemb(const bool& IsOut, const int& NID) { return IsOut ? F[NID] : H[NID]; }
+  const TIntFltH& GetMemb(const bool& IsOut, const int& NID) const { return IsOut ? F[NID] : H[NID]; }
+  double GetCom(const bool& IsOut, const int& NID, const int& CID) const {
+    const TIntFltH& MembH = GetMemb(IsOut, NID);
+    return MembH.IsKey(CID) ? MembH.GetDat(CID).Val : 0.0;
+  }
+  double GetSumVal(const bool& IsOut, const int& CID) const { return IsOut ? SumFV[CID] : SumHV[CID]; }
+  void AddCom(const bool& IsOut, const int& NID, const int& CID, const double& Val) {
+    (IsOut ? SumFV : SumHV)[CID] += Val - GetCom(IsOut, NID, CID);
+    GetMemb(IsOut, NID).AddDat(CID) = Val;
+  }
+  void DelCom(const bool& IsOut, const int& NID, const int& CID) {
+    TIntFltH& MembH = GetMemb(IsOut, NID);
+    if (MembH.IsKey(CID)) { (IsOut ? SumFV : SumHV)[CID] -= MembH.GetDat(CID);  MembH.DelKey(CID); }
+  }
+  double Prediction(const TIntFltH& FU, const TIntFltH& HV) const {
+    return exp(- (log(1.0 / (1.0 - PNoCom)) + TRefBigClam::DotProduct(FU, HV)));
+  }
+  void GetHoldOutSumV(const bool& IsRow, const int& UID, TFltV& HOSumV) const {
+    HOSumV.Gen(NumComs);
+    for (int e = 0; e < HOVIDSV[UID].Len(); e++) {
+      for (int c = 0; c < SumHV.Len(); c++) { HOSumV[c] += GetCom(! IsRow, HOVIDSV[UID][e], c); }
+    }
+  }
+  double LikelihoodForNode(const bool& IsRow, const int& UID, const TIntFltH& FU) const {
+    double L = 0.0;
+    TFltV HOSumV;
+    GetHoldOutSumV(IsRow, UID, HOSumV);
+    TNGraph::TNodeI NI = G->GetNI(UID);
+    const int Deg = IsRow ? NI.GetOutDeg() : NI.GetInDeg();
+    for (int e = 0; e < Deg; e++) {
+      const int v = IsRow ? NI.GetOutNId(e) : NI.GetInNId(e);
+      if (v == UID || HOVIDSV[UID].IsKey(v)) { continue; }
+      const double DP = TRefBigClam::DotProduct(FU, IsRow ? H[v] : F[v]);
+      L += log(1.0 - Prediction(FU, IsRow ? H[v] : F[v])) + NegWgt * DP;
+    }
+    for (TIntFltH::TIter HI = FU.BegI(); HI < FU.EndI(); HI++) {
+      L -= NegWgt * (GetSumVal(! IsRow, HI.GetKey()) - HOSumV[HI.GetKey()] - GetCom(! IsRow, UID, HI.GetKey())) * HI.GetDat();
+    }
+    if (RegCoef > 0.0) { L -= RegCoef * TRefBigClam::Sum(FU); }
+    if (RegCoef < 0.0) { L += RegCoef * TRefBigClam::Norm2(FU); }
+    return L;
+  }
+  double Likelihood() const {
+    double L = 0.0;
+    for (int u = 0; u < F.Len(); u++) { L += LikelihoodForNode(true, u, F[u]); }
+    return L;
+  }
+  void GradientForNode(const bool& IsRow, const int& UID, TIntFltH& GradU, const TIntSet& CIDSet) const {
+    GradU.Gen(CIDSet.Len());
+    TFltV HOSumV;
+    GetHoldOutSumV(IsRow, UID, HOSumV);
+    TNGraph::TNodeI NI = G->GetNI(UID);
+    const int Deg = IsRow ? NI.GetOutDeg() : NI.GetInDeg();
+    TFltV PredV(Deg);
+    for (int e = 0; e < Deg; e++) {
+      const int VID = IsRow ? NI.GetOutNId(e) : NI.GetInNId(e);
+      if (VID == UID || HOVIDSV[UID].IsKey(VID)) { continue; }
+      PredV[e] = IsRow ? Prediction(F[UID], H[VID]) : Prediction(F[VID], H[UID]);
+    }
+    for (int c = 0; c < CIDSet.Len(); c++) {
+      const int CID = CIDSet.GetKey(c);
+      double Val = 0.0;
+      for (int e = 0; e < Deg; e++) {
+        const int VID = IsRow ? NI.GetOutNId(e) : NI.GetInNId(e);
+        if (VID == UID || HOVIDSV[UID].IsKey(VID)) { continue; }
+        Val += PredV[e] * GetCom(! IsRow, VID, CID) / (1.0 - PredV[e]) + NegWgt * GetCom(! IsRow, VID, CID);
+      }
+      Val -= NegWgt * (GetSumVal(! IsRow, CID) - HOSumV[CID] - GetCom(! IsRow, UID, CID));
+      if (RegCoef > 0.0) { Val -= RegCoef; }
+      if (RegCoef < 0.0) { Val += 2 * RegCoef * GetCom(IsRow, UID, CID); }
+      if (GetCom(IsRow, UID, CID) == 0.0 && Val < 0.0) { continue; }
+      if (fabs(Val) < 0.0001) { continue; }
+      GradU.AddDat(CID, TMath::Mx(TMath::Mn(Val, 10.0), -10.0));
+    }
+  }
+  double GetStepSizeByLineSearch(const bool& IsRow, const int& UID, const TIntFltH& GradV, const double& Alpha, const double& Beta) const {
+    const int MaxIter = 10;
+    double StepSize = 1.0;
+    const double InitLikelihood = LikelihoodForNode(IsRow, UID, GetMemb(IsRow, UID));
+    TIntFltH NewVarV(GradV.Len());
+    for (int iter = 0; iter < MaxIter; iter++) {
+      for (int i = 0; i < GradV.Len(); i++) {
+        const int CID = GradV.GetKey(i);
+        const double NewVal = TMath::Mx(TMath::Mn(GetCom(IsRow, UID, CID) + StepSize * GradV[i], MaxVal.Val), MinVal.Val);
+        NewVarV.AddDat(CID, NewVal);
+      }
+      if (LikelihoodForNode(IsRow, UID, NewVarV) >= InitLikelihood + Alpha * StepSize * TRefBigClam::DotProduct(GradV, GradV)) { break; }
+      StepSize *= Beta;
+      if (iter == MaxIter - 1) { StepSize = 0.0; }
+    }
+    return StepSize;
+  }
+  void MLEGradAscent(const int& MaxIter, const double& StepAlpha, const double& StepBeta) {
+    TIntV NIdxV(F.Len(), 0);
+    for (int i = 0; i < F.Len(); i++) { NIdxV.Add(i); }
+    TIntFltH GradV;
+    for (int iter = 0; iter < MaxIter; ) {
+      NIdxV.Shuffle(Rnd);
+      for (int ui = 0; ui < F.Len(); ui++, iter++) {
+        const bool IsRow = ui % 2 == 0;
+        const int u = NIdxV[ui];
+        TNGraph::TNodeI UI = G->GetNI(u);
+        const int Deg = IsRow ? UI.GetOutDeg() : UI.GetInDeg();
+        TIntSet CIDSet;
+        for (int e = 0; e < Deg; e++) {
+          const int VID = IsRow ? UI.GetOutNId(e) : UI.GetInNId(e);
+          if (HOVIDSV[u].IsKey(VID)) { continue; }
+          const TIntFltH& NbhCIDH = GetMemb(! IsRow, VID);
+          for (TIntFltH::TIter CI = NbhCIDH.BegI(); CI < NbhCIDH.EndI(); CI++) { CIDSet.AddKey(CI.GetKey()); }
+        }
+        TIntV CIDV;
+        GetMemb(IsRow, u).GetKeyV(CIDV);
+        for (int c = 0; c < CIDV.Len(); c++) {
+          if (! CIDSet.IsKey(CIDV[c])) { DelCom(IsRow, u, CIDV[c]); } }
+        if (CIDSet.Empty()) { continue; }
+        GradientForNode(IsRow, u, GradV, CIDSet);
+        if (TRefBigClam::Norm2(GradV) < 1e-4) { continue; }
+        const double LearnRate = GetStepSizeByLineSearch(IsRow, u, GradV, StepAlpha, StepBeta);
+        if (LearnRate == 0.0) { continue; }
+        for (int ci = 0; ci < GradV.Len(); ci++) {
+          const int CID = GradV.GetKey(ci);
+          const double NewFuc = GetCom(IsRow, u, CID) + LearnRate * GradV[ci];
+          if (NewFuc <= 0.0) { DelCom(IsRow, u, CID); } else { AddCom(IsRow, u, CID, NewFuc); }
+        }
+      }
+    }
+  }
+};
+
+// Compares two gradients, which must have the same communities
+void CheckGrad(const TIntFltH& GradH, const TIntFltH& RefGradH) {
+  ASSERT_EQ(RefGradH.Len(), GradH.Len());
+  for (int c = 0; c < RefGradH.Len(); c++) {
+    const int CID = RefGradH.GetKey(c);
+    ASSERT_TRUE(GradH.IsKey(CID));
+    EXPECT_NEAR(RefGradH[c].Val, GradH.GetDat(CID).Val, 1e-9 * (1.0 + fabs(RefGradH[c].Val)));
+  }
+}
+
+// Graph with overlapping planted communities, so that nodes have up to 10
+// memberships and many of them more than TAGMMembV keeps inline
+template <class PGraph>
+PGraph GenAgmTestGraph(const int& Nodes, const int& Coms, const double& Prob) {
+  TRnd Rnd(1);
+  PGraph Graph = PGraph::TObj::New();
+  for (int n = 0; n < Nodes; n++) { Graph->AddNode(n); }
+  for (int c = 0; c < Coms; c++) {
+    TIntV CmtyV;
+    for (int n = 0; n < Nodes-1; n++) {
+      if (Rnd.GetUniDev() < 3.0 / Coms) { CmtyV.Add(n); } }
+    for (int i = 0; i < CmtyV.Len(); i++) {
+      for (int j = 0; j < CmtyV.Len(); j++) {
+        if (i != j && Rnd.GetUniDev() < Prob) { Graph->AddEdge(CmtyV[i], CmtyV[j]); } }
+    }
+  }
+  // a few random edges, node Nodes-1 stays isolated
+  for (int e = 0; e < Nodes; e++) {
+    const int Src = Rnd.GetUniDevInt(Nodes-1), Dst = Rnd.GetUniDevInt(Nodes-1);
+    if (Src != Dst) { Graph->AddEdge(Src, Dst); }
+  }
+  return Graph;
+}
+
+// BigCLAM likelihood, gradients and gradient ascent match the hash table computation
+TEST(agm, BigClamHashMemberships) {
+  const int Nodes = 80, Coms = 12;
+  PUNGraph Graph = GenAgmTestGraph<PUNGraph>(Nodes, Coms, 0.3);
+  const double RegCoefV[] = {0.0, 0.05, -0.05};
+  for (int r = 0; r < 3; r++) {
+    TAGMFast Model(Graph, Coms, 10+r);
+    Model.SetRegCoef(RegCoefV[r]);
+    // hold out a few edges and non-edges
+    TRnd Rnd(2);
+    for (int h = 0; h < 40; h++) {
+      const int u = Rnd.GetUniDevInt(Nodes), v = Rnd.GetUniDevInt(Nodes);
+      if (u == v) { continue; }
+      Model.HOVIDSV[u].AddKey(v);  Model.HOVIDSV[v].AddKey(u);
+    }
+    TMOut MOut;
+    Model.Save(MOut);
+    TRefBigClam Ref(*MOut.GetSIn(false), 5);
+    Model.Load(*MOut.GetSIn(false), 5);
+
+    const double RefL = Ref.Likelihood();
+    EXPECT_NEAR(RefL, Model.Likelihood(), 1e-9 * fabs(RefL));
+    EXPECT_NEAR(RefL, Model.Likelihood(true), 1e-9 * fabs(RefL));
+    int Grads = 0;
+    for (int u = 0; u < Nodes; u++) {
+      TIntSet CIDSet;
+      for (int c = 0; c < Coms; c++) {
+        if (c % 3 == u % 3 || Ref.F[u].IsKey(c)) { CIDSet.AddKey(c); } }
+      TIntFltH GradH, RefGradH;
+      Model.GradientForRow(u, GradH, CIDSet);
+      Ref.GradientForRow(u, RefGradH, CIDSet);
+      CheckGrad(GradH, RefGradH);
+      Grads += RefGradH.Len();
+    }
+    EXPECT_LT(Nodes, Grads);
+
+    Model.MLEGradAscent(0.0001, 3*Nodes, TStr());
+    Ref.MLEGradAscent(3*Nodes, 0.3, 0.1);
+    for (int u = 0; u < Nodes; u++) {
+      for (int c = 0; c < Coms; c++) {
+        EXPECT_NEAR(Ref.GetCom(u, c), Model.GetCom(u, c), 1e-8 * (1.0 + Ref.GetCom(u, c)));
+      }
+    }
+    const double RefMLEL = Ref.Likelihood();
+    EXPECT_GT(RefMLEL, RefL);
+    EXPECT_NEAR(RefMLEL, Model.Likelihood(), 1e-9 * fabs(RefMLEL));
+  }
+}
+
+// Coda likelihood, gradients and gradient ascent match the hash table computation
+TEST(agm, CodaHashMemberships) {
+  const int Nodes = 80, Coms = 12;
+  PNGraph Graph = GenAgmTestGraph<PNGraph>(Nodes, Coms, 0.15);
+  const double RegCoefV[] = {0.0, 0.05, -0.05};
+  for (int r = 0; r < 3; r++) {
+    TCoda Model(Graph, Coms, 10+r);
+    Model.SetRegCoef(RegCoefV[r]);
+    Model.SetHoldOut(0.05);
+    TMOut MOut;
+    Model.Save(MOut);
+    TRefCoda Ref(*MOut.GetSIn(false), 5);
+    Model.Load(*MOut.GetSIn(false), 5);
+
+    const double RefL = Ref.Likelihood();
+    EXPECT_NEAR(RefL, Model.Likelihood(), 1e-9 * fabs(RefL));
+    EXPECT_NEAR(RefL, Model.Likelihood(true), 1e-9 * fabs(RefL));
+    int Grads = 0;
+    for (int u = 0; u < Nodes; u++) {
+      for (int IsRow = 0; IsRow < 2; IsRow++) {
+        TIntSet CIDSet;
+        for (int c = 0; c < Coms; c++) {
+          if (c % 3 == u % 3 || Ref.GetMemb(IsRow, u).IsKey(c)) { CIDSet.AddKey(c); } }
+        TIntFltH GradH, RefGradH;
+        Model.GradientForNode(IsRow, u, GradH, CIDSet);
+        Ref.GradientForNode(IsRow, u, RefGradH, CIDSet);
+        CheckGrad(GradH, RefGradH);
+        Grads += RefGradH.Len();
+      }
+    }
+    EXPECT_LT(Nodes, Grads);
+
+    Model.MLEGradAscent(0.0001, 3*Nodes, TStr());
+    Ref.MLEGradAscent(3*Nodes, 0.3, 0.1);
+    for (int u = 0; u < Nodes; u++) {
+      for (int c = 0; c < Coms; c++) {
+        EXPECT_NEAR(Ref.GetCom(true, u, c), Model.GetComOut(u, c), 1e-8 * (1.0 + Ref.GetCom(true, u, c)));
+        EXPECT_NEAR(Ref.GetCom(false, u, c), Model.GetComIn(u, c), 1e-8 * (1.0 + Ref.GetCom(false, u, c)));
+      }
+    }
+    const double RefMLEL = Ref.Likelihood();
+    EXPECT_GT(RefMLEL, RefL);
+    EXPECT_NEAR(RefMLEL, Model.Likelihood(), 1e-9 * fabs(RefMLEL));
+  }
+}
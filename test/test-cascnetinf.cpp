@@ -0,0 +1,81 @@
+#include <gtest/gtest.h>
+
+#include "Snap.h"
+#include "cascnetinf.h"
+
+// Adds to NIB cascades spreading over a random ground truth network
+void GenNetInfCascades(TNetInfBs& NIB, const int& Cascs) {
+  TRnd Rnd(1);
+  TInt::Rnd.PutSeed(1);
+  TFlt::Rnd.PutSeed(1);
+  NIB.GroundTruth = TSnap::GenRndGnm<PNGraph>(40, 160, true, Rnd);
+  for (TNGraph::TEdgeI EI = NIB.GroundTruth->BegEI(); EI < NIB.GroundTruth->EndEI(); EI++) {
+    const TIntPr Edge(EI.GetSrcNId(), EI.GetDstNId());
+    NIB.Alphas.AddDat(Edge, 0.5 + Rnd.GetUniDev());
+    NIB.Betas.AddDat(Edge, 0.5);
+  }
+  TIntPrIntH EdgesUsed;
+  for (int c = 0; c < Cascs; c++) {
+    TCascade C(1.0, 0);
+    NIB.GenCascade(C, 0, 10.0, EdgesUsed, 1.0);
+    NIB.AddCasc(C);
+  }
+}
+
+// Plain greedy of GetBestEdge(), as GreedyOpt() ran before the lazy greedy
+void GetGreedyEdges(TNetInfBs& NIB, const int& MxEdges, TIntPrV& EdgeV, TFltV& GainV) {
+  NIB.Init();
+  double CurProb = NIB.GetAllCascProb(-1, -1);
+  double LastGain = TFlt::Mx;
+  int Attempts = 0;
+  bool MSort = false;
+  for (int k = 0; k < MxEdges && NIB.EdgeGainV.Len() > 0; k++) {
+    const TIntPr BestE = NIB.GetBestEdge(CurProb, LastGain, MSort, Attempts);
+    if (BestE == TIntPr(-1, -1)) { break; }
+    NIB.Graph->AddEdge(BestE.Val1, BestE.Val2);
+    TIntV& CascsEdge = NIB.CascPerEdge.GetDat(BestE);
+    for (int c = 0; c < CascsEdge.Len(); c++) {
+      NIB.CascV[CascsEdge[c]].UpdateProb(BestE.Val1, BestE.Val2, true); }
+    EdgeV.Add(BestE);
+    GainV.Add(LastGain);
+  }
+}
+
+// Lazy greedy of GreedyOpt() with the given number of threads
+void GetLazyGreedyEdges(TNetInfBs& NIB, const int& MxEdges, const int& Threads, TIntPrV& EdgeV, TFltV& GainV) {
+#ifdef USE_OPENMP
+  const int MxThreads = omp_get_max_threads();
+  omp_set_num_threads(Threads);
+#endif
+  NIB.Init();
+  NIB.EdgeInfoH.Clr();
+  NIB.GreedyOpt(MxEdges);
+#ifdef USE_OPENMP
+  omp_set_num_threads(MxThreads);
+#endif
+  for (int i = 0; i < NIB.EdgeInfoH.Len(); i++) {
+    EdgeV.Add(NIB.EdgeInfoH.GetKey(i));
+    GainV.Add(NIB.EdgeInfoH[i].MarginalGain);
+  }
+}
+
+// The lazy greedy picks the same edges with the same gains as the plain greedy
+TEST(cascnetinf, GreedyOpt) {
+  const int MxEdges = 120;
+  TNetInfBs GreedyNIB, LazyNIB;
+  GenNetInfCascades(GreedyNIB, 300);
+  GenNetInfCascades(LazyNIB, 300);
+  TIntPrV EdgeV, EdgeV1, EdgeV4;
+  TFltV GainV, GainV1, GainV4;
+  GetGreedyEdges(GreedyNIB, MxEdges, EdgeV, GainV);
+  GetLazyGreedyEdges(LazyNIB, MxEdges, 1, EdgeV1, GainV1);
+  GetLazyGreedyEdges(LazyNIB, MxEdges, 4, EdgeV4, GainV4);
+  EXPECT_EQ(MxEdges, EdgeV.Len());
+  EXPECT_TRUE(EdgeV == EdgeV1);
+  EXPECT_TRUE(EdgeV1 == EdgeV4);
+  EXPECT_TRUE(GainV1 == GainV4);
+  ASSERT_EQ(GainV.Len(), GainV1.Len());
+  for (int i = 0; i < GainV.Len(); i++) {
+    EXPECT_NEAR(GainV[i], GainV1[i], 1e-8 * TFlt::Abs(GainV[i]));
+  }
+}
@@ -0,0 +1,60 @@
+#include <gtest/gtest.h>
+
+#include "Snap.h"
+#include "cliques.h"
+
+// Sorts the nodes of each clique and then the cliques
+void SortCliques(TVec<TIntV>& CliqueVV) {
+  for (int c = 0; c < CliqueVV.Len(); c++) { CliqueVV[c].Sort(); }
+  CliqueVV.Sort();
+}
+
+// Parallel maximal cliques are the same as the sequential ones, for 1 and 4 threads
+TEST(cliques, GetMaxCliquesMP) {
+  const int MinSizeV[] = { 1, 3, 5 };
+#ifdef USE_OPENMP
+  const int Threads = omp_get_max_threads();
+#endif
+  for (int g = 0; g < 6; g++) {
+    TRnd Rnd(g + 1);
+    PUNGraph Graph = TSnap::GenRndGnm<PUNGraph>(100 + 50*g, 500 + 500*g, false, Rnd);
+    // planted cliques overlapping the random edges and an isolated node
+    for (int k = 0; k < 3; k++) {
+      const int Start = Rnd.GetUniDevInt(Graph->GetNodes() - 8);
+      for (int i = Start; i < Start + 5 + k; i++) {
+        for (int j = i + 1; j < Start + 5 + k; j++) {
+          if (! Graph->IsEdge(i, j)) { Graph->AddEdge(i, j); }
+        }
+      }
+    }
+    Graph->AddNode(Graph->GetMxNId());
+    for (int m = 0; m < 3; m++) {
+      TVec<TIntV> ExpCliqueVV, CliqueVV1, CliqueVV4;
+      TCliqueOverlap::GetMaxCliques(Graph, MinSizeV[m], ExpCliqueVV);
+      SortCliques(ExpCliqueVV);
+#ifdef USE_OPENMP
+      omp_set_num_threads(1);
+#endif
+      TCliqueOverlap::GetMaxCliquesMP(Graph, MinSizeV[m], CliqueVV1);
+#ifdef USE_OPENMP
+      omp_set_num_threads(4);
+#endif
+      TCliqueOverlap::GetMaxCliquesMP(Graph, MinSizeV[m], CliqueVV4);
+#ifdef USE_OPENMP
+      omp_set_num_threads(Threads);
+#endif
+      SortCliques(CliqueVV1);
+      SortCliques(CliqueVV4);
+      EXPECT_LT(0, ExpCliqueVV.Len());
+      EXPECT_TRUE(ExpCliqueVV == CliqueVV1);
+      EXPECT_TRUE(ExpCliqueVV == CliqueVV4);
+    }
+    // self-loops do not change the cliques, the sequential search drops
+    // the looped node altogether so it is compared with the loop-free graph
+    TVec<TIntV> ExpCliqueVV, CliqueVV;
+    TCliqueOverlap::GetMaxCliquesMP(Graph, 1, ExpCliqueVV);
+    Graph->AddEdge(0, 0);
+    TCliqueOverlap::GetMaxCliquesMP(Graph, 1, CliqueVV);
+    EXPECT_TRUE(ExpCliqueVV == CliqueVV);
+  }
+}
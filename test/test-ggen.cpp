@@ -888,6 +888,176 @@ TEST(GGenTest, GenRMat) {
   } // end loop - NNodes
 }
 
+// Returns true if two graphs have identical node and edge lists
+template <class PGraph> bool IsSameGraph(const PGraph& Graph1, const PGraph& Graph2) {
+  TIntPrV EdgeV1, EdgeV2;
+  for (typename PGraph::TObj::TEdgeI EI = Graph1->BegEI(); EI < Graph1->EndEI(); EI++) {
+    EdgeV1.Add(TIntPr(EI.GetSrcNId(), EI.GetDstNId())); }
+  for (typename PGraph::TObj::TEdgeI EI = Graph2->BegEI(); EI < Graph2->EndEI(); EI++) {
+    EdgeV2.Add(TIntPr(EI.GetSrcNId(), EI.GetDstNId())); }
+  return Graph1->GetNodes() == Graph2->GetNodes() && EdgeV1 == EdgeV2;
+}
+
+// Test parallel generators: exact sizes and independence of the number of threads
+TEST(GGenTest, GenRndGnmMP) {
+  for (int NNodes = 2; NNodes < 30; NNodes++) {
+    for (int NEdges = 0; NEdges < 50 && NEdges <= NNodes*(NNodes-1)/2; NEdges++) {
+      PUNGraph UNGraph = TSnap::GenRndGnmMP<PUNGraph>(NNodes, NEdges, false, NNodes);
+      EXPECT_TRUE(UNGraph->IsOk());
+      EXPECT_EQ(NNodes, UNGraph->GetNodes());
+      EXPECT_EQ(NEdges, UNGraph->GetEdges());
+      EXPECT_EQ(0, TSnap::CntSelfEdges(UNGraph));
+
+      PNGraph NGraph = TSnap::GenRndGnmMP<PNGraph>(NNodes, NEdges, true, NNodes);
+      EXPECT_TRUE(NGraph->IsOk());
+      EXPECT_EQ(NNodes, NGraph->GetNodes());
+      EXPECT_EQ(NEdges, NGraph->GetEdges());
+
+      NGraph = TSnap::GenRndGnmMP<PNGraph>(NNodes, NEdges, false, NNodes);
+      EXPECT_TRUE(NGraph->IsOk());
+      EXPECT_EQ(2*NEdges, NGraph->GetEdges());
+    }
+  }
+}
+
+TEST(GGenTest, GenMPThreads) {
+  TIntV DegSeqV;
+  for (int n = 0; n < 1000; n++) { DegSeqV.Add(1 + n % 7); }
+#ifdef USE_OPENMP
+  const int Threads = omp_get_max_threads();
+  omp_set_num_threads(1);
+#endif
+  PUNGraph Gnm1 = TSnap::GenRndGnmMP<PUNGraph>(1000, 5000, false, 7);
+  PNGraph RMat1 = TSnap::GenRMatMP(1024, 5000, 0.45, 0.15, 0.15, 7);
+  PUNGraph PrefAttach1 = TSnap::GenPrefAttachMP(1000, 3, 7);
+  PUNGraph SmallWorld1 = TSnap::GenSmallWorldMP(1000, 3, 0.1, 7);
+  PUNGraph ConfModel1 = TSnap::GenConfModelMP(DegSeqV, 7);
+#ifdef USE_OPENMP
+  omp_set_num_threads(4);
+#endif
+  PUNGraph Gnm4 = TSnap::GenRndGnmMP<PUNGraph>(1000, 5000, false, 7);
+  PNGraph RMat4 = TSnap::GenRMatMP(1024, 5000, 0.45, 0.15, 0.15, 7);
+  PUNGraph PrefAttach4 = TSnap::GenPrefAttachMP(1000, 3, 7);
+  PUNGraph SmallWorld4 = TSnap::GenSmallWorldMP(1000, 3, 0.1, 7);
+  PUNGraph ConfModel4 = TSnap::GenConfModelMP(DegSeqV, 7);
+#ifdef USE_OPENMP
+  omp_set_num_threads(Threads);
+#endif
+  EXPECT_TRUE(IsSameGraph(Gnm1, Gnm4));
+  EXPECT_TRUE(IsSameGraph(RMat1, RMat4));
+  EXPECT_TRUE(IsSameGraph(PrefAttach1, PrefAttach4));
+  EXPECT_TRUE(IsSameGraph(SmallWorld1, SmallWorld4));
+  EXPECT_TRUE(IsSameGraph(ConfModel1, ConfModel4));
+
+  EXPECT_TRUE(RMat4->IsOk());
+  EXPECT_EQ(5000, RMat4->GetEdges());
+  EXPECT_EQ(0, TSnap::CntSelfEdges(RMat4));
+  EXPECT_TRUE(PrefAttach4->IsOk());
+  EXPECT_EQ(1000, PrefAttach4->GetNodes());
+  EXPECT_GT(PrefAttach4->GetEdges(), 2000);
+  EXPECT_LE(PrefAttach4->GetEdges(), 3000);
+  EXPECT_TRUE(SmallWorld4->IsOk());
+  EXPECT_LE(SmallWorld4->GetEdges(), 3000);
+  EXPECT_GT(SmallWorld4->GetEdges(), 2900);
+  EXPECT_TRUE(ConfModel4->IsOk());
+  EXPECT_EQ(1000, ConfModel4->GetNodes());
+  EXPECT_EQ(0, TSnap::CntSelfEdges(ConfModel4));
+  for (TUNGraph::TNodeI NI = ConfModel4->BegNI(); NI < ConfModel4->EndNI(); NI++) {
+    EXPECT_LE(NI.GetDeg(), DegSeqV[NI.GetId()]);
+  }
+}
+
+// Test CSR generation: exact entry counts, sorted unique adjacency, same output for a seed
+TEST(GGenTest, GenCsrMP) {
+  for (int IsDir = 0; IsDir < 2; IsDir++) {
+    for (int SelfLoops = 0; SelfLoops < 2; SelfLoops++) {
+      const int Nodes = 12;
+      const int64 Entries = int64(Nodes) * (SelfLoops ? Nodes : Nodes-1);
+      TVec<TInt64> OffV, OffV2;
+      TVec<TInt, int64> NbrV, NbrV2;
+      // all possible entries, so every round has to find the missing ones
+      TSnap::TSnapDetail::GenCsrMP(Nodes, Entries, IsDir, SelfLoops,
+        TSnap::TSnapDetail::TGnmEdgeGen(TCtrRnd(3), Nodes), OffV, NbrV);
+      ASSERT_EQ(Nodes+1, OffV.Len());
+      EXPECT_EQ(0, OffV[0].Val);
+      EXPECT_EQ(Entries, OffV[Nodes].Val);
+      EXPECT_EQ(Entries, NbrV.Len());
+      for (int n = 0; n < Nodes; n++) {
+        for (int64 i = OffV[n]+1; i < OffV[n+1]; i++) { EXPECT_LT(NbrV[i-1].Val, NbrV[i].Val); }
+      }
+
+      TSnap::TSnapDetail::GenCsrMP(Nodes, Entries/4*2, IsDir, SelfLoops,
+        TSnap::TSnapDetail::TGnmEdgeGen(TCtrRnd(3), Nodes), OffV, NbrV);
+      EXPECT_EQ(Entries/4*2, NbrV.Len());
+      for (int n = 0; n < Nodes; n++) {
+        for (int64 i = OffV[n]; i < OffV[n+1]; i++) {
+          if (! SelfLoops) { EXPECT_NE(n, NbrV[i].Val); }
+          if (IsDir) { continue; }
+          // undirected adjacency is symmetric
+          bool IsNbr = false;
+          for (int64 j = OffV[NbrV[i]]; j < OffV[NbrV[i]+1]; j++) { IsNbr = IsNbr || NbrV[j] == n; }
+          EXPECT_TRUE(IsNbr);
+        }
+      }
+#ifdef USE_OPENMP
+      const int Threads = omp_get_max_threads();
+      omp_set_num_threads(4);
+#endif
+      TSnap::TSnapDetail::GenCsrMP(Nodes, Entries/4*2, IsDir, SelfLoops,
+        TSnap::TSnapDetail::TGnmEdgeGen(TCtrRnd(3), Nodes), OffV2, NbrV2);
+#ifdef USE_OPENMP
+      omp_set_num_threads(Threads);
+#endif
+      EXPECT_TRUE(OffV == OffV2);
+      EXPECT_TRUE(NbrV == NbrV2);
+      TSnap::TSnapDetail::GenCsrMP(Nodes, Entries/4*2, IsDir, SelfLoops,
+        TSnap::TSnapDetail::TGnmEdgeGen(TCtrRnd(4), Nodes), OffV2, NbrV2);
+      EXPECT_FALSE(NbrV == NbrV2);
+    }
+  }
+}
+
+// Test CSR generation with overshooting rounds: undirected self-loops add one entry
+TEST(GGenTest, GenCsrMPExact) {
+  const int Nodes = 12;
+  for (int64 Entries = 1; Entries <= int64(Nodes) * Nodes; Entries += 11) {
+    TVec<TInt64> OffV;
+    TVec<TInt, int64> NbrV;
+    TSnap::TSnapDetail::GenCsrMP(Nodes, Entries, false, true,
+      TSnap::TSnapDetail::TGnmEdgeGen(TCtrRnd(5), Nodes), OffV, NbrV);
+    EXPECT_EQ(Entries, OffV[Nodes].Val);
+    EXPECT_EQ(Entries, NbrV.Len());
+    for (int n = 0; n < Nodes; n++) {
+      for (int64 i = OffV[n]; i < OffV[n+1]; i++) {
+        if (i > OffV[n]) { EXPECT_LT(NbrV[i-1].Val, NbrV[i].Val); }
+        bool IsNbr = false;
+        for (int64 j = OffV[NbrV[i]]; j < OffV[NbrV[i]+1]; j++) { IsNbr = IsNbr || NbrV[j] == n; }
+        EXPECT_TRUE(IsNbr);
+      }
+    }
+  }
+  // a directed request that is almost all of the pairs needs rounds with more draws than missing entries
+  TVec<TInt64> OffV;
+  TVec<TInt, int64> NbrV;
+  TSnap::TSnapDetail::GenCsrMP(Nodes, int64(Nodes) * Nodes - 1, true, true,
+    TSnap::TSnapDetail::TGnmEdgeGen(TCtrRnd(5), Nodes), OffV, NbrV);
+  EXPECT_EQ(int64(Nodes) * Nodes - 1, NbrV.Len());
+}
+
+// Test CSR generation from streams with too few distinct edges
+TEST(GGenTest, GenCsrMPNoEdges) {
+  TVec<TInt64> OffV;
+  TVec<TInt, int64> NbrV;
+  // edges only among nodes 0..3, 12 directed pairs
+  EXPECT_DEATH(TSnap::TSnapDetail::GenCsrMP(12, 20, true, false,
+    TSnap::TSnapDetail::TGnmEdgeGen(TCtrRnd(5), 4), OffV, NbrV), "");
+  TSnap::TSnapDetail::GenCsrMP(12, 12, true, false,
+    TSnap::TSnapDetail::TGnmEdgeGen(TCtrRnd(5), 4), OffV, NbrV);
+  EXPECT_EQ(12, NbrV.Len());
+  // R-MAT without off-diagonal cells draws only self-loops
+  EXPECT_DEATH(TSnap::GenRMatMP(64, 10, 0.6, 0.0, 0.0, 1), "");
+}
+
 template <class PGraph> void TestRewire(const PGraph& Graph) {
   PGraph GraphOut;
   TIntPrV DegToCntV;
@@ -0,0 +1,124 @@
+#include <gtest/gtest.h>
+
+#include "Snap.h"
+
+// Complete graph on 10 nodes, a star with 36 leaves and a 200 node cycle.
+// Eigenvalues of largest magnitude are 9 (K10), 6 and -6 (star).
+PUNGraph GetSpectrumTestTUNGraph() {
+  PUNGraph Graph = TUNGraph::New();
+  for (int i = 0; i < 10; i++) {
+    Graph->AddNode(100+i);
+    for (int j = 0; j < i; j++) { Graph->AddEdge(100+i, 100+j); }
+  }
+  Graph->AddNode(500);
+  for (int i = 0; i < 36; i++) { Graph->AddNode(1000+3*i); Graph->AddEdge(500, 1000+3*i); }
+  for (int i = 0; i < 200; i++) { Graph->AddNode(5000+i); }
+  for (int i = 0; i < 200; i++) { Graph->AddEdge(5000+i, 5000+(i+1)%200); }
+  return Graph;
+}
+
+// Test eigenvalues and the leading eigenvector of an undirected graph with arbitrary node ids
+TEST(gsvd, GetEigVals) {
+  PUNGraph Graph = GetSpectrumTestTUNGraph();
+  TFltV EigValV;
+  TSnap::GetEigVals(Graph, 3, EigValV);
+  ASSERT_EQ(3, EigValV.Len());
+  EXPECT_NEAR(9.0, EigValV[0], 1e-6);
+  EXPECT_NEAR(6.0, EigValV[1], 1e-6);
+  EXPECT_NEAR(-6.0, EigValV[2], 1e-6);
+
+  TFltV EigVecV;
+  TSnap::GetEigVec(Graph, EigVecV);
+  ASSERT_EQ(Graph->GetNodes(), EigVecV.Len());
+  int i = 0;
+  for (TUNGraph::TNodeI NI = Graph->BegNI(); NI < Graph->EndNI(); NI++, i++) {
+    const double Expected = NI.GetId() < 200 ? 1.0/sqrt(10.0) : 0.0;
+    EXPECT_NEAR(Expected, fabs(EigVecV[i]), 1e-6);
+  }
+}
+
+// Test singular values and vectors of a directed graph
+TEST(gsvd, GetSngVals) {
+  PNGraph Graph = TNGraph::New();
+  // complete bipartite 4 -> 9 (singular value 6)
+  for (int i = 0; i < 4; i++) { Graph->AddNode(10+i); }
+  for (int j = 0; j < 9; j++) { Graph->AddNode(20+j); }
+  for (int i = 0; i < 4; i++) {
+    for (int j = 0; j < 9; j++) { Graph->AddEdge(10+i, 20+j); }
+  }
+  // out-star with 25 leaves (singular value 5)
+  Graph->AddNode(7);
+  for (int i = 0; i < 25; i++) { Graph->AddNode(100+i); Graph->AddEdge(7, 100+i); }
+  // directed cycle (singular values 1)
+  for (int i = 0; i < 150; i++) { Graph->AddNode(1000+i); }
+  for (int i = 0; i < 150; i++) { Graph->AddEdge(1000+i, 1000+(i+1)%150); }
+
+  TFltV SngValV;
+  TSnap::GetSngVals(Graph, 2, SngValV);
+  ASSERT_EQ(2, SngValV.Len());
+  EXPECT_NEAR(6.0, SngValV[0], 1e-6);
+  EXPECT_NEAR(5.0, SngValV[1], 1e-6);
+
+  TVec<TFltV> LeftSV, RightSV;
+  TSnap::GetSngVec(Graph, 2, SngValV, LeftSV, RightSV);
+  ASSERT_EQ(2, LeftSV.Len());
+  TCsrMtx GraphMtx(Graph);
+  for (int v = 0; v < 2; v++) {
+    TFltV AvV(Graph->GetNodes());
+    GraphMtx.Multiply(RightSV[v], AvV);
+    for (int i = 0; i < AvV.Len(); i++) {
+      EXPECT_NEAR(SngValV[v] * LeftSV[v][i], AvV[i], 1e-6);
+    }
+  }
+}
+
+// All eigenvalues of the dense symmetric matrix MtxVV, by decreasing magnitude
+void GetDenseEigVals(TFltVV& MtxVV, TFltV& EigValV) {
+  const int N = MtxVV.GetRows();
+  TFltV d(N+1), e(N+1);
+  TNumericalStuff::SymetricToTridiag(MtxVV, N, d, e);
+  TNumericalStuff::EigSymmetricTridiag(d, e, N, MtxVV);
+  TFltIntKdV SortV(N);
+  for (int i = 0; i < N; i++) { SortV[i] = TFltIntKd(TFlt::Abs(d[i+1]), i); }
+  SortV.Sort(false);
+  EigValV.Gen(N, 0);
+  for (int i = 0; i < N; i++) { EigValV.Add(d[SortV[i].Dat+1]); }
+}
+
+// Test eigenvalues and singular values of random graphs against a dense eigensolver
+TEST(gsvd, DenseCompare) {
+  PUNGraph Graph = TSnap::GenRndGnm<PUNGraph>(800, 4000, false, TInt::Rnd);
+  const int N = Graph->GetNodes();
+  TFltVV AdjVV(N, N);
+  for (TUNGraph::TEdgeI EI = Graph->BegEI(); EI < Graph->EndEI(); EI++) {
+    AdjVV(EI.GetSrcNId(), EI.GetDstNId()) = 1;
+    AdjVV(EI.GetDstNId(), EI.GetSrcNId()) = 1;
+  }
+  TFltV DenseV;
+  GetDenseEigVals(AdjVV, DenseV);
+  const int ValsV[] = { 10, 100 };
+  for (int t = 0; t < 2; t++) {
+    TFltV EigValV;
+    TSnap::GetEigVals(Graph, ValsV[t], EigValV);
+    ASSERT_EQ(ValsV[t], EigValV.Len());
+    // GetEigVals() sorts the values of largest magnitude decreasingly
+    TFltV TopV;
+    DenseV.GetSubValV(0, ValsV[t]-1, TopV);
+    TopV.Sort(false);
+    for (int i = 0; i < EigValV.Len(); i++) { EXPECT_NEAR(TopV[i], EigValV[i], 1e-6); }
+  }
+
+  PNGraph DGraph = TSnap::GenRndGnm<PNGraph>(400, 2000, true, TInt::Rnd);
+  const int DN = DGraph->GetNodes();
+  TFltVV AtAVV(DN, DN);
+  for (TNGraph::TNodeI NI = DGraph->BegNI(); NI < DGraph->EndNI(); NI++) {
+    for (int i = 0; i < NI.GetOutDeg(); i++) {
+      for (int j = 0; j < NI.GetOutDeg(); j++) { AtAVV(NI.GetOutNId(i), NI.GetOutNId(j)) += 1; }
+    }
+  }
+  GetDenseEigVals(AtAVV, DenseV);
+  TFltV SngValV;
+  TSnap::GetSngVals(DGraph, 20, SngValV);
+  ASSERT_EQ(20, SngValV.Len());
+  for (int i = 0; i < SngValV.Len(); i++) { EXPECT_NEAR(sqrt(DenseV[i]), SngValV[i], 1e-6); }
+}
@@ -0,0 +1,93 @@
+#include <gtest/gtest.h>
+
+#include "Snap.h"
+#include "kronecker.h"
+
+// Sorted edges of Graph
+void GetKronEdgeV(const PNGraph& Graph, TIntPrV& EdgeV) {
+  EdgeV.Clr();
+  for (TNGraph::TEdgeI EI = Graph->BegEI(); EI < Graph->EndEI(); EI++) {
+    EdgeV.Add(TIntPr(EI.GetSrcNId(), EI.GetDstNId())); }
+  EdgeV.Sort();
+}
+
+// Parallel Kronecker graphs have the requested size and depend only on the seed
+TEST(kronecker, GenFastKroneckerMP) {
+  TFltV SeedV;
+  SeedV.Add(0.9);  SeedV.Add(0.5);  SeedV.Add(0.5);  SeedV.Add(0.2);
+  const TKronMtx SeedMtx(SeedV);
+  const int NIter = 10;
+  PNGraph Graph = TKronMtx::GenFastKroneckerMP(SeedMtx, NIter, true, 5);
+  EXPECT_TRUE(Graph->IsOk());
+  EXPECT_EQ(SeedMtx.GetNodes(NIter), Graph->GetNodes());
+  EXPECT_EQ(SeedMtx.GetEdges(NIter), Graph->GetEdges());
+
+  PNGraph UGraph = TKronMtx::GenFastKroneckerMP(SeedMtx, NIter, 4000, false, 5);
+  EXPECT_EQ(SeedMtx.GetNodes(NIter), UGraph->GetNodes());
+  EXPECT_EQ(4000, UGraph->GetEdges());
+  for (TNGraph::TEdgeI EI = UGraph->BegEI(); EI < UGraph->EndEI(); EI++) {
+    EXPECT_TRUE(UGraph->IsEdge(EI.GetDstNId(), EI.GetSrcNId())); }
+
+#ifdef USE_OPENMP
+  const int Threads = omp_get_max_threads();
+  omp_set_num_threads(1);
+#endif
+  PNGraph Graph1 = TKronMtx::GenFastKroneckerMP(SeedMtx, NIter, true, 5);
+#ifdef USE_OPENMP
+  omp_set_num_threads(4);
+#endif
+  PNGraph Graph4 = TKronMtx::GenFastKroneckerMP(SeedMtx, NIter, true, 5);
+#ifdef USE_OPENMP
+  omp_set_num_threads(Threads);
+#endif
+  PNGraph Graph6 = TKronMtx::GenFastKroneckerMP(SeedMtx, NIter, true, 6);
+  TIntPrV EdgeV, EdgeV1, EdgeV4, EdgeV6;
+  GetKronEdgeV(Graph, EdgeV);
+  GetKronEdgeV(Graph1, EdgeV1);
+  GetKronEdgeV(Graph4, EdgeV4);
+  GetKronEdgeV(Graph6, EdgeV6);
+  EXPECT_TRUE(EdgeV == EdgeV1);
+  EXPECT_TRUE(EdgeV == EdgeV4);
+  EXPECT_FALSE(EdgeV == EdgeV6);
+}
+
+// Approximate LL and gradient through the per-call TKronMtx formulas
+void CheckKronApxLL(const PNGraph& Graph, const TKronMtx& ParamMtx) {
+  PKroneckerLL KronLL = TKroneckerLL::New(Graph, ParamMtx);
+  KronLL->SetRndPerm();
+  const TKronMtx& LLMtx = KronLL->GetLLMtx();
+  const TIntV& PermV = KronLL->GetPermV();
+  const int KronIters = KronLL->GetKronIters();
+  const int Params = KronLL->GetParams();
+  double LL = KronLL->GetApxEmptyGraphLL();
+  for (TNGraph::TEdgeI EI = Graph->BegEI(); EI < Graph->EndEI(); EI++) {
+    const int Row = PermV[EI.GetSrcNId()], Col = PermV[EI.GetDstNId()];
+    LL += LLMtx.GetEdgeLL(Row, Col, KronIters) - LLMtx.GetApxNoEdgeLL(Row, Col, KronIters);
+  }
+  EXPECT_NEAR(LL, KronLL->CalcApxGraphLL(), 1e-6*fabs(LL));
+  // gradient of single edges
+  int Edges = 0;
+  for (TNGraph::TEdgeI EI = Graph->BegEI(); EI < Graph->EndEI() && Edges < 10; EI++, Edges++) {
+    const int Row = PermV[EI.GetSrcNId()], Col = PermV[EI.GetDstNId()];
+    TFltV DLLV(Params);
+    KronLL->AddKronEdgeDLLDelta(Row, Col, 1.0, DLLV);
+    for (int p = 0; p < Params; p++) {
+      const double DLL = LLMtx.GetEdgeDLL(p, Row, Col, KronIters) - LLMtx.GetApxNoEdgeDLL(p, Row, Col, KronIters);
+      EXPECT_NEAR(DLL, DLLV[p], 1e-6*fabs(DLL)+1e-9);
+    }
+  }
+}
+
+// KronFit LL and gradient match the TKronMtx formulas, also for initiators
+// too large for the digit table
+TEST(kronecker, ApxGraphLL) {
+  TKronMtx::PutRndSeed(1);
+  TFltV SeedV;
+  SeedV.Add(0.9);  SeedV.Add(0.6);  SeedV.Add(0.6);  SeedV.Add(0.1);
+  const TKronMtx SeedMtx(SeedV);
+  PNGraph Graph = TKronMtx::GenFastKroneckerMP(SeedMtx, 8, true, 1);
+  CheckKronApxLL(Graph, TKronMtx::GetRndMtx(2, 0.1));
+
+  PNGraph Graph2 = TSnap::GenRndGnm<PNGraph>(257, 300);
+  CheckKronApxLL(Graph2, TKronMtx::GetRndMtx(257, 0.1));
+}
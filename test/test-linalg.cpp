@@ -0,0 +1,116 @@
+#include <gtest/gtest.h>
+
+#include "Snap.h"
+
+// fills a Rows x Cols matrix with values in [-1, 1)
+void GenRndMtx(const int& Rows, const int& Cols, TRnd& Rnd, TFltVV& X) {
+  X.Gen(Rows, Cols);
+  for (int i = 0; i < Rows; i++) {
+    for (int j = 0; j < Cols; j++) {
+      X(i, j) = 2.0 * Rnd.GetUniDev() - 1.0;
+    }
+  }
+}
+
+// D = Alpha * op(A) * op(B) + Beta * op(C) with a plain triple loop
+void NaiveGemm(const double& Alpha, const TFltVV& A, const TFltVV& B,
+    const double& Beta, const TFltVV& C, TFltVV& D, const int& Flags) {
+  const bool tA = (Flags & TLinAlg::GEMM_A_T) != 0;
+  const bool tB = (Flags & TLinAlg::GEMM_B_T) != 0;
+  const bool tC = (Flags & TLinAlg::GEMM_C_T) != 0;
+  const int Rows = tA ? A.GetCols() : A.GetRows();
+  const int Inner = tA ? A.GetRows() : A.GetCols();
+  const int Cols = tB ? B.GetRows() : B.GetCols();
+  D.Gen(Rows, Cols);
+  for (int i = 0; i < Rows; i++) {
+    for (int j = 0; j < Cols; j++) {
+      double Sum = 0.0;
+      for (int p = 0; p < Inner; p++) {
+        Sum += (tA ? A(p, i) : A(i, p)) * (tB ? B(j, p) : B(p, j));
+      }
+      D(i, j) = Alpha * Sum + (Beta != 0.0 ? Beta * (tC ? C(j, i) : C(i, j)) : 0.0);
+    }
+  }
+}
+
+double GetMxAbsDiff(const TFltVV& X, const TFltVV& Y) {
+  double MxDiff = 0.0;
+  for (int i = 0; i < X.GetRows(); i++) {
+    for (int j = 0; j < X.GetCols(); j++) {
+      MxDiff = TFlt::GetMx(MxDiff, TFlt::Abs(X(i, j) - Y(i, j)));
+    }
+  }
+  return MxDiff;
+}
+
+// Test Gemm against a naive product for all transpose combinations, on shapes
+// that hit the unpacked path, partial register tiles and partial cache blocks
+TEST(TLinAlg, Gemm) {
+  // M x N x K, none a multiple of the 4 x 8 register tile; the last one
+  // spans more than one 128 row block and one 256 deep panel
+  const int Shapes[][3] = { {3, 5, 7}, {37, 53, 29}, {131, 67, 300} };
+  const double Betas[] = { 0.0, 1.0, -0.5 };
+  TRnd Rnd(1);
+  for (int s = 0; s < 3; s++) {
+    const int M = Shapes[s][0], N = Shapes[s][1], K = Shapes[s][2];
+    for (int Flags = 0; Flags < 8; Flags++) {
+      const bool tA = (Flags & TLinAlg::GEMM_A_T) != 0;
+      const bool tB = (Flags & TLinAlg::GEMM_B_T) != 0;
+      const bool tC = (Flags & TLinAlg::GEMM_C_T) != 0;
+      TFltVV A, B, C;
+      GenRndMtx(tA ? K : M, tA ? M : K, Rnd, A);
+      GenRndMtx(tB ? N : K, tB ? K : N, Rnd, B);
+      GenRndMtx(tC ? N : M, tC ? M : N, Rnd, C);
+      for (int b = 0; b < 3; b++) {
+        TFltVV D, ExpD;
+        NaiveGemm(1.5, A, B, Betas[b], C, ExpD, Flags);
+        TLinAlg::Gemm(1.5, A, B, Betas[b], C, D, Flags);
+        EXPECT_EQ(M, D.GetRows());
+        EXPECT_EQ(N, D.GetCols());
+        EXPECT_GT(1e-10, GetMxAbsDiff(D, ExpD));
+      }
+    }
+  }
+}
+
+// Test Gemm with the output aliasing C
+TEST(TLinAlg, GemmInPlace) {
+  TRnd Rnd(2);
+  for (int tC = 0; tC < 2; tC++) {
+    const int Flags = tC ? TLinAlg::GEMM_C_T : TLinAlg::GEMM_NO_T;
+    TFltVV A, B, C, ExpD;
+    GenRndMtx(41, 19, Rnd, A);
+    GenRndMtx(19, 41, Rnd, B);
+    GenRndMtx(41, 41, Rnd, C);
+    NaiveGemm(-1.0, A, B, 2.0, C, ExpD, Flags);
+    TLinAlg::Gemm(-1.0, A, B, 2.0, C, C, Flags);
+    EXPECT_GT(1e-10, GetMxAbsDiff(C, ExpD));
+  }
+}
+
+// Test GemmRowMajor on sub-blocks of larger arrays: leading dimensions wider
+// than the operands and entries of C outside the block left untouched
+TEST(TLinAlg, GemmRowMajor) {
+  const int M = 29, N = 45, K = 33, Ld = 64;
+  TRnd Rnd(3);
+  for (int Trans = 0; Trans < 4; Trans++) {
+    const bool TransA = (Trans & 1) != 0, TransB = (Trans & 2) != 0;
+    TFltVV A, B, C;
+    GenRndMtx(Ld, Ld, Rnd, A);
+    GenRndMtx(Ld, Ld, Rnd, B);
+    GenRndMtx(Ld, Ld, Rnd, C);
+    TFltVV ExpC = C;
+    for (int i = 0; i < M; i++) {
+      for (int j = 0; j < N; j++) {
+        double Sum = 0.0;
+        for (int p = 0; p < K; p++) {
+          Sum += (TransA ? A(p, i) : A(i, p)) * (TransB ? B(j, p) : B(p, j));
+        }
+        ExpC(i, j) = 0.5 * Sum + 3.0 * C(i, j);
+      }
+    }
+    TLinAlg::GemmRowMajor(TransA, TransB, M, N, K, 0.5, &A(0, 0).Val, Ld,
+      &B(0, 0).Val, Ld, 3.0, &C(0, 0).Val, Ld);
+    EXPECT_GT(1e-10, GetMxAbsDiff(C, ExpC));
+  }
+}
@@ -1253,4 +1253,231 @@ TEST(multimodal, ToNetwork) {
   PNEANet Net = Graph->ToNetwork(CrossNetIds, NodeAttrMapping, EdgeAttrMapping);
   EXPECT_EQ(NNodes*2, Net->GetNodes());
   EXPECT_EQ(NEdges*6, Net->GetEdges()); //undirected has 2*NEdges edges, one in each direction
-}
\ No newline at end of file
+}
+
+TEST(multimodal, ToNetworkDictStrAttr) {
+  PMMNet Graph = PMMNet::New();
+  Graph->AddModeNet("M1");
+  Graph->AddModeNet("M2");
+  Graph->AddCrossNet("M1", "M2", "C", true);
+  TModeNet& ModeNet1 = Graph->GetModeNetByName("M1");
+  TModeNet& ModeNet2 = Graph->GetModeNetByName("M2");
+  ModeNet1.AddStrAttrN("kind", "unknown", true);
+  ModeNet2.AddStrAttrN("kind", "unknown", true);
+  const char* Kinds[] = { "a", "b", "c", "d" };
+  for (int i = 0; i < 100; i++) {
+    ModeNet1.AddNode(i);
+    ModeNet2.AddNode(i);
+    ModeNet1.AddStrAttrDatN(i, Kinds[i % 4], "kind");
+    if (i % 2 == 0) { ModeNet2.AddStrAttrDatN(i, Kinds[3 - i % 4], "kind"); }
+  }
+  TCrossNet& CrossNet = Graph->GetCrossNetByName("C");
+  for (int i = 0; i < 100; i++) {
+    CrossNet.AddEdge(i, (i+1) % 100, i);
+  }
+  TIntV CrossNetIds;
+  CrossNetIds.Add(Graph->GetCrossId("C"));
+  TVec<TTriple<TInt, TStr, TStr> > NodeAttrMapping;
+  TVec<TTriple<TInt, TStr, TStr> > EdgeAttrMapping;
+  NodeAttrMapping.Add(TTriple<TInt, TStr, TStr>(Graph->GetModeId("M1"), "kind", "kind1"));
+  NodeAttrMapping.Add(TTriple<TInt, TStr, TStr>(Graph->GetModeId("M2"), "kind", "kind2"));
+  PNEANet Net = Graph->ToNetwork(CrossNetIds, NodeAttrMapping, EdgeAttrMapping);
+  ASSERT_EQ(200, Net->GetNodes());
+  EXPECT_TRUE(Net->IsDictStrAttrN("kind1"));
+  EXPECT_EQ(5, Net->GetStrCodes());
+  TIntV NIdV;
+  Net->GetStrAttrEqNIdV("kind1", "b", NIdV);
+  EXPECT_EQ(25, NIdV.Len());
+  Net->GetStrAttrEqNIdV("kind2", "b", NIdV);
+  EXPECT_EQ(25, NIdV.Len());
+  Net->GetStrAttrEqNIdV("kind2", "unknown", NIdV);
+  EXPECT_EQ(150, NIdV.Len());
+  Net->GetStrAttrEqNIdV("kind1", "unknown", NIdV);
+  EXPECT_EQ(100, NIdV.Len());
+}
+TEST(multimodal, ToNetwork2MP) {
+  PMMNet Graph = PMMNet::New();
+  Graph->AddModeNet("M1");
+  Graph->AddModeNet("M2");
+  Graph->AddCrossNet("M1", "M2", "C", true);
+  Graph->AddCrossNet("M1", "M1", "U", false);
+  TModeNet& ModeNet1 = Graph->GetModeNetByName("M1");
+  TModeNet& ModeNet2 = Graph->GetModeNetByName("M2");
+  ModeNet1.AddIntAttrN("deg", -1);
+  ModeNet1.AddStrAttrN("name");
+  ModeNet2.AddFltAttrN("deg", -1.0);
+  ModeNet2.AddStrAttrN("kind", "unknown", true);
+  const char* Kinds[] = { "a", "b", "c" };
+  for (int i = 0; i < 100; i++) {
+    ModeNet1.AddNode(i);
+    ModeNet2.AddNode(2*i);
+    if (i % 3 != 0) { ModeNet1.AddIntAttrDatN(i, i*i, "deg"); }
+    ModeNet1.AddStrAttrDatN(i, TStr::Fmt("n%d", i), "name");
+    ModeNet2.AddFltAttrDatN(2*i, 0.5*i, "deg");
+    if (i % 2 == 0) { ModeNet2.AddStrAttrDatN(2*i, Kinds[i % 3], "kind"); }
+  }
+  TCrossNet& CrossNet = Graph->GetCrossNetByName("C");
+  TCrossNet& UndirNet = Graph->GetCrossNetByName("U");
+  CrossNet.AddIntAttrE("w", 0);
+  CrossNet.AddStrAttrE("label");
+  UndirNet.AddFltAttrE("w", 1.0);
+  for (int i = 1; i < 100; i++) {
+    CrossNet.AddEdge(i, 2*((3*i) % 90), i);
+    CrossNet.AddIntAttrDatE(i, 10*i, "w");
+    CrossNet.AddStrAttrDatE(i, TStr::Fmt("e%d", i), "label");
+    if (i < 99) {
+      UndirNet.AddEdge(i, i+1, i);
+      UndirNet.AddFltAttrDatE(i, 0.25*i, "w");
+    }
+  }
+  // deleted nodes and edges leave gaps in the hash keys, node 0 is not on any edge
+  for (int i = 7; i < 100; i += 7) { ModeNet1.DelNode(i); }
+  for (int i = 1; i < 30; i += 5) {
+    if (CrossNet.IsEdge(i)) { CrossNet.DelEdge(i); }
+  }
+
+  TIntV CrossNetIds;
+  CrossNetIds.Add(Graph->GetCrossId("C"));
+  CrossNetIds.Add(Graph->GetCrossId("U"));
+  const int M1 = Graph->GetModeId("M1"), M2 = Graph->GetModeId("M2");
+  const int C = Graph->GetCrossId("C"), U = Graph->GetCrossId("U");
+  TIntStrPrVH NodeAttrMap;
+  NodeAttrMap.AddDat(M1).Add(TStrPr("deg", "deg1"));
+  NodeAttrMap.AddDat(M1).Add(TStrPr("name", "name"));
+  NodeAttrMap.AddDat(M2).Add(TStrPr("deg", "deg2"));
+  NodeAttrMap.AddDat(M2).Add(TStrPr("kind", "kind"));
+  THash<TInt, TVec<TPair<TStr, TStr> > > EdgeAttrMap;
+  EdgeAttrMap.AddDat(C).Add(TStrPr("w", "wc"));
+  EdgeAttrMap.AddDat(C).Add(TStrPr("label", "label"));
+  EdgeAttrMap.AddDat(U).Add(TStrPr("w", "wu"));
+
+  PNEANet Net2 = Graph->ToNetwork2(CrossNetIds, NodeAttrMap, EdgeAttrMap);
+  PNEANet Net = Graph->ToNetwork2MP(CrossNetIds, NodeAttrMap, EdgeAttrMap);
+  EXPECT_TRUE(Net->IsOk());
+  EXPECT_EQ(ModeNet1.GetNodes() + ModeNet2.GetNodes(), Net->GetNodes());
+  EXPECT_EQ(Net2->GetNodes(), Net->GetNodes());
+  EXPECT_EQ(Net2->GetEdges(), Net->GetEdges());
+  EXPECT_EQ(CrossNet.GetEdges() + 2*UndirNet.GetEdges(), Net->GetEdges());
+  EXPECT_TRUE(Net->IsDictStrAttrN("kind"));
+
+  for (TNEANet::TNodeI NI = Net->BegNI(); NI < Net->EndNI(); NI++) {
+    const int NId = NI.GetId();
+    const int Mode = Net->GetIntAttrDatN(NId, "Mode");
+    const int OldNId = Net->GetIntAttrDatN(NId, "Id");
+    if (Mode == M1) {
+      ASSERT_TRUE(ModeNet1.IsNode(OldNId));
+      EXPECT_EQ(ModeNet1.GetIntAttrDatN(OldNId, "deg"), Net->GetIntAttrDatN(NId, "deg1"));
+      EXPECT_EQ(ModeNet1.GetStrAttrDatN(OldNId, "name"), Net->GetStrAttrDatN(NId, "name"));
+    } else {
+      ASSERT_EQ(M2, Mode);
+      ASSERT_TRUE(ModeNet2.IsNode(OldNId));
+      EXPECT_EQ(ModeNet2.GetFltAttrDatN(OldNId, "deg"), Net->GetFltAttrDatN(NId, "deg2"));
+      EXPECT_EQ(ModeNet2.GetStrAttrDatN(OldNId, "kind"), Net->GetStrAttrDatN(NId, "kind"));
+    }
+  }
+  for (TNEANet::TEdgeI EI = Net->BegEI(); EI < Net->EndEI(); EI++) {
+    const int EId = EI.GetId();
+    const int OldEId = Net->GetIntAttrDatE(EId, "Id");
+    const int SrcNId = Net->GetIntAttrDatN(EI.GetSrcNId(), "Id");
+    const int DstNId = Net->GetIntAttrDatN(EI.GetDstNId(), "Id");
+    if (Net->GetIntAttrDatE(EId, "CrossNet") == C) {
+      ASSERT_TRUE(CrossNet.IsEdge(OldEId));
+      EXPECT_EQ(CrossNet.GetEdgeI(OldEId).GetSrcNId(), SrcNId);
+      EXPECT_EQ(CrossNet.GetEdgeI(OldEId).GetDstNId(), DstNId);
+      EXPECT_EQ(10*OldEId, Net->GetIntAttrDatE(EId, "wc"));
+      EXPECT_EQ(TStr::Fmt("e%d", OldEId), Net->GetStrAttrDatE(EId, "label"));
+    } else {
+      ASSERT_TRUE(UndirNet.IsEdge(OldEId));
+      EXPECT_EQ(OldEId, TMath::Mn(SrcNId, DstNId));
+      EXPECT_EQ(OldEId+1, TMath::Mx(SrcNId, DstNId));
+      EXPECT_EQ(0.25*OldEId, Net->GetFltAttrDatE(EId, "wu"));
+    }
+  }
+}
+
+TEST(multimodal, MetaPath) {
+  PMMNet Graph = PMMNet::New();
+  Graph->AddModeNet("Author");
+  Graph->AddModeNet("Paper");
+  Graph->AddModeNet("Venue");
+  Graph->AddCrossNet("Author", "Paper", "writes", true);
+  Graph->AddCrossNet("Paper", "Venue", "in", true);
+  Graph->AddCrossNet("Paper", "Paper", "cites", true);
+  Graph->AddCrossNet("Author", "Author", "coauthor", false);
+  TModeNet& Authors = Graph->GetModeNetByName("Author");
+  TModeNet& Papers = Graph->GetModeNetByName("Paper");
+  TModeNet& Venues = Graph->GetModeNetByName("Venue");
+  for (int i = 0; i < 3; i++) { Authors.AddNode(i); }
+  for (int i = 0; i < 4; i++) { Papers.AddNode(10+i); }
+  for (int i = 0; i < 2; i++) { Venues.AddNode(20+i); }
+  TCrossNet& Writes = Graph->GetCrossNetByName("writes");
+  Writes.AddEdge(0, 10);
+  Writes.AddEdge(0, 11);
+  Writes.AddEdge(1, 11);
+  Writes.AddEdge(1, 12);
+  Writes.AddEdge(2, 13);
+  TCrossNet& In = Graph->GetCrossNetByName("in");
+  In.AddEdge(10, 20);
+  In.AddEdge(11, 20);
+  In.AddEdge(12, 21);
+  In.AddEdge(13, 21);
+  Graph->GetCrossNetByName("cites").AddEdge(10, 11);
+  Graph->GetCrossNetByName("cites").AddEdge(11, 12);
+  Graph->GetCrossNetByName("coauthor").AddEdge(0, 1);
+
+  TIntV SrcNIdV;
+  SrcNIdV.Add(0);  SrcNIdV.Add(1);  SrcNIdV.Add(2);
+  TStrV APA;
+  APA.Add("writes");  APA.Add("writes");
+  TVec<TIntFltH> CntHV;
+  EXPECT_EQ(Graph->GetModeId("Author"), Graph->GetMetaPathCnt("Author", APA, SrcNIdV, CntHV));
+  ASSERT_EQ(3, CntHV.Len());
+  EXPECT_EQ(2, CntHV[0].Len());
+  EXPECT_EQ(2.0, CntHV[0].GetDat(0));
+  EXPECT_EQ(1.0, CntHV[0].GetDat(1));
+  EXPECT_EQ(2.0, CntHV[1].GetDat(1));
+  EXPECT_EQ(1, CntHV[2].Len());
+
+  TStrV APVPA;
+  APVPA.Add("writes");  APVPA.Add("in");  APVPA.Add("in");  APVPA.Add("writes");
+  Graph->GetMetaPathCnt("Author", APVPA, SrcNIdV, CntHV);
+  EXPECT_EQ(4.0, CntHV[0].GetDat(0));
+  EXPECT_EQ(2.0, CntHV[0].GetDat(1));
+  EXPECT_EQ(3, CntHV[1].Len());
+  EXPECT_EQ(1.0, CntHV[1].GetDat(2));
+  // pruning to one node per hop keeps a single path
+  Graph->GetMetaPathCnt("Author", APVPA, SrcNIdV, CntHV, 1);
+  EXPECT_EQ(1, CntHV[1].Len());
+
+  TVec<TIntFltH> SimHV;
+  Graph->GetPathSim("Author", APVPA, SrcNIdV, SimHV);
+  EXPECT_DOUBLE_EQ(1.0, SimHV[0].GetDat(0));
+  EXPECT_DOUBLE_EQ(2.0/3.0, SimHV[0].GetDat(1));
+  EXPECT_DOUBLE_EQ(2.0/3.0, SimHV[1].GetDat(2));
+  EXPECT_FALSE(SimHV[2].IsKey(0));
+  Graph->GetPathSim("Author", APA, SrcNIdV, SimHV);
+  EXPECT_DOUBLE_EQ(0.5, SimHV[0].GetDat(1));
+
+  // reverse and same-mode hops
+  TVec<TIntV> NbrVV;
+  TStrV PA;
+  PA.Add("writes");
+  TIntV PaperV;
+  PaperV.Add(11);
+  EXPECT_EQ(Graph->GetModeId("Author"), Graph->GetMetaPathNbrs("Paper", PA, PaperV, NbrVV));
+  ASSERT_EQ(2, NbrVV[0].Len());
+  EXPECT_EQ(0, NbrVV[0][0]);
+  EXPECT_EQ(1, NbrVV[0][1]);
+  TStrV PPP;
+  PPP.Add("cites");  PPP.Add("cites");
+  PaperV[0] = 10;
+  Graph->GetMetaPathNbrs("Paper", PPP, PaperV, NbrVV);
+  ASSERT_EQ(1, NbrVV[0].Len());
+  EXPECT_EQ(12, NbrVV[0][0]);
+  TStrV AA;
+  AA.Add("coauthor");
+  Graph->GetMetaPathNbrs("Author", AA, SrcNIdV, NbrVV);
+  EXPECT_EQ(1, NbrVV[0].Len());
+  EXPECT_EQ(0, NbrVV[1][0]);
+  EXPECT_EQ(0, NbrVV[2].Len());
+}
@@ -0,0 +1,52 @@
+#include <gtest/gtest.h>
+
+#include "Snap.h"
+#include "ncp.h"
+
+// Runs local clustering on Graph with the seeds drawn from a fixed state of TInt::Rnd
+void RunNcp(const PUNGraph& Graph, const int& Threads, TLocClustStat& ClustStat) {
+#ifdef USE_OPENMP
+  const int MxThreads = omp_get_max_threads();
+  omp_set_num_threads(Threads);
+#endif
+  TInt::Rnd.PutSeed(1);
+  ClustStat.Run(Graph, true, true, true);
+#ifdef USE_OPENMP
+  omp_set_num_threads(MxThreads);
+#endif
+}
+
+// The network community profile does not depend on the number of threads
+TEST(ncp, RunThreads) {
+  const bool Verbose = TLocClust::Verbose;
+  TLocClust::Verbose = false;
+  TRnd Rnd(1);
+  PUNGraph Graph = TSnap::GenRndGnm<PUNGraph>(400, 1600, false, Rnd);
+  TLocClustStat ClustStat1(0.001, 10, 400, 1.5, 2, 0.001);
+  TLocClustStat ClustStat4(0.001, 10, 400, 1.5, 2, 0.001);
+  RunNcp(Graph, 1, ClustStat1);
+  RunNcp(Graph, 4, ClustStat4);
+  TLocClust::Verbose = Verbose;
+
+  ASSERT_LT(0, ClustStat1.SweepsV.Len());
+  ASSERT_EQ(ClustStat1.SweepsV.Len(), ClustStat4.SweepsV.Len());
+  for (int i = 0; i < ClustStat1.SweepsV.Len(); i++) {
+    const TLocClustStat::TNodeSweep& Sweep1 = ClustStat1.SweepsV[i];
+    const TLocClustStat::TNodeSweep& Sweep4 = ClustStat4.SweepsV[i];
+    EXPECT_EQ(Sweep1.GetSeed(), Sweep4.GetSeed());
+    EXPECT_TRUE(Sweep1.SweepV == Sweep4.SweepV);
+    EXPECT_TRUE(Sweep1.PhiV == Sweep4.PhiV);
+  }
+  EXPECT_TRUE(ClustStat1.SizePhiH == ClustStat4.SizePhiH);
+  ASSERT_EQ(ClustStat1.GetCuts(), ClustStat4.GetCuts());
+  for (int c = 0; c < ClustStat1.GetCuts(); c++) {
+    const TLocClustStat::TCutInfo& Cut1 = ClustStat1.GetCutN(c);
+    const TLocClustStat::TCutInfo& Cut4 = ClustStat4.GetCutN(c);
+    EXPECT_EQ(Cut1.GetNodes(), Cut4.GetNodes());
+    EXPECT_EQ(Cut1.GetEdges(), Cut4.GetEdges());
+    EXPECT_EQ(Cut1.GetCutSz(), Cut4.GetCutSz());
+    EXPECT_TRUE(Cut1.CutNIdV == Cut4.CutNIdV);
+  }
+  EXPECT_TRUE(ClustStat1.GetBestCut().CutNIdV == ClustStat4.GetBestCut().CutNIdV);
+  EXPECT_EQ(ClustStat1.GetBestCut().GetPhi(), ClustStat4.GetBestCut().GetPhi());
+}
@@ -0,0 +1,98 @@
+#include <gtest/gtest.h>
+
+#include "Snap.h"
+
+// Random graph with sparse node ids, nodes are added in random order
+template <class PGraph>
+PGraph GetReorderTestGraph(const int& Nodes, const int& Edges) {
+  PGraph Graph0 = TSnap::GenRndGnm<PGraph>(Nodes, Edges);
+  TIntV NIdV;
+  Graph0->GetNIdV(NIdV);
+  TRnd Rnd(1);
+  NIdV.Shuffle(Rnd);
+  PGraph Graph = PGraph::TObj::New();
+  for (int n = 0; n < NIdV.Len(); n++) { Graph->AddNode(3*NIdV[n]+1); }
+  for (typename PGraph::TObj::TEdgeI EI = Graph0->BegEI(); EI < Graph0->EndEI(); EI++) {
+    Graph->AddEdge(3*EI.GetSrcNId()+1, 3*EI.GetDstNId()+1);
+  }
+  Graph->AddNode(3*Nodes+5); // isolated node
+  return Graph;
+}
+
+// NIdV is an order of all nodes and Graph2 is Graph renumbered by it
+template <class PGraph>
+void CheckReordered(const PGraph& Graph, const PGraph& Graph2, const TIntV& NIdV, const TIntH& NewNIdH) {
+  ASSERT_EQ(Graph->GetNodes(), NIdV.Len());
+  ASSERT_EQ(Graph->GetNodes(), NewNIdH.Len());
+  EXPECT_EQ(Graph->GetNodes(), Graph2->GetNodes());
+  EXPECT_EQ(Graph->GetEdges(), Graph2->GetEdges());
+  for (int n = 0; n < NIdV.Len(); n++) {
+    EXPECT_TRUE(Graph->IsNode(NIdV[n]));
+    EXPECT_EQ(n, NewNIdH.GetDat(NIdV[n]).Val);
+    EXPECT_TRUE(Graph2->IsNode(n));
+  }
+  for (typename PGraph::TObj::TEdgeI EI = Graph->BegEI(); EI < Graph->EndEI(); EI++) {
+    EXPECT_TRUE(Graph2->IsEdge(NewNIdH.GetDat(EI.GetSrcNId()), NewNIdH.GetDat(EI.GetDstNId())));
+  }
+  // adjacency vectors stay sorted
+  for (typename PGraph::TObj::TNodeI NI = Graph2->BegNI(); NI < Graph2->EndNI(); NI++) {
+    for (int e = 1; e < NI.GetOutDeg(); e++) { EXPECT_TRUE(NI.GetOutNId(e-1) < NI.GetOutNId(e)); }
+    for (int e = 1; e < NI.GetInDeg(); e++) { EXPECT_TRUE(NI.GetInNId(e-1) < NI.GetInNId(e)); }
+  }
+}
+
+// All orders renumber undirected and directed graphs
+TEST(reorder, Reorder) {
+  const TSnap::TNodeOrder OrderV[] = { TSnap::noDeg, TSnap::noBfs, TSnap::noRcm, TSnap::noGorder };
+  PUNGraph UGraph = GetReorderTestGraph<PUNGraph>(2000, 10000);
+  PNGraph NGraph = GetReorderTestGraph<PNGraph>(2000, 10000);
+  NGraph->AddEdge(NGraph->BegNI().GetId(), NGraph->BegNI().GetId());
+  for (int o = 0; o < 4; o++) {
+    TIntV NIdV;
+    TIntH NewNIdH;
+    PUNGraph UGraph2 = TSnap::Reorder(UGraph, OrderV[o], NIdV, NewNIdH);
+    CheckReordered(UGraph, UGraph2, NIdV, NewNIdH);
+    PNGraph NGraph2 = TSnap::Reorder(NGraph, OrderV[o], NIdV, NewNIdH);
+    CheckReordered(NGraph, NGraph2, NIdV, NewNIdH);
+  }
+}
+
+// Degree order is non-increasing, RCM numbers a path consecutively
+TEST(reorder, DegRcm) {
+  PUNGraph Graph = GetReorderTestGraph<PUNGraph>(1000, 5000);
+  TIntV NIdV;
+  TSnap::GetDegOrder(Graph, NIdV);
+  for (int n = 1; n < NIdV.Len(); n++) {
+    EXPECT_TRUE(Graph->GetNI(NIdV[n-1]).GetDeg() >= Graph->GetNI(NIdV[n]).GetDeg());
+  }
+
+  TIntV PathV;
+  for (int n = 0; n < 500; n++) { PathV.Add(n); }
+  TRnd Rnd(1);
+  PathV.Shuffle(Rnd);
+  PUNGraph Path = TUNGraph::New();
+  for (int n = 0; n < PathV.Len(); n++) { Path->AddNode(n); }
+  for (int n = 1; n < PathV.Len(); n++) { Path->AddEdge(PathV[n-1], PathV[n]); }
+  TSnap::GetRcmOrder(Path, NIdV);
+  TIntH NewNIdH;
+  PUNGraph Path2 = TSnap::GetReorderedGraph(Path, NIdV, NewNIdH);
+  for (TUNGraph::TEdgeI EI = Path2->BegEI(); EI < Path2->EndEI(); EI++) {
+    EXPECT_EQ(1, abs(EI.GetSrcNId() - EI.GetDstNId()));
+  }
+}
+
+// Results on a reordered graph translate back to the original ids
+TEST(reorder, GetOrigNIdDat) {
+  PNGraph Graph = GetReorderTestGraph<PNGraph>(1000, 8000);
+  TIntV NIdV;
+  TIntH NewNIdH;
+  PNGraph Graph2 = TSnap::Reorder(Graph, TSnap::noGorder, NIdV, NewNIdH);
+  TIntFltH PRankH, PRankH2, OrigPRankH2;
+  TSnap::GetPageRank(Graph, PRankH);
+  TSnap::GetPageRank(Graph2, PRankH2);
+  TSnap::GetOrigNIdDat(PRankH2, NIdV, OrigPRankH2);
+  ASSERT_EQ(PRankH.Len(), OrigPRankH2.Len());
+  for (int KeyId = PRankH.FFirstKeyId(); PRankH.FNextKeyId(KeyId); ) {
+    EXPECT_NEAR(PRankH[KeyId].Val, OrigPRankH2.GetDat(PRankH.GetKey(KeyId)).Val, 1e-6);
+  }
+}
@@ -62,3 +62,34 @@ TEST(sim, parallel) {
 
 }
 #endif
+
+TEST(sim, lsh) {
+  PNGraph G = new TNGraph();
+  G->AddNode(1);
+  G->AddNode(2);
+  G->AddNode(3);
+  G->AddNode(4);
+  G->AddNode(10);
+  G->AddNode(11);
+  G->AddNode(12);
+  G->AddEdge(1,10);
+  G->AddEdge(2,10);
+  G->AddEdge(1,11);
+  G->AddEdge(2,12);
+  G->AddEdge(3,11);
+  G->AddEdge(3,12);
+  G->AddEdge(2,11);
+  G->AddEdge(4,10);
+
+  // with many single-row bands all pairs with positive similarity collide
+  PNEANet K = KNNJaccardLSH(G,3,64,1);
+  int s = 0;
+  float sum = 0;
+  for (TNEANet::TEdgeI EI = K->BegEI(); EI < K->EndEI(); EI++ ){
+    s += EI.GetDstNId();
+    sum += K->GetFltAttrDatE(EI.GetId(), "sim");
+  }
+  EXPECT_EQ(7, K->GetNodes());
+  EXPECT_EQ(26, s);
+  EXPECT_EQ(8, int(sum));
+}
@@ -43,6 +43,84 @@ TEST(subgraph, TestSubTUNGraphs) {
   EXPECT_EQ(10,Graph3->GetEdges());
 }
 
+// Test bulk subgraph and egonet extraction against the one-at-a-time versions
+TEST(subgraph, TestBulkSubGraphs) {
+  PUNGraph UNGraph = TSnap::GenRndGnm<PUNGraph>(300, 1500);
+  PNGraph NGraph = TSnap::GenRndGnm<PNGraph>(300, 1500);
+  UNGraph->AddEdge(7, 7);
+  NGraph->AddEdge(7, 7);
+  TRnd Rnd(1);
+  TVec<TIntV> NIdVV(50);
+  for (int i = 0; i < NIdVV.Len(); i++) {
+    for (int n = 0; n < 5 + i; n++) { NIdVV[i].Add(Rnd.GetUniDevInt(310)); }
+  }
+  NIdVV.Add(TIntV());
+  for (int Renumber = 0; Renumber < 2; Renumber++) {
+    TVec<PUNGraph> UNGraphV;
+    TVec<PNGraph> NGraphV;
+    TSnap::GetSubGraphs(UNGraph, NIdVV, UNGraphV, Renumber == 1);
+    TSnap::GetSubGraphs(NGraph, NIdVV, NGraphV, Renumber == 1);
+    ASSERT_EQ(NIdVV.Len(), UNGraphV.Len());
+    for (int i = 0; i < NIdVV.Len(); i++) {
+      TIntSet NIdSet;
+      for (int n = 0; n < NIdVV[i].Len(); n++) {
+        if (UNGraph->IsNode(NIdVV[i][n])) { NIdSet.AddKey(NIdVV[i][n]); } }
+      const PUNGraph UNSub = TSnap::GetSubGraph(UNGraph, NIdVV[i], Renumber == 1);
+      const PNGraph NSub = TSnap::GetSubGraph(NGraph, NIdVV[i], Renumber == 1);
+      EXPECT_EQ(NIdSet.Len(), UNGraphV[i]->GetNodes());
+      EXPECT_EQ(UNSub->GetEdges(), UNGraphV[i]->GetEdges());
+      EXPECT_EQ(NSub->GetEdges(), NGraphV[i]->GetEdges());
+      EXPECT_TRUE(UNGraphV[i]->IsOk(false));
+      EXPECT_TRUE(NGraphV[i]->IsOk(false));
+      for (TUNGraph::TEdgeI EI = UNSub->BegEI(); EI < UNSub->EndEI(); EI++) {
+        EXPECT_TRUE(UNGraphV[i]->IsEdge(EI.GetSrcNId(), EI.GetDstNId())); }
+      for (TNGraph::TEdgeI EI = NSub->BegEI(); EI < NSub->EndEI(); EI++) {
+        EXPECT_TRUE(NGraphV[i]->IsEdge(EI.GetSrcNId(), EI.GetDstNId())); }
+    }
+  }
+
+  // dense path of GetSubGraph and node masks give the same subgraph
+  TBoolV MaskV(UNGraph->GetMxNId());
+  TIntV HalfNIdV;
+  for (int NId = 0; NId < MaskV.Len(); NId += 2) { MaskV[NId] = true;  HalfNIdV.Add(NId); }
+  PUNGraph UNMask = TSnap::GetMaskSubGraph(UNGraph, MaskV);
+  PUNGraph UNHalf = TSnap::GetSubGraph(UNGraph, HalfNIdV);
+  EXPECT_EQ(150, UNMask->GetNodes());
+  EXPECT_EQ(UNHalf->GetEdges(), UNMask->GetEdges());
+  EXPECT_TRUE(UNMask->IsOk(false));
+  PNGraph NMask = TSnap::GetMaskSubGraph(NGraph, MaskV, true);
+  EXPECT_EQ(TSnap::GetSubGraph(NGraph, HalfNIdV)->GetEdges(), NMask->GetEdges());
+  EXPECT_EQ(150, NMask->GetMxNId());
+
+  TIntV CtrNIdV;
+  for (int NId = 0; NId < 300; NId += 3) { CtrNIdV.Add(NId); }
+  TVec<PUNGraph> UNEgoV;
+  TIntV ArndV;
+  TIntTrV StatV;
+  TSnap::GetEgonets(UNGraph, CtrNIdV, UNEgoV, ArndV);
+  TSnap::GetEgonetStats(UNGraph, CtrNIdV, StatV);
+  for (int i = 0; i < CtrNIdV.Len(); i++) {
+    if (CtrNIdV[i] == 7) { continue; } // GetEgonet does not support a center with a self-loop
+    int ArndEdges;
+    PUNGraph Ego = TSnap::GetEgonet(UNGraph, CtrNIdV[i], ArndEdges);
+    EXPECT_EQ(Ego->GetNodes(), UNEgoV[i]->GetNodes());
+    EXPECT_EQ(Ego->GetEdges(), UNEgoV[i]->GetEdges());
+    EXPECT_EQ(ArndEdges, ArndV[i]);
+    EXPECT_EQ(TIntTr(Ego->GetNodes(), Ego->GetEdges(), ArndEdges), StatV[i]);
+  }
+  TVec<PNGraph> NEgoV;
+  TIntV InV, OutV;
+  TSnap::GetEgonets(NGraph, CtrNIdV, NEgoV, InV, OutV);
+  for (int i = 0; i < CtrNIdV.Len(); i++) {
+    int InEdges, OutEdges;
+    PNGraph Ego = TSnap::GetEgonet(NGraph, CtrNIdV[i], InEdges, OutEdges);
+    EXPECT_EQ(Ego->GetNodes(), NEgoV[i]->GetNodes());
+    EXPECT_EQ(Ego->GetEdges(), NEgoV[i]->GetEdges());
+    EXPECT_GE(InEdges, InV[i]);
+    EXPECT_GE(OutEdges, OutV[i]);
+  }
+}
+
 // Test subgraphs
 TEST(subgraph, TestSubTNGraphs) {
   PNGraph Graph;
@@ -231,8 +309,11 @@ TEST(subgraph, TestConvertSubGraphs) {
     NIdV.Add(i);
   }
 
-  // TODO: fix TSnap::ConvertSubGraph<PUNGraph>(NGraph, NIdV, true), it fails
-  // UNGraph = TSnap::ConvertSubGraph<PUNGraph>(NGraph, NIdV, true);
+  UNGraph = TSnap::ConvertSubGraph<PUNGraph>(NGraph, NIdV, true);
+  EXPECT_EQ(10,UNGraph->GetNodes());
+  EXPECT_EQ(10,UNGraph->GetEdges());
+  EXPECT_EQ(9,UNGraph->GetMxNId()-1);
+
   UNGraph = TSnap::ConvertSubGraph<PUNGraph>(NGraph, NIdV);
   EXPECT_EQ(10,UNGraph->GetNodes());
   EXPECT_EQ(10,UNGraph->GetEdges());
@@ -0,0 +1,92 @@
+#include <gtest/gtest.h>
+
+#include "Snap.h"
+#include "graphcounter.h"
+#include "subgraphenum.h"
+
+// Counts of the isomorphism classes of the connected induced subgraphs on SubGraphSz nodes
+void GetSubGraphCnts(PNGraph& Graph, const int& SubGraphSz, const bool& MP, const int& Threads,
+    THash<TInt, TUInt64>& CntH) {
+  TD34GraphCounter Counter(SubGraphSz);
+  TSubGraphEnum<TD34GraphCounter> GraphEnum;
+#ifdef USE_OPENMP
+  const int MxThreads = omp_get_max_threads();
+  omp_set_num_threads(Threads);
+#endif
+  if (MP) { GraphEnum.GetSubGraphsMP(Graph, SubGraphSz, Counter); }
+  else { GraphEnum.GetSubGraphs(Graph, SubGraphSz, Counter); }
+#ifdef USE_OPENMP
+  omp_set_num_threads(MxThreads);
+#endif
+  CntH.Clr();
+  for (int i = 0; i < Counter.Len(); i++) {
+    const int GraphId = Counter.GetId(i);
+    if (Counter.GetCnt(GraphId) > 0) { CntH.AddDat(GraphId, Counter.GetCnt(GraphId)); }
+  }
+  CntH.SortByKey();
+}
+
+// Parallel enumeration finds the same number of subgraphs of each class
+TEST(subgraphenum, GetSubGraphsMP) {
+  TRnd Rnd(1);
+  PNGraph Graph = TSnap::GenRndGnm<PNGraph>(60, 240, true, Rnd);
+  for (int SubGraphSz = 3; SubGraphSz <= 4; SubGraphSz++) {
+    THash<TInt, TUInt64> ExpCntH, CntH1, CntH4;
+    GetSubGraphCnts(Graph, SubGraphSz, false, 1, ExpCntH);
+    GetSubGraphCnts(Graph, SubGraphSz, true, 1, CntH1);
+    GetSubGraphCnts(Graph, SubGraphSz, true, 4, CntH4);
+    EXPECT_LT(1, ExpCntH.Len());
+    EXPECT_TRUE(ExpCntH == CntH1);
+    EXPECT_TRUE(ExpCntH == CntH4);
+  }
+}
+
+// Rand-ESU counts divided by the sampling probability are unbiased estimates of the exact counts
+TEST(subgraphenum, GetSubGraphsMPSample) {
+  TRnd Rnd(2);
+  PNGraph Graph = TSnap::GenRndGnm<PNGraph>(60, 240, true, Rnd);
+  const int SubGraphSz = 4, Samples = 200;
+  TFltV ProbV;
+  ProbV.Add(1.0);  ProbV.Add(0.8);  ProbV.Add(0.7);  ProbV.Add(0.5);
+  const double SampleProb = TSubGraphEnum<TD34GraphCounter>::GetSampleProb(ProbV);
+  EXPECT_NEAR(0.28, SampleProb, 1e-12);
+  THash<TInt, TUInt64> ExpCntH;
+  GetSubGraphCnts(Graph, SubGraphSz, false, 1, ExpCntH);
+  // sum and sum of squares of the estimates of each class
+  TFltV SumV(ExpCntH.Len()), SqSumV(ExpCntH.Len());
+  for (int s = 1; s <= Samples; s++) {
+    TD34GraphCounter Counter(SubGraphSz);
+    TSubGraphEnum<TD34GraphCounter> GraphEnum;
+    GraphEnum.GetSubGraphsMP(Graph, SubGraphSz, Counter, ProbV, s);
+    for (int i = 0; i < ExpCntH.Len(); i++) {
+      const double Est = Counter.GetCnt(ExpCntH.GetKey(i)) / SampleProb;
+      SumV[i] += Est;  SqSumV[i] += Est * Est;
+    }
+  }
+  for (int i = 0; i < ExpCntH.Len(); i++) {
+    const double Exp = double(ExpCntH[i]);
+    const double Mean = SumV[i] / Samples;
+    const double StdErr = sqrt(TFlt::GetMx(SqSumV[i] / Samples - Mean * Mean, 0.0) / Samples);
+    if (Exp < 50) { continue; }
+    EXPECT_NEAR(Exp, Mean, 4 * StdErr + 1e-9);
+    EXPECT_NEAR(Exp, Mean, 0.05 * Exp);
+  }
+  // a fixed seed gives the same sample for 1 and 4 threads
+  TD34GraphCounter Counter1(SubGraphSz), Counter4(SubGraphSz);
+  TSubGraphEnum<TD34GraphCounter> GraphEnum;
+#ifdef USE_OPENMP
+  const int MxThreads = omp_get_max_threads();
+  omp_set_num_threads(1);
+#endif
+  GraphEnum.GetSubGraphsMP(Graph, SubGraphSz, Counter1, ProbV, 7);
+#ifdef USE_OPENMP
+  omp_set_num_threads(4);
+#endif
+  GraphEnum.GetSubGraphsMP(Graph, SubGraphSz, Counter4, ProbV, 7);
+#ifdef USE_OPENMP
+  omp_set_num_threads(MxThreads);
+#endif
+  for (int i = 0; i < ExpCntH.Len(); i++) {
+    EXPECT_EQ(Counter1.GetCnt(ExpCntH.GetKey(i)), Counter4.GetCnt(ExpCntH.GetKey(i)));
+  }
+}
@@ -0,0 +1,138 @@
+#include <gtest/gtest.h>
+
+#include "Snap.h"
+#include "temporalmotifs.h"
+
+// Random temporal edges on Nodes nodes in time order. Every edge repeats the
+// time of the previous one with probability TieProb, and repeats the whole
+// previous edge with probability DupProb.
+void GenTempEdges(const int& Edges, const int& Nodes, const double& TieProb, const double& DupProb,
+ TIntV& SrcV, TIntV& DstV, TIntV& TmV) {
+  TRnd Rnd(1);
+  SrcV.Clr();  DstV.Clr();  TmV.Clr();
+  int Tm = 0;
+  for (int e = 0; e < Edges; e++) {
+    if (e > 0 && Rnd.GetUniDev() < DupProb) {
+      SrcV.Add(SrcV.Last());  DstV.Add(DstV.Last());  TmV.Add(Tm);
+      continue;
+    }
+    if (e == 0 || Rnd.GetUniDev() >= TieProb) { Tm += 1 + Rnd.GetUniDevInt(3); }
+    const int Src = Rnd.GetUniDevInt(Nodes);
+    // a few self-loops, which both counters ignore
+    const int Dst = Rnd.GetUniDev() < 0.02 ? Src : (Src + 1 + Rnd.GetUniDevInt(Nodes-1)) % Nodes;
+    SrcV.Add(Src);  DstV.Add(Dst);  TmV.Add(Tm);
+  }
+}
+
+// Batch counts of the edges [Beg, End) of the stream, written in arrival order
+void GetBatchCounts(const TIntV& SrcV, const TIntV& DstV, const TIntV& TmV, const int& Beg, const int& End,
+ const double& Delta, Counter2D& Counts, Counter2D& EdgeCounts, Counter3D& TriadCounts) {
+  const TStr FNm = "test-tempmotifs.dat";
+  {
+    TFOut FOut(FNm);
+    for (int e = Beg; e < End; e++) {
+      FOut.PutStr(TStr::Fmt("%d %d %d\n", SrcV[e].Val, DstV[e].Val, TmV[e].Val)); }
+  }
+  TempMotifCounter Counter(FNm);
+  Counter.Count3TEdge23Node(Delta, Counts);
+  Counter.Count3TEdge2Node(Delta, EdgeCounts);
+  Counter.Count3TEdgeTriads(Delta, TriadCounts);
+}
+
+// Family of motif M_{i+1,j+1}: 0 for two nodes, 1 for stars, 2 for triangles
+int GetMotifFamily(const int& i, const int& j) {
+  if (i >= 4 && j <= 1) { return 0; }
+  if ((i <= 1 && (j == 2 || j == 3)) || ((i == 2 || i == 3) && j >= 4)) { return 2; }
+  return 1;
+}
+
+// Streams the edges and compares the counts of the window with the batch
+// counts of its edges every Step edges. With ExactTies false only the number
+// of instances of each family is compared, since the batch counter orders
+// edges with equal times by motif role and the stream by arrival.
+void TestStream(const TIntV& SrcV, const TIntV& DstV, const TIntV& TmV,
+ const double& Window, const double& Delta, const int& Step, const bool& ExactTies) {
+  TempMotifStreamCounter Stream(Window, Delta);
+  int Beg = 0, Checks = 0;
+  for (int e = 0; e < SrcV.Len(); e++) {
+    Stream.AddEdge(SrcV[e], DstV[e], TmV[e]);
+    while (double(TmV[Beg]) + Window < double(TmV[e])) { Beg++; }
+    if ((e+1) % Step != 0 && e+1 < SrcV.Len()) { continue; }
+    Counter2D StreamCounts, Counts, EdgeCounts;
+    Counter3D TriadCounts;
+    Stream.GetCounts(StreamCounts);
+    GetBatchCounts(SrcV, DstV, TmV, Beg, e+1, Stream.GetDelta(), Counts, EdgeCounts, TriadCounts);
+    uint64 StreamFamV[3] = {0, 0, 0}, FamV[3] = {0, 0, 0};
+    for (int i = 0; i < 6; i++) {
+      for (int j = 0; j < 6; j++) {
+        StreamFamV[GetMotifFamily(i, j)] += StreamCounts(i, j);
+        FamV[GetMotifFamily(i, j)] += Counts(i, j);
+        if (ExactTies) { EXPECT_EQ(Counts(i, j).Val, StreamCounts(i, j).Val) << "M" << i+1 << "," << j+1 << " at edge " << e; }
+      }
+    }
+    for (int f = 0; f < 3; f++) { EXPECT_EQ(FamV[f], StreamFamV[f]) << "family " << f << " at edge " << e; }
+    if (ExactTies) {
+      // the two-node motifs and the triangles on their own
+      EXPECT_EQ(EdgeCounts(0, 0).Val, StreamCounts(4, 0).Val);
+      EXPECT_EQ(EdgeCounts(0, 1).Val, StreamCounts(4, 1).Val);
+      EXPECT_EQ(EdgeCounts(1, 0).Val, StreamCounts(5, 0).Val);
+      EXPECT_EQ(EdgeCounts(1, 1).Val, StreamCounts(5, 1).Val);
+      EXPECT_EQ(TriadCounts(0, 0, 0).Val, StreamCounts(0, 2).Val);
+      EXPECT_EQ(TriadCounts(0, 1, 1).Val, StreamCounts(1, 3).Val);
+      EXPECT_EQ(TriadCounts(1, 0, 1).Val, StreamCounts(2, 5).Val);
+      EXPECT_EQ(TriadCounts(1, 1, 0).Val, StreamCounts(3, 4).Val);
+    }
+    Checks++;
+  }
+  EXPECT_LT(0, Checks);
+}
+
+// Distinct times: every motif count matches the batch counter
+TEST(temporalmotifs, StreamDistinctTimes) {
+  TIntV SrcV, DstV, TmV;
+  GenTempEdges(300, 6, 0.0, 0.0, SrcV, DstV, TmV);
+  TestStream(SrcV, DstV, TmV, 10, -1, 25, true);
+  TestStream(SrcV, DstV, TmV, 30, 12, 25, true);
+  TestStream(SrcV, DstV, TmV, 1000, 40, 50, true);
+  TestStream(SrcV, DstV, TmV, 1000, -1, 300, true);
+}
+
+// Equal times of repeated edges keep all motif counts exact, and windows and
+// delta include edges exactly at their bound
+TEST(temporalmotifs, StreamRepeatedEdges) {
+  TIntV SrcV, DstV, TmV;
+  GenTempEdges(300, 5, 0.0, 0.3, SrcV, DstV, TmV);
+  TestStream(SrcV, DstV, TmV, 8, -1, 20, true);
+  TestStream(SrcV, DstV, TmV, 20, 6, 20, true);
+  TestStream(SrcV, DstV, TmV, 1000, 15, 100, true);
+}
+
+// Equal times of different edges: the number of instances of each family matches
+TEST(temporalmotifs, StreamTiedTimes) {
+  TIntV SrcV, DstV, TmV;
+  GenTempEdges(300, 6, 0.5, 0.1, SrcV, DstV, TmV);
+  TestStream(SrcV, DstV, TmV, 6, -1, 20, false);
+  TestStream(SrcV, DstV, TmV, 20, 5, 20, false);
+  TestStream(SrcV, DstV, TmV, 1000, 10, 100, false);
+}
+
+// The stream rejects edges out of time order and Clr() resets it
+TEST(temporalmotifs, StreamOrder) {
+  TempMotifStreamCounter Stream(10);
+  Stream.AddEdge(0, 1, 5);
+  Stream.AddEdge(1, 0, 6);
+  Stream.AddEdge(0, 1, 7);
+  EXPECT_EQ(3, Stream.GetEdges());
+  Counter2D Counts;
+  Stream.GetCounts(Counts);
+  EXPECT_EQ(1, Counts(4, 0).Val);
+  EXPECT_ANY_THROW(Stream.AddEdge(0, 1, 4));
+  Stream.AdvanceTime(16);
+  EXPECT_EQ(2, Stream.GetEdges());
+  Stream.GetCounts(Counts);
+  EXPECT_EQ(0, Counts(4, 0).Val);
+  Stream.Clr();
+  EXPECT_EQ(0, Stream.GetEdges());
+  Stream.AddEdge(0, 1, 1);
+  EXPECT_EQ(1, Stream.GetEdges());
+}
@@ -471,6 +471,38 @@ TEST(triad, TestGetLen2Paths) {
   }
 }
 
+// Test streaming triangle estimation
+TEST(triad, TestStreamTriads) {
+  PUNGraph Graph = TSnap::GenRndGnm<PUNGraph>(300, 3000, false, TInt::Rnd);
+  const int64 Triads = TSnap::GetTriads(Graph);
+
+  // a reservoir that holds the whole stream gives exact counts
+  TStreamTriads Exact(Graph->GetEdges(), true);
+  for (TUNGraph::TEdgeI EI = Graph->BegEI(); EI < Graph->EndEI(); EI++) {
+    Exact.AddEdge(EI.GetSrcNId(), EI.GetDstNId());
+    Exact.AddEdge(EI.GetDstNId(), EI.GetSrcNId());
+  }
+  EXPECT_EQ(Graph->GetEdges(), Exact.GetEdges());
+  EXPECT_DOUBLE_EQ(double(Triads), Exact.GetTriads());
+  EXPECT_NEAR(TSnap::GetClustCf(Graph), Exact.GetClustCf(), 1e-9);
+  for (TUNGraph::TNodeI NI = Graph->BegNI(); NI < Graph->EndNI(); NI++) {
+    EXPECT_DOUBLE_EQ(TSnap::GetNodeTriads(Graph, NI.GetId()), Exact.GetNodeTriads(NI.GetId()));
+  }
+  int64 ClosedTriads, OpenTriads;
+  TSnap::GetTriads(Graph, ClosedTriads, OpenTriads, -1);
+  EXPECT_NEAR(3.0 * ClosedTriads / double(3 * ClosedTriads + OpenTriads), Exact.GetGlobClustCf(), 1e-9);
+
+  // sampled estimates from independent reservoirs
+  TSnap::SaveEdgeList(Graph, "test-stream.txt");
+  TFltTr TriadsCI, ClustCfCI;
+  TIntFltH NIdTriadH;
+  TSnap::GetStreamTriads("test-stream.txt", 1000, 16, TriadsCI, ClustCfCI, NIdTriadH);
+  EXPECT_TRUE(TriadsCI.Val2 <= TriadsCI.Val1 && TriadsCI.Val1 <= TriadsCI.Val3);
+  EXPECT_NEAR(double(Triads), TriadsCI.Val1, 0.25 * Triads);
+  EXPECT_NEAR(Exact.GetGlobClustCf(), ClustCfCI.Val1, 0.25 * Exact.GetGlobClustCf());
+  EXPECT_TRUE(NIdTriadH.Len() > 0);
+}
+
 // Helper: Testing Opened/Closed Triads for Specific Generated Graph
 void TestOpenCloseVector(TIntTrV& NIdCOTriadV) {
   for (TIntTr *Vec = NIdCOTriadV.BegI(); Vec < NIdCOTriadV.EndI(); Vec++) {